@@ -10,6 +10,8 @@
  * | Info         :   Basic version
  ******************************************************************************/
 
+#include <time.h>               // time_t conversions
+#include <sys/time.h>           // settimeofday()
 #include "freertos/FreeRTOS.h"  // FreeRTOS core definitions
 #include "freertos/task.h"      // FreeRTOS task management functions
 #include "io_extension.h"       // IO extension control (e.g., external interrupt input)
@@ -17,6 +19,8 @@
 
 static const char *TAG = "main";  // Tag for logging
 
+#define EXAMPLE_RTC_CHECK_PERIOD_S  (60)  // Compare the RTC with the system clock this often, in seconds
+
 // Initial RTC time to be set
 static datetime_t Set_Time = {
     .year = 2025,
@@ -41,13 +45,46 @@ static datetime_t Set_Alarm_Time = {
 
 char datetime_str[256];  // Buffer to store formatted date-time string
 
+// Seconds since the epoch of an RTC date, no time zone is set so mktime() takes it as UTC
+static time_t datetime_to_time(const datetime_t *dt)
+{
+    struct tm tm = {
+        .tm_year = dt->year - 1900,
+        .tm_mon = dt->month - 1,
+        .tm_mday = dt->day,
+        .tm_hour = dt->hour,
+        .tm_min = dt->min,
+        .tm_sec = dt->sec,
+    };
+    return mktime(&tm);
+}
+
+// RTC date of seconds since the epoch
+static datetime_t time_to_datetime(time_t t)
+{
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    const datetime_t dt = {
+        .year = tm.tm_year + 1900,
+        .month = tm.tm_mon + 1,
+        .day = tm.tm_mday,
+        .dotw = tm.tm_wday,
+        .hour = tm.tm_hour,
+        .min = tm.tm_min,
+        .sec = tm.tm_sec,
+    };
+    return dt;
+}
+
 /**
  * @brief Main application entry point.
  * 
  * This function initializes the I2C interface, IO extension hardware,
- * and the PCF85063A RTC. It sets the current time and alarm,
- * then enters a loop that reads the current time every second,
- * prints it over the serial interface, and checks the alarm status.
+ * and the PCF85063A RTC. It sets the current time and alarm, and
+ * seeds the system clock with one RTC read. It then enters a loop that
+ * prints the system time every second over the serial interface, checks
+ * the alarm status, and compares the RTC with the system clock every
+ * EXAMPLE_RTC_CHECK_PERIOD_S seconds instead of reading it every second.
  * 
  * Note: Alarm status must be polled due to lack of direct interrupt connection.
  */
@@ -73,10 +110,17 @@ void app_main()
     // Enable alarm interrupt
     PCF85063A_Enable_Alarm();
 
-    while (1)
+    // Read the RTC once, the system clock keeps the time from then on
+    PCF85063A_Read_now(&Now_time);
+    struct timeval tv = {
+        .tv_sec = datetime_to_time(&Now_time),
+    };
+    settimeofday(&tv, NULL);
+
+    for (int i = 1; ; i++)
     {
-        // Read current time from RTC
-        PCF85063A_Read_now(&Now_time);
+        // Current time from the system clock, no I2C traffic
+        Now_time = time_to_datetime(time(NULL));
 
         // Format current time as a string
         datetime_to_str(datetime_str, Now_time);
@@ -90,6 +134,14 @@ void app_main()
             ESP_LOGI(TAG, "The alarm clock goes off.");
         }
 
+        // Check that the RTC still agrees with the system clock
+        if (i % EXAMPLE_RTC_CHECK_PERIOD_S == 0)
+        {
+            datetime_t rtc_time;
+            PCF85063A_Read_now(&rtc_time);
+            ESP_LOGI(TAG, "RTC is %+d s from the system clock", (int)(datetime_to_time(&rtc_time) - time(NULL)));
+        }
+
         // Wait for 1 second
         vTaskDelay(1000 / portTICK_PERIOD_MS);
     }
@@ -18,6 +18,10 @@
  #define __IO_EXTENSION_H
  
  #include "i2c.h"  // Include I2C header for I2C communication functions
+ #include "freertos/FreeRTOS.h"
+ #include "freertos/semphr.h"
+ #include "freertos/task.h"
+ #include "esp_timer.h"
  
  /* 
   * IO EXTENSION GPIO control via I2C - Register and Command Definitions
@@ -54,11 +58,43 @@
  #define DO0 IO_EXTENSION_IO_6
  #define DO1 IO_EXTENSION_IO_7
  
+ /*
+  * Bus traffic related parameters, can be adjusted by users
+  */
+ #define IO_EXTENSION_COALESCE_US       (1000)          // Output changes within this window go out in one write, 0 writes at once
+ #define IO_EXTENSION_INPUT_CACHE_US    (5000)          // Input reads younger than this are served from the cache, 0 always reads
+ #define IO_EXTENSION_INT_GPIO          (GPIO_NUM_NC)   // ESP32 pin wired to the expander interrupt, inputs are then cached until it fires
+ #define IO_EXTENSION_FLUSH_TASK_STACK_SIZE (3 * 1024)  // Stack size of the task which sends the coalesced output writes, in bytes
+ #define IO_EXTENSION_FLUSH_TASK_PRIORITY   (5)         // Priority of the flush task
+ 
+ /* Bus transaction counters */
+ typedef struct {
+     uint32_t write_cnt;        // Register writes sent
+     uint32_t read_cnt;         // Register reads sent
+     uint32_t coalesced_cnt;    // Output changes merged into an earlier write
+     uint32_t skipped_cnt;      // Writes dropped because the register already held the value
+     uint32_t cache_hit_cnt;    // Input reads served from the cache
+ } io_extension_stats_t;
+ 
  /* Structure to represent the IO EXTENSION device */
  typedef struct _io_extension_obj_t {
      i2c_master_dev_handle_t addr;      // Handle for mode configuration
-     uint8_t Last_io_value;
+     uint8_t Last_io_value;             // Shadow of the output register, may be ahead of the chip
      uint8_t Last_od_value;
+     uint8_t Last_mode_value;           // Shadow of the mode register
+     uint8_t Last_pwm_value;            // Shadow of the PWM register
+     uint8_t Sent_io_value;             // Output register value last written to the chip
+     bool sent_valid;                   // Sent_io_value is known, false until the first write
+     bool io_dirty;                     // Last_io_value waits for the coalescing timer
+     uint8_t In_value;                  // Cached input register
+     volatile bool in_valid;            // In_value may be used
+     int64_t in_time_us;                // Time In_value was read
+     portMUX_TYPE lock;                 // Protects the shadow registers
+     SemaphoreHandle_t bus_lock;        // Keeps the register writes in order
+     esp_timer_handle_t flush_timer;    // Ends the coalescing window
+     TaskHandle_t flush_task;           // Sends the coalesced output writes, woken by flush_timer
+     io_extension_stats_t stats;        // Bus transaction counters
+     int64_t stats_since_us;            // Time the counters were last reset
  } io_extension_obj_t;
  
  
@@ -66,10 +102,16 @@
  void IO_EXTENSION_Init();                     // Initialize the IO_EXTENSION device
  void IO_EXTENSION_IO_Mode(uint8_t pin);
  void IO_EXTENSION_Output(uint8_t pin, uint8_t value);     // Set IO pin output (high/low)
+ void IO_EXTENSION_Output_Mask(uint8_t mask, uint8_t values);  // Set several IO pins in one update
+ void IO_EXTENSION_Flush();                    // Send pending output changes now
  uint8_t IO_EXTENSION_Input(uint8_t pin);   // Read IO pin input state
+ uint8_t IO_EXTENSION_Input_All();             // Read all IO pin input states
+ void IO_EXTENSION_Input_Invalidate();         // Force the next input read to use the bus, ISR safe
  void IO_EXTENSION_Pwm_Output(uint8_t Value);
  uint16_t IO_EXTENSION_Adc_Input();
  uint8_t IO_EXTENSION_RTC_INT_READ();
+ void IO_EXTENSION_Get_Stats(io_extension_stats_t *stats, bool reset);   // Read the bus transaction counters
+ void IO_EXTENSION_Log_Stats();                // Log the transactions per second since the last call
  
  #endif  // __IO_EXTENSION_H
  
\ No newline at end of file
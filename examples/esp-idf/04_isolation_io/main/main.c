@@ -23,7 +23,7 @@ void app_main()
     DEV_I2C_Init();
     IO_EXTENSION_Init();
 
-    IO_EXTENSION_IO_Mode(DI0 | DI5); // Set EXIO0 and EXIO5 to input mode
+    IO_EXTENSION_IO_Mode(~((1 << DI0) | (1 << DI1))); // Set EXIO0 and EXIO5 to input mode
 
     // Initialize the Waveshare ESP32-S3 RGB LCD
     waveshare_esp32_s3_rgb_lcd_init(); 
@@ -51,31 +51,33 @@ void app_main()
     // Clear the canvas and fill it with a white background
     Paint_Clear(WHITE);
 
-    uint8_t io[2] = {0}, DI_flag = 0, num = 0;
+    uint8_t io[2] = {0}, DI_flag = 0, num = 0, in = 0;
+    const uint8_t do_mask = (1 << DO0) | (1 << DO1);
     while (1)
     {
-        IO_EXTENSION_Output(DO0, 1);
-        IO_EXTENSION_Output(DO1, 0);
+        IO_EXTENSION_Output_Mask(do_mask, 1 << DO0); // DO0 high, DO1 low, in one write
         vTaskDelay(10 / portTICK_PERIOD_MS);
-        io[0] = IO_EXTENSION_Input(DI0); // Read DI0
-        io[1] = IO_EXTENSION_Input(DI1); // Read DI1
+        in = IO_EXTENSION_Input_All(); // Read DI0 and DI1 in one read
+        io[0] = (in >> DI0) & 1;
+        io[1] = (in >> DI1) & 1;
         // Check if both pins match expected values
         if (io[0] == 1 && io[1] == 0)
         {
             DI_flag++; // Increment DI flag
         }
 
-        IO_EXTENSION_Output(DO0, 0);
-        IO_EXTENSION_Output(DO1, 1);
+        IO_EXTENSION_Output_Mask(do_mask, 1 << DO1); // DO0 low, DO1 high, in one write
         vTaskDelay(10 / portTICK_PERIOD_MS);
-        io[0] = IO_EXTENSION_Input(DI0); // Read DI0
-        io[1] = IO_EXTENSION_Input(DI1); // Read DI1
+        in = IO_EXTENSION_Input_All(); // Read DI0 and DI1 in one read
+        io[0] = (in >> DI0) & 1;
+        io[1] = (in >> DI1) & 1;
         // Check again if both pins match expected values
         if (io[0] == 0 && io[1] == 1)
         {
             DI_flag++; // Increment DI flag
         }
         printf("DI_flag:%d\r\n",DI_flag);
+        IO_EXTENSION_Log_Stats(); // Expander bus transactions per second
         // If both conditions are met, DI & DO are working
         if (DI_flag >= 2)
         {
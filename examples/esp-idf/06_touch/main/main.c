@@ -19,7 +19,7 @@ static const char *TAG = "main";  // Logging tag for debugging purposes
 
 void app_main()
 {
-    touch_gt911_point_t point_data;  // Structure to store touch point data
+    touch_gt911_event_t point_data;  // Structure to store touch point data
 
     // Initialize the GT911 touch screen controller
     touch_gt911_init();  
@@ -70,8 +70,14 @@ void app_main()
     // Main application loop
     while (1)
     {
-        // Read the touch points from the touchscreen controller
-        point_data = touch_gt911_read_point(ESP_LCD_TOUCH_MAX_POINTS);
+        // Sleep until the touch controller reports a change, the bus stays idle meanwhile
+        if (!touch_gt911_event_wait(&point_data, portMAX_DELAY)) {
+            continue;
+        }
+
+        // Only the newest sample is drawn, skip the ones queued while the last frame was shown
+        while (touch_gt911_event_get(&point_data)) {
+        }
 
         // Process each touch point
         for (int i = 0; i < ESP_LCD_TOUCH_MAX_POINTS; i++)
@@ -6,12 +6,14 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 
 #include "i2c.h"
 #include "gpio.h"
@@ -33,6 +35,21 @@ static const char *TAG = "GT911";
 #define ESP_GT911_TOUCH_MAX_BUTTONS         (4)
 
 esp_lcd_touch_handle_t tp_handle = NULL; // Declare a handle for the touch panel
+
+/* Interrupt driven reader: one producer (reader task), one consumer (queue) */
+static struct {
+    TaskHandle_t task;                                          // Reader task, woken by the INT edge
+    TaskHandle_t consumer;                                      // Task blocked in touch_gt911_event_wait(), if any
+    volatile int64_t irq_time_us;                               // Time of the last INT edge
+    touch_gt911_event_t ring[TOUCH_GT911_EVENT_QUEUE_LEN];      // Event queue storage
+    atomic_uint head;                                           // Written by the producer only
+    atomic_uint tail;                                           // Written by the consumer only
+    portMUX_TYPE lock;                                          // Protects latest
+    touch_gt911_event_t latest;                                 // Latest sample for raw consumers
+    touch_gt911_reader_stats_t stats;                           // Reader statistics
+} reader = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -411,6 +428,11 @@ esp_lcd_touch_handle_t touch_gt911_init()
     // Create a new touch controller instance using the configured I2C and settings
     ESP_ERROR_CHECK(esp_lcd_touch_new_i2c_gt911(tp_io_handle, &tp_cfg, &tp_handle));
 
+#if TOUCH_GT911_USE_IRQ_READER
+    // Read the controller only when it signals new data on the INT pin
+    ESP_ERROR_CHECK(touch_gt911_reader_start(tp_handle));
+#endif
+
     return tp_handle;  // Return the touch controller handle
 }
 
@@ -419,6 +441,16 @@ touch_gt911_point_t touch_gt911_read_point(uint8_t max_touch_cnt)
 {
     touch_gt911_point_t data;  // Declare a structure to hold touch point data
 
+    /* The reader task owns the bus access, just return its latest sample */
+    if (touch_gt911_reader_is_running()) {
+        touch_gt911_event_t event;
+        touch_gt911_get_latest(&event);
+        data.cnt = (event.cnt > max_touch_cnt) ? max_touch_cnt : event.cnt;
+        memcpy(data.x, event.x, sizeof(data.x));
+        memcpy(data.y, event.y, sizeof(data.y));
+        return data;
+    }
+
     /* Read touch data from the touch controller */
     esp_lcd_touch_read_data(tp_handle);  // Read raw data from the touch controller
 
@@ -428,6 +460,173 @@ touch_gt911_point_t touch_gt911_read_point(uint8_t max_touch_cnt)
     return data;  // Return the touch point data
 }
 
+/*******************************************************************************
+* Interrupt driven reader
+*******************************************************************************/
+
+static void IRAM_ATTR touch_gt911_isr(esp_lcd_touch_handle_t tp)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    reader.irq_time_us = esp_timer_get_time();
+    reader.stats.irq_cnt++;
+    vTaskNotifyGiveFromISR(reader.task, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void touch_gt911_event_push(const touch_gt911_event_t *event)
+{
+    unsigned head = atomic_load_explicit(&reader.head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&reader.tail, memory_order_acquire);
+    TaskHandle_t consumer;
+
+    portENTER_CRITICAL(&reader.lock);
+    reader.latest = *event;
+    consumer = reader.consumer;
+    portEXIT_CRITICAL(&reader.lock);
+
+    /* Keep the queued history, the latest copy above always reflects the current state */
+    if (head - tail >= TOUCH_GT911_EVENT_QUEUE_LEN) {
+        reader.stats.drop_cnt++;
+    } else {
+        reader.ring[head & (TOUCH_GT911_EVENT_QUEUE_LEN - 1)] = *event;
+        atomic_store_explicit(&reader.head, head + 1, memory_order_release);
+        reader.stats.sample_cnt++;
+    }
+
+    if (consumer) {
+        xTaskNotifyGive(consumer);
+    }
+}
+
+static void touch_gt911_reader_task(void *arg)
+{
+    esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)arg;
+    touch_gt911_event_t event;
+    bool pressed = false;
+
+    while (1) {
+        /* Sleep until the next INT edge, only time out while a touch is held so a lost release edge is recovered */
+        TickType_t wait = pressed ? pdMS_TO_TICKS(TOUCH_GT911_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        if (ulTaskNotifyTake(pdTRUE, wait) > 0) {
+            event.timestamp_us = reader.irq_time_us;
+        } else {
+            event.timestamp_us = esp_timer_get_time();
+            reader.stats.poll_cnt++;
+        }
+
+        if (esp_lcd_touch_read_data(tp) != ESP_OK) {
+            reader.stats.err_cnt++;
+            continue;
+        }
+        esp_lcd_touch_get_coordinates(tp, event.x, event.y, event.strength, &event.cnt, ESP_LCD_TOUCH_MAX_POINTS);
+
+        /* Report a release only once */
+        if (event.cnt == 0 && !pressed) {
+            continue;
+        }
+        pressed = (event.cnt > 0);
+        touch_gt911_event_push(&event);
+    }
+}
+
+esp_err_t touch_gt911_reader_start(esp_lcd_touch_handle_t tp)
+{
+    ESP_RETURN_ON_FALSE(tp && tp->config.int_gpio_num != GPIO_NUM_NC, ESP_ERR_INVALID_ARG, TAG, "INT pin is required");
+    if (reader.task) {
+        return ESP_OK;
+    }
+
+    BaseType_t core_id = (TOUCH_GT911_READER_TASK_CORE < 0) ? tskNO_AFFINITY : TOUCH_GT911_READER_TASK_CORE;
+    BaseType_t ret = xTaskCreatePinnedToCore(touch_gt911_reader_task, "gt911", TOUCH_GT911_READER_TASK_STACK_SIZE, tp,
+                                             TOUCH_GT911_READER_TASK_PRIORITY, &reader.task, core_id);
+    ESP_RETURN_ON_FALSE(ret == pdPASS, ESP_FAIL, TAG, "Failed to create reader task");
+
+    /* Clear the pending status so the controller raises a fresh edge */
+    touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, 0);
+    ESP_RETURN_ON_ERROR(esp_lcd_touch_register_interrupt_callback(tp, touch_gt911_isr), TAG, "Register ISR failed");
+    ESP_LOGI(TAG, "Interrupt driven reader started");
+
+    return ESP_OK;
+}
+
+bool touch_gt911_reader_is_running(void)
+{
+    return (reader.task != NULL);
+}
+
+bool touch_gt911_event_get(touch_gt911_event_t *event)
+{
+    unsigned tail = atomic_load_explicit(&reader.tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&reader.head, memory_order_acquire);
+
+    assert(event != NULL);
+
+    if (head == tail) {
+        return false;
+    }
+    *event = reader.ring[tail & (TOUCH_GT911_EVENT_QUEUE_LEN - 1)];
+    atomic_store_explicit(&reader.tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+bool touch_gt911_event_wait(touch_gt911_event_t *event, TickType_t timeout)
+{
+    assert(event != NULL);
+
+    /* Without the reader, poll the controller once per period */
+    if (!touch_gt911_reader_is_running()) {
+        vTaskDelay(pdMS_TO_TICKS(TOUCH_GT911_POLL_PERIOD_MS));
+        touch_gt911_point_t point = touch_gt911_read_point(ESP_LCD_TOUCH_MAX_POINTS);
+        memset(event, 0, sizeof(*event));
+        event->timestamp_us = esp_timer_get_time();
+        event->cnt = point.cnt;
+        memcpy(event->x, point.x, sizeof(point.x));
+        memcpy(event->y, point.y, sizeof(point.y));
+        return true;
+    }
+
+    /* Register before looking at the queue, a sample pushed in between leaves the notification pending */
+    portENTER_CRITICAL(&reader.lock);
+    reader.consumer = xTaskGetCurrentTaskHandle();
+    portEXIT_CRITICAL(&reader.lock);
+
+    bool got = touch_gt911_event_get(event);
+    if (!got && ulTaskNotifyTake(pdTRUE, timeout) > 0) {
+        got = touch_gt911_event_get(event);
+    }
+
+    portENTER_CRITICAL(&reader.lock);
+    reader.consumer = NULL;
+    portEXIT_CRITICAL(&reader.lock);
+
+    return got;
+}
+
+bool touch_gt911_event_pending(void)
+{
+    return atomic_load_explicit(&reader.head, memory_order_acquire) != atomic_load_explicit(&reader.tail, memory_order_relaxed);
+}
+
+void touch_gt911_get_latest(touch_gt911_event_t *event)
+{
+    assert(event != NULL);
+
+    portENTER_CRITICAL(&reader.lock);
+    *event = reader.latest;
+    portEXIT_CRITICAL(&reader.lock);
+}
+
+void touch_gt911_reader_get_stats(touch_gt911_reader_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    *stats = reader.stats;
+}
+
 
 /*******************************************************************************
 * Private API function
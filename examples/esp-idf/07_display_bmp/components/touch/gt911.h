@@ -28,6 +28,20 @@
 #define EXAMPLE_PIN_NUM_TOUCH_RST       (-1)            // Reset pin for the touch controller (set to -1 if not used)
 #define EXAMPLE_PIN_NUM_TOUCH_INT       (GPIO_NUM_4)    // Interrupt pin for the touch controller
 
+/**
+ * Interrupt driven reader related parameters, can be adjusted by users
+ *
+ * When enabled, the INT edge wakes a reader task which fetches all points in one go,
+ * so the bus stays idle while nobody touches the screen.
+ */
+#define TOUCH_GT911_USE_IRQ_READER          (1)         // Set to 1 to start the reader in touch_gt911_init()
+#define TOUCH_GT911_READER_TASK_STACK_SIZE  (3 * 1024)  // The stack size of the reader task, in bytes
+#define TOUCH_GT911_READER_TASK_PRIORITY    (4)         // The priority of the reader task
+#define TOUCH_GT911_READER_TASK_CORE        (0)         // The core of the reader task, `-1` means don't specify the core
+#define TOUCH_GT911_EVENT_QUEUE_LEN         (16)        // Length of the event queue, must be a power of 2
+#define TOUCH_GT911_RELEASE_TIMEOUT_MS      (100)       // Poll once if no interrupt arrives for this long while pressed
+#define TOUCH_GT911_POLL_PERIOD_MS          (20)        // Polling period of touch_gt911_event_wait() when the reader is disabled
+
 /**
  * @brief GT911 Configuration Structure
  *
@@ -50,6 +64,30 @@ typedef struct {
     uint8_t cnt;                          /*!< Number of detected touch points */
 } touch_gt911_point_t;
 
+/**
+ * @brief Timestamped touch sample produced by the interrupt driven reader
+ *
+ * A sample with `cnt == 0` reports the release of all points.
+ */
+typedef struct {
+    int64_t timestamp_us;                           /*!< Time of the INT edge, from esp_timer_get_time() */
+    uint16_t x[ESP_LCD_TOUCH_MAX_POINTS];           /*!< X coordinates of touch points */
+    uint16_t y[ESP_LCD_TOUCH_MAX_POINTS];           /*!< Y coordinates of touch points */
+    uint16_t strength[ESP_LCD_TOUCH_MAX_POINTS];    /*!< Strength of touch points */
+    uint8_t cnt;                                    /*!< Number of detected touch points */
+} touch_gt911_event_t;
+
+/**
+ * @brief Statistics of the interrupt driven reader
+ */
+typedef struct {
+    uint32_t irq_cnt;       /*!< Number of INT edges */
+    uint32_t sample_cnt;    /*!< Number of samples pushed into the queue */
+    uint32_t drop_cnt;      /*!< Number of samples dropped because the queue was full */
+    uint32_t poll_cnt;      /*!< Number of reads triggered by the release timeout */
+    uint32_t err_cnt;       /*!< Number of failed reads */
+} touch_gt911_reader_stats_t;
+
 /**
  * @brief Create a new GT911 touch driver instance
  *
@@ -88,6 +126,74 @@ esp_lcd_touch_handle_t touch_gt911_init();
  */
 touch_gt911_point_t touch_gt911_read_point(uint8_t max_touch_cnt);
 
+/**
+ * @brief Start the interrupt driven reader
+ *
+ * The INT edge wakes a task which reads the points, timestamps them and pushes
+ * them into a lock-free queue. Once started, touch_gt911_read_point() returns the
+ * latest sample without accessing the bus.
+ *
+ * @param tp Touch handle returned by touch_gt911_init()
+ * @return
+ *      - ESP_OK: Success (also when the reader is running already)
+ *      - ESP_ERR_INVALID_ARG: The INT pin is not connected
+ *      - ESP_FAIL: Failed to create the task
+ */
+esp_err_t touch_gt911_reader_start(esp_lcd_touch_handle_t tp);
+
+/**
+ * @brief Check whether the interrupt driven reader is running
+ *
+ * @return true if the reader is running
+ */
+bool touch_gt911_reader_is_running(void);
+
+/**
+ * @brief Take the oldest sample from the event queue
+ *
+ * @note The queue has a single consumer.
+ *
+ * @param event Output sample
+ * @return true if a sample was taken, false if the queue is empty
+ */
+bool touch_gt911_event_get(touch_gt911_event_t *event);
+
+/**
+ * @brief Take the oldest sample from the event queue, waiting for one if it is empty
+ *
+ * The calling task sleeps until the reader pushes a sample, so a loop around this
+ * function costs nothing while nobody touches the screen.
+ *
+ * @note It uses the task notification of the calling task. When the reader is not
+ *       running, it polls the controller every TOUCH_GT911_POLL_PERIOD_MS instead.
+ *
+ * @param event Output sample
+ * @param timeout Maximum time to wait, in ticks
+ * @return true if a sample was taken, false on timeout
+ */
+bool touch_gt911_event_wait(touch_gt911_event_t *event, TickType_t timeout);
+
+/**
+ * @brief Check whether the event queue holds samples
+ *
+ * @return true if at least one sample is queued
+ */
+bool touch_gt911_event_pending(void);
+
+/**
+ * @brief Get a copy of the latest sample, it can be called from any task
+ *
+ * @param event Output sample
+ */
+void touch_gt911_get_latest(touch_gt911_event_t *event);
+
+/**
+ * @brief Get the statistics of the interrupt driven reader
+ *
+ * @param stats Output statistics
+ */
+void touch_gt911_reader_get_stats(touch_gt911_reader_stats_t *stats);
+
 /**
  * @brief Touch IO configuration structure for GT911
  *
@@ -49,7 +49,7 @@ void list_files(const char *base_path) {
 // Main application function
 void app_main()
 {
-    touch_gt911_point_t point_data;  // Structure to store touch point data
+    touch_gt911_event_t point_data;  // Structure to store touch point data
 
     // Initialize the GT911 touch screen controller
     touch_gt911_init();  
@@ -123,8 +123,11 @@ void app_main()
 
     while (1)
     {
-        point_data = touch_gt911_read_point(1);  // Read touch data
-        if (point_data.cnt == 1)  // Check if touch is detected
+        // Sleep until the touch controller reports a change, the bus stays idle meanwhile
+        if (!touch_gt911_event_wait(&point_data, portMAX_DELAY)) {
+            continue;
+        }
+        if (point_data.cnt > 0)  // Check if touch is detected
         {
             // If touch position hasn't changed, continue the loop
             if ((prev_x == point_data.x[0]) && (prev_y == point_data.y[0]))
@@ -185,6 +188,5 @@ void app_main()
                 prev_y = point_data.y[0];
             }          
         }
-        vTaskDelay(30);  // Delay for 30ms to avoid high CPU usage
     }
 }
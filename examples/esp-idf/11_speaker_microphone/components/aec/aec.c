@@ -0,0 +1,497 @@
+/*****************************************************************************
+ * | File         :   aec.c
+ * | Author       :   Waveshare team
+ * | Function     :   Acoustic echo canceller
+ * | Info         :
+ * |                 TX and RX share the I2S clock, so a reference sample and
+ * |                 a microphone sample keep a fixed distance in their
+ * |                 streams. That distance is searched on 4:1 decimated
+ * |                 audio, a few lags per frame, and the NLMS filter then
+ * |                 only has to cover the echo tail. A background filter
+ * |                 adapts all the time and is copied to the foreground
+ * |                 filter, which makes the output, only while it does
+ * |                 better, so double talk can not spoil the output. The
+ * |                 reference ring has one writer (playback) and one reader
+ * |                 (capture).
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "aec.h"
+
+static const char *TAG = "aec";  // Define a tag for logging
+
+#define AEC_BLOCK               (256)       // Samples per filter block, DTD and suppressor decisions are per block
+#define AEC_DEC                 (4)         // Decimation of the delay search
+#define AEC_DELAY_WINDOW        (1024)      // Decimated samples correlated per lag, 256 ms
+#define AEC_DELAY_LAGS          (AEC_MS_TO_SAMPLES(AEC_MAX_DELAY_MS) / AEC_DEC)
+#define AEC_DELAY_LAGS_PER_CALL (64)        // Spreads one search over about 16 blocks
+#define AEC_DELAY_RETRY_MS      (250)       // Wait after a search on a silent reference
+#define AEC_W_SHIFT             (28)        // Filter weights in Q28, echo path gains up to 8
+#define AEC_STEP_MAX            (8191)      // Limit of the per-sample update factor, keeps the update in 32 bits
+#define AEC_REGULARIZATION      ((int64_t)AEC_FILTER_TAPS * 32 * 32) // Keeps the NLMS step bounded on a quiet reference
+#define AEC_REF_SLACK           (2 * AEC_BLOCK) // Ring space kept clear of a push in progress
+
+#define AEC_MS_TO_SAMPLES(ms)   ((uint32_t)((uint64_t)(ms) * AEC_SAMPLE_RATE / 1000))
+#define AEC_DTD_HOLD_BLOCKS     ((AEC_MS_TO_SAMPLES(AEC_DTD_HOLD_MS) + AEC_BLOCK - 1) / AEC_BLOCK)
+
+// Levels are log2 of energies in Q8, 3.01 dB per unit, a full scale square wave is 30
+#define AEC_DB_TO_Q8(db)        ((int32_t)(db) * 25600 / 301)
+#define AEC_Q8_TO_DB(q8)        ((int16_t)((int32_t)(q8) * 301 / 25600))
+
+#if (AEC_REF_RING_SAMPLES & (AEC_REF_RING_SAMPLES - 1)) != 0
+#error "AEC_REF_RING_SAMPLES must be a power of two"
+#endif
+#if AEC_REF_RING_SAMPLES < AEC_DEC * (AEC_DELAY_WINDOW + AEC_MAX_DELAY_MS * AEC_SAMPLE_RATE / 1000 / AEC_DEC) + 4 * AEC_BLOCK
+#error "AEC_REF_RING_SAMPLES must cover the delay search"
+#endif
+
+struct aec {
+    // Reference ring, tx is written by aec_push_reference() only
+    int16_t *ref;
+    uint32_t tx;                                // Reference samples pushed
+
+    // Microphone side, aec_process() only
+    uint32_t rx;                                // Microphone samples processed
+    int32_t base;                               // tx - rx when the first microphone block came
+    bool based;
+    int32_t delay;                              // Reference index is rx + base - delay, -1 until found
+    int32_t candidate;                          // Delay found once, taken when the next search agrees
+
+    // NLMS filters
+    int32_t w[AEC_FILTER_TAPS];                 // Foreground echo path in Q28, makes the output
+    int32_t wb[AEC_FILTER_TAPS];                // Background echo path, adapts
+    int16_t xh[2 * AEC_FILTER_TAPS];            // Reference history, stored twice so it reads straight
+    uint32_t xpos;                              // Newest sample in xh
+    int64_t px;                                 // Energy of the history
+    int16_t ref_block[AEC_BLOCK];               // Reference of the current block, kept off the caller's stack
+    int32_t err_block[AEC_BLOCK];               // Filter output of the current block
+
+    // Block decisions
+    int32_t erle_q8;                            // Average ERLE of far-end only blocks
+    uint32_t dtd_hold;                          // Blocks left before the background may be copied again
+    int32_t res_gain_q15;                       // Suppressor gain of the last block
+    uint64_t sum_d, sum_e, sum_o;               // Averaged energies of far-end only blocks: mic, filter out, final out
+
+    // Delay search
+    int16_t mic_hist[AEC_DELAY_WINDOW];         // Decimated microphone, a ring
+    uint32_t mic_pos;
+    uint32_t mic_fill;
+    int32_t dec_acc;
+    uint32_t dec_cnt;
+    int16_t dm[AEC_DELAY_WINDOW];               // Snapshot of the microphone, oldest first
+    int16_t dr[AEC_DELAY_WINDOW + AEC_DELAY_LAGS]; // Snapshot of the reference, AEC_DELAY_LAGS older than dm
+    bool searching;
+    uint32_t lag;                               // Next lag to correlate
+    int64_t em;                                 // Energy of dm
+    int64_t er;                                 // Energy of the dr window at lag
+    float best_score;
+    uint32_t best_lag;
+    uint32_t search_at;                         // rx at which the next search may start
+
+    aec_stats_t stats;
+};
+
+/**************************************************************************************************
+ *
+ * Helper Functions
+ *
+ **************************************************************************************************/
+
+// log2 in Q8, the mantissa is taken as linear
+static int32_t aec_log2_q8(uint64_t x)
+{
+    if (x == 0) {
+        return 0;
+    }
+    const int n = 63 - __builtin_clzll(x);
+    const uint64_t frac = (n >= 8) ? (x >> (n - 8)) : (x << (8 - n));
+    return n * 256 + (int32_t)(frac & 0xff);
+}
+
+static inline int16_t aec_sat16(int32_t v)
+{
+    return (v > INT16_MAX) ? INT16_MAX : (v < INT16_MIN) ? INT16_MIN : (int16_t)v;
+}
+
+// Copy reference samples from idx on, false with zeros if any of them is not there
+static bool aec_ref_fetch(aec_t *aec, uint32_t idx, int16_t *dst, uint32_t n)
+{
+    const uint32_t tx = __atomic_load_n(&aec->tx, __ATOMIC_ACQUIRE);
+
+    if ((int32_t)(tx - (idx + n)) < 0 || (int32_t)(tx - idx) > AEC_REF_RING_SAMPLES - AEC_REF_SLACK) {
+        memset(dst, 0, n * sizeof(int16_t));
+        return false;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = aec->ref[(idx + i) & (AEC_REF_RING_SAMPLES - 1)];
+    }
+    return true;
+}
+
+static void aec_filter_reset(aec_t *aec)
+{
+    memset(aec->w, 0, sizeof(aec->w));
+    memset(aec->wb, 0, sizeof(aec->wb));
+    memset(aec->xh, 0, sizeof(aec->xh));
+    aec->xpos = 0;
+    aec->px = 0;
+    aec->erle_q8 = 0;
+    aec->dtd_hold = 0;
+    aec->res_gain_q15 = 32768;
+}
+
+/**************************************************************************************************
+ *
+ * Delay Search
+ *
+ **************************************************************************************************/
+
+static void aec_delay_feed(aec_t *aec, const int16_t *pcm, uint32_t n, int channels)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        aec->dec_acc += pcm[i * channels];
+        if (++aec->dec_cnt == AEC_DEC) {
+            aec->mic_hist[aec->mic_pos] = (int16_t)(aec->dec_acc / AEC_DEC);
+            aec->mic_pos = (aec->mic_pos + 1) % AEC_DELAY_WINDOW;
+            if (aec->mic_fill < AEC_DELAY_WINDOW) {
+                aec->mic_fill++;
+            }
+            aec->dec_acc = 0;
+            aec->dec_cnt = 0;
+        }
+    }
+}
+
+// Freeze the last window of both streams, false if the reference was too quiet to search
+static bool aec_delay_snapshot(aec_t *aec, uint32_t rx_end)
+{
+    int16_t block[AEC_DEC * 64];
+    const uint32_t total = AEC_DELAY_WINDOW + AEC_DELAY_LAGS;
+    const uint32_t ref_start = rx_end + aec->base - AEC_DEC * total;
+    int64_t ref_energy = 0;
+
+    for (uint32_t i = 0; i < AEC_DELAY_WINDOW; i++) {
+        aec->dm[i] = aec->mic_hist[(aec->mic_pos + i) % AEC_DELAY_WINDOW];
+    }
+    for (uint32_t j = 0; j < total; j += 64) {
+        const uint32_t cnt = (total - j < 64) ? total - j : 64;
+        aec_ref_fetch(aec, ref_start + j * AEC_DEC, block, cnt * AEC_DEC);
+        for (uint32_t k = 0; k < cnt; k++) {
+            const int32_t s = block[k * AEC_DEC] + block[k * AEC_DEC + 1] + block[k * AEC_DEC + 2] + block[k * AEC_DEC + 3];
+            aec->dr[j + k] = (int16_t)(s / AEC_DEC);
+            ref_energy += (int32_t)aec->dr[j + k] * aec->dr[j + k];
+        }
+    }
+
+    aec->em = 0;
+    for (uint32_t i = 0; i < AEC_DELAY_WINDOW; i++) {
+        aec->em += (int32_t)aec->dm[i] * aec->dm[i];
+    }
+    aec->er = 0;
+    for (uint32_t i = 0; i < AEC_DELAY_WINDOW; i++) {
+        aec->er += (int32_t)aec->dr[AEC_DELAY_LAGS + i] * aec->dr[AEC_DELAY_LAGS + i];
+    }
+
+    const int32_t level = aec_log2_q8((uint64_t)ref_energy / total);
+    return aec->em > 0 && level >= 30 * 256 + AEC_DB_TO_Q8(AEC_FAR_MIN_DBFS);
+}
+
+// Take a found delay, the filter is restarted only if the echo falls outside it
+static void aec_delay_apply(aec_t *aec, int32_t lag)
+{
+    if (aec->delay >= 0) {
+        if (lag - aec->delay >= AEC_DELAY_MARGIN / 2 && lag - aec->delay <= AEC_FILTER_TAPS * 3 / 4) {
+            aec->candidate = -1;
+            return;
+        }
+        // Voiced speech correlates at its pitch period too, so a working filter is
+        // trusted and a move needs two searches that agree
+        if (aec->erle_q8 >= AEC_DB_TO_Q8(AEC_DTD_DB)) {
+            return;
+        }
+        if (aec->candidate < 0 || abs(lag - aec->candidate) > 2 * AEC_DEC) {
+            aec->candidate = lag;
+            return;
+        }
+    }
+    aec->candidate = -1;
+    aec->delay = (lag > AEC_DELAY_MARGIN) ? lag - AEC_DELAY_MARGIN : 0;
+    aec_filter_reset(aec);
+    aec->stats.delay = aec->delay;
+    aec->stats.delay_changes++;
+    ESP_LOGD(TAG, "Reference delay %" PRId32 " samples", aec->delay);
+}
+
+// Start or continue the search, AEC_DELAY_LAGS_PER_CALL lags at a time
+static void aec_delay_step(aec_t *aec, uint32_t rx_end)
+{
+    if (!aec->searching) {
+        if ((int32_t)(rx_end - aec->search_at) < 0 || aec->mic_fill < AEC_DELAY_WINDOW) {
+            return;
+        }
+        if (!aec_delay_snapshot(aec, rx_end)) {
+            aec->search_at = rx_end + AEC_MS_TO_SAMPLES(AEC_DELAY_RETRY_MS);
+            return;
+        }
+        aec->searching = true;
+        aec->lag = 0;
+        aec->best_score = 0;
+        aec->best_lag = 0;
+    }
+
+    const uint32_t end = (aec->lag + AEC_DELAY_LAGS_PER_CALL < AEC_DELAY_LAGS) ? aec->lag + AEC_DELAY_LAGS_PER_CALL : AEC_DELAY_LAGS;
+    for (uint32_t k = aec->lag; k < end; k++) {
+        const int16_t *r = &aec->dr[AEC_DELAY_LAGS - k];
+        int64_t c = 0;
+        for (uint32_t i = 0; i < AEC_DELAY_WINDOW; i++) {
+            c += (int32_t)aec->dm[i] * r[i];
+        }
+        if (aec->er > 0) {
+            const float score = (float)c * (float)c / ((float)aec->em * (float)aec->er);
+            if (score > aec->best_score) {
+                aec->best_score = score;
+                aec->best_lag = k;
+            }
+        }
+        // Slide the reference window one step back for lag k + 1
+        if (k + 1 < AEC_DELAY_LAGS) {
+            aec->er -= (int32_t)r[AEC_DELAY_WINDOW - 1] * r[AEC_DELAY_WINDOW - 1];
+            aec->er += (int32_t)r[-1] * r[-1];
+        }
+    }
+    aec->lag = end;
+    if (end < AEC_DELAY_LAGS) {
+        return;
+    }
+
+    aec->searching = false;
+    aec->search_at = rx_end + (aec->delay >= 0 ? AEC_MS_TO_SAMPLES(AEC_DELAY_PERIOD_MS) : 0);
+    if (aec->best_score * 10000 >= AEC_DELAY_MIN_CORR * AEC_DELAY_MIN_CORR) {
+        aec_delay_apply(aec, (int32_t)(aec->best_lag * AEC_DEC));
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Echo Cancellation
+ *
+ **************************************************************************************************/
+
+static void aec_process_block(aec_t *aec, int16_t *pcm, uint32_t n, int channels)
+{
+    int16_t *ref = aec->ref_block;
+    int32_t *err = aec->err_block;
+
+    if (!aec->based) {
+        aec->base = (int32_t)(__atomic_load_n(&aec->tx, __ATOMIC_ACQUIRE) - aec->rx);
+        aec->based = true;
+    }
+    aec_delay_feed(aec, pcm, n, channels);
+    aec_delay_step(aec, aec->rx + n - aec->dec_cnt);
+    aec->stats.frames++;
+
+    // Pass through until the delay is known
+    if (aec->delay < 0) {
+        aec->rx += n;
+        return;
+    }
+
+    const bool have_ref = aec_ref_fetch(aec, aec->rx + aec->base - aec->delay, ref, n);
+    aec->rx += n;
+    int64_t ref_energy = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        ref_energy += (int32_t)ref[i] * ref[i];
+    }
+    const bool far = have_ref && aec_log2_q8((uint64_t)ref_energy / n) >= 30 * 256 + AEC_DB_TO_Q8(AEC_FAR_MIN_DBFS);
+    aec->stats.ref_missing += have_ref ? 0 : 1;
+
+    uint64_t ed = 0, ee = 0, ey = 0, eb = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        // Slot xpos - 1 holds the oldest sample, it becomes the newest
+        aec->xpos = (aec->xpos + AEC_FILTER_TAPS - 1) % AEC_FILTER_TAPS;
+        const int32_t old = aec->xh[aec->xpos];
+        aec->px += (int32_t)ref[i] * ref[i] - old * old;
+        aec->xh[aec->xpos] = aec->xh[aec->xpos + AEC_FILTER_TAPS] = ref[i];
+
+        const int16_t *x = &aec->xh[aec->xpos];
+        int64_t acc = 0, accb = 0;
+        for (int k = 0; k < AEC_FILTER_TAPS; k++) {
+            acc += (int64_t)aec->w[k] * x[k];
+            accb += (int64_t)aec->wb[k] * x[k];
+        }
+        const int32_t d = pcm[i * channels];
+        const int32_t y = (int32_t)(acc >> AEC_W_SHIFT);
+        const int32_t e = d - y;
+        const int32_t e_b = d - (int32_t)(accb >> AEC_W_SHIFT);
+
+        if (far) {
+            int64_t g = (((int64_t)AEC_STEP_SIZE_Q15 * e_b) << (AEC_W_SHIFT - 15)) / (aec->px + AEC_REGULARIZATION);
+            g = (g > AEC_STEP_MAX) ? AEC_STEP_MAX : (g < -AEC_STEP_MAX) ? -AEC_STEP_MAX : g;
+            for (int k = 0; k < AEC_FILTER_TAPS; k++) {
+                aec->wb[k] += (int32_t)g * x[k];
+            }
+        }
+
+        err[i] = e;
+        ed += (uint64_t)((int64_t)d * d);
+        ee += (uint64_t)((int64_t)e * e);
+        ey += (uint64_t)((int64_t)y * y);
+        eb += (uint64_t)((int64_t)e_b * e_b);
+    }
+
+    // Double talk: the block removes much less echo than the output filter usually does
+    bool double_talk = false;
+    if (far) {
+        aec->stats.far_frames++;
+        const int32_t block_erle = aec_log2_q8(ed) - aec_log2_q8(ee);
+        if (aec->erle_q8 > AEC_DB_TO_Q8(AEC_DTD_DB) && block_erle < aec->erle_q8 - AEC_DB_TO_Q8(AEC_DTD_DB)) {
+            double_talk = true;
+            aec->dtd_hold = AEC_DTD_HOLD_BLOCKS;
+            aec->stats.double_talk_frames++;
+            aec->erle_q8 -= AEC_DB_TO_Q8(3) / 64;   // A moved echo path looks the same, so the average sinks 3 dB/s
+        } else {
+            aec->erle_q8 += (block_erle - aec->erle_q8) / 8;
+        }
+    }
+
+    // The background takes over once clearly better. In double talk it partly fits the
+    // near-end speech, so there it must be far better and the microphone must be no louder
+    // than the echo the output filter expects, which is what a moved echo path looks like.
+    // It is pulled back once it has clearly diverged
+    if (far) {
+        const bool better = (aec->dtd_hold == 0) ? (eb * 2 < ee && eb < ed) : (eb * 8 < ee && eb * 8 < ed && ed * 2 < ey * 3);
+        if (better) {
+            memcpy(aec->w, aec->wb, sizeof(aec->w));
+            aec->stats.filter_copies++;
+        } else if (eb > ee * 4 && eb > ed) {
+            memcpy(aec->wb, aec->w, sizeof(aec->wb));
+        }
+    }
+    if (aec->dtd_hold > 0 && !double_talk) {
+        aec->dtd_hold--;
+    }
+
+    // Residual echo suppressor: attenuate blocks where what is left looks like echo
+    int32_t gain = 32768;
+    if (far && ey > 0) {
+        const uint64_t ratio = (ee * AEC_RES_OVERDRIVE * 32768) / ey;
+        gain = (ratio > 32768) ? 32768 : (int32_t)ratio;
+        const int32_t floor_q15 = (int32_t)(32768 >> (-AEC_RES_FLOOR_DB / 6));  // 6 dB per shift
+        if (gain < floor_q15) {
+            gain = floor_q15;
+        }
+    }
+    // Open at once for near-end speech, close over a few blocks
+    if (gain < aec->res_gain_q15) {
+        gain = aec->res_gain_q15 + (gain - aec->res_gain_q15) / 2;
+    }
+
+    uint64_t eo = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        // Ramp from the last gain so a change does not click
+        const int32_t g = aec->res_gain_q15 + (int32_t)((int64_t)(gain - aec->res_gain_q15) * (int32_t)i / (int32_t)n);
+        const int16_t o = aec_sat16((int32_t)(((int64_t)err[i] * g) >> 15));
+        eo += (uint64_t)((int32_t)o * o);
+        for (int c = 0; c < channels; c++) {
+            pcm[i * channels + c] = o;
+        }
+    }
+    aec->res_gain_q15 = gain;
+
+    if (far && !double_talk) {
+        aec->sum_d += ed - (aec->sum_d >> 6);
+        aec->sum_e += ee - (aec->sum_e >> 6);
+        aec->sum_o += eo - (aec->sum_o >> 6);
+        aec->stats.erle_db = AEC_Q8_TO_DB(aec_log2_q8(aec->sum_d) - aec_log2_q8(aec->sum_e));
+        aec->stats.erle_res_db = AEC_Q8_TO_DB(aec_log2_q8(aec->sum_d) - aec_log2_q8(aec->sum_o));
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Public Functions
+ *
+ **************************************************************************************************/
+
+aec_t *aec_create(void)
+{
+    // The filter runs from internal RAM, the long reference history lives in PSRAM
+    aec_t *aec = heap_caps_calloc(1, sizeof(aec_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!aec) {
+        return NULL;
+    }
+    aec->ref = heap_caps_calloc(AEC_REF_RING_SAMPLES, sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!aec->ref) {
+        heap_caps_free(aec);
+        return NULL;
+    }
+    aec_reset(aec);
+    return aec;
+}
+
+void aec_delete(aec_t *aec)
+{
+    if (aec) {
+        heap_caps_free(aec->ref);
+        heap_caps_free(aec);
+    }
+}
+
+void aec_reset(aec_t *aec)
+{
+    int16_t *ref = aec->ref;
+
+    memset(aec, 0, sizeof(aec_t));
+    aec->ref = ref;
+    aec->delay = -1;
+    aec->candidate = -1;
+    aec->stats.delay = -1;
+    aec_filter_reset(aec);
+}
+
+void aec_push_reference(aec_t *aec, const int16_t *pcm, size_t frames, int channels)
+{
+    uint32_t tx = aec->tx;
+
+    for (size_t i = 0; i < frames; i++) {
+        const int32_t s = (channels == 2) ? (pcm[2 * i] + pcm[2 * i + 1]) / 2 : pcm[i];
+        aec->ref[tx++ & (AEC_REF_RING_SAMPLES - 1)] = (int16_t)s;
+    }
+    __atomic_store_n(&aec->tx, tx, __ATOMIC_RELEASE);
+}
+
+void aec_process(aec_t *aec, int16_t *pcm, size_t frames, int channels)
+{
+    while (frames > 0) {
+        const uint32_t n = (frames < AEC_BLOCK) ? frames : AEC_BLOCK;
+        aec_process_block(aec, pcm, n, channels);
+        pcm += n * channels;
+        frames -= n;
+    }
+}
+
+void aec_get_stats(aec_t *aec, aec_stats_t *stats)
+{
+    *stats = aec->stats;
+}
+
+void aec_log_stats(aec_t *aec)
+{
+    aec_stats_t stats;
+    aec_get_stats(aec, &stats);
+
+    ESP_LOGI(TAG, "delay %" PRId32 " samples (%" PRIu32 " changes), frames %" PRIu32 ", far-end %" PRIu32
+             ", double talk %" PRIu32 ", filter copies %" PRIu32 ", no reference %" PRIu32,
+             stats.delay, stats.delay_changes, stats.frames, stats.far_frames,
+             stats.double_talk_frames, stats.filter_copies, stats.ref_missing);
+    ESP_LOGI(TAG, "ERLE %d dB, with suppressor %d dB", stats.erle_db, stats.erle_res_db);
+}
@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * | File         :   aec.h
+ * | Author       :   Waveshare team
+ * | Function     :   Acoustic echo canceller
+ * | Info         :
+ * |                 Removes the speaker from the microphone with the played
+ * |                 audio as reference. The delay between the two streams is
+ * |                 found by cross-correlation, a fixed point NLMS filter
+ * |                 models the echo path and a residual echo suppressor
+ * |                 attenuates what the filter leaves.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#ifndef __AEC_H
+#define __AEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Canceller configuration, can be adjusted by users */
+#define AEC_SAMPLE_RATE             (16000)     // The only rate the canceller runs at
+#define AEC_FILTER_TAPS             (256)       // Echo tail covered by the filter, 16 ms
+#define AEC_STEP_SIZE_Q15           (8192)      // NLMS step size, 0.25
+#define AEC_MAX_DELAY_MS            (250)       // Longest reference delay searched: I2S DMA on both sides plus the air
+#define AEC_DELAY_MARGIN            (32)        // Filter taps kept ahead of the estimated delay
+#define AEC_DELAY_PERIOD_MS         (1000)      // How often the delay is checked once found
+#define AEC_DELAY_MIN_CORR          (30)        // Lowest normalized correlation, in %, for a delay to be taken
+#define AEC_REF_RING_SAMPLES        (16384)     // Reference history in PSRAM, must cover the delay search
+#define AEC_FAR_MIN_DBFS            (-50)       // Quieter reference counts as silence, the filter does not adapt on it
+#define AEC_DTD_DB                  (6)         // A frame whose ERLE drops this far below the average is double talk
+#define AEC_DTD_HOLD_MS             (96)        // The output filter is not updated this long after double talk
+#define AEC_RES_OVERDRIVE           (4)         // Residual echo suppression strength
+#define AEC_RES_FLOOR_DB            (-30)       // Strongest residual echo suppression
+
+typedef struct aec aec_t;
+
+/**
+ * @brief Canceller statistics
+ */
+typedef struct {
+    int32_t delay;                  // Reference delay applied in samples, -1 until it is found
+    uint32_t delay_changes;         // Times the delay was found or moved
+    uint32_t frames;                // Calls to aec_process()
+    uint32_t far_frames;            // Frames with audio on the reference
+    uint32_t double_talk_frames;    // Far-end frames with near-end speech, left out of the ERLE
+    uint32_t filter_copies;         // Times the adapting filter replaced the output filter
+    uint32_t ref_missing;           // Frames without reference, it was not pushed yet or already overwritten
+    int16_t erle_db;                // Echo removed by the filter on far-end only frames, averaged
+    int16_t erle_res_db;            // Same after the residual echo suppressor
+} aec_stats_t;
+
+/**
+ * @brief Create a canceller.
+ *
+ * @return The canceller, NULL if memory is short
+ */
+aec_t *aec_create(void);
+
+/**
+ * @brief Delete a canceller.
+ *
+ * @param aec: Canceller
+ */
+void aec_delete(aec_t *aec);
+
+/**
+ * @brief Forget the echo path, the delay and the statistics, for a new stream.
+ *
+ * @param aec: Canceller
+ */
+void aec_reset(aec_t *aec);
+
+/**
+ * @brief Hand over audio that was just written to the speaker.
+ *
+ * Call from the task that writes I2S, right after each write, silence included, so the
+ * reference runs in step with the speaker. Stereo is mixed down.
+ *
+ * @param aec: Canceller
+ * @param pcm: Interleaved 16-bit samples at AEC_SAMPLE_RATE
+ * @param frames: Samples per channel
+ * @param channels: 1 or 2
+ */
+void aec_push_reference(aec_t *aec, const int16_t *pcm, size_t frames, int channels);
+
+/**
+ * @brief Remove the echo from audio that was just read from the microphone.
+ *
+ * Call from the task that reads I2S, right after each read, so the microphone runs in
+ * step with the reference. Runs on the first channel and writes the result to all of them.
+ *
+ * @param aec: Canceller
+ * @param pcm: Interleaved 16-bit samples at AEC_SAMPLE_RATE, processed in place
+ * @param frames: Samples per channel
+ * @param channels: 1 or 2
+ */
+void aec_process(aec_t *aec, int16_t *pcm, size_t frames, int channels);
+
+/**
+ * @brief Get the statistics.
+ *
+ * @param aec: Canceller
+ * @param stats: Output statistics
+ */
+void aec_get_stats(aec_t *aec, aec_stats_t *stats);
+
+/**
+ * @brief Log the statistics.
+ *
+ * @param aec: Canceller
+ */
+void aec_log_stats(aec_t *aec);
+
+#endif
@@ -0,0 +1,11 @@
+/* Host stub of the capability allocator, maps to calloc */
+#pragma once
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+
+#define heap_caps_calloc(n, size, caps)     calloc(n, size)
+#define heap_caps_free(ptr)                 free(ptr)
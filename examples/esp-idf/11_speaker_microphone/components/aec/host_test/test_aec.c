@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * | File         :   test_aec.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the echo canceller
+ * | Info         :
+ * |                 Plays synthetic voiced speech through a simulated speaker
+ * |                 to microphone path, 12 ms of echo tail behind about 100 ms
+ * |                 of I2S delay, and runs aec.c on the microphone. Checks the
+ * |                 echo removed (ERLE) with and without the suppressor, the
+ * |                 recovery after the echo path moves and that near-end
+ * |                 speech passes during double talk.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "aec.h"
+
+#define FS              (AEC_SAMPLE_RATE)
+#define CLIP_SECONDS    (24)
+#define N               (FS * CLIP_SECONDS)
+#define BLOCK           (256)               // Samples per I2S read and write, 16 ms
+#define SYS_DELAY       (1700)              // Speaker write to microphone read, DMA on both sides
+#define PATH_LEN        (200)               // Echo path taps, 12.5 ms
+#define PATH_MOVE_S     (14)                // The echo path changes here, someone moved the board
+#define ECHO_GAIN       (0.5)
+#define MIC_NOISE       (4)                 // Microphone noise, about -80 dBFS
+
+static int failures;
+
+#define CHECK(cond) do {                                                    \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static double far_end[N], near_end[N], echo[N];
+static int16_t ref[N], mic[N], out[N];
+
+/**************************************************************************************************
+ *
+ * Signals
+ *
+ **************************************************************************************************/
+
+static uint32_t rnd_state;
+
+// Uniform in [-1, 1], repeatable
+static double rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (double)(rnd_state >> 8) / (1 << 23) - 1.0;
+}
+
+// Voiced speech: a wobbling pitch with three formants, syllables at 4 Hz and some fricatives
+static void speech(double *x, double level_dbfs, uint32_t seed, double gap_s, int from_s, int to_s)
+{
+    int t = from_s * FS;
+    double ph = 0;
+
+    rnd_state = seed;
+    while (t < to_s * FS) {
+        const int len = (int)(FS * (0.4 + 0.8 * (rnd() + 1)));
+        const double f0 = 100 + 75 * (rnd() + 1);
+        const double amp = pow(10, (level_dbfs + 4 * rnd()) / 20) * 32767;
+
+        for (int i = 0; i < len && t + i < to_s * FS; i++) {
+            const double tt = (double)i / FS;
+            const double f = f0 * (1 + 0.05 * sin(2 * M_PI * 2 * tt));
+            double env = 0.5 - 0.5 * cos(2 * M_PI * 4 * tt);
+            double s = 0;
+
+            env = env < 0.15 ? 0.15 : env;
+            ph += 2 * M_PI * f / FS;
+            for (int h = 1; h * f < 7500; h++) {
+                const double fh = h * f;
+                const double g = exp(-pow((fh - 700) / 300, 2)) + 0.6 * exp(-pow((fh - 1200) / 400, 2)) +
+                                 0.3 * exp(-pow((fh - 2500) / 500, 2));
+                s += g * sin(h * ph);
+            }
+            if (fmod(tt, 0.5) > 0.42) {
+                s = 0.3 * rnd();
+            }
+            x[t + i] += amp * env * s;
+        }
+        t += len + (int)(FS * (gap_s + 0.3 * (rnd() + 1)));
+    }
+}
+
+// A direct sound and a decaying tail of reflections, scaled to the echo gain
+static void echo_path(double *h, int direct, double direct_gain, double decay, uint32_t seed)
+{
+    double norm = 0;
+
+    rnd_state = seed;
+    for (int k = 0; k < PATH_LEN; k++) {
+        h[k] = (k < direct) ? 0 : rnd() * exp(-(k - direct) / decay);
+        norm += h[k] * h[k];
+    }
+    h[direct] = direct_gain;
+    norm += direct_gain * direct_gain;
+    for (int k = 0; k < PATH_LEN; k++) {
+        h[k] *= ECHO_GAIN / sqrt(norm);
+    }
+}
+
+static int16_t sat16(double v)
+{
+    return (int16_t)(v > 32767 ? 32767 : v < -32768 ? -32768 : lrint(v));
+}
+
+/**************************************************************************************************
+ *
+ * Measurement
+ *
+ **************************************************************************************************/
+
+// Echo removed over a stretch without near-end speech, in dB
+static double erle_db(int from_s, int to_s)
+{
+    double se = 0, so = 0;
+
+    for (int i = from_s * FS; i < to_s * FS; i++) {
+        se += echo[i] * echo[i];
+        so += (double)out[i] * out[i];
+    }
+    return 10 * log10(se / so);
+}
+
+// What double talk did to the near-end speech, distortion and echo left, in dB below it
+static double near_error_db(int from_s, int to_s)
+{
+    double sn = 0, se = 0;
+
+    for (int i = from_s * FS; i < to_s * FS; i++) {
+        const double r = out[i] - near_end[i];
+        sn += near_end[i] * near_end[i];
+        se += r * r;
+    }
+    return 10 * log10(se / sn);
+}
+
+// Level of the output against the near-end speech alone, the suppressor must not duck it
+static double near_kept_db(int from_s, int to_s)
+{
+    double sn = 0, so = 0;
+
+    for (int i = from_s * FS; i < to_s * FS; i++) {
+        sn += near_end[i] * near_end[i];
+        so += (double)out[i] * out[i];
+    }
+    return 10 * log10(so / sn);
+}
+
+int main(void)
+{
+    static double h1[PATH_LEN], h2[PATH_LEN];
+    aec_stats_t stats;
+    aec_t *aec;
+
+    // Far-end talk all along, near-end talk over it twice, once on each echo path
+    speech(far_end, -18, 7, 0.1, 0, CLIP_SECONDS);
+    speech(near_end, -22, 11, 0.3, 10, 13);
+    speech(near_end, -22, 13, 0.3, 18, 21);
+    echo_path(h1, 20, 1.0, 30, 3);
+    echo_path(h2, 28, -0.8, 35, 5);
+
+    rnd_state = 17;
+    for (int i = 0; i < N; i++) {
+        ref[i] = sat16(far_end[i]);
+    }
+    for (int i = 0; i < N; i++) {
+        const double *h = (i < PATH_MOVE_S * FS) ? h1 : h2;
+        double s = 0;
+        for (int k = 0; k < PATH_LEN; k++) {
+            const int m = i - SYS_DELAY - k;
+            s += (m >= 0) ? h[k] * ref[m] : 0;
+        }
+        echo[i] = s;
+        mic[i] = sat16(s + near_end[i] + MIC_NOISE * rnd());
+    }
+
+    // The speaker task pushes each block right after its write, the microphone task reads one
+    aec = aec_create();
+    CHECK(aec != NULL);
+    if (!aec) {
+        return 1;
+    }
+    memcpy(out, mic, sizeof(out));
+    for (int b = 0; b < N / BLOCK; b++) {
+        aec_push_reference(aec, ref + b * BLOCK, BLOCK, 1);
+        aec_process(aec, out + b * BLOCK, BLOCK, 1);
+    }
+    aec_get_stats(aec, &stats);
+    aec_log_stats(aec);
+
+    // The first seconds find the delay and train the filter
+    printf("ERLE  3-10 s: %5.1f dB\n", erle_db(3, 10));
+    printf("ERLE 13-14 s: %5.1f dB, after double talk\n", erle_db(13, 14));
+    printf("ERLE 16-18 s: %5.1f dB, after the path moved\n", erle_db(16, 18));
+    printf("ERLE 21-24 s: %5.1f dB\n", erle_db(21, 24));
+    printf("Near-end 10-13 s: error %5.1f dB, level %+5.1f dB\n", near_error_db(10, 13), near_kept_db(10, 13));
+    printf("Near-end 18-21 s: error %5.1f dB, level %+5.1f dB\n", near_error_db(18, 21), near_kept_db(18, 21));
+
+    // Set about 6 dB under what this clip measures, 63/70/46/53 dB out, 44 and 60 dB in the stats
+    CHECK(stats.delay >= 0 && stats.delay_changes >= 1);
+    CHECK(stats.ref_missing == 0);
+    CHECK(stats.erle_db >= 38);
+    CHECK(stats.erle_res_db >= stats.erle_db + 10);
+    CHECK(erle_db(3, 10) >= 55);
+    CHECK(erle_db(13, 14) >= 60);
+    CHECK(erle_db(16, 18) >= 40);
+    CHECK(erle_db(21, 24) >= 46);
+
+    // Double talk freezes the filter, near-end speech passes at its level over the echo left
+    CHECK(near_error_db(10, 13) <= -10);
+    CHECK(near_error_db(18, 21) <= -10);
+    CHECK(fabs(near_kept_db(10, 13)) <= 2);
+    CHECK(fabs(near_kept_db(18, 21)) <= 2);
+
+    aec_delete(aec);
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
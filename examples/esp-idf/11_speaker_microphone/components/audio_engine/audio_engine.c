@@ -0,0 +1,464 @@
+/*****************************************************************************
+ * | File         :   audio_engine.c
+ * | Author       :   Waveshare team
+ * | Function     :   Full-duplex audio engine
+ * | Info         :
+ * |                 Each ring has exactly one producer and one consumer, the
+ * |                 free running head and tail counters are each written by
+ * |                 one side only, so no locks are taken on the audio path.
+ * |                 The playback task writes silence when its ring is empty,
+ * |                 I2S never stalls on a late producer.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "codec_dev.h"
+#include "aec.h"
+#include "audio_engine.h"
+
+static const char *TAG = "audio_engine";  // Define a tag for logging
+
+#define AUDIO_ENGINE_MAX_FRAME_SIZE     (AUDIO_ENGINE_FRAME_SAMPLES * 2 * sizeof(int16_t))
+
+// Single producer, single consumer ring of frames
+typedef struct {
+    uint8_t *buf;
+    int64_t *stamp;                 // esp_timer time each frame was queued
+    uint32_t frame_num;
+    volatile uint32_t head;         // Frames queued, written by the producer only
+    volatile uint32_t tail;         // Frames taken, written by the consumer only
+    uint32_t head_off;              // Bytes already in the head frame, byte-wise producer only
+    uint32_t tail_off;              // Bytes already taken from the tail frame, byte-wise consumer only
+} audio_ring_t;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static audio_ring_t s_capture_ring = { .frame_num = AUDIO_ENGINE_CAPTURE_FRAMES };
+static audio_ring_t s_playback_ring = { .frame_num = AUDIO_ENGINE_PLAYBACK_FRAMES };
+static uint8_t *s_in_frame = NULL;         // I2S read target
+static uint8_t *s_silence = NULL;          // Written while the playback ring is empty
+static SemaphoreHandle_t s_capture_sem = NULL;     // Given when a frame was captured
+static SemaphoreHandle_t s_space_sem = NULL;       // Given when a frame was played
+static SemaphoreHandle_t s_done_sem = NULL;        // Given by each task on exit
+static aec_t *s_aec = NULL;                        // Created on the first run with aec, kept for the next
+
+static audio_engine_config_t s_config;
+static uint32_t s_frame_size = 0;
+static volatile bool s_running = false;
+static volatile bool s_stop = false;
+static int64_t s_start_us = 0;
+static int64_t s_capture_busy_us = 0;     // Guarded by s_lock, 64 bits are not read in one access
+static int64_t s_playback_busy_us = 0;    // Guarded by s_lock
+static uint64_t s_latency_sum_us = 0;
+static uint32_t s_latency_cnt = 0;
+static audio_engine_stats_t s_stats;
+
+/**************************************************************************************************
+ *
+ * Ring Functions
+ *
+ **************************************************************************************************/
+
+static inline uint8_t *audio_ring_slot(audio_ring_t *ring, uint32_t n)
+{
+    return ring->buf + (n % ring->frame_num) * s_frame_size;
+}
+
+// Frames waiting, as seen by the producer
+static inline uint32_t audio_ring_fill_producer(audio_ring_t *ring)
+{
+    return ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+// Frames waiting, as seen by the consumer
+static inline uint32_t audio_ring_fill_consumer(audio_ring_t *ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - ring->tail;
+}
+
+static void audio_ring_commit(audio_ring_t *ring, uint32_t *peak)
+{
+    ring->stamp[ring->head % ring->frame_num] = esp_timer_get_time();
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+
+    const uint32_t fill = audio_ring_fill_producer(ring);
+    portENTER_CRITICAL(&s_lock);
+    if (fill > *peak) {
+        *peak = fill;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// Queue one whole frame, false if the ring is full
+static bool audio_ring_push_frame(audio_ring_t *ring, const uint8_t *frame, uint32_t *peak)
+{
+    if (audio_ring_fill_producer(ring) >= ring->frame_num) {
+        return false;
+    }
+    memcpy(audio_ring_slot(ring, ring->head), frame, s_frame_size);
+    audio_ring_commit(ring, peak);
+    return true;
+}
+
+static void audio_ring_alloc(audio_ring_t *ring)
+{
+    ring->buf = heap_caps_malloc(ring->frame_num * AUDIO_ENGINE_MAX_FRAME_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    ring->stamp = heap_caps_calloc(ring->frame_num, sizeof(int64_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
+static void audio_ring_reset(audio_ring_t *ring)
+{
+    ring->head = ring->tail = 0;
+    ring->head_off = ring->tail_off = 0;
+}
+
+/**************************************************************************************************
+ *
+ * Capture And Playback Tasks
+ *
+ **************************************************************************************************/
+
+static void audio_engine_capture_task(void *arg)
+{
+    int64_t busy_from = esp_timer_get_time();
+
+    while (!s_stop) {
+        size_t bytes_read = 0;
+        const int64_t wait_from = esp_timer_get_time();
+        const esp_err_t ret = mic_i2s_read(s_in_frame, s_frame_size, &bytes_read, portMAX_DELAY);
+        const int64_t now = esp_timer_get_time();
+        const int64_t busy_us = wait_from - busy_from;
+        busy_from = now;
+
+        if (ret != ESP_OK || bytes_read != s_frame_size) {
+            portENTER_CRITICAL(&s_lock);
+            s_capture_busy_us += busy_us;
+            s_stats.io_errors++;
+            portEXIT_CRITICAL(&s_lock);
+            continue;
+        }
+        if (s_config.aec) {
+            aec_process(s_aec, (int16_t *)s_in_frame, AUDIO_ENGINE_FRAME_SAMPLES, s_config.channels);
+        }
+
+        bool capture_lost = false;
+        bool loopback_lost = false;
+        if (s_config.capture) {
+            capture_lost = !audio_ring_push_frame(&s_capture_ring, s_in_frame, &s_stats.capture_peak);
+            if (!capture_lost) {
+                xSemaphoreGive(s_capture_sem);
+            }
+        }
+        if (s_config.loopback) {
+            loopback_lost = !audio_ring_push_frame(&s_playback_ring, s_in_frame, &s_stats.playback_peak);
+        }
+
+        portENTER_CRITICAL(&s_lock);
+        s_capture_busy_us += busy_us;
+        s_stats.captured_frames++;
+        s_stats.capture_overruns += capture_lost;
+        s_stats.loopback_overruns += loopback_lost;
+        portEXIT_CRITICAL(&s_lock);
+    }
+
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+static void audio_engine_playback_task(void *arg)
+{
+    audio_ring_t *ring = &s_playback_ring;
+    int64_t busy_from = esp_timer_get_time();
+    bool primed = false;
+
+    while (!s_stop) {
+        const bool have = audio_ring_fill_consumer(ring) > 0;
+        uint8_t *frame = have ? audio_ring_slot(ring, ring->tail) : s_silence;
+        const bool underrun = !have && primed;
+        primed = have;
+
+        uint32_t latency_us = 0;
+        if (have) {
+            const int64_t dma_us = (int64_t)AUDIO_ENGINE_DMA_SAMPLES * 1000000 / s_config.sample_rate;
+            latency_us = (uint32_t)(esp_timer_get_time() - ring->stamp[ring->tail % ring->frame_num] + dma_us);
+        }
+
+        size_t bytes_written = 0;
+        const int64_t wait_from = esp_timer_get_time();
+        const esp_err_t ret = speaker_i2s_write(frame, s_frame_size, &bytes_written, portMAX_DELAY);
+        const int64_t now = esp_timer_get_time();
+        const int64_t busy_us = wait_from - busy_from;
+        busy_from = now;
+
+        // The canceller needs what the speaker plays, silence included, in step with I2S
+        if (s_config.aec) {
+            aec_push_reference(s_aec, (const int16_t *)frame, AUDIO_ENGINE_FRAME_SAMPLES, s_config.channels);
+        }
+
+        // The slot is only handed back once I2S has copied it
+        if (have) {
+            __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+            xSemaphoreGive(s_space_sem);
+        }
+
+        portENTER_CRITICAL(&s_lock);
+        s_playback_busy_us += busy_us;
+        s_stats.played_frames++;
+        s_stats.playback_underruns += underrun;
+        if (ret != ESP_OK || bytes_written != s_frame_size) {
+            s_stats.io_errors++;
+        }
+        if (have) {
+            s_latency_sum_us += latency_us;
+            s_latency_cnt++;
+            if (latency_us > s_stats.latency_max_us) {
+                s_stats.latency_max_us = latency_us;
+            }
+        }
+        portEXIT_CRITICAL(&s_lock);
+    }
+
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+/**************************************************************************************************
+ *
+ * Engine Functions
+ *
+ **************************************************************************************************/
+
+esp_err_t audio_engine_start(const audio_engine_config_t *config)
+{
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!config || !config->sample_rate || config->channels < 1 || config->channels > 2) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (config->aec && config->sample_rate != AEC_SAMPLE_RATE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Buffers are sized for stereo and stay allocated for the next run
+    if (!s_in_frame) {
+        audio_ring_alloc(&s_capture_ring);
+        audio_ring_alloc(&s_playback_ring);
+        s_in_frame = heap_caps_malloc(AUDIO_ENGINE_MAX_FRAME_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_silence = heap_caps_calloc(1, AUDIO_ENGINE_MAX_FRAME_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_capture_sem = xSemaphoreCreateBinary();
+        s_space_sem = xSemaphoreCreateBinary();
+        s_done_sem = xSemaphoreCreateCounting(2, 0);
+        if (!s_capture_ring.buf || !s_capture_ring.stamp || !s_playback_ring.buf || !s_playback_ring.stamp ||
+            !s_in_frame || !s_silence || !s_capture_sem || !s_space_sem || !s_done_sem) {
+            ESP_LOGE(TAG, "Failed to allocate buffers");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (config->aec) {
+        if (!s_aec) {
+            s_aec = aec_create();
+            if (!s_aec) {
+                ESP_LOGE(TAG, "Failed to create the echo canceller");
+                return ESP_ERR_NO_MEM;
+            }
+        }
+        aec_reset(s_aec);
+    }
+
+    s_config = *config;
+    s_frame_size = AUDIO_ENGINE_FRAME_SAMPLES * config->channels * sizeof(int16_t);
+    audio_ring_reset(&s_capture_ring);
+    audio_ring_reset(&s_playback_ring);
+    xSemaphoreTake(s_capture_sem, 0);
+    xSemaphoreTake(s_space_sem, 0);
+
+    portENTER_CRITICAL(&s_lock);
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.frame_size = s_frame_size;
+    s_stats.frame_us = (uint32_t)((uint64_t)AUDIO_ENGINE_FRAME_SAMPLES * 1000000 / config->sample_rate);
+    s_latency_sum_us = 0;
+    s_latency_cnt = 0;
+    s_capture_busy_us = 0;
+    s_playback_busy_us = 0;
+    portEXIT_CRITICAL(&s_lock);
+
+    speaker_codec_set_fs(config->sample_rate, 16, config->channels);
+
+    s_stop = false;
+    portENTER_CRITICAL(&s_lock);
+    s_start_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&s_lock);
+    if (xTaskCreate(audio_engine_playback_task, "audio_play", AUDIO_ENGINE_TASK_STACK_SIZE, NULL,
+                    AUDIO_ENGINE_TASK_PRIORITY, NULL) != pdPASS) {
+        speaker_codec_dev_resume();
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(audio_engine_capture_task, "audio_capture", AUDIO_ENGINE_TASK_STACK_SIZE, NULL,
+                    AUDIO_ENGINE_TASK_PRIORITY, NULL) != pdPASS) {
+        s_stop = true;
+        xSemaphoreTake(s_done_sem, portMAX_DELAY);
+        speaker_codec_dev_resume();
+        return ESP_ERR_NO_MEM;
+    }
+    s_running = true;
+
+    ESP_LOGI(TAG, "Started, %" PRIu32 " Hz, %d channel(s), %" PRIu32 " us frames%s%s%s",
+             config->sample_rate, config->channels, s_stats.frame_us,
+             config->capture ? ", capture" : "", config->loopback ? ", loopback" : "", config->aec ? ", aec" : "");
+    return ESP_OK;
+}
+
+esp_err_t audio_engine_stop(void)
+{
+    if (!s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Each task ends after its current frame
+    s_stop = true;
+    xSemaphoreTake(s_done_sem, portMAX_DELAY);
+    xSemaphoreTake(s_done_sem, portMAX_DELAY);
+    s_running = false;
+
+    speaker_codec_dev_resume();
+    audio_engine_log_stats();
+    return ESP_OK;
+}
+
+bool audio_engine_is_running(void)
+{
+    return s_running;
+}
+
+size_t audio_engine_read(void *buffer, size_t len, uint32_t timeout_ms)
+{
+    audio_ring_t *ring = &s_capture_ring;
+    uint8_t *dst = buffer;
+    const int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    size_t done = 0;
+
+    if (!s_running || !s_config.capture) {
+        return 0;
+    }
+
+    while (done < len) {
+        if (audio_ring_fill_consumer(ring) == 0) {
+            const int64_t left_us = deadline - esp_timer_get_time();
+            if (left_us <= 0 || s_stop) {
+                break;
+            }
+            xSemaphoreTake(s_capture_sem, pdMS_TO_TICKS(left_us / 1000) + 1);
+            continue;
+        }
+
+        const size_t n = (len - done < s_frame_size - ring->tail_off) ? len - done : s_frame_size - ring->tail_off;
+        memcpy(dst + done, audio_ring_slot(ring, ring->tail) + ring->tail_off, n);
+        done += n;
+        ring->tail_off += n;
+        if (ring->tail_off == s_frame_size) {
+            ring->tail_off = 0;
+            __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+        }
+    }
+    return done;
+}
+
+size_t audio_engine_write(const void *buffer, size_t len, uint32_t timeout_ms)
+{
+    audio_ring_t *ring = &s_playback_ring;
+    const uint8_t *src = buffer;
+    const int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    size_t done = 0;
+
+    if (!s_running || s_config.loopback) {
+        return 0;
+    }
+
+    while (done < len) {
+        if (audio_ring_fill_producer(ring) >= ring->frame_num) {
+            const int64_t left_us = deadline - esp_timer_get_time();
+            if (left_us <= 0 || s_stop) {
+                break;
+            }
+            xSemaphoreTake(s_space_sem, pdMS_TO_TICKS(left_us / 1000) + 1);
+            continue;
+        }
+
+        const size_t n = (len - done < s_frame_size - ring->head_off) ? len - done : s_frame_size - ring->head_off;
+        memcpy(audio_ring_slot(ring, ring->head) + ring->head_off, src + done, n);
+        done += n;
+        ring->head_off += n;
+        if (ring->head_off == s_frame_size) {
+            ring->head_off = 0;
+            audio_ring_commit(ring, &s_stats.playback_peak);
+        }
+    }
+    return done;
+}
+
+void audio_engine_flush(void)
+{
+    audio_ring_t *ring = &s_playback_ring;
+
+    if (!s_running || s_config.loopback || ring->head_off == 0) {
+        return;
+    }
+    // A partial head frame always has room, the ring was not full when it was started
+    memset(audio_ring_slot(ring, ring->head) + ring->head_off, 0, s_frame_size - ring->head_off);
+    ring->head_off = 0;
+    audio_ring_commit(ring, &s_stats.playback_peak);
+}
+
+uint32_t audio_engine_playback_queued(void)
+{
+    return audio_ring_fill_producer(&s_playback_ring);
+}
+
+void audio_engine_get_stats(audio_engine_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_lock);
+    const int64_t elapsed_us = esp_timer_get_time() - s_start_us;
+    *stats = s_stats;
+    const uint64_t latency_sum_us = s_latency_sum_us;
+    const uint32_t latency_cnt = s_latency_cnt;
+    const int64_t capture_busy_us = s_capture_busy_us;
+    const int64_t playback_busy_us = s_playback_busy_us;
+    portEXIT_CRITICAL(&s_lock);
+
+    stats->latency_avg_us = latency_cnt ? (uint32_t)(latency_sum_us / latency_cnt) : 0;
+    if (elapsed_us > 0) {
+        stats->capture_load_pm = (uint16_t)(capture_busy_us * 1000 / elapsed_us);
+        stats->playback_load_pm = (uint16_t)(playback_busy_us * 1000 / elapsed_us);
+    }
+}
+
+void audio_engine_log_stats(void)
+{
+    audio_engine_stats_t stats;
+    audio_engine_get_stats(&stats);
+
+    ESP_LOGI(TAG, "frames captured %" PRIu32 ", played %" PRIu32 " (%" PRIu32 " bytes, %" PRIu32 " us), "
+             "overruns capture %" PRIu32 " loopback %" PRIu32 ", underruns %" PRIu32 ", io errors %" PRIu32,
+             stats.captured_frames, stats.played_frames, stats.frame_size, stats.frame_us,
+             stats.capture_overruns, stats.loopback_overruns, stats.playback_underruns, stats.io_errors);
+    ESP_LOGI(TAG, "latency avg %" PRIu32 " us, max %" PRIu32 " us, ring peak capture %" PRIu32 "/%d playback %" PRIu32 "/%d, "
+             "cpu capture %u.%u%%, playback %u.%u%%",
+             stats.latency_avg_us, stats.latency_max_us,
+             stats.capture_peak, AUDIO_ENGINE_CAPTURE_FRAMES, stats.playback_peak, AUDIO_ENGINE_PLAYBACK_FRAMES,
+             stats.capture_load_pm / 10, stats.capture_load_pm % 10,
+             stats.playback_load_pm / 10, stats.playback_load_pm % 10);
+    if (s_config.aec && s_aec) {
+        aec_log_stats(s_aec);
+    }
+}
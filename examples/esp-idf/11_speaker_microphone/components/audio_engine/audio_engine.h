@@ -0,0 +1,153 @@
+/*****************************************************************************
+ * | File         :   audio_engine.h
+ * | Author       :   Waveshare team
+ * | Function     :   Full-duplex audio engine
+ * | Info         :
+ * |                 A capture task and a playback task own the I2S channels
+ * |                 and exchange fixed-size frames with the application
+ * |                 through lock-free rings, so no caller blocks on I2S.
+ * |                 Capture can also be fed straight to playback (loopback)
+ * |                 and cleaned of the speaker echo on the way (AEC).
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#ifndef __AUDIO_ENGINE_H
+#define __AUDIO_ENGINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/* Engine configuration, can be adjusted by users */
+#define AUDIO_ENGINE_FRAME_SAMPLES      (256)       // Samples per channel in one frame, 5.8 ms at 44.1 kHz
+#define AUDIO_ENGINE_CAPTURE_FRAMES     (32)        // Capture ring depth
+#define AUDIO_ENGINE_PLAYBACK_FRAMES    (32)        // Playback ring depth
+#define AUDIO_ENGINE_DMA_SAMPLES        (6 * 240)   // I2S TX DMA buffering (dma_desc_num * dma_frame_num), added to the latency
+#define AUDIO_ENGINE_TASK_PRIORITY      (10)
+#define AUDIO_ENGINE_TASK_STACK_SIZE    (3 * 1024)
+
+/**
+ * @brief Engine configuration
+ */
+typedef struct {
+    uint32_t sample_rate;       // e.g. 16000, 44100, 48000
+    uint8_t channels;           // 1 or 2, 16-bit samples
+    bool capture;               // Keep captured frames for audio_engine_read()
+    bool loopback;              // Play captured frames straight away, audio_engine_write() is refused then
+    bool aec;                   // Remove the speaker echo from captured frames, needs AEC_SAMPLE_RATE
+} audio_engine_config_t;
+
+/**
+ * @brief Engine statistics
+ */
+typedef struct {
+    uint32_t frame_size;            // Bytes per frame
+    uint32_t frame_us;              // Duration of one frame
+    uint32_t captured_frames;       // Frames read from I2S
+    uint32_t played_frames;         // Frames written to I2S, silence included
+    uint32_t capture_overruns;      // Captured frames dropped, audio_engine_read() fell behind
+    uint32_t loopback_overruns;     // Captured frames not looped back, the playback ring was full
+    uint32_t playback_underruns;    // Times the playback ring ran dry after holding audio, the end of a stream counts once
+    uint32_t io_errors;             // Failed I2S reads and writes
+    uint32_t capture_peak;          // Most frames waiting in the capture ring at once
+    uint32_t playback_peak;         // Most frames waiting in the playback ring at once
+    uint32_t latency_avg_us;        // Frame queued to heard: playback ring wait plus TX DMA
+    uint32_t latency_max_us;
+    uint16_t capture_load_pm;       // CPU time of the capture task outside I2S waits, per mille
+    uint16_t playback_load_pm;      // Same for the playback task
+} audio_engine_stats_t;
+
+/**
+ * @brief Start the engine.
+ *
+ * Switches the codec to the given format until audio_engine_stop(). Do not run it
+ * together with the WAV recorder, both read the microphone.
+ *
+ * @param config: Engine configuration
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: Already running
+ *    - ESP_ERR_INVALID_ARG: Bad configuration, or aec at a rate other than AEC_SAMPLE_RATE
+ *    - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t audio_engine_start(const audio_engine_config_t *config);
+
+/**
+ * @brief Stop the engine and restore the default codec format.
+ *
+ * Frames still queued for playback are dropped.
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: Not running
+ */
+esp_err_t audio_engine_stop(void);
+
+/**
+ * @brief Check whether the engine is running.
+ *
+ * @return
+ *    - true: Running
+ *    - false: Stopped
+ */
+bool audio_engine_is_running(void);
+
+/**
+ * @brief Read captured audio.
+ *
+ * Needs the capture option. Returns early with what is there once the timeout expires.
+ *
+ * @param buffer: Output samples
+ * @param len: Bytes wanted
+ * @param timeout_ms: Max block time, 0 to return at once
+ *
+ * @return Bytes actually read
+ */
+size_t audio_engine_read(void *buffer, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Queue audio for playback.
+ *
+ * Returns early with what fitted once the timeout expires. Refused in loopback mode,
+ * where the capture task is the only one filling the playback ring.
+ *
+ * @param buffer: Samples in the engine format
+ * @param len: Bytes to queue
+ * @param timeout_ms: Max block time, 0 to return at once
+ *
+ * @return Bytes actually queued
+ */
+size_t audio_engine_write(const void *buffer, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Queue the last partial frame, padded with silence.
+ *
+ * Call after the final audio_engine_write() of a stream.
+ */
+void audio_engine_flush(void);
+
+/**
+ * @brief Get the number of frames still waiting for playback.
+ *
+ * @return Queued frames
+ */
+uint32_t audio_engine_playback_queued(void);
+
+/**
+ * @brief Get the statistics of the current or last run.
+ *
+ * @param stats: Output statistics
+ */
+void audio_engine_get_stats(audio_engine_stats_t *stats);
+
+/**
+ * @brief Log the statistics of the current or last run.
+ */
+void audio_engine_log_stats(void);
+
+#endif
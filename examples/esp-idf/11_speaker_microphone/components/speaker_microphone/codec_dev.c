@@ -61,7 +61,10 @@ esp_err_t mic_i2s_read(void *audio_buffer, size_t len, size_t *bytes_read, uint3
 {
     esp_err_t ret = ESP_OK;
     ret = esp_codec_dev_read(record_dev_handle, audio_buffer, len);
-    *bytes_read = len;
+    // esp_codec_dev_read() fills the whole buffer or fails, nothing is read on failure
+    if (bytes_read) {
+        *bytes_read = (ret == ESP_OK) ? len : 0;
+    }
     return ret;
 }
 
@@ -69,7 +72,10 @@ esp_err_t speaker_i2s_write(void *audio_buffer, size_t len, size_t *bytes_writte
 {
     esp_err_t ret = ESP_OK;
     ret = esp_codec_dev_write(play_dev_handle, audio_buffer, len);
-    *bytes_written = len;
+    // esp_codec_dev_write() sends the whole buffer or fails
+    if (bytes_written) {
+        *bytes_written = (ret == ESP_OK) ? len : 0;
+    }
     return ret;
 }
 
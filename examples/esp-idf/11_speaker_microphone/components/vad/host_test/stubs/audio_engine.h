@@ -0,0 +1,19 @@
+/* Host stub of the audio engine, the test feeds the capture */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct {
+    uint32_t sample_rate;
+    uint8_t channels;
+    bool capture;
+    bool loopback;
+    bool aec;
+} audio_engine_config_t;
+
+esp_err_t audio_engine_start(const audio_engine_config_t *config);
+esp_err_t audio_engine_stop(void);
+size_t audio_engine_read(void *buffer, size_t len, uint32_t timeout_ms);
@@ -0,0 +1,20 @@
+/* Host stub of FreeRTOS, single threaded so the locks do nothing */
+#pragma once
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void *SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0 }
+#define portENTER_CRITICAL(mux)         (void)(mux)
+#define portEXIT_CRITICAL(mux)          (void)(mux)
+#define portMAX_DELAY                   (0xffffffffu)
+#define pdTRUE                          (1)
+#define pdPASS                          (1)
+#define pdMS_TO_TICKS(ms)               ((TickType_t)(ms))
@@ -0,0 +1,19 @@
+/* Host stub of the FreeRTOS semaphores, single threaded so they never wait */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return (SemaphoreHandle_t)1;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    return pdTRUE;
+}
@@ -0,0 +1,7 @@
+/* Host stub of the FreeRTOS tasks, the test runs the task in place */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+BaseType_t xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg, int prio, TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t handle);
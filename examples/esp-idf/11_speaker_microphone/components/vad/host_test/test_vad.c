@@ -0,0 +1,277 @@
+/*****************************************************************************
+ * | File         :   test_vad.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the voice activity detection
+ * | Info         :
+ * |                 Runs the VAD task of vad.c on short synthetic clips, tone
+ * |                 bursts over a quiet background, and reads the segments as
+ * |                 they come. Checks the frames of the start and stop events
+ * |                 and that each segment is the clip from the pre-roll on,
+ * |                 also after the ring wrapped.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../vad.c"
+
+#define CLIP_MAX        (VAD_SAMPLE_RATE * 8)       // Longest clip, 8 s
+#define SEG_MAX         (8)
+#define TONE_AMP        (4000)                      // About -18 dBFS
+#define NOISE_AMP       (30)                        // About -63 dBFS, under VAD_MIN_LEVEL_DBFS
+#define MIC_DC          (200)                       // Offset of the microphone, removed by the detector
+
+static int failures;
+
+#define CHECK(cond) do {                                                    \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/**************************************************************************************************
+ *
+ * Simulated microphone and reader
+ *
+ **************************************************************************************************/
+
+static int16_t clip[CLIP_MAX];
+static uint32_t clip_len;
+static uint32_t clip_pos;
+static int64_t now_us;
+
+// Events as the callback saw them
+static struct {
+    vad_event_t event;
+    uint32_t frames;                // Frames processed when it was sent
+    uint32_t write;                 // Ring write position then
+} ev[SEG_MAX * 2];
+static int ev_cnt;
+
+// Segments as vad_read() returned them, data read after a start belongs to its segment
+static int16_t seg[SEG_MAX][CLIP_MAX];
+static uint32_t seg_len[SEG_MAX];
+static int seg_cnt;
+
+int64_t esp_timer_get_time(void)
+{
+    return now_us;
+}
+
+BaseType_t xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg, int prio, TaskHandle_t *handle)
+{
+    fn(arg);                        // The whole clip runs before vad_start() returns
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t handle) { }
+esp_err_t audio_engine_start(const audio_engine_config_t *config) { return ESP_OK; }
+esp_err_t audio_engine_stop(void) { return ESP_OK; }
+
+// Read whatever the current segment has, as a reader task keeping up would
+static void drain(void)
+{
+    size_t n;
+
+    if (seg_cnt == 0) {
+        return;
+    }
+    do {
+        int16_t *dst = seg[seg_cnt - 1] + seg_len[seg_cnt - 1];
+        n = vad_read(dst, (CLIP_MAX - seg_len[seg_cnt - 1]) * sizeof(int16_t), 0);
+        seg_len[seg_cnt - 1] += n / sizeof(int16_t);
+    } while (n);
+}
+
+size_t audio_engine_read(void *buffer, size_t len, uint32_t timeout_ms)
+{
+    size_t n = len / sizeof(int16_t);
+
+    drain();
+    if (clip_pos >= clip_len) {
+        s_stop = true;
+        return 0;
+    }
+    if (n > clip_len - clip_pos) {
+        n = clip_len - clip_pos;
+    }
+    memcpy(buffer, clip + clip_pos, n * sizeof(int16_t));
+    clip_pos += n;
+    now_us += (int64_t)n * 1000000 / VAD_SAMPLE_RATE;
+    return n * sizeof(int16_t);
+}
+
+static void event_cb(vad_event_t event, void *user_data)
+{
+    if (ev_cnt < SEG_MAX * 2) {
+        ev[ev_cnt].event = event;
+        ev[ev_cnt].frames = s_stats.frames;
+        ev[ev_cnt].write = s_write;
+        ev_cnt++;
+    }
+    if (event == VAD_EVENT_SPEECH_START && seg_cnt < SEG_MAX) {
+        seg_len[seg_cnt++] = 0;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Clips
+ *
+ **************************************************************************************************/
+
+static uint32_t noise_state = 1;
+
+// A quiet background with the microphone offset
+static void clip_background(uint32_t samples)
+{
+    clip_len = samples;
+    for (uint32_t i = 0; i < samples; i++) {
+        noise_state = noise_state * 1103515245 + 12345;
+        clip[i] = MIC_DC + (int16_t)((int32_t)(noise_state >> 16) % (2 * NOISE_AMP + 1) - NOISE_AMP);
+    }
+}
+
+// A 200 Hz tone burst, voiced speech as far as the detector can tell
+static void clip_tone(uint32_t from, uint32_t to)
+{
+    for (uint32_t i = from; i < to; i++) {
+        clip[i] += (int16_t)lrint(TONE_AMP * sin(2.0 * M_PI * 200 * (i - from) / VAD_SAMPLE_RATE));
+    }
+}
+
+// Run the VAD over the clip and read the segments as they come
+static void run_clip(void)
+{
+    clip_pos = 0;
+    ev_cnt = 0;
+    seg_cnt = 0;
+    CHECK(vad_start(event_cb, NULL) == ESP_OK);
+    drain();
+    CHECK(vad_stop() == ESP_OK);
+}
+
+static uint32_t ms_to_samples(uint32_t ms)
+{
+    return ms * VAD_SAMPLE_RATE / 1000;
+}
+
+// Frames counted when the start event of a burst from `onset` is due
+static uint32_t start_frame(uint32_t onset)
+{
+    return onset / VAD_FRAME_SAMPLES + VAD_START_FRAMES;
+}
+
+// Frames counted when the end event of a burst ending at `end` is due
+static uint32_t end_frame(uint32_t end)
+{
+    return (end - 1) / VAD_FRAME_SAMPLES + 1 + VAD_HANGOVER_FRAMES;
+}
+
+// Segment k runs from the pre-roll before its start event to its end event, sample for sample
+static void check_segment(int k, uint32_t onset, uint32_t end)
+{
+    const uint32_t start_write = ev[2 * k].write;
+    const uint32_t end_write = ev[2 * k + 1].write;
+    const uint32_t back = VAD_START_FRAMES * VAD_FRAME_SAMPLES + VAD_PREROLL_SAMPLES;
+    const uint32_t from = start_write > back ? start_write - back : 0;
+
+    printf("  segment %d: start at frame %" PRIu32 " (due %" PRIu32 "), end at frame %" PRIu32 " (due %" PRIu32 "), %" PRIu32 " samples from %" PRIu32 "\n",
+           k, ev[2 * k].frames, start_frame(onset), ev[2 * k + 1].frames, end_frame(end), seg_len[k], from);
+    CHECK(ev[2 * k].event == VAD_EVENT_SPEECH_START);
+    CHECK(ev[2 * k + 1].event == VAD_EVENT_SPEECH_END);
+    CHECK(abs((int)ev[2 * k].frames - (int)start_frame(onset)) <= 1);
+    CHECK(abs((int)ev[2 * k + 1].frames - (int)end_frame(end)) <= 1);
+
+    // The pre-roll reaches VAD_PREROLL_MS before the onset and holds the background
+    CHECK(from + VAD_PREROLL_SAMPLES <= onset);
+    CHECK(seg_len[k] == end_write - from);
+    CHECK(seg_len[k] > 0 && memcmp(seg[k], clip + from, seg_len[k] * sizeof(int16_t)) == 0);
+    for (uint32_t i = 0; i < onset - from && i < seg_len[k]; i++) {
+        if (abs(seg[k][i] - MIC_DC) > NOISE_AMP) {
+            printf("  pre-roll sample %" PRIu32 " is not background\n", i);
+            failures++;
+            break;
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Tests
+ *
+ **************************************************************************************************/
+
+static void test_one_utterance(void)
+{
+    const uint32_t onset = ms_to_samples(500);
+    const uint32_t end = ms_to_samples(1100);
+    vad_stats_t stats;
+
+    printf("one utterance\n");
+    clip_background(ms_to_samples(1800));
+    clip_tone(onset, end);
+    run_clip();
+
+    CHECK(ev_cnt == 2 && seg_cnt == 1);
+    if (ev_cnt == 2 && seg_cnt == 1) {
+        check_segment(0, onset, end);
+    }
+    vad_get_stats(&stats);
+    CHECK(stats.segments == 1 && stats.dropped_bytes == 0);
+    CHECK(!vad_segment_pending());
+}
+
+// Shorter than VAD_START_MS: no event, nothing to read
+static void test_short_burst(void)
+{
+    vad_stats_t stats;
+
+    printf("short burst\n");
+    clip_background(ms_to_samples(1000));
+    clip_tone(ms_to_samples(500), ms_to_samples(500) + (VAD_START_FRAMES - 1) * VAD_FRAME_SAMPLES - VAD_FRAME_SAMPLES / 2);
+    run_clip();
+
+    CHECK(ev_cnt == 0 && seg_cnt == 0);
+    vad_get_stats(&stats);
+    CHECK(stats.segments == 0);
+    CHECK(!vad_segment_pending());
+}
+
+// Several segments over more than the ring, each read back whole
+static void test_ring_wrap(void)
+{
+    static const uint32_t bursts_ms[][2] = { { 400, 1200 }, { 2000, 2300 }, { 3300, 4800 }, { 5600, 6100 } };
+    const int count = sizeof(bursts_ms) / sizeof(bursts_ms[0]);
+    vad_stats_t stats;
+
+    printf("ring wrap\n");
+    clip_background(ms_to_samples(7000));
+    for (int k = 0; k < count; k++) {
+        clip_tone(ms_to_samples(bursts_ms[k][0]), ms_to_samples(bursts_ms[k][1]));
+    }
+    run_clip();
+
+    CHECK(ev_cnt == 2 * count && seg_cnt == count);
+    for (int k = 0; k < count && k < seg_cnt && 2 * k + 1 < ev_cnt; k++) {
+        check_segment(k, ms_to_samples(bursts_ms[k][0]), ms_to_samples(bursts_ms[k][1]));
+    }
+    vad_get_stats(&stats);
+    CHECK(s_write > VAD_RING_SAMPLES);
+    CHECK(stats.segments == (uint32_t)count && stats.dropped_bytes == 0);
+}
+
+int main(void)
+{
+    test_one_utterance();
+    test_short_burst();
+    test_ring_wrap();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
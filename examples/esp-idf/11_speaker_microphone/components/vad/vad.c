@@ -0,0 +1,429 @@
+/*****************************************************************************
+ * | File         :   vad.c
+ * | Author       :   Waveshare team
+ * | Function     :   Voice activity detection on the microphone
+ * | Info         :
+ * |                 The VAD task is the only writer of the sample ring and
+ * |                 vad_read() the only reader. The reader copies outside the
+ * |                 lock and keeps the copy only if the writer did not move
+ * |                 its position meanwhile, which it does on an overrun or a
+ * |                 new segment.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "audio_engine.h"
+#include "vad.h"
+
+static const char *TAG = "vad";  // Define a tag for logging
+
+#define VAD_FRAME_BYTES         (VAD_FRAME_SAMPLES * sizeof(int16_t))
+#define VAD_FRAME_US            ((uint32_t)((uint64_t)VAD_FRAME_SAMPLES * 1000000 / VAD_SAMPLE_RATE))
+#define VAD_MS_TO_SAMPLES(ms)   ((uint32_t)((uint64_t)(ms) * VAD_SAMPLE_RATE / 1000))
+#define VAD_MS_TO_FRAMES(ms)    ((VAD_MS_TO_SAMPLES(ms) + VAD_FRAME_SAMPLES - 1) / VAD_FRAME_SAMPLES)
+#define VAD_START_FRAMES        VAD_MS_TO_FRAMES(VAD_START_MS)
+#define VAD_HANGOVER_FRAMES     VAD_MS_TO_FRAMES(VAD_HANGOVER_MS)
+#define VAD_PREROLL_SAMPLES     VAD_MS_TO_SAMPLES(VAD_PREROLL_MS)
+#define VAD_RING_SAMPLES        VAD_MS_TO_SAMPLES(VAD_RING_MS)
+
+// Levels are log2 of the mean square in Q8, 3.01 dB per unit, a full scale square wave is 30
+#define VAD_DB_TO_Q8(db)        ((int32_t)(db) * 25600 / 301)
+#define VAD_Q8_TO_DBFS(q8)      ((int16_t)(((int32_t)(q8) - 30 * 256) * 301 / 25600))
+#define VAD_HP_COEF_Q14         (16302)     // One-pole DC blocker, 0.995, corner near 13 Hz at 16 kHz
+
+#if VAD_RING_MS < VAD_PREROLL_MS + VAD_START_MS + 100
+#error "VAD_RING_MS must hold the pre-roll, the start delay and some slack for the reader"
+#endif
+#if (VAD_RING_MS * VAD_SAMPLE_RATE) % 1000 || (VAD_RING_MS * VAD_SAMPLE_RATE / 1000) % VAD_FRAME_SAMPLES
+#error "VAD_RING_MS must hold a whole number of frames, a frame is copied into the ring in one piece"
+#endif
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static int16_t *s_ring = NULL;                  // VAD_RING_SAMPLES samples in PSRAM
+static int16_t s_frame[VAD_FRAME_SAMPLES];      // Frame being assembled from the audio engine
+static vad_detector_t s_det;
+static SemaphoreHandle_t s_data_sem = NULL;     // Given for each frame while a segment is pending
+static SemaphoreHandle_t s_done_sem = NULL;     // Given by the task on exit
+
+static vad_event_cb_t s_cb = NULL;
+static void *s_cb_user_data = NULL;
+static volatile bool s_running = false;
+static volatile bool s_stop = false;
+
+// Ring positions are free running sample counts, guarded by s_lock
+static uint32_t s_write = 0;                    // Samples written
+static uint32_t s_read = 0;                     // Next sample vad_read() returns
+static uint32_t s_seg_end = 0;                  // End of a closed segment
+static uint32_t s_gen = 0;                      // Bumped whenever the writer moves s_read
+static bool s_seg_open = false;                 // Speech or hangover still going on
+static bool s_pending = false;                  // Segment audio left to read
+
+static int64_t s_busy_us = 0;
+static vad_stats_t s_stats;
+
+/**************************************************************************************************
+ *
+ * Detector Functions
+ *
+ **************************************************************************************************/
+
+// log2 in Q8, the mantissa is taken as linear, off by at most 0.09 (0.26 dB)
+static int32_t vad_log2_q8(uint32_t x)
+{
+    if (x == 0) {
+        return 0;
+    }
+    const int n = 31 - __builtin_clz(x);
+    const uint32_t frac = (n >= 8) ? (x >> (n - 8)) : (x << (8 - n));
+    return n * 256 + (int32_t)(frac & 0xff);
+}
+
+void vad_detector_init(vad_detector_t *det)
+{
+    memset(det, 0, sizeof(vad_detector_t));
+}
+
+vad_event_t vad_detector_process(vad_detector_t *det, const int16_t *pcm)
+{
+    int32_t x1 = det->hp_x;
+    int32_t y1 = det->hp_y;
+    bool neg = det->last < 0;
+    uint64_t sum = 0;
+    uint32_t crossings = 0;
+
+    for (int i = 0; i < VAD_FRAME_SAMPLES; i++) {
+        const int32_t x = pcm[i];
+        const int32_t y = x - x1 + ((y1 * VAD_HP_COEF_Q14) >> 14);
+        x1 = x;
+        y1 = y;
+        sum += (uint64_t)((int64_t)y * y);
+        crossings += (uint32_t)((y < 0) != neg);
+        neg = y < 0;
+    }
+    det->hp_x = x1;
+    det->hp_y = y1;
+    det->last = neg ? -1 : 1;
+
+    const uint64_t mean = sum / VAD_FRAME_SAMPLES;
+    const int32_t energy = vad_log2_q8(mean > UINT32_MAX ? UINT32_MAX : (uint32_t)mean);
+    det->energy_q8 = energy;
+    det->zcr = crossings * 100 / VAD_FRAME_SAMPLES;
+
+    if (!det->primed) {
+        det->floor_q8 = energy;
+        det->primed = true;
+    }
+
+    const int32_t rel = energy - det->floor_q8;
+    const bool active = det->active = energy >= VAD_DB_TO_Q8(VAD_MIN_LEVEL_DBFS) + 30 * 256 &&
+                        rel >= VAD_DB_TO_Q8(VAD_THRESHOLD_DB) &&
+                        (det->zcr <= VAD_ZCR_MAX || rel >= VAD_DB_TO_Q8(VAD_LOUD_DB));
+
+    // The floor falls fast and rises slowly, and slower still under speech, so a
+    // background that stays louder ends a segment after some seconds
+    if (rel < 0) {
+        det->floor_q8 += rel >> 2;
+    } else if (!active) {
+        det->floor_q8 += rel >> 5;
+    } else {
+        det->floor_q8 += rel >> 9;
+    }
+
+    if (!det->speech) {
+        det->run = active ? det->run + 1 : 0;
+        if (det->run >= VAD_START_FRAMES) {
+            det->speech = true;
+            det->run = 0;
+            return VAD_EVENT_SPEECH_START;
+        }
+    } else {
+        det->run = active ? 0 : det->run + 1;
+        if (det->run >= VAD_HANGOVER_FRAMES) {
+            det->speech = false;
+            det->run = 0;
+            return VAD_EVENT_SPEECH_END;
+        }
+    }
+    return VAD_EVENT_NONE;
+}
+
+/**************************************************************************************************
+ *
+ * Listening Task
+ *
+ **************************************************************************************************/
+
+// End the open segment where the writer is, under s_lock
+static void vad_segment_close(void)
+{
+    s_seg_open = false;
+    s_seg_end = s_write;
+}
+
+// Make room for the next frame, the reader loses its oldest audio if it fell behind, under s_lock
+static void vad_ring_reserve(void)
+{
+    if (s_pending && s_write + VAD_FRAME_SAMPLES - s_read > VAD_RING_SAMPLES) {
+        const uint32_t read = s_write + VAD_FRAME_SAMPLES - VAD_RING_SAMPLES;
+        s_stats.dropped_bytes += (read - s_read) * sizeof(int16_t);
+        s_read = read;
+        s_gen++;
+    }
+}
+
+// Commit the frame copied to the ring and open or close the segment, under s_lock
+static void vad_ring_update(vad_event_t event)
+{
+    s_write += VAD_FRAME_SAMPLES;
+
+    s_stats.frames++;
+    s_stats.active_frames += s_det.active ? 1 : 0;
+    s_stats.floor_dbfs = VAD_Q8_TO_DBFS(s_det.floor_q8);
+    s_stats.level_dbfs = VAD_Q8_TO_DBFS(s_det.energy_q8);
+
+    if (event == VAD_EVENT_SPEECH_START) {
+        // The onset was VAD_START_FRAMES ago, the pre-roll goes back further
+        const uint32_t back = VAD_START_FRAMES * VAD_FRAME_SAMPLES + VAD_PREROLL_SAMPLES;
+        const uint32_t onset = (s_write > back) ? s_write - back : 0;
+        const uint32_t limit = s_seg_open ? s_write : s_seg_end;
+        if (s_pending && limit > s_read) {
+            s_stats.dropped_bytes += (limit - s_read) * sizeof(int16_t);
+        }
+        s_read = onset;
+        s_gen++;
+        s_seg_open = true;
+        s_pending = true;
+        s_stats.segments++;
+    } else if (event == VAD_EVENT_SPEECH_END) {
+        vad_segment_close();
+    }
+}
+
+static void vad_task(void *arg)
+{
+    size_t fill = 0;
+
+    while (!s_stop) {
+        fill += audio_engine_read((uint8_t *)s_frame + fill, VAD_FRAME_BYTES - fill, 100);
+        if (fill < VAD_FRAME_BYTES) {
+            continue;
+        }
+        fill = 0;
+
+        const int64_t start_us = esp_timer_get_time();
+        const vad_event_t event = vad_detector_process(&s_det, s_frame);
+
+        portENTER_CRITICAL(&s_lock);
+        vad_ring_reserve();
+        portEXIT_CRITICAL(&s_lock);
+        memcpy(s_ring + s_write % VAD_RING_SAMPLES, s_frame, VAD_FRAME_BYTES);
+
+        portENTER_CRITICAL(&s_lock);
+        vad_ring_update(event);
+        const bool pending = s_pending;
+        portEXIT_CRITICAL(&s_lock);
+
+        const uint32_t spent_us = (uint32_t)(esp_timer_get_time() - start_us);
+        s_busy_us += spent_us;
+        if (spent_us > s_stats.frame_us_max) {
+            s_stats.frame_us_max = spent_us;
+        }
+
+        if (pending) {
+            xSemaphoreGive(s_data_sem);
+        }
+        if (event != VAD_EVENT_NONE) {
+            ESP_LOGD(TAG, "%s at %d dBFS, floor %d dBFS", event == VAD_EVENT_SPEECH_START ? "Speech" : "Silence",
+                     s_stats.level_dbfs, s_stats.floor_dbfs);
+            if (s_cb) {
+                s_cb(event, s_cb_user_data);
+            }
+        }
+    }
+
+    // Close an open segment so the reader can finish it
+    if (s_det.speech) {
+        portENTER_CRITICAL(&s_lock);
+        vad_segment_close();
+        portEXIT_CRITICAL(&s_lock);
+        xSemaphoreGive(s_data_sem);
+        if (s_cb) {
+            s_cb(VAD_EVENT_SPEECH_END, s_cb_user_data);
+        }
+    }
+
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+/**************************************************************************************************
+ *
+ * Public Functions
+ *
+ **************************************************************************************************/
+
+esp_err_t vad_start(vad_event_cb_t cb, void *user_data)
+{
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // The ring stays allocated for the next run
+    if (!s_ring) {
+        s_ring = heap_caps_malloc(VAD_RING_SAMPLES * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        s_data_sem = xSemaphoreCreateBinary();
+        s_done_sem = xSemaphoreCreateBinary();
+        if (!s_ring || !s_data_sem || !s_done_sem) {
+            ESP_LOGE(TAG, "Failed to allocate buffers");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    const audio_engine_config_t config = {
+        .sample_rate = VAD_SAMPLE_RATE,
+        .channels = 1,
+        .capture = true,
+    };
+    esp_err_t ret = audio_engine_start(&config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    vad_detector_init(&s_det);
+    s_cb = cb;
+    s_cb_user_data = user_data;
+    portENTER_CRITICAL(&s_lock);
+    s_write = s_read = s_seg_end = 0;
+    s_seg_open = s_pending = false;
+    s_gen++;
+    memset(&s_stats, 0, sizeof(s_stats));
+    portEXIT_CRITICAL(&s_lock);
+    s_busy_us = 0;
+    xSemaphoreTake(s_data_sem, 0);
+
+    s_stop = false;
+    if (xTaskCreate(vad_task, "vad", VAD_TASK_STACK_SIZE, NULL, VAD_TASK_PRIORITY, NULL) != pdPASS) {
+        audio_engine_stop();
+        return ESP_ERR_NO_MEM;
+    }
+    s_running = true;
+
+    ESP_LOGI(TAG, "Listening, %d ms frames, threshold %d dB, pre-roll %d ms",
+             (int)(VAD_FRAME_US / 1000), VAD_THRESHOLD_DB, VAD_PREROLL_MS);
+    return ESP_OK;
+}
+
+esp_err_t vad_stop(void)
+{
+    if (!s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_stop = true;
+    xSemaphoreTake(s_done_sem, portMAX_DELAY);
+    s_running = false;
+
+    audio_engine_stop();
+    vad_log_stats();
+    return ESP_OK;
+}
+
+bool vad_is_running(void)
+{
+    return s_running;
+}
+
+bool vad_segment_pending(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    const bool pending = s_pending;
+    portEXIT_CRITICAL(&s_lock);
+    return pending;
+}
+
+size_t vad_read(void *buffer, size_t len, uint32_t timeout_ms)
+{
+    int16_t *dst = buffer;
+    const size_t want = len / sizeof(int16_t);
+    const int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    size_t done = 0;
+
+    while (done < want && s_ring) {
+        portENTER_CRITICAL(&s_lock);
+        const uint32_t read = s_read;
+        const uint32_t gen = s_gen;
+        const uint32_t limit = s_seg_open ? s_write : s_seg_end;
+        if (s_pending && !s_seg_open && read == limit) {
+            s_pending = false;      // The closed segment is fully read
+        }
+        const bool pending = s_pending;
+        portEXIT_CRITICAL(&s_lock);
+
+        if (!pending) {
+            break;
+        }
+        if (read == limit) {
+            const int64_t left_us = deadline - esp_timer_get_time();
+            if (left_us <= 0 || !s_running) {
+                break;
+            }
+            xSemaphoreTake(s_data_sem, pdMS_TO_TICKS(left_us / 1000) + 1);
+            continue;
+        }
+
+        // Copy up to the end of the ring, the writer keeps one frame clear of it
+        const uint32_t off = read % VAD_RING_SAMPLES;
+        uint32_t n = limit - read;
+        if (n > want - done) {
+            n = want - done;
+        }
+        if (n > VAD_RING_SAMPLES - off) {
+            n = VAD_RING_SAMPLES - off;
+        }
+        memcpy(dst + done, s_ring + off, n * sizeof(int16_t));
+
+        portENTER_CRITICAL(&s_lock);
+        const bool valid = (s_gen == gen);
+        if (valid) {
+            s_read = read + n;
+        }
+        portEXIT_CRITICAL(&s_lock);
+        if (valid) {
+            done += n;
+        }
+    }
+    return done * sizeof(int16_t);
+}
+
+void vad_get_stats(vad_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+
+    const uint64_t audio_us = (uint64_t)stats->frames * VAD_FRAME_US;
+    stats->cpu_permille = audio_us ? (uint16_t)((uint64_t)s_busy_us * 1000 / audio_us) : 0;
+}
+
+void vad_log_stats(void)
+{
+    vad_stats_t stats;
+    vad_get_stats(&stats);
+
+    ESP_LOGI(TAG, "frames %" PRIu32 ", active %" PRIu32 ", segments %" PRIu32 ", dropped %" PRIu32 " bytes",
+             stats.frames, stats.active_frames, stats.segments, stats.dropped_bytes);
+    ESP_LOGI(TAG, "floor %d dBFS, level %d dBFS, frame max %" PRIu32 " us, cpu %u.%u%%",
+             stats.floor_dbfs, stats.level_dbfs, stats.frame_us_max,
+             stats.cpu_permille / 10, stats.cpu_permille % 10);
+}
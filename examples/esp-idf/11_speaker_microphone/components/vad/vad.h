@@ -0,0 +1,175 @@
+/*****************************************************************************
+ * | File         :   vad.h
+ * | Author       :   Waveshare team
+ * | Function     :   Voice activity detection on the microphone
+ * | Info         :
+ * |                 Listens continuously through the audio engine and marks
+ * |                 speech with frame energy against a tracked noise floor
+ * |                 and the zero-crossing rate, all in fixed point. The last
+ * |                 VAD_PREROLL_MS are kept, so a speech segment read with
+ * |                 vad_read() starts before the detected onset.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#ifndef __VAD_H
+#define __VAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/* Detector configuration, can be adjusted by users */
+#define VAD_SAMPLE_RATE             (16000)     // Mono capture rate while listening
+#define VAD_FRAME_SAMPLES           (256)       // Samples per decision, 16 ms at VAD_SAMPLE_RATE
+#define VAD_THRESHOLD_DB            (10)        // Frame energy above the noise floor that counts as speech
+#define VAD_LOUD_DB                 (16)        // Above the noise floor by this much, the zero-crossing rate is ignored
+#define VAD_ZCR_MAX                 (30)        // Highest zero-crossing rate of speech, in % of sample pairs, hiss is near 50
+#define VAD_MIN_LEVEL_DBFS          (-55)       // Frames quieter than this never count as speech
+#define VAD_START_MS                (48)        // Speech must last this long before VAD_EVENT_SPEECH_START
+#define VAD_HANGOVER_MS             (400)       // Silence that ends a segment, pauses between words are shorter
+#define VAD_PREROLL_MS              (300)       // Audio kept from before the onset
+#define VAD_RING_MS                 (2000)      // Ring in PSRAM, how far vad_read() may fall behind
+#define VAD_TASK_PRIORITY           (6)         // Below the audio engine that feeds it
+#define VAD_TASK_STACK_SIZE         (3 * 1024)
+
+/**
+ * @brief Detector events
+ */
+typedef enum {
+    VAD_EVENT_NONE = 0,
+    VAD_EVENT_SPEECH_START,         // Speech lasted VAD_START_MS
+    VAD_EVENT_SPEECH_END,           // Silence lasted VAD_HANGOVER_MS
+} vad_event_t;
+
+/**
+ * @brief Event callback, runs in the VAD task and must not block
+ *
+ * @param event: VAD_EVENT_SPEECH_START or VAD_EVENT_SPEECH_END
+ * @param user_data: Pointer given to vad_start()
+ */
+typedef void (*vad_event_cb_t)(vad_event_t event, void *user_data);
+
+/**
+ * @brief Detector state, usable on its own on any 16-bit mono audio
+ */
+typedef struct {
+    int32_t hp_x;                   // High-pass filter state, removes the microphone DC offset
+    int32_t hp_y;
+    int16_t last;                   // Sign of the last filtered sample, for zero crossings across frames
+    int32_t floor_q8;               // Noise floor, log2 of the mean square in Q8
+    int32_t energy_q8;              // Energy of the last frame, same unit
+    uint32_t zcr;                   // Zero-crossing rate of the last frame, in %
+    bool active;                    // The last frame was above the threshold
+    bool primed;                    // The noise floor holds a measurement
+    bool speech;                    // Inside a speech segment
+    uint32_t run;                   // Consecutive frames on the other side of the decision
+} vad_detector_t;
+
+/**
+ * @brief Statistics
+ */
+typedef struct {
+    uint32_t frames;                // Frames processed
+    uint32_t active_frames;         // Frames above the threshold
+    uint32_t segments;              // Speech segments detected
+    uint32_t dropped_bytes;         // Segment audio lost because vad_read() fell behind
+    int16_t floor_dbfs;             // Current noise floor
+    int16_t level_dbfs;             // Level of the last frame
+    uint32_t frame_us_max;          // Slowest frame through the detector
+    uint16_t cpu_permille;          // Detector time over audio time, per mille of one core
+} vad_stats_t;
+
+/**
+ * @brief Reset a detector.
+ *
+ * @param det: Detector
+ */
+void vad_detector_init(vad_detector_t *det);
+
+/**
+ * @brief Run one frame through a detector.
+ *
+ * @param det: Detector
+ * @param pcm: VAD_FRAME_SAMPLES mono samples at VAD_SAMPLE_RATE
+ *
+ * @return The event the frame caused, VAD_EVENT_NONE most of the time
+ */
+vad_event_t vad_detector_process(vad_detector_t *det, const int16_t *pcm);
+
+/**
+ * @brief Start listening.
+ *
+ * Runs the audio engine in capture mode at VAD_SAMPLE_RATE mono until vad_stop(),
+ * so the recorder and playback are not available meanwhile.
+ *
+ * @param cb: Event callback, may be NULL
+ * @param user_data: Passed to the callback
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: Already listening, or the audio engine is busy
+ *    - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t vad_start(vad_event_cb_t cb, void *user_data);
+
+/**
+ * @brief Stop listening, an open segment is ended.
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: Not listening
+ */
+esp_err_t vad_stop(void);
+
+/**
+ * @brief Check whether the detector is listening.
+ *
+ * @return
+ *    - true: Listening
+ *    - false: Stopped
+ */
+bool vad_is_running(void);
+
+/**
+ * @brief Check whether a segment has audio left to read.
+ *
+ * True from VAD_EVENT_SPEECH_START until vad_read() has returned the last byte of
+ * the segment, which ends VAD_HANGOVER_MS after the speech.
+ *
+ * @return
+ *    - true: Call vad_read()
+ *    - false: No segment
+ */
+bool vad_segment_pending(void);
+
+/**
+ * @brief Read the audio of the current segment, pre-roll included.
+ *
+ * A segment that is not read within VAD_RING_MS loses its oldest audio. A new
+ * segment drops what is left of the previous one.
+ *
+ * @param buffer: Output, 16-bit mono samples at VAD_SAMPLE_RATE
+ * @param len: Bytes wanted
+ * @param timeout_ms: Max block time, 0 to return at once
+ *
+ * @return Bytes actually read
+ */
+size_t vad_read(void *buffer, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Get the statistics.
+ *
+ * @param stats: Output statistics
+ */
+void vad_get_stats(vad_stats_t *stats);
+
+/**
+ * @brief Log the statistics.
+ */
+void vad_log_stats(void);
+
+#endif
@@ -0,0 +1,444 @@
+/*****************************************************************************
+ * | File         :   wav_recorder.c
+ * | Author       :   Waveshare team
+ * | Function     :   Streaming WAV recorder
+ * | Info         :
+ * |                 The capture task reads one block at a time from I2S into
+ * |                 a ring in PSRAM and never touches the card. The writer
+ * |                 task copies runs of blocks into an internal DMA-capable
+ * |                 buffer and writes them in one call, so FATFS hands whole
+ * |                 sectors to the SDMMC driver without bouncing.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "codec_dev.h"
+#include "wav_recorder.h"
+
+static const char *TAG = "wav_recorder";  // Define a tag for logging
+
+#define WAV_RECORDER_BLOCKS_PER_WRITE   (WAV_RECORDER_WRITE_SIZE / WAV_RECORDER_BLOCK_SIZE)
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t *s_ring = NULL;             // WAV_RECORDER_BLOCK_NUM blocks in PSRAM
+static uint8_t *s_stage = NULL;            // One write, internal and DMA capable
+static uint8_t *s_scratch = NULL;          // Drain target while the ring is full
+static WORD_ALIGNED_ATTR uint8_t s_header[WAV_RECORDER_HEADER_SIZE];
+
+// Free running block counters: s_head only written by the capture task, s_tail only by the writer
+static volatile uint32_t s_head = 0;
+static volatile uint32_t s_tail = 0;
+
+static volatile bool s_running = false;
+static volatile bool s_stop = false;
+static volatile bool s_capture_done = false;
+static TaskHandle_t s_writer_task = NULL;
+static SemaphoreHandle_t s_done_sem = NULL;
+
+static char s_path[128];
+static int s_fd = -1;
+static uint32_t s_data_size = 0;           // Data bytes in the current file
+static bool s_write_failed = false;
+static wav_recorder_stats_t s_stats;
+
+/**************************************************************************************************
+ *
+ * WAV File Functions
+ *
+ **************************************************************************************************/
+
+static void wav_recorder_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void wav_recorder_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+// RIFF header padded with a JUNK chunk to WAV_RECORDER_HEADER_SIZE, players skip unknown chunks
+static void wav_recorder_build_header(uint32_t data_size)
+{
+    const uint16_t block_align = s_stats.channels * 2;
+    const uint32_t junk_size = WAV_RECORDER_HEADER_SIZE - 12 - 24 - 8 - 8;
+    uint8_t *p = s_header;
+
+    memset(s_header, 0, sizeof(s_header));
+    memcpy(p, "RIFF", 4);
+    wav_recorder_put_u32(p + 4, WAV_RECORDER_HEADER_SIZE - 8 + data_size);
+    memcpy(p + 8, "WAVE", 4);
+    p += 12;
+
+    memcpy(p, "fmt ", 4);
+    wav_recorder_put_u32(p + 4, 16);
+    wav_recorder_put_u16(p + 8, 1);                                     // PCM
+    wav_recorder_put_u16(p + 10, s_stats.channels);
+    wav_recorder_put_u32(p + 12, s_stats.sample_rate);
+    wav_recorder_put_u32(p + 16, s_stats.sample_rate * block_align);    // Byte rate
+    wav_recorder_put_u16(p + 20, block_align);
+    wav_recorder_put_u16(p + 22, 16);                                   // Bits per sample
+    p += 24;
+
+    memcpy(p, "JUNK", 4);
+    wav_recorder_put_u32(p + 4, junk_size);
+    p += 8 + junk_size;
+
+    memcpy(p, "data", 4);
+    wav_recorder_put_u32(p + 4, data_size);
+}
+
+// Rewrite the header with the current sizes, one whole sector
+static esp_err_t wav_recorder_patch_header(void)
+{
+    wav_recorder_build_header(s_data_size);
+    if (lseek(s_fd, 0, SEEK_SET) != 0 ||
+        write(s_fd, s_header, WAV_RECORDER_HEADER_SIZE) != WAV_RECORDER_HEADER_SIZE ||
+        lseek(s_fd, 0, SEEK_END) < 0) {
+        return ESP_FAIL;
+    }
+    return fsync(s_fd) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t wav_recorder_open_file(void)
+{
+    char path[sizeof(s_path) + 8];
+    const char *name = s_path;
+
+    // Later files of one recording: rec.wav, rec_001.wav, rec_002.wav ...
+    if (s_stats.file_cnt > 0) {
+        const char *dot = strrchr(s_path, '.');
+        const int base_len = dot ? (int)(dot - s_path) : (int)strlen(s_path);
+        snprintf(path, sizeof(path), "%.*s_%03" PRIu32 "%s", base_len, s_path, s_stats.file_cnt, dot ? dot : "");
+        name = path;
+    }
+
+    s_fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (s_fd < 0) {
+        ESP_LOGE(TAG, "Failed to create %s", name);
+        return ESP_FAIL;
+    }
+
+    s_data_size = 0;
+    wav_recorder_build_header(0);
+    if (write(s_fd, s_header, WAV_RECORDER_HEADER_SIZE) != WAV_RECORDER_HEADER_SIZE) {
+        close(s_fd);
+        s_fd = -1;
+        ESP_LOGE(TAG, "Failed to write the header of %s", name);
+        return ESP_FAIL;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.file_cnt++;
+    portEXIT_CRITICAL(&s_lock);
+    ESP_LOGI(TAG, "Recording to %s", name);
+    return ESP_OK;
+}
+
+static esp_err_t wav_recorder_close_file(void)
+{
+    esp_err_t ret = wav_recorder_patch_header();
+    if (close(s_fd) != 0) {
+        ret = ESP_FAIL;
+    }
+    s_fd = -1;
+    return ret;
+}
+
+/**************************************************************************************************
+ *
+ * Capture And Writer Tasks
+ *
+ **************************************************************************************************/
+
+static void wav_recorder_capture_task(void *arg)
+{
+    while (!s_stop) {
+        const uint32_t head = s_head;
+        const uint32_t tail = __atomic_load_n(&s_tail, __ATOMIC_ACQUIRE);
+        const bool full = head - tail >= WAV_RECORDER_BLOCK_NUM;
+
+        // Keep reading while the ring is full, an I2S DMA overflow would drop data unnoticed
+        uint8_t *block = full ? s_scratch : s_ring + (head % WAV_RECORDER_BLOCK_NUM) * WAV_RECORDER_BLOCK_SIZE;
+        size_t bytes_read = 0;
+        if (mic_i2s_read(block, WAV_RECORDER_BLOCK_SIZE, &bytes_read, portMAX_DELAY) != ESP_OK) {
+            portENTER_CRITICAL(&s_lock);
+            s_stats.read_error_cnt++;
+            portEXIT_CRITICAL(&s_lock);
+            continue;
+        }
+
+        const uint32_t fill = head + 1 - tail;
+        portENTER_CRITICAL(&s_lock);
+        if (full) {
+            s_stats.overrun_cnt++;
+            s_stats.dropped_bytes += WAV_RECORDER_BLOCK_SIZE;
+        } else {
+            s_stats.captured_bytes += WAV_RECORDER_BLOCK_SIZE;
+            if (fill > s_stats.ring_peak) {
+                s_stats.ring_peak = fill;
+            }
+        }
+        portEXIT_CRITICAL(&s_lock);
+        if (full) {
+            continue;
+        }
+
+        __atomic_store_n(&s_head, head + 1, __ATOMIC_RELEASE);
+        // Wake the writer once a full write is waiting, not for every block
+        if (fill >= WAV_RECORDER_BLOCKS_PER_WRITE) {
+            xTaskNotifyGive(s_writer_task);
+        }
+    }
+
+    s_capture_done = true;
+    xTaskNotifyGive(s_writer_task);
+    vTaskDelete(NULL);
+}
+
+// Write up to WAV_RECORDER_WRITE_SIZE from the ring to the card
+static void wav_recorder_write_run(uint32_t blocks)
+{
+    const uint32_t tail = s_tail;
+    const size_t len = blocks * WAV_RECORDER_BLOCK_SIZE;
+
+    // Copy out first and free the ring, the card may take a while
+    for (uint32_t i = 0; i < blocks; i++) {
+        memcpy(s_stage + i * WAV_RECORDER_BLOCK_SIZE,
+               s_ring + ((tail + i) % WAV_RECORDER_BLOCK_NUM) * WAV_RECORDER_BLOCK_SIZE,
+               WAV_RECORDER_BLOCK_SIZE);
+    }
+    __atomic_store_n(&s_tail, tail + blocks, __ATOMIC_RELEASE);
+
+    if (!s_write_failed &&
+        (uint64_t)s_data_size + len > WAV_RECORDER_MAX_FILE_SIZE - WAV_RECORDER_HEADER_SIZE) {
+        if (wav_recorder_close_file() != ESP_OK || wav_recorder_open_file() != ESP_OK) {
+            s_write_failed = true;
+        }
+    }
+    if (s_write_failed) {
+        // Keep draining so the capture side stays healthy, the error is reported on stop
+        portENTER_CRITICAL(&s_lock);
+        s_stats.dropped_bytes += len;
+        portEXIT_CRITICAL(&s_lock);
+        return;
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+    const ssize_t written = write(s_fd, s_stage, len);
+    const uint32_t latency_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    const uint32_t latency_ms = latency_us / 1000;
+    int bucket = latency_ms ? 32 - __builtin_clz(latency_ms) : 0;
+    if (bucket >= WAV_RECORDER_HIST_BUCKETS) {
+        bucket = WAV_RECORDER_HIST_BUCKETS - 1;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.write_cnt++;
+    s_stats.write_hist[bucket]++;
+    if (latency_us > s_stats.write_max_us) {
+        s_stats.write_max_us = latency_us;
+    }
+    if (written == (ssize_t)len) {
+        s_stats.written_bytes += len;
+    } else {
+        s_stats.write_error_cnt++;
+        s_stats.dropped_bytes += len;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (written != (ssize_t)len) {
+        ESP_LOGE(TAG, "Write failed (%d of %u bytes), card full or removed?", (int)written, (unsigned)len);
+        s_write_failed = true;
+        return;
+    }
+    s_data_size += len;
+}
+
+static void wav_recorder_writer_task(void *arg)
+{
+    int64_t sync_us = esp_timer_get_time();
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        const bool last = s_capture_done;
+
+        // Full writes only, except for the rest of the ring once capture has stopped
+        uint32_t avail;
+        while ((avail = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE) - s_tail) >= WAV_RECORDER_BLOCKS_PER_WRITE ||
+               (last && avail > 0)) {
+            wav_recorder_write_run(avail < WAV_RECORDER_BLOCKS_PER_WRITE ? avail : WAV_RECORDER_BLOCKS_PER_WRITE);
+        }
+        if (last) {
+            break;
+        }
+
+        // Keep the file playable up to here if power is lost
+        if (WAV_RECORDER_SYNC_MS && !s_write_failed &&
+            esp_timer_get_time() - sync_us >= WAV_RECORDER_SYNC_MS * 1000LL) {
+            sync_us = esp_timer_get_time();
+            if (wav_recorder_patch_header() != ESP_OK) {
+                ESP_LOGE(TAG, "Header update failed");
+                s_write_failed = true;
+            }
+        }
+    }
+
+    if (wav_recorder_close_file() != ESP_OK) {
+        s_write_failed = true;
+    }
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+/**************************************************************************************************
+ *
+ * Recorder Functions
+ *
+ **************************************************************************************************/
+
+esp_err_t wav_recorder_start(const char *path, uint32_t sample_rate, uint8_t channels)
+{
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!path || !sample_rate || channels < 1 || channels > 2) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Buffers stay allocated for the next recording
+    if (!s_ring) {
+        s_ring = heap_caps_malloc(WAV_RECORDER_BLOCK_NUM * WAV_RECORDER_BLOCK_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        s_stage = heap_caps_malloc(WAV_RECORDER_WRITE_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        s_scratch = heap_caps_malloc(WAV_RECORDER_BLOCK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_done_sem = xSemaphoreCreateBinary();
+        if (!s_ring || !s_stage || !s_scratch || !s_done_sem) {
+            ESP_LOGE(TAG, "Failed to allocate buffers");
+            heap_caps_free(s_ring);
+            heap_caps_free(s_stage);
+            heap_caps_free(s_scratch);
+            if (s_done_sem) {
+                vSemaphoreDelete(s_done_sem);
+            }
+            s_ring = s_stage = s_scratch = NULL;
+            s_done_sem = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.sample_rate = sample_rate;
+    s_stats.channels = channels;
+    portEXIT_CRITICAL(&s_lock);
+    snprintf(s_path, sizeof(s_path), "%s", path);
+    s_head = s_tail = 0;
+    s_stop = false;
+    s_capture_done = false;
+    s_write_failed = false;
+
+    if (wav_recorder_open_file() != ESP_OK) {
+        return ESP_FAIL;
+    }
+
+    speaker_codec_set_fs(sample_rate, 16, channels);
+
+    s_running = true;
+    if (xTaskCreate(wav_recorder_writer_task, "wav_writer", WAV_RECORDER_TASK_STACK_SIZE, NULL,
+                    WAV_RECORDER_WRITER_PRIORITY, &s_writer_task) != pdPASS) {
+        s_running = false;
+        close(s_fd);
+        s_fd = -1;
+        speaker_codec_dev_resume();
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(wav_recorder_capture_task, "wav_capture", WAV_RECORDER_TASK_STACK_SIZE, NULL,
+                    WAV_RECORDER_CAPTURE_PRIORITY, NULL) != pdPASS) {
+        // The writer finishes the empty file on its own
+        s_capture_done = true;
+        xTaskNotifyGive(s_writer_task);
+        xSemaphoreTake(s_done_sem, portMAX_DELAY);
+        s_running = false;
+        speaker_codec_dev_resume();
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Started, %" PRIu32 " Hz, %d channel(s)", sample_rate, channels);
+    return ESP_OK;
+}
+
+esp_err_t wav_recorder_stop(void)
+{
+    if (!s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // The capture task ends after its current block, the writer after emptying the ring
+    s_stop = true;
+    xSemaphoreTake(s_done_sem, portMAX_DELAY);
+    s_running = false;
+
+    speaker_codec_dev_resume();
+    wav_recorder_log_stats();
+    return s_write_failed ? ESP_FAIL : ESP_OK;
+}
+
+bool wav_recorder_is_running(void)
+{
+    return s_running;
+}
+
+void wav_recorder_get_stats(wav_recorder_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void wav_recorder_log_stats(void)
+{
+    wav_recorder_stats_t stats;
+    wav_recorder_get_stats(&stats);
+
+    const uint32_t byte_rate = stats.sample_rate * stats.channels * 2;
+    const uint32_t dropped_ms = byte_rate ? (uint32_t)(stats.dropped_bytes * 1000 / byte_rate) : 0;
+    ESP_LOGI(TAG, "%" PRIu32 " Hz x%d, %" PRIu32 " file(s), captured %" PRIu64 " bytes, written %" PRIu64 " bytes, "
+             "overruns %" PRIu32 ", read errors %" PRIu32 ", write errors %" PRIu32 ", ring peak %" PRIu32 "/%d blocks",
+             stats.sample_rate, stats.channels, stats.file_cnt, stats.captured_bytes, stats.written_bytes,
+             stats.overrun_cnt, stats.read_error_cnt, stats.write_error_cnt, stats.ring_peak, WAV_RECORDER_BLOCK_NUM);
+    if (stats.dropped_bytes) {
+        ESP_LOGW(TAG, "Dropped %" PRIu64 " bytes, %" PRIu32 " ms of audio", stats.dropped_bytes, dropped_ms);
+    } else {
+        ESP_LOGI(TAG, "No audio dropped");
+    }
+
+    char hist[WAV_RECORDER_HIST_BUCKETS * 16];
+    int len = 0;
+    for (int i = 0; i < WAV_RECORDER_HIST_BUCKETS && len < (int)sizeof(hist); i++) {
+        if (i < WAV_RECORDER_HIST_BUCKETS - 1) {
+            len += snprintf(hist + len, sizeof(hist) - len, " <%dms:%" PRIu32, 1 << i, stats.write_hist[i]);
+        } else {
+            len += snprintf(hist + len, sizeof(hist) - len, " >=%dms:%" PRIu32, 1 << (i - 1), stats.write_hist[i]);
+        }
+    }
+    ESP_LOGI(TAG, "%" PRIu32 " writes, max %" PRIu32 " us,%s", stats.write_cnt, stats.write_max_us, hist);
+}
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * | File         :   wav_recorder.h
+ * | Author       :   Waveshare team
+ * | Function     :   Streaming WAV recorder
+ * | Info         :
+ * |                 Records the microphone straight to a WAV file on the SD
+ * |                 card. A capture task moves I2S blocks into a lock-free
+ * |                 ring, a writer task empties the ring in large aligned
+ * |                 writes, so the recording length is only limited by the card.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2025-07-28
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#ifndef __WAV_RECORDER_H
+#define __WAV_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/* Recorder configuration, can be adjusted by users */
+#define WAV_RECORDER_BLOCK_SIZE         (2048)              // Bytes of one ring block, one I2S read
+#define WAV_RECORDER_BLOCK_NUM          (128)               // Ring blocks, 256 KB in PSRAM, 1.3 s at 48 kHz stereo
+#define WAV_RECORDER_WRITE_SIZE         (32 * 1024)         // Largest file write, a multiple of the 512-byte sector
+#define WAV_RECORDER_HEADER_SIZE        (512)               // Header padded to one sector so the data stays sector aligned
+#define WAV_RECORDER_MAX_FILE_SIZE      (0xFFFFFFFFUL - WAV_RECORDER_WRITE_SIZE) // FAT32 limit, the recording continues in a new file
+#define WAV_RECORDER_SYNC_MS            (5000)              // Patch the header and sync this often, 0 to do it on stop only
+#define WAV_RECORDER_CAPTURE_PRIORITY   (10)                // Above the writer, I2S must never wait for the card
+#define WAV_RECORDER_WRITER_PRIORITY    (5)
+#define WAV_RECORDER_TASK_STACK_SIZE    (4 * 1024)
+#define WAV_RECORDER_HIST_BUCKETS       (12)                // Write latency buckets: < 1, 2, 4, ... 1024 ms and above
+
+/**
+ * @brief Recorder statistics
+ */
+typedef struct {
+    uint32_t sample_rate;                               // Rate of the current or last recording
+    uint8_t channels;                                   // Channels of the current or last recording
+    uint32_t file_cnt;                                  // Files written, more than one once a file hit WAV_RECORDER_MAX_FILE_SIZE
+    uint64_t captured_bytes;                            // Bytes read from I2S and queued for the file, dropped blocks excluded
+    uint64_t written_bytes;                             // Bytes written to the card
+    uint64_t dropped_bytes;                             // Audio missing from the file: ring overruns, failed and skipped writes
+    uint32_t overrun_cnt;                               // Blocks dropped because the ring was full
+    uint32_t read_error_cnt;                            // Failed I2S reads
+    uint32_t write_error_cnt;                           // Failed or short file writes
+    uint32_t write_cnt;                                 // File writes
+    uint32_t ring_peak;                                 // Most blocks waiting in the ring at once
+    uint32_t write_max_us;                              // Slowest file write
+    uint32_t write_hist[WAV_RECORDER_HIST_BUCKETS];     // File writes by latency, bucket n holds < 2^n ms
+} wav_recorder_stats_t;
+
+/**
+ * @brief Start recording to a WAV file.
+ *
+ * Switches the codec to the given format, which also applies to the speaker
+ * until wav_recorder_stop() restores the default.
+ *
+ * @param path: File path, e.g. "/sdcard/rec.wav". Later files of a long recording get "_001" ... appended
+ * @param sample_rate: Sample rate, e.g. 16000 or 48000
+ * @param channels: 1 or 2
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: Already recording
+ *    - ESP_ERR_NO_MEM: Not enough memory for the ring
+ *    - ESP_FAIL: The file could not be created
+ */
+esp_err_t wav_recorder_start(const char *path, uint32_t sample_rate, uint8_t channels);
+
+/**
+ * @brief Stop recording.
+ *
+ * Blocks until the ring is written out and the WAV header holds the final sizes.
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: Not recording
+ *    - ESP_FAIL: A write failed during the recording
+ */
+esp_err_t wav_recorder_stop(void);
+
+/**
+ * @brief Check whether a recording is running.
+ *
+ * @return
+ *    - true: Recording
+ *    - false: Idle
+ */
+bool wav_recorder_is_running(void);
+
+/**
+ * @brief Get the statistics of the current or last recording.
+ *
+ * @param stats: Output statistics
+ */
+void wav_recorder_get_stats(wav_recorder_stats_t *stats);
+
+/**
+ * @brief Log the statistics of the current or last recording.
+ *
+ * Includes the dropped audio in milliseconds, to check that the card keeps up with a format.
+ */
+void wav_recorder_log_stats(void);
+
+#endif
@@ -11,20 +11,175 @@
 #include "rgb_lcd_port.h" // LCD display driver
 #include "gui_paint.h"    // GUI drawing functions
 #include "gt911.h"        // GT911 touch controller
-#include "sd.h"           // SD card (not used directly here)
+#include "sd.h"           // SD card, recordings are stored there
 #include "codec_dev.h"    // Codec driver
-#include "format_wav.h"   // WAV formatting (not used directly here)
+#include "wav_recorder.h" // Streaming WAV recorder
+#include "audio_engine.h" // Full-duplex capture and playback
+#include "vad.h"          // Voice activity detection
+#include "aec.h"          // Acoustic echo canceller
+#include "format_wav.h"   // WAV header of the speech segments
 #include "esp_check.h"    // Error handling macros
+#include <inttypes.h>
 
 static const char *TAG = "main";
 
 // Configuration macros
-#define RECORD_TIME_SEC 5
-#define BUFFER_SIZE (CODEC_DEFAULT_SAMPLE_RATE * RECORD_TIME_SEC * CODEC_DEFAULT_CHANNEL * (CODEC_DEFAULT_BIT_WIDTH / 8))
+#define RECORD_FILE_PATH   MOUNT_POINT "/rec.wav"
+#define RECORD_SAMPLE_RATE 16000   // Set to 48000 with 2 channels to check that the card keeps up, drops are logged
+#define RECORD_CHANNEL     1
+#define RECORD_STATS_PERIOD_MS 10000 // Log the statistics of the recorder, detector or audio engine this often while they run
+#define PLAY_BUFFER_SIZE   4096
+#define LOOPBACK_MODE      0       // Set to 1 to hear the microphone live instead of recording
+#define LOOPBACK_AEC       1       // Cancel the speaker echo in loopback, at AEC_SAMPLE_RATE mono, so it does not howl
+#define VAD_MODE           0       // Set to 1 to listen and save each utterance to its own file instead of recording
+#define VAD_FILE_PATH      MOUNT_POINT "/vad_%03d.wav"
 
-static int16_t *record_buffer = NULL;
 UBYTE *BlackImage;
 
+static FILE *play_fp = NULL;
+static uint8_t *play_buffer = NULL;
+
+// Draw the idle screen once recording or playback has finished
+static void draw_done(const char *text)
+{
+    Paint_Clear(WHITE);
+    Paint_DrawLine(420, 450, 390, 435, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
+    Paint_DrawLine(420, 450, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
+    Paint_DrawLine(390, 435, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
+    Paint_DrawString_EN(250, 150, text, &Font48, BLACK, WHITE);
+    wavesahre_rgb_lcd_display(BlackImage);
+}
+
+#if VAD_MODE
+static volatile bool vad_speech = false;   // Set by the VAD task
+static bool vad_shown = false;             // State on the screen
+static FILE *vad_fp = NULL;
+static uint32_t vad_bytes = 0;
+static int vad_file_cnt = 0;
+
+static void vad_event(vad_event_t event, void *user_data)
+{
+    vad_speech = (event == VAD_EVENT_SPEECH_START);
+}
+
+// Save pending speech, one WAV file per segment, called from the touch loop
+static void vad_poll(void)
+{
+    if (!vad_is_running() && !vad_fp)
+        return;
+
+    if (vad_speech != vad_shown)
+    {
+        vad_shown = vad_speech;
+        Paint_ClearWindows(0, 100, EXAMPLE_LCD_H_RES, 250, WHITE);
+        Paint_DrawString_EN(200, 150, vad_shown ? "Speech..." : "Listening...", &Font48, BLACK, WHITE);
+        wavesahre_rgb_lcd_display(BlackImage);
+    }
+
+    if (vad_segment_pending() && !vad_fp)
+    {
+        char path[32];
+        const wav_header_t header = WAV_HEADER_PCM_DEFAULT(0, 16, VAD_SAMPLE_RATE, 1);
+
+        snprintf(path, sizeof(path), VAD_FILE_PATH, vad_file_cnt++);
+        vad_fp = fopen(path, "wb");
+        if (!vad_fp)
+        {
+            ESP_LOGE(TAG, "Failed to create %s", path);
+        }
+        else
+        {
+            fwrite(&header, sizeof(header), 1, vad_fp); // Sizes are patched when the segment ends
+            ESP_LOGI(TAG, "Saving speech to %s", path);
+        }
+        vad_bytes = 0;
+    }
+
+    // The segment is drained even without a file, so the next one starts clean
+    size_t len;
+    while ((len = vad_read(play_buffer, PLAY_BUFFER_SIZE, 0)) > 0)
+    {
+        if (vad_fp)
+            fwrite(play_buffer, 1, len, vad_fp);
+        vad_bytes += len;
+    }
+
+    if (vad_fp && !vad_segment_pending())
+    {
+        const wav_header_t header = WAV_HEADER_PCM_DEFAULT(vad_bytes, 16, VAD_SAMPLE_RATE, 1);
+        fseek(vad_fp, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, vad_fp);
+        fclose(vad_fp);
+        vad_fp = NULL;
+        ESP_LOGI(TAG, "Speech saved, %" PRIu32 " ms", vad_bytes / (VAD_SAMPLE_RATE * 2 / 1000));
+    }
+}
+#endif
+
+// Start playing the recording back from the SD card, the audio engine does the I2S writes
+static bool play_start(void)
+{
+    wav_recorder_stats_t stats;
+    wav_recorder_get_stats(&stats);
+
+    if (!play_buffer)
+        play_buffer = malloc(PLAY_BUFFER_SIZE);
+    play_fp = fopen(RECORD_FILE_PATH, "rb");
+    if (!play_fp || !play_buffer || fseek(play_fp, WAV_RECORDER_HEADER_SIZE, SEEK_SET) != 0)
+    {
+        ESP_LOGE(TAG, "Failed to open %s", RECORD_FILE_PATH);
+        if (play_fp)
+            fclose(play_fp);
+        play_fp = NULL;
+        return false;
+    }
+
+    audio_engine_config_t config = {
+        .sample_rate = stats.sample_rate,
+        .channels = stats.channels,
+    };
+    if (audio_engine_start(&config) != ESP_OK)
+    {
+        fclose(play_fp);
+        play_fp = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Top up the playback ring without blocking, called from the touch loop
+static void play_poll(void)
+{
+    if (!play_fp)
+        return;
+
+    while (audio_engine_playback_queued() < AUDIO_ENGINE_PLAYBACK_FRAMES - 1)
+    {
+        size_t len = fread(play_buffer, 1, PLAY_BUFFER_SIZE, play_fp);
+        if (len == 0)
+        {
+            audio_engine_flush();
+            // Let the queued frames play out before the engine stops
+            if (audio_engine_playback_queued() == 0)
+            {
+                audio_engine_stop();
+                fclose(play_fp);
+                play_fp = NULL;
+                ESP_LOGI(TAG, "Playback done.");
+                draw_done("Playback done.");
+            }
+            return;
+        }
+        size_t queued = audio_engine_write(play_buffer, len, 0);
+        if (queued < len)
+        {
+            // Ring full: rewind to the first byte that was not queued
+            fseek(play_fp, -(long)(len - queued), SEEK_CUR);
+            break;
+        }
+    }
+}
+
 // Function to handle recording and playback
 void play_or_pause(bool play)
 {
@@ -33,54 +188,84 @@ void play_or_pause(bool play)
         // Recording logic
         Paint_DrawLine(390, 435, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
         Paint_DrawLine(410, 435, 410, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawString_EN(200, 150, "Start recording...", &Font48, BLACK, WHITE);
+#if VAD_MODE
+        Paint_DrawString_EN(200, 150, "Listening...", &Font48, BLACK, WHITE);
         wavesahre_rgb_lcd_display(BlackImage);
-        ESP_LOGI(TAG, "Start recording...");
+        ESP_LOGI(TAG, "Start listening...");
 
-        size_t total_bytes = 0;
-        while (total_bytes < BUFFER_SIZE)
+        if (!play_buffer)
+            play_buffer = malloc(PLAY_BUFFER_SIZE);
+        vad_shown = vad_speech = false;
+        if (!play_buffer || vad_start(vad_event, NULL) != ESP_OK)
         {
-            size_t bytes_read = 0;
-            mic_i2s_read(record_buffer + total_bytes / 2,
-                         BUFFER_SIZE - total_bytes,
-                         &bytes_read, portMAX_DELAY);
-            total_bytes += bytes_read;
+            ESP_LOGE(TAG, "Failed to start listening");
         }
+#elif LOOPBACK_MODE
+        Paint_DrawString_EN(200, 150, "Start loopback...", &Font48, BLACK, WHITE);
+        wavesahre_rgb_lcd_display(BlackImage);
+        ESP_LOGI(TAG, "Start loopback...");
 
-        ESP_LOGI(TAG, "Recording done.");
-        Paint_Clear(WHITE);
-        Paint_DrawLine(420, 450, 390, 435, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawLine(420, 450, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawLine(390, 435, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawString_EN(250, 150, "Recording done.", &Font48, BLACK, WHITE);
+#if LOOPBACK_AEC
+        audio_engine_config_t config = {
+            .sample_rate = AEC_SAMPLE_RATE,
+            .channels = 1,
+            .loopback = true,
+            .aec = true,
+        };
+#else
+        audio_engine_config_t config = {
+            .sample_rate = CODEC_DEFAULT_SAMPLE_RATE,
+            .channels = CODEC_DEFAULT_CHANNEL,
+            .loopback = true,
+        };
+#endif
+        if (audio_engine_start(&config) != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to start loopback");
+        }
+#else
+        Paint_DrawString_EN(200, 150, "Start recording...", &Font48, BLACK, WHITE);
         wavesahre_rgb_lcd_display(BlackImage);
+        ESP_LOGI(TAG, "Start recording...");
+
+        // Runs in the background until the next click, limited only by the card
+        if (wav_recorder_start(RECORD_FILE_PATH, RECORD_SAMPLE_RATE, RECORD_CHANNEL) != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to start recording, is a card inserted?");
+        }
+#endif
     }
     else
     {
-        // Playback logic
+#if VAD_MODE
+        vad_stop();
+        vad_poll(); // Save what is left of the last segment
+        ESP_LOGI(TAG, "Listening done.");
+        draw_done("Listening done.");
+#elif LOOPBACK_MODE
+        audio_engine_stop();
+        ESP_LOGI(TAG, "Loopback done.");
+        draw_done("Loopback done.");
+#else
+        if (wav_recorder_stop() != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Recording incomplete");
+        }
+        ESP_LOGI(TAG, "Recording done.");
+
+        // Playback logic, continues in play_poll() while the touch loop keeps running
+        Paint_Clear(WHITE);
         Paint_DrawLine(390, 435, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
         Paint_DrawLine(410, 435, 410, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
         Paint_DrawString_EN(200, 150, "Start playing...", &Font48, BLACK, WHITE);
         wavesahre_rgb_lcd_display(BlackImage);
         ESP_LOGI(TAG, "Start playing...");
 
-        size_t total_bytes = 0;
-        while (total_bytes < BUFFER_SIZE)
+        if (!play_start())
         {
-            size_t bytes_written = 0;
-            speaker_i2s_write(record_buffer + total_bytes / 2,
-                              BUFFER_SIZE - total_bytes,
-                              &bytes_written, portMAX_DELAY);
-            total_bytes += bytes_written;
+            draw_done("Recording done.");
         }
-
-        ESP_LOGI(TAG, "Playback done.");
-        Paint_Clear(WHITE);
-        Paint_DrawLine(420, 450, 390, 435, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawLine(420, 450, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawLine(390, 435, 390, 465, RED, DOT_PIXEL_2X2, LINE_STYLE_SOLID);
-        Paint_DrawString_EN(250, 150, "Playback done.", &Font48, BLACK, WHITE);
-        wavesahre_rgb_lcd_display(BlackImage);
+#endif
     }
 }
 
@@ -116,22 +301,36 @@ void app_main()
     speaker_codec_volume_set(100, NULL);
     microphone_codec_gain_set(30, NULL);
 
-    // Allocate memory for recording buffer
-    record_buffer = heap_caps_malloc(BUFFER_SIZE * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
-    if (!record_buffer)
+    // Mount the SD card for the recordings
+    if (sd_mmc_init() != ESP_OK)
     {
-        ESP_LOGE(TAG, "Failed to allocate buffer");
-        vTaskDelete(NULL);
-        return;
+        ESP_LOGE(TAG, "No SD card, recording is not available");
     }
 
     // Touch handling loop
     static uint16_t prev_x;
     static uint16_t prev_y;
     bool is_playing = false;
+    TickType_t stats_tick = xTaskGetTickCount();
 
     while (1)
     {
+        play_poll();
+        if (xTaskGetTickCount() - stats_tick >= pdMS_TO_TICKS(RECORD_STATS_PERIOD_MS))
+        {
+            stats_tick = xTaskGetTickCount();
+            if (wav_recorder_is_running())
+                wav_recorder_log_stats(); // Drops show up while recording, not only on stop
+#if VAD_MODE
+            if (vad_is_running())
+                vad_log_stats();          // Detector load and the segments found so far
+#endif
+            if (audio_engine_is_running())
+                audio_engine_log_stats(); // Loopback or playback: load, latency, underruns and the echo canceller
+        }
+#if VAD_MODE
+        vad_poll();
+#endif
         point_data = touch_gt911_read_point(1);
         if (point_data.cnt == 1)
         {
@@ -139,7 +338,7 @@ void app_main()
             {
                 continue;
             }
-            else if (point_data.x[0] > 390 && point_data.x[0] < 420 &&
+            else if (!play_fp && point_data.x[0] > 390 && point_data.x[0] < 420 &&
                      point_data.y[0] > 420 && point_data.y[0] < 480)
             {
                 Paint_Clear(WHITE);
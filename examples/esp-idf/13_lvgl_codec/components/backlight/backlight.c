@@ -0,0 +1,409 @@
+/*****************************************************************************
+ * | File         :   backlight.c
+ * | Author       :   Waveshare team
+ * | Function     :   LCD backlight service
+ * | Info         :
+ * |                 Gamma corrected brightness fades on the IO_EXTENSION
+ * |                 PWM, dimming and blanking after touch inactivity and
+ * |                 optional ambient light control.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "i2c.h"
+#include "io_extension.h"
+#include "backlight.h"
+
+static const char *TAG = "backlight";
+
+// Bus time of one register write: address, register and value bytes plus start and stop
+#define BACKLIGHT_WRITE_US      ((9 * 3 + 2) * 1000000 / EXAMPLE_I2C_MASTER_FREQUENCY + 1)
+
+// Shortest interval between two writes, from the update rate and the bus cap
+#define BACKLIGHT_INTERVAL_US_RATE  (1000000 / BACKLIGHT_FADE_RATE_HZ)
+#define BACKLIGHT_INTERVAL_US_BUS   (BACKLIGHT_WRITE_US * 1000 / BACKLIGHT_BUS_CAP_PERMILLE)
+#define BACKLIGHT_INTERVAL_US       (BACKLIGHT_INTERVAL_US_RATE > BACKLIGHT_INTERVAL_US_BUS ? \
+                                     BACKLIGHT_INTERVAL_US_RATE : BACKLIGHT_INTERVAL_US_BUS)
+
+// Brightness is handled in 1/1000 of the perceived range for smooth fades
+#define BACKLIGHT_SCALE         (1000)
+
+typedef enum {
+    BACKLIGHT_STATE_ACTIVE = 0,
+    BACKLIGHT_STATE_DIMMED,
+    BACKLIGHT_STATE_OFF,
+} backlight_state_t;
+
+typedef struct {
+    TaskHandle_t task;
+    portMUX_TYPE lock;                  // Protects the fields below
+    uint8_t user_level;                 // Level set by the user, in percent
+    uint32_t user_fade_ms;              // Fade requested with the level, 0 for the default rate
+    bool user_changed;                  // user_level changed since the task last looked
+    uint32_t dim_ms;                    // Inactivity before dimming
+    uint32_t off_ms;                    // Inactivity before blanking
+    bool ambient;                       // Ambient light control enabled
+    int64_t activity_us;                // Time of the last user activity, 64 bits so only read and written under lock
+    volatile backlight_state_t state;   // Inactivity state applied by the task
+
+    /* Task only */
+    int32_t current;                    // Brightness being shown, 0 to BACKLIGHT_SCALE
+    int32_t rate;                       // Fade speed, brightness units per second
+    int32_t ambient_level;              // Filtered ambient brightness, 0 to BACKLIGHT_SCALE
+    int64_t ambient_us;                 // Time of the last ambient sample
+    int16_t duty;                       // Register value last written, -1 before the first write
+    bool enabled;                       // State of the backlight enable pin
+
+    /* Statistics, updated under lock */
+    int64_t stats_since_us;
+    int64_t stats_last_us;
+    uint64_t on_us;
+    uint64_t dimmed_us;
+    uint64_t duty_sum;                  // Duty in 1/1000 times microseconds
+    uint64_t user_duty_sum;             // Same with the duty of the user level
+    uint32_t write_cnt;
+} backlight_obj_t;
+
+static backlight_obj_t backlight = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+    .user_level = BACKLIGHT_DEFAULT_LEVEL,
+    .dim_ms = BACKLIGHT_DIM_TIMEOUT_MS,
+    .off_ms = BACKLIGHT_OFF_TIMEOUT_MS,
+    .ambient = BACKLIGHT_AMBIENT_ENABLE,
+    .ambient_level = BACKLIGHT_SCALE,
+    .duty = -1,
+};
+
+// Light output in 1/1000, proportional to the PWM on time
+static uint32_t backlight_output(int32_t brightness)
+{
+    if (brightness <= 0) {
+        return 0;
+    }
+    return (uint32_t)(powf((float)brightness / BACKLIGHT_SCALE, BACKLIGHT_GAMMA) * 1000.0f + 0.5f);
+}
+
+// PWM register value for a light output in 1/1000
+static uint8_t backlight_duty(uint32_t output)
+{
+    uint32_t duty = (output * 255 + 500) / 1000;
+#if BACKLIGHT_PWM_INVERTED
+    duty = 255 - duty;
+#endif
+    return duty > IO_EXTENSION_PWM_DUTY_MAX ? IO_EXTENSION_PWM_DUTY_MAX : duty;
+}
+
+// Account the time since the last call at the brightness being shown
+static void backlight_stats_update(int64_t now, int32_t user_brightness)
+{
+    uint64_t dt = now - backlight.stats_last_us;
+    uint32_t output = backlight.enabled ? backlight_output(backlight.current) : 0;
+
+    taskENTER_CRITICAL(&backlight.lock);
+    if (backlight.enabled) {
+        backlight.on_us += dt;
+    }
+    if (backlight.state == BACKLIGHT_STATE_DIMMED) {
+        backlight.dimmed_us += dt;
+    }
+    backlight.duty_sum += (uint64_t)output * dt;
+    backlight.user_duty_sum += (uint64_t)backlight_output(user_brightness) * dt;
+    backlight.stats_last_us = now;
+    taskEXIT_CRITICAL(&backlight.lock);
+}
+
+// Count one IO_EXTENSION transaction for the bus share
+static void backlight_count_write(void)
+{
+    taskENTER_CRITICAL(&backlight.lock);
+    backlight.write_cnt++;
+    taskEXIT_CRITICAL(&backlight.lock);
+}
+
+// Send the brightness being shown to the IO_EXTENSION, skipping unchanged values
+static void backlight_apply(void)
+{
+    bool enable = backlight.current > 0;
+    uint8_t duty = backlight_duty(backlight_output(backlight.current));
+
+    // Keep the old duty while turning off, the enable pin does the work
+    if (enable && duty != backlight.duty) {
+        IO_EXTENSION_Pwm_Duty(duty);
+        backlight.duty = duty;
+        backlight_count_write();
+    }
+    if (enable != backlight.enabled) {
+        IO_EXTENSION_Output(IO_EXTENSION_IO_2, enable);
+        backlight.enabled = enable;
+        backlight_count_write();
+    }
+}
+
+// Sample the ambient light and low pass filter it
+static void backlight_ambient_update(int64_t now)
+{
+    if (now - backlight.ambient_us < BACKLIGHT_AMBIENT_PERIOD_MS * 1000LL) {
+        return;
+    }
+    backlight.ambient_us = now;
+
+    int32_t adc = IO_EXTENSION_Adc_Input();
+    backlight_count_write();
+    int32_t level;
+    if (adc <= BACKLIGHT_AMBIENT_ADC_DARK) {
+        level = 0;
+    } else if (adc >= BACKLIGHT_AMBIENT_ADC_BRIGHT) {
+        level = BACKLIGHT_SCALE;
+    } else {
+        level = (adc - BACKLIGHT_AMBIENT_ADC_DARK) * BACKLIGHT_SCALE /
+                (BACKLIGHT_AMBIENT_ADC_BRIGHT - BACKLIGHT_AMBIENT_ADC_DARK);
+    }
+    // Quarter step per sample, so passing shadows don't pump the brightness
+    backlight.ambient_level += (level - backlight.ambient_level) / 4;
+}
+
+static void backlight_task(void *arg)
+{
+    int64_t last_us = esp_timer_get_time();
+    backlight.stats_last_us = last_us;
+
+    while (1) {
+        int64_t now = esp_timer_get_time();
+
+        taskENTER_CRITICAL(&backlight.lock);
+        int32_t user = backlight.user_level * (BACKLIGHT_SCALE / 100);
+        uint32_t user_fade_ms = backlight.user_changed ? backlight.user_fade_ms : 0;
+        bool user_changed = backlight.user_changed;
+        backlight.user_changed = false;
+        uint32_t dim_ms = backlight.dim_ms;
+        uint32_t off_ms = backlight.off_ms;
+        bool ambient = backlight.ambient;
+        int64_t activity_us = backlight.activity_us;
+        taskEXIT_CRITICAL(&backlight.lock);
+
+        backlight_stats_update(now, user);
+
+        /* Inactivity state */
+        int64_t idle_us = now - activity_us;
+        backlight_state_t state = BACKLIGHT_STATE_ACTIVE;
+        if (off_ms && idle_us >= off_ms * 1000LL) {
+            state = BACKLIGHT_STATE_OFF;
+        } else if (dim_ms && idle_us >= dim_ms * 1000LL) {
+            state = BACKLIGHT_STATE_DIMMED;
+        }
+        if (state != backlight.state) {
+            backlight.state = state;
+            backlight.rate = 0; // Back to the default rate
+        }
+
+        /* Target brightness */
+        int32_t target = user;
+        if (ambient && target > 0) {
+            backlight_ambient_update(now);
+            int32_t min = BACKLIGHT_MIN_LEVEL * (BACKLIGHT_SCALE / 100);
+            if (target > min) {
+                target = min + (target - min) * backlight.ambient_level / BACKLIGHT_SCALE;
+            }
+        }
+        if (target > 0 && target < BACKLIGHT_MIN_LEVEL * (BACKLIGHT_SCALE / 100)) {
+            target = BACKLIGHT_MIN_LEVEL * (BACKLIGHT_SCALE / 100);
+        }
+        if (state == BACKLIGHT_STATE_OFF) {
+            target = 0;
+        } else if (state == BACKLIGHT_STATE_DIMMED && target > BACKLIGHT_DIM_LEVEL * (BACKLIGHT_SCALE / 100)) {
+            target = BACKLIGHT_DIM_LEVEL * (BACKLIGHT_SCALE / 100);
+        }
+
+        /* Fade speed, a full scale fade takes BACKLIGHT_FADE_MS unless the user asked otherwise */
+        if (user_changed) {
+            int32_t delta = abs(target - backlight.current);
+            backlight.rate = (user_fade_ms && delta) ? delta * 1000 / user_fade_ms : 0;
+        }
+        int32_t rate = backlight.rate ? backlight.rate : BACKLIGHT_SCALE * 1000 / BACKLIGHT_FADE_MS;
+
+        /* Step towards the target, at most one interval: after a long sleep at the target the fade starts from here */
+        int64_t elapsed_us = now - last_us;
+        if (elapsed_us > BACKLIGHT_INTERVAL_US) {
+            elapsed_us = BACKLIGHT_INTERVAL_US;
+        }
+        int32_t step = (int32_t)(elapsed_us * rate / 1000000);
+        last_us = now;
+        if (step < 1) {
+            step = 1;
+        }
+        if (backlight.current < target) {
+            backlight.current = backlight.current + step > target ? target : backlight.current + step;
+        } else if (backlight.current > target) {
+            backlight.current = backlight.current - step < target ? target : backlight.current - step;
+        }
+        backlight_apply();
+
+        /* Sleep until the next step, the next timeout or some activity */
+        TickType_t wait = portMAX_DELAY;
+        if (backlight.current != target) {
+            wait = pdMS_TO_TICKS(BACKLIGHT_INTERVAL_US / 1000);
+        } else {
+            int64_t next_ms = INT64_MAX;
+            if (state == BACKLIGHT_STATE_ACTIVE && dim_ms) {
+                next_ms = dim_ms - idle_us / 1000;
+            } else if (state != BACKLIGHT_STATE_OFF && off_ms) {
+                next_ms = off_ms - idle_us / 1000;
+            }
+            if (ambient && state != BACKLIGHT_STATE_OFF && next_ms > BACKLIGHT_AMBIENT_PERIOD_MS) {
+                next_ms = BACKLIGHT_AMBIENT_PERIOD_MS;
+            }
+            if (next_ms != INT64_MAX) {
+                wait = pdMS_TO_TICKS(next_ms > 0 ? next_ms : 0) + 1;
+            }
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+esp_err_t backlight_init(void)
+{
+    if (backlight.task) {
+        return ESP_OK;
+    }
+
+    int64_t now = esp_timer_get_time();
+    backlight.activity_us = now;
+    backlight.stats_since_us = now;
+    backlight.enabled = false; // The pin goes on with the first step of the fade in
+    backlight.current = 0;
+
+    BaseType_t res;
+    if (BACKLIGHT_TASK_CORE < 0) {
+        res = xTaskCreate(backlight_task, "backlight", BACKLIGHT_TASK_STACK_SIZE, NULL,
+                          BACKLIGHT_TASK_PRIORITY, &backlight.task);
+    } else {
+        res = xTaskCreatePinnedToCore(backlight_task, "backlight", BACKLIGHT_TASK_STACK_SIZE, NULL,
+                                      BACKLIGHT_TASK_PRIORITY, &backlight.task, BACKLIGHT_TASK_CORE);
+    }
+    if (res != pdPASS) {
+        backlight.task = NULL;
+        ESP_LOGE(TAG, "Failed to create the backlight task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Update every %d ms at most, %d us of bus per write", BACKLIGHT_INTERVAL_US / 1000, BACKLIGHT_WRITE_US);
+    return ESP_OK;
+}
+
+void backlight_set_level(uint8_t level, uint32_t fade_ms)
+{
+    if (level > 100) {
+        level = 100;
+    }
+
+    taskENTER_CRITICAL(&backlight.lock);
+    backlight.user_level = level;
+    backlight.user_fade_ms = fade_ms;
+    backlight.user_changed = true;
+    taskEXIT_CRITICAL(&backlight.lock);
+
+    if (backlight.task) {
+        xTaskNotifyGive(backlight.task);
+    }
+}
+
+uint8_t backlight_get_level(void)
+{
+    return backlight.user_level;
+}
+
+bool backlight_notify_activity(void)
+{
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&backlight.lock);
+    backlight.activity_us = now;
+    taskEXIT_CRITICAL(&backlight.lock);
+
+    // Only wake the task when there is something to restore
+    backlight_state_t state = backlight.state;
+    if (state != BACKLIGHT_STATE_ACTIVE && backlight.task) {
+        xTaskNotifyGive(backlight.task);
+    }
+    return state == BACKLIGHT_STATE_OFF;
+}
+
+void backlight_set_timeouts(uint32_t dim_ms, uint32_t off_ms)
+{
+    taskENTER_CRITICAL(&backlight.lock);
+    backlight.dim_ms = dim_ms;
+    backlight.off_ms = off_ms;
+    taskEXIT_CRITICAL(&backlight.lock);
+
+    if (backlight.task) {
+        xTaskNotifyGive(backlight.task);
+    }
+}
+
+void backlight_set_ambient(bool enable)
+{
+    taskENTER_CRITICAL(&backlight.lock);
+    backlight.ambient = enable;
+    backlight.ambient_us = 0; // Sample at once
+    taskEXIT_CRITICAL(&backlight.lock);
+
+    if (backlight.task) {
+        xTaskNotifyGive(backlight.task);
+    }
+}
+
+void backlight_get_stats(backlight_stats_t *stats, bool reset)
+{
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&backlight.lock);
+    // Time since the task last ran is counted at the current state
+    uint64_t pending = now - backlight.stats_last_us;
+    uint64_t elapsed = now - backlight.stats_since_us;
+    uint64_t on_us = backlight.on_us + (backlight.enabled ? pending : 0);
+    uint64_t dimmed_us = backlight.dimmed_us + (backlight.state == BACKLIGHT_STATE_DIMMED ? pending : 0);
+    uint64_t duty_sum = backlight.duty_sum;
+    uint64_t user_duty_sum = backlight.user_duty_sum;
+    uint64_t covered = backlight.stats_last_us - backlight.stats_since_us;
+    uint32_t write_cnt = backlight.write_cnt;
+    if (reset) {
+        backlight.stats_since_us = now;
+        backlight.stats_last_us = now;
+        backlight.on_us = 0;
+        backlight.dimmed_us = 0;
+        backlight.duty_sum = 0;
+        backlight.user_duty_sum = 0;
+        backlight.write_cnt = 0;
+    }
+    taskEXIT_CRITICAL(&backlight.lock);
+
+    stats->elapsed_ms = elapsed / 1000;
+    stats->on_ms = on_us / 1000;
+    stats->dimmed_ms = dimmed_us / 1000;
+    stats->duty_avg_permille = covered ? duty_sum / covered : 0;
+    stats->saved_permille = user_duty_sum ? (user_duty_sum - (duty_sum < user_duty_sum ? duty_sum : user_duty_sum)) * 1000 / user_duty_sum : 0;
+    stats->write_cnt = write_cnt;
+    stats->bus_permille = elapsed ? (uint64_t)write_cnt * BACKLIGHT_WRITE_US * 1000 / elapsed : 0;
+}
+
+void backlight_log_stats(void)
+{
+    backlight_stats_t stats;
+    backlight_get_stats(&stats, true);
+
+    ESP_LOGI(TAG, "%" PRIu32 " ms: on %" PRIu32 " ms, dimmed %" PRIu32 " ms, duty %" PRIu32 ".%" PRIu32 "%%, saved %" PRIu32 ".%" PRIu32 "%%, %" PRIu32 " writes, bus %" PRIu32 ".%" PRIu32 "%%",
+             stats.elapsed_ms, stats.on_ms, stats.dimmed_ms,
+             stats.duty_avg_permille / 10, stats.duty_avg_permille % 10,
+             stats.saved_permille / 10, stats.saved_permille % 10,
+             stats.write_cnt, stats.bus_permille / 10, stats.bus_permille % 10);
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * | File         :   backlight.h
+ * | Author       :   Waveshare team
+ * | Function     :   LCD backlight service
+ * | Info         :
+ * |                 Gamma corrected brightness fades on the IO_EXTENSION
+ * |                 PWM, dimming and blanking after touch inactivity and
+ * |                 optional ambient light control. PWM writes are rate
+ * |                 limited so the backlight never takes more than a set
+ * |                 share of the shared I2C bus.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#ifndef __BACKLIGHT_H
+#define __BACKLIGHT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+/**
+ * Backlight related parameters, can be adjusted by users
+ *
+ */
+#define BACKLIGHT_TASK_STACK_SIZE       (3 * 1024)  // The stack size of the backlight task, in bytes
+#define BACKLIGHT_TASK_PRIORITY         (1)         // The priority of the backlight task
+#define BACKLIGHT_TASK_CORE             (-1)        // The core of the backlight task, `-1` means don't specify the core
+
+#define BACKLIGHT_DEFAULT_LEVEL         (80)        // Brightness at start, in percent of perceived brightness
+#define BACKLIGHT_MIN_LEVEL             (5)         // Lowest brightness while the screen is on
+#define BACKLIGHT_DIM_LEVEL             (15)        // Brightness after BACKLIGHT_DIM_TIMEOUT_MS without touch
+#define BACKLIGHT_DIM_TIMEOUT_MS        (30 * 1000) // Inactivity before dimming, 0 never dims
+#define BACKLIGHT_OFF_TIMEOUT_MS        (120 * 1000)// Inactivity before blanking, 0 never blanks
+#define BACKLIGHT_FADE_MS               (400)       // Duration of a full scale fade
+#define BACKLIGHT_GAMMA                 (2.2f)      // Perceived brightness to PWM duty exponent
+#define BACKLIGHT_PWM_INVERTED          (1)         // The PWM register sets the off time, see the 97% limit in IO_EXTENSION_Pwm_Output()
+
+#define BACKLIGHT_FADE_RATE_HZ          (50)        // Maximum PWM updates per second
+#define BACKLIGHT_BUS_CAP_PERMILLE      (5)         // Maximum share of the I2C bus used by PWM updates, in 1/1000
+
+#define BACKLIGHT_AMBIENT_ENABLE        (0)         // Follow the ambient light sensor on the IO_EXTENSION ADC
+#define BACKLIGHT_AMBIENT_PERIOD_MS     (1000)      // Ambient light sampling period
+#define BACKLIGHT_AMBIENT_ADC_DARK      (100)       // ADC reading mapped to BACKLIGHT_MIN_LEVEL
+#define BACKLIGHT_AMBIENT_ADC_BRIGHT    (3000)      // ADC reading mapped to the level set by the user
+
+/**
+ * @brief Backlight statistics
+ *
+ * Backlight power is taken as proportional to the PWM duty, so the saving is the
+ * share of the duty removed by dimming, blanking and ambient control compared to
+ * keeping the level set by the user all the time.
+ */
+typedef struct {
+    uint32_t elapsed_ms;            /*!< Time covered by the statistics */
+    uint32_t on_ms;                 /*!< Time with the backlight on */
+    uint32_t dimmed_ms;             /*!< Time dimmed for inactivity */
+    uint32_t duty_avg_permille;     /*!< Average PWM duty */
+    uint32_t saved_permille;        /*!< Backlight energy saved */
+    uint32_t write_cnt;             /*!< PWM, enable and ambient light transactions */
+    uint32_t bus_permille;          /*!< Share of the I2C bus taken by those transactions */
+} backlight_stats_t;
+
+/**
+ * @brief Start the backlight service
+ *
+ * IO_EXTENSION_Init() must have been called. The backlight fades in to BACKLIGHT_DEFAULT_LEVEL.
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t backlight_init(void);
+
+/**
+ * @brief Set the brightness chosen by the user
+ *
+ * @param level Perceived brightness in percent, 0 turns the backlight off
+ * @param fade_ms Duration of the fade, 0 for BACKLIGHT_FADE_MS scaled to the step
+ */
+void backlight_set_level(uint8_t level, uint32_t fade_ms);
+
+/**
+ * @brief Get the brightness chosen by the user
+ *
+ * @return Perceived brightness in percent
+ */
+uint8_t backlight_get_level(void);
+
+/**
+ * @brief Report user activity, which restores the brightness
+ *
+ * Cheap enough to be called on every touch sample.
+ *
+ * @return true if the screen was blank, the caller should drop the touch that woke it
+ */
+bool backlight_notify_activity(void);
+
+/**
+ * @brief Change the inactivity timeouts
+ *
+ * @param dim_ms Inactivity before dimming, 0 never dims
+ * @param off_ms Inactivity before blanking, 0 never blanks
+ */
+void backlight_set_timeouts(uint32_t dim_ms, uint32_t off_ms);
+
+/**
+ * @brief Enable or disable the ambient light control
+ *
+ * @param enable true to scale the brightness with the ambient light
+ */
+void backlight_set_ambient(bool enable);
+
+/**
+ * @brief Get the statistics
+ *
+ * @param stats Output statistics
+ * @param reset Set to true to restart the statistics after reading them
+ */
+void backlight_get_stats(backlight_stats_t *stats, bool reset);
+
+/**
+ * @brief Log the statistics since the last call, then reset them
+ */
+void backlight_log_stats(void);
+
+#endif
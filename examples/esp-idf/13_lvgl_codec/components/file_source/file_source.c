@@ -0,0 +1,457 @@
+/*****************************************************************************
+ * | File         :   file_source.c
+ * | Author       :   Waveshare team
+ * | Function     :   Read-ahead file source for SD card readers
+ * | Info         :
+ * |                 The reader task serves the open file with the lowest
+ * |                 ring level first. Each SD read is one chunk into an
+ * |                 internal DMA-capable buffer, copied into the ring
+ * |                 outside the lock. Readers copy out of the ring.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include "file_source.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+
+static const char *TAG = "file_source";
+
+#if (FILE_SOURCE_RING_SIZE & (FILE_SOURCE_RING_SIZE - 1)) || (FILE_SOURCE_RING_SIZE % FILE_SOURCE_CHUNK_SIZE)
+#error "FILE_SOURCE_RING_SIZE must be a power of two and a multiple of FILE_SOURCE_CHUNK_SIZE"
+#endif
+
+struct file_source {
+    int fd;
+    long size;
+    uint8_t *ring;
+    uint32_t ring_size;             // A power of two
+    uint32_t chunk_size;            // Bytes per SD read, at most half the ring
+    uint32_t low_watermark;
+    SemaphoreHandle_t data;         // Given when a chunk lands
+
+    // Guarded by s_lock
+    uint32_t head;                  // Ring bytes written, free running, whole chunks until the end of the file
+    uint32_t tail;                  // Ring bytes read, free running
+    long pos;                       // File offset of the byte at tail
+    long read_pos;                  // File offset of the next chunk
+    uint32_t skip;                  // Bytes of the next chunk before the position, after a seek
+    uint32_t gen;                   // Bumped by seeks, drops a chunk read before them
+    bool refilling;                 // Below the low watermark, filling until full
+    bool primed;                    // First refill done, min_fill counts from here
+
+    file_source_stats_t stats;
+};
+
+static TaskHandle_t s_task;
+static SemaphoreHandle_t s_lock;
+static SemaphoreHandle_t s_wake;            // Wakes the reader task
+static file_source_t *s_sources[FILE_SOURCE_MAX_OPEN];
+static file_source_t *s_busy;               // Source the reader task is reading for, outside the lock
+static uint8_t *s_bounce;                   // Internal DMA-capable chunk buffer, NULL reads straight into PSRAM
+
+/**************************************************************************************************
+ *
+ * Reader Task
+ *
+ **************************************************************************************************/
+
+static bool source_wants_chunk(file_source_t *src)
+{
+    const uint32_t fill = src->head - src->tail;
+
+    if (src->read_pos >= src->size || src->ring_size - fill < src->chunk_size) {
+        src->refilling = false;
+        return false;
+    }
+    if (!src->refilling && fill < src->low_watermark) {
+        src->refilling = true;
+        src->stats.refills++;
+    }
+    return src->refilling;
+}
+
+static void reader_task(void *arg)
+{
+    while (1) {
+        file_source_t *src = NULL;
+        uint32_t gen = 0;
+        uint32_t head = 0;
+        long off = 0;
+
+        // The emptiest ring goes first
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        for (int i = 0; i < FILE_SOURCE_MAX_OPEN; i++) {
+            file_source_t *s = s_sources[i];
+            if (s && source_wants_chunk(s) && (!src || s->head - s->tail < src->head - src->tail)) {
+                src = s;
+            }
+        }
+        if (src) {
+            s_busy = src;
+            gen = src->gen;
+            head = src->head;
+            off = src->read_pos;
+        }
+        xSemaphoreGive(s_lock);
+
+        if (!src) {
+            xSemaphoreTake(s_wake, portMAX_DELAY);
+            continue;
+        }
+
+        // The ring space past head is not visible to the reader of the file, fill it unlocked
+        uint8_t *dst = s_bounce ? s_bounce : &src->ring[head & (src->ring_size - 1)];
+        const int64_t start_us = esp_timer_get_time();
+        ssize_t n = -1;
+        if (lseek(src->fd, off, SEEK_SET) == off) {
+            n = read(src->fd, dst, src->chunk_size);
+        }
+        const uint32_t chunk_us = esp_timer_get_time() - start_us;
+        if (n > 0 && s_bounce) {
+            memcpy(&src->ring[head & (src->ring_size - 1)], s_bounce, n);
+        }
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        if (src->gen == gen) {
+            if (n <= 0) {
+                ESP_LOGE(TAG, "Read failed at %ld", off);
+                src->read_pos = src->size;          // Readers see the end of the file
+            } else {
+                src->head += n;
+                src->read_pos += n;
+                if (n < (ssize_t)src->chunk_size) {
+                    src->read_pos = src->size;
+                }
+                if (src->skip) {
+                    src->tail += ((ssize_t)src->skip < n) ? src->skip : (uint32_t)n;
+                    src->skip = 0;
+                }
+                src->stats.chunks++;
+                src->stats.bytes_read += n;
+                if (chunk_us > src->stats.chunk_us_max) {
+                    src->stats.chunk_us_max = chunk_us;
+                }
+            }
+            if (!source_wants_chunk(src)) {
+                src->primed = true;
+            }
+        }
+        s_busy = NULL;
+        xSemaphoreGive(s_lock);
+        xSemaphoreGive(src->data);
+    }
+}
+
+static esp_err_t reader_start(void)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+
+    s_lock = xSemaphoreCreateMutex();
+    s_wake = xSemaphoreCreateBinary();
+    if (!s_lock || !s_wake) {
+        return ESP_ERR_NO_MEM;
+    }
+    s_bounce = heap_caps_malloc(FILE_SOURCE_CHUNK_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (!s_bounce) {
+        ESP_LOGW(TAG, "No internal buffer, reading straight into PSRAM");
+    }
+
+    BaseType_t core_id = (FILE_SOURCE_TASK_CORE < 0) ? tskNO_AFFINITY : FILE_SOURCE_TASK_CORE;
+    if (xTaskCreatePinnedToCore(reader_task, "file_source", FILE_SOURCE_TASK_STACK_SIZE, NULL,
+                                FILE_SOURCE_TASK_PRIORITY, &s_task, core_id) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+/**************************************************************************************************
+ *
+ * Source Function
+ *
+ **************************************************************************************************/
+
+file_source_t *file_source_open(const char *path)
+{
+    return file_source_open_ring(path, FILE_SOURCE_RING_SIZE);
+}
+
+file_source_t *file_source_open_ring(const char *path, uint32_t ring_size)
+{
+    file_source_t *src;
+    int slot = -1;
+
+    if (ring_size < 2 * FILE_SOURCE_MIN_CHUNK_SIZE || (ring_size & (ring_size - 1))) {
+        ESP_LOGE(TAG, "Ring of %" PRIu32 " bytes is not a power of two of at least %d", ring_size, 2 * FILE_SOURCE_MIN_CHUNK_SIZE);
+        return NULL;
+    }
+    if (reader_start() != ESP_OK) {
+        return NULL;
+    }
+
+    src = calloc(1, sizeof(file_source_t));
+    if (!src) {
+        return NULL;
+    }
+    src->fd = open(path, O_RDONLY);
+    if (src->fd < 0) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        free(src);
+        return NULL;
+    }
+    src->size = lseek(src->fd, 0, SEEK_END);
+    src->ring_size = ring_size;
+    src->chunk_size = (ring_size >= 2 * FILE_SOURCE_CHUNK_SIZE) ? FILE_SOURCE_CHUNK_SIZE : ring_size / 2;
+    src->low_watermark = (uint64_t)FILE_SOURCE_LOW_WATERMARK * ring_size / FILE_SOURCE_RING_SIZE;
+    src->ring = heap_caps_malloc(ring_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    src->data = xSemaphoreCreateBinary();
+    src->stats.min_fill = ring_size;
+    if (src->size < 0 || !src->ring || !src->data) {
+        goto err;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int i = 0; i < FILE_SOURCE_MAX_OPEN; i++) {
+        if (!s_sources[i]) {
+            s_sources[i] = src;
+            slot = i;
+            break;
+        }
+    }
+    xSemaphoreGive(s_lock);
+    if (slot >= 0) {
+        xSemaphoreGive(s_wake);
+        return src;
+    }
+    ESP_LOGE(TAG, "All %d sources are open", FILE_SOURCE_MAX_OPEN);
+
+err:
+    close(src->fd);
+    heap_caps_free(src->ring);
+    if (src->data) {
+        vSemaphoreDelete(src->data);
+    }
+    free(src);
+    return NULL;
+}
+
+size_t file_source_read(file_source_t *src, void *buf, size_t len)
+{
+    size_t done = 0;
+    bool waited = false;
+
+    while (done < len) {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        const uint32_t fill = src->head - src->tail;
+        const uint32_t tail = src->tail;
+        const bool at_end = (src->read_pos >= src->size);
+        xSemaphoreGive(s_lock);
+
+        if (fill == 0) {
+            if (at_end) {
+                break;
+            }
+            // Empty before the end: the reader task fell behind, unless it is still on the first fill
+            if (!waited && src->primed) {
+                src->stats.underruns++;
+                waited = true;
+            }
+            xSemaphoreGive(s_wake);
+            const int64_t start_us = esp_timer_get_time();
+            const bool ok = xSemaphoreTake(src->data, pdMS_TO_TICKS(FILE_SOURCE_READ_TIMEOUT_MS)) == pdTRUE;
+            const uint32_t wait_us = esp_timer_get_time() - start_us;
+            src->stats.wait_us_total += wait_us;
+            if (wait_us > src->stats.wait_us_max) {
+                src->stats.wait_us_max = wait_us;
+            }
+            if (!ok) {
+                ESP_LOGW(TAG, "Read timed out at %ld", src->pos);
+                break;
+            }
+            continue;
+        }
+
+        // Only this reader moves tail, and the reader task writes past head, so copy unlocked
+        uint32_t n = src->ring_size - (tail & (src->ring_size - 1));
+        n = (n < fill) ? n : fill;
+        n = (n < len - done) ? n : len - done;
+        memcpy((uint8_t *)buf + done, &src->ring[tail & (src->ring_size - 1)], n);
+        done += n;
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        src->tail += n;
+        src->pos += n;
+        const uint32_t left = src->head - src->tail;
+        if (src->primed && left < src->stats.min_fill) {
+            src->stats.min_fill = left;
+        }
+        const bool wake = (left < src->low_watermark && !src->refilling && src->read_pos < src->size);
+        xSemaphoreGive(s_lock);
+        if (wake) {
+            xSemaphoreGive(s_wake);
+        }
+    }
+
+    src->stats.bytes_served += done;
+    return done;
+}
+
+long file_source_seek(file_source_t *src, long offset, int whence)
+{
+    long target;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    switch (whence) {
+    case SEEK_SET:
+        target = offset;
+        break;
+    case SEEK_CUR:
+        target = src->pos + offset;
+        break;
+    case SEEK_END:
+        target = src->size + offset;
+        break;
+    default:
+        target = -1;
+        break;
+    }
+    if (target < 0 || target > src->size) {
+        xSemaphoreGive(s_lock);
+        return -1;
+    }
+
+    // Ring bytes behind tail keep their data until the reader task writes over them, a chunk
+    // may be on its way into the space past head, which overlaps the oldest chunk_size bytes
+    const uint32_t fill = src->head - src->tail;
+    const uint32_t oldest = (src->head + src->chunk_size > src->ring_size) ? src->head + src->chunk_size - src->ring_size : 0;
+    const uint32_t kept = (src->tail > oldest) ? src->tail - oldest : 0;
+    if (src->skip == 0 && target >= src->pos - (long)kept && target <= src->pos + (long)fill) {
+        // Still in the ring, move tail forward or back
+        src->tail += (uint32_t)(target - src->pos);
+    } else {
+        // Restart at the chunk holding the target, a chunk in flight is dropped by gen
+        src->gen++;
+        src->head = 0;
+        src->tail = 0;
+        src->read_pos = target - target % src->chunk_size;
+        src->skip = target - src->read_pos;
+        src->refilling = false;
+        src->primed = false;
+        src->stats.seeks++;
+    }
+    src->pos = target;
+    xSemaphoreGive(s_lock);
+
+    // Drop a wake-up left by a chunk of the old position, then start the refill
+    xSemaphoreTake(src->data, 0);
+    xSemaphoreGive(s_wake);
+    return target;
+}
+
+long file_source_tell(file_source_t *src)
+{
+    return src->pos;
+}
+
+long file_source_size(file_source_t *src)
+{
+    return src->size;
+}
+
+void file_source_close(file_source_t *src)
+{
+    if (!src) {
+        return;
+    }
+
+    // Take the source out and wait for a chunk being read for it
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int i = 0; i < FILE_SOURCE_MAX_OPEN; i++) {
+        if (s_sources[i] == src) {
+            s_sources[i] = NULL;
+        }
+    }
+    while (s_busy == src) {
+        xSemaphoreGive(s_lock);
+        vTaskDelay(pdMS_TO_TICKS(1));
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+    }
+    xSemaphoreGive(s_lock);
+
+    if (src->stats.underruns) {
+        file_source_log_stats(src);
+    }
+    close(src->fd);
+    heap_caps_free(src->ring);
+    vSemaphoreDelete(src->data);
+    free(src);
+}
+
+/**************************************************************************************************
+ *
+ * stdio Function
+ *
+ **************************************************************************************************/
+
+static int stdio_read(void *cookie, char *buf, int len)
+{
+    return file_source_read((file_source_t *)cookie, buf, len);
+}
+
+static fpos_t stdio_seek(void *cookie, fpos_t offset, int whence)
+{
+    return file_source_seek((file_source_t *)cookie, offset, whence);
+}
+
+static int stdio_close(void *cookie)
+{
+    file_source_close((file_source_t *)cookie);
+    return 0;
+}
+
+FILE *file_source_fopen(const char *path)
+{
+    file_source_t *src = file_source_open(path);
+    FILE *fp;
+
+    if (!src) {
+        return NULL;
+    }
+    fp = funopen(src, stdio_read, NULL, stdio_seek, stdio_close);
+    if (!fp) {
+        file_source_close(src);
+        return NULL;
+    }
+    // The ring is the buffer, stdio would only add a copy
+    setvbuf(fp, NULL, _IONBF, 0);
+    return fp;
+}
+
+void file_source_get_stats(file_source_t *src, file_source_stats_t *stats)
+{
+    *stats = src->stats;
+}
+
+void file_source_log_stats(file_source_t *src)
+{
+    const file_source_stats_t *s = &src->stats;
+
+    ESP_LOGI(TAG, "%" PRIu32 " chunks, %" PRIu32 " bytes read, %" PRIu32 " served, %" PRIu32 " refills, %" PRIu32 " seeks",
+             s->chunks, s->bytes_read, s->bytes_served, s->refills, s->seeks);
+    ESP_LOGI(TAG, "%" PRIu32 " underruns, waited %" PRIu32 " us (max %" PRIu32 " us), slowest chunk %" PRIu32 " us, lowest fill %" PRIu32,
+             s->underruns, s->wait_us_total, s->wait_us_max, s->chunk_us_max, s->min_fill);
+}
@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * | File         :   file_source.h
+ * | Author       :   Waveshare team
+ * | Function     :   Read-ahead file source for SD card readers
+ * | Info         :
+ * |                 One reader task fills a PSRAM ring per open file in
+ * |                 large chunks at chunk-aligned offsets, so the audio
+ * |                 decoder and the image loaders read from memory and
+ * |                 SD access from several users is serialized.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#ifndef __FILE_SOURCE_H
+#define __FILE_SOURCE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+/**
+ * File source parameters, can be adjusted by users
+ *
+ */
+#define FILE_SOURCE_MAX_OPEN            (6)             // Files open at once: four for the player, LVGL_PORT_FS_MAX_OPEN for LVGL
+#define FILE_SOURCE_CHUNK_SIZE          (32 * 1024)     // Bytes per SD read, reads start at multiples of it
+#define FILE_SOURCE_RING_SIZE           (256 * 1024)    // PSRAM ring per file, a multiple of FILE_SOURCE_CHUNK_SIZE
+#define FILE_SOURCE_LOW_WATERMARK       (FILE_SOURCE_RING_SIZE / 2) // A ring below this level is refilled until full, scaled for other ring sizes
+#define FILE_SOURCE_MIN_CHUNK_SIZE      (512)           // Smallest SD read, rings given to file_source_open_ring() hold at least two
+#define FILE_SOURCE_READ_TIMEOUT_MS     (1000)          // Longest wait of a read for the reader task
+#define FILE_SOURCE_TASK_PRIORITY       (6)             // Above the audio player, SD reads are short and rare
+#define FILE_SOURCE_TASK_STACK_SIZE     (3 * 1024)
+#define FILE_SOURCE_TASK_CORE           (0)             // Away from LVGL_PORT_TASK_CORE
+
+typedef struct file_source file_source_t;
+
+/**
+ * @brief File source statistics
+ */
+typedef struct {
+    uint32_t chunks;                /*!< SD reads done by the reader task */
+    uint32_t bytes_read;            /*!< Bytes read from the SD card */
+    uint32_t bytes_served;          /*!< Bytes handed to the reader of the file */
+    uint32_t refills;               /*!< Times the ring fell below the low watermark */
+    uint32_t seeks;                 /*!< Seeks outside the data held in the ring, each drops the ring */
+    uint32_t underruns;             /*!< Reads that found the ring empty before the end of the file */
+    uint32_t wait_us_total;         /*!< Time reads spent waiting for the reader task */
+    uint32_t wait_us_max;
+    uint32_t chunk_us_max;          /*!< Slowest SD read of one chunk */
+    uint32_t min_fill;              /*!< Lowest ring level seen after the first refill */
+} file_source_stats_t;
+
+/**
+ * @brief Open a file and start reading it ahead
+ *
+ * @param path Path of the file
+ *
+ * @return The source, NULL if the file cannot be opened, all slots are taken or memory is short
+ */
+file_source_t *file_source_open(const char *path);
+
+/**
+ * @brief Open a file with a ring of the given size
+ *
+ * For files read once or in small pieces, such as images, where a FILE_SOURCE_RING_SIZE
+ * ring and FILE_SOURCE_CHUNK_SIZE reads would cost more memory and time than they save.
+ * SD reads are FILE_SOURCE_CHUNK_SIZE or half the ring, whichever is smaller.
+ *
+ * @param path Path of the file
+ * @param ring_size Ring size in bytes, a power of two of at least 2 * FILE_SOURCE_MIN_CHUNK_SIZE
+ *
+ * @return The source, NULL if the file cannot be opened, all slots are taken, memory is short or the size is wrong
+ */
+file_source_t *file_source_open_ring(const char *path, uint32_t ring_size);
+
+/**
+ * @brief Read from a source
+ *
+ * Copies from the ring and waits for the reader task only when the ring is empty.
+ *
+ * @param src The source
+ * @param buf Output buffer
+ * @param len Bytes wanted
+ *
+ * @return Bytes read, less than len only at the end of the file or after FILE_SOURCE_READ_TIMEOUT_MS
+ */
+size_t file_source_read(file_source_t *src, void *buf, size_t len);
+
+/**
+ * @brief Move the read position
+ *
+ * Seeks to data still in the ring cost nothing: forward into what is read ahead, or
+ * back into what was read but not yet written over, up to about the ring size less one
+ * chunk. Others drop the ring and refill it from the chunk holding the new position.
+ *
+ * @param src The source
+ * @param offset Offset
+ * @param whence SEEK_SET, SEEK_CUR or SEEK_END
+ *
+ * @return The new position, -1 if it is outside the file
+ */
+long file_source_seek(file_source_t *src, long offset, int whence);
+
+/**
+ * @brief Get the read position
+ *
+ * @param src The source
+ * @return The position
+ */
+long file_source_tell(file_source_t *src);
+
+/**
+ * @brief Get the file size
+ *
+ * @param src The source
+ * @return The size in bytes
+ */
+long file_source_size(file_source_t *src);
+
+/**
+ * @brief Close a source, its statistics are logged if it ran dry
+ *
+ * @param src The source
+ */
+void file_source_close(file_source_t *src);
+
+/**
+ * @brief Open a file as a read-only FILE backed by a file source
+ *
+ * For code written against stdio, such as the audio player. fread(), fseek(), ftell()
+ * and fclose() work as usual.
+ *
+ * The player holds up to four: the playing track, the queued one, the queued track it
+ * replaces until the swap closes it, and a track started with speaker_player_play_file()
+ * before the player drops the old stream.
+ *
+ * @param path Path of the file
+ *
+ * @return The FILE, NULL on failure
+ */
+FILE *file_source_fopen(const char *path);
+
+/**
+ * @brief Get the statistics of a source
+ *
+ * @param src The source
+ * @param stats Output statistics
+ */
+void file_source_get_stats(file_source_t *src, file_source_stats_t *stats);
+
+/**
+ * @brief Log the statistics of a source
+ *
+ * @param src The source
+ */
+void file_source_log_stats(file_source_t *src);
+
+#endif
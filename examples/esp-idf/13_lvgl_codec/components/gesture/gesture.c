@@ -0,0 +1,406 @@
+/*****************************************************************************
+ * | File         :   gesture.c
+ * | Author       :   Waveshare team
+ * | Function     :   Multi-touch gesture recognizer
+ * | Info         :
+ * |                 Contact tracking and gesture state machine.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gesture.h"
+
+#define GESTURE_PI              (3.14159265f)
+
+/* Recognizer modes */
+#define GESTURE_MODE_IDLE       (0)     // No finger down
+#define GESTURE_MODE_SINGLE     (1)     // One finger drives long press / swipe
+#define GESTURE_MODE_MULTI      (2)     // Two fingers drive pinch / rotate / two-finger swipe
+#define GESTURE_MODE_DONE       (3)     // Gesture ended, wait until all fingers are lifted
+
+static gesture_contact_t *gesture_find(gesture_t *g, uint8_t id)
+{
+    for (int i = 0; i < GESTURE_MAX_CONTACTS; i++) {
+        if (g->contacts[i].active && g->contacts[i].id == id) {
+            return &g->contacts[i];
+        }
+    }
+    return NULL;
+}
+
+/* Count the contacts down, without the ones lifted in this frame */
+static uint8_t gesture_active_cnt(const gesture_t *g, const bool *ended)
+{
+    uint8_t cnt = 0;
+    for (int i = 0; i < GESTURE_MAX_CONTACTS; i++) {
+        cnt += (g->contacts[i].active && !(ended && ended[i])) ? 1 : 0;
+    }
+    return cnt;
+}
+
+static gesture_dir_t gesture_dir(int32_t dx, int32_t dy)
+{
+    if (dx == 0 && dy == 0) {
+        return GESTURE_DIR_NONE;
+    }
+    if (abs(dx) >= abs(dy)) {
+        return (dx < 0) ? GESTURE_DIR_LEFT : GESTURE_DIR_RIGHT;
+    }
+    return (dy < 0) ? GESTURE_DIR_UP : GESTURE_DIR_DOWN;
+}
+
+static gesture_event_t *gesture_emit(gesture_event_t *events, uint8_t *n, uint8_t max,
+                                     gesture_type_t type, gesture_phase_t phase, int64_t timestamp_us)
+{
+    if (*n >= max) {
+        return NULL;
+    }
+    gesture_event_t *e = &events[(*n)++];
+    memset(e, 0, sizeof(*e));
+    e->type = type;
+    e->phase = phase;
+    e->scale = 1000;
+    e->timestamp_us = timestamp_us;
+    return e;
+}
+
+/* Match the new points to the tracked contacts, closest pairs first */
+static void gesture_track(gesture_t *g, const gesture_point_t *points, uint8_t cnt, int64_t timestamp_us,
+                          bool *ended)
+{
+    bool point_used[GESTURE_MAX_CONTACTS] = { false };
+    bool contact_used[GESTURE_MAX_CONTACTS] = { false };
+    const int32_t radius2 = (int32_t)g->config.match_radius * g->config.match_radius;
+
+    cnt = (cnt > GESTURE_MAX_CONTACTS) ? GESTURE_MAX_CONTACTS : cnt;
+
+    while (1) {
+        int32_t best = radius2 + 1;
+        int best_c = -1, best_p = -1;
+        for (int c = 0; c < GESTURE_MAX_CONTACTS; c++) {
+            if (!g->contacts[c].active || contact_used[c]) {
+                continue;
+            }
+            for (int p = 0; p < cnt; p++) {
+                if (point_used[p]) {
+                    continue;
+                }
+                int32_t dx = (int32_t)points[p].x - g->contacts[c].x;
+                int32_t dy = (int32_t)points[p].y - g->contacts[c].y;
+                int32_t d2 = dx * dx + dy * dy;
+                if (d2 < best) {
+                    best = d2;
+                    best_c = c;
+                    best_p = p;
+                }
+            }
+        }
+        if (best_c < 0) {
+            break;
+        }
+
+        /* Update the matched contact, velocity is smoothed over two frames */
+        gesture_contact_t *ct = &g->contacts[best_c];
+        int64_t dt = timestamp_us - ct->last_us;
+        if (dt > 0) {
+            float vx = ((int32_t)points[best_p].x - ct->x) * 1e6f / dt;
+            float vy = ((int32_t)points[best_p].y - ct->y) * 1e6f / dt;
+            ct->vx = (ct->vx + vx) * 0.5f;
+            ct->vy = (ct->vy + vy) * 0.5f;
+        }
+        ct->x = points[best_p].x;
+        ct->y = points[best_p].y;
+        ct->strength = points[best_p].strength;
+        ct->last_us = timestamp_us;
+        contact_used[best_c] = true;
+        point_used[best_p] = true;
+    }
+
+    /* Contacts without a point were lifted */
+    for (int c = 0; c < GESTURE_MAX_CONTACTS; c++) {
+        ended[c] = g->contacts[c].active && !contact_used[c];
+    }
+
+    /* Points without a contact are new fingers */
+    for (int p = 0; p < cnt; p++) {
+        if (point_used[p]) {
+            continue;
+        }
+        for (int c = 0; c < GESTURE_MAX_CONTACTS; c++) {
+            if (!g->contacts[c].active && !ended[c]) {
+                gesture_contact_t *ct = &g->contacts[c];
+                memset(ct, 0, sizeof(*ct));
+                ct->active = true;
+                ct->id = g->next_id++;
+                ct->x = ct->start_x = points[p].x;
+                ct->y = ct->start_y = points[p].y;
+                ct->strength = points[p].strength;
+                ct->start_us = ct->last_us = timestamp_us;
+                break;
+            }
+        }
+    }
+}
+
+static void gesture_two_finger_state(const gesture_contact_t *a, const gesture_contact_t *b,
+                                     float *dist, float *angle, int16_t *cx, int16_t *cy)
+{
+    float dx = (float)b->x - a->x;
+    float dy = (float)b->y - a->y;
+    *dist = sqrtf(dx * dx + dy * dy);
+    *angle = atan2f(dy, dx);
+    *cx = (a->x + b->x) / 2;
+    *cy = (a->y + b->y) / 2;
+}
+
+/* Fill the fields shared by all two finger events */
+static void gesture_fill_two(gesture_t *g, gesture_event_t *e, const gesture_contact_t *a, const gesture_contact_t *b,
+                             int32_t scale, int32_t rotation, float dt_s)
+{
+    e->fingers = 2;
+    e->x = (a->x + b->x) / 2;
+    e->y = (a->y + b->y) / 2;
+    e->dx = e->x - g->cx0;
+    e->dy = e->y - g->cy0;
+    e->vx = (int32_t)((a->vx + b->vx) * 0.5f);
+    e->vy = (int32_t)((a->vy + b->vy) * 0.5f);
+    e->scale = scale;
+    e->rotation = rotation;
+    if (dt_s > 0) {
+        e->scale_speed = (int32_t)((scale - g->last_scale) / dt_s);
+        e->rotation_speed = (int32_t)((rotation - g->last_rotation) / dt_s);
+    }
+}
+
+static void gesture_multi_begin(gesture_t *g, const bool *ended)
+{
+    const gesture_contact_t *first = NULL, *second = NULL;
+
+    /* The two oldest fingers drive the gesture */
+    for (int i = 0; i < GESTURE_MAX_CONTACTS; i++) {
+        const gesture_contact_t *ct = &g->contacts[i];
+        if (!ct->active || ended[i]) {
+            continue;
+        }
+        if (first == NULL || ct->start_us < first->start_us) {
+            second = first;
+            first = ct;
+        } else if (second == NULL || ct->start_us < second->start_us) {
+            second = ct;
+        }
+    }
+
+    g->ids[0] = first->id;
+    g->ids[1] = second->id;
+    gesture_two_finger_state(first, second, &g->dist0, &g->angle0, &g->cx0, &g->cy0);
+    if (g->dist0 < 1.0f) {
+        g->dist0 = 1.0f;
+    }
+    g->pinch = false;
+    g->rotate = false;
+    g->last_scale = 1000;
+    g->last_rotation = 0;
+    g->mode = GESTURE_MODE_MULTI;
+}
+
+void gesture_init(gesture_t *g, const gesture_config_t *config)
+{
+    const gesture_config_t def = GESTURE_CONFIG_DEFAULT();
+
+    memset(g, 0, sizeof(*g));
+    g->config = config ? *config : def;
+    g->mode = GESTURE_MODE_IDLE;
+}
+
+uint8_t gesture_process(gesture_t *g, const gesture_point_t *points, uint8_t cnt, int64_t timestamp_us,
+                        gesture_event_t *events, uint8_t max_events)
+{
+    bool ended[GESTURE_MAX_CONTACTS];
+    uint8_t n = 0;
+    gesture_event_t *e;
+    float dt_s = (g->last_us > 0 && timestamp_us > g->last_us) ? (timestamp_us - g->last_us) / 1e6f : 0;
+
+    gesture_track(g, points, cnt, timestamp_us, ended);
+
+    switch (g->mode) {
+    case GESTURE_MODE_IDLE:
+        if (gesture_active_cnt(g, ended) == 1) {
+            const gesture_contact_t *ct = gesture_get_primary(g);
+            g->ids[0] = ct->id;
+            g->moved = false;
+            g->long_press = false;
+            g->mode = GESTURE_MODE_SINGLE;
+        } else if (gesture_active_cnt(g, ended) >= 2) {
+            gesture_multi_begin(g, ended);
+        }
+        break;
+
+    case GESTURE_MODE_SINGLE: {
+        gesture_contact_t *ct = NULL;
+        int slot = -1;
+        for (int i = 0; i < GESTURE_MAX_CONTACTS; i++) {
+            if (g->contacts[i].active && g->contacts[i].id == g->ids[0]) {
+                ct = &g->contacts[i];
+                slot = i;
+            }
+        }
+        if (ct == NULL) {
+            g->mode = GESTURE_MODE_DONE;
+            break;
+        }
+        int32_t dx = ct->x - ct->start_x;
+        int32_t dy = ct->y - ct->start_y;
+
+        if (ended[slot]) {
+            if (g->long_press) {
+                if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_LONG_PRESS, GESTURE_PHASE_END, timestamp_us))) {
+                    e->fingers = 1;
+                    e->x = ct->x;
+                    e->y = ct->y;
+                    e->dx = dx;
+                    e->dy = dy;
+                }
+            } else {
+                int32_t dist2 = dx * dx + dy * dy;
+                float speed = sqrtf(ct->vx * ct->vx + ct->vy * ct->vy);
+                if (dist2 >= (int32_t)g->config.swipe_min_dist * g->config.swipe_min_dist &&
+                        speed >= g->config.swipe_min_speed) {
+                    if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_SWIPE, GESTURE_PHASE_END, timestamp_us))) {
+                        e->fingers = 1;
+                        e->dir = gesture_dir(dx, dy);
+                        e->x = ct->x;
+                        e->y = ct->y;
+                        e->dx = dx;
+                        e->dy = dy;
+                        e->vx = (int32_t)ct->vx;
+                        e->vy = (int32_t)ct->vy;
+                    }
+                }
+            }
+            g->mode = GESTURE_MODE_DONE;
+            break;
+        }
+
+        /* A second finger turns it into a two finger gesture */
+        if (gesture_active_cnt(g, ended) >= 2 && !g->long_press) {
+            gesture_multi_begin(g, ended);
+            break;
+        }
+
+        if (dx * dx + dy * dy > (int32_t)g->config.slop * g->config.slop) {
+            g->moved = true;
+        }
+        if (!g->moved && !g->long_press && timestamp_us - ct->start_us >= (int64_t)g->config.long_press_ms * 1000) {
+            g->long_press = true;
+            if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_LONG_PRESS, GESTURE_PHASE_BEGIN, timestamp_us))) {
+                e->fingers = 1;
+                e->x = ct->x;
+                e->y = ct->y;
+            }
+        }
+        break;
+    }
+
+    case GESTURE_MODE_MULTI: {
+        gesture_contact_t *a = gesture_find(g, g->ids[0]);
+        gesture_contact_t *b = gesture_find(g, g->ids[1]);
+        int sa = a ? (int)(a - g->contacts) : -1;
+        int sb = b ? (int)(b - g->contacts) : -1;
+        if (a == NULL || b == NULL) {
+            g->mode = GESTURE_MODE_DONE;
+            break;
+        }
+
+        float dist, angle;
+        int16_t cx, cy;
+        gesture_two_finger_state(a, b, &dist, &angle, &cx, &cy);
+        float da = angle - g->angle0;
+        while (da > GESTURE_PI) {
+            da -= 2 * GESTURE_PI;
+        }
+        while (da < -GESTURE_PI) {
+            da += 2 * GESTURE_PI;
+        }
+        int32_t scale = (int32_t)(dist * 1000.0f / g->dist0);
+        int32_t rotation = (int32_t)(da * 18000.0f / GESTURE_PI);
+        bool lifted = ended[sa] || ended[sb];
+
+        if (!g->pinch && abs(scale - 1000) >= g->config.pinch_threshold) {
+            g->pinch = true;
+            if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_PINCH, GESTURE_PHASE_BEGIN, timestamp_us))) {
+                gesture_fill_two(g, e, a, b, scale, rotation, dt_s);
+            }
+        } else if (g->pinch && (scale != g->last_scale || lifted)) {
+            if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_PINCH, lifted ? GESTURE_PHASE_END : GESTURE_PHASE_UPDATE, timestamp_us))) {
+                gesture_fill_two(g, e, a, b, scale, rotation, dt_s);
+            }
+        }
+
+        if (!g->rotate && abs(rotation) >= g->config.rotate_threshold) {
+            g->rotate = true;
+            if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_ROTATE, GESTURE_PHASE_BEGIN, timestamp_us))) {
+                gesture_fill_two(g, e, a, b, scale, rotation, dt_s);
+            }
+        } else if (g->rotate && (rotation != g->last_rotation || lifted)) {
+            if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_ROTATE, lifted ? GESTURE_PHASE_END : GESTURE_PHASE_UPDATE, timestamp_us))) {
+                gesture_fill_two(g, e, a, b, scale, rotation, dt_s);
+            }
+        }
+
+        if (lifted) {
+            /* Both fingers travelled together without pinching or turning */
+            if (!g->pinch && !g->rotate) {
+                int32_t dx = cx - g->cx0;
+                int32_t dy = cy - g->cy0;
+                float vx = (a->vx + b->vx) * 0.5f;
+                float vy = (a->vy + b->vy) * 0.5f;
+                if (dx * dx + dy * dy >= (int32_t)g->config.swipe_min_dist * g->config.swipe_min_dist &&
+                        sqrtf(vx * vx + vy * vy) >= g->config.swipe_min_speed) {
+                    if ((e = gesture_emit(events, &n, max_events, GESTURE_TYPE_TWO_FINGER_SWIPE, GESTURE_PHASE_END, timestamp_us))) {
+                        gesture_fill_two(g, e, a, b, scale, rotation, dt_s);
+                        e->dir = gesture_dir(dx, dy);
+                    }
+                }
+            }
+            g->mode = GESTURE_MODE_DONE;
+        }
+        g->last_scale = scale;
+        g->last_rotation = rotation;
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    /* Retire the lifted contacts */
+    for (int c = 0; c < GESTURE_MAX_CONTACTS; c++) {
+        if (ended[c]) {
+            g->contacts[c].active = false;
+        }
+    }
+    if (gesture_active_cnt(g, NULL) == 0) {
+        g->mode = GESTURE_MODE_IDLE;
+    }
+    g->last_us = timestamp_us;
+
+    return n;
+}
+
+const gesture_contact_t *gesture_get_primary(const gesture_t *g)
+{
+    const gesture_contact_t *primary = NULL;
+
+    for (int i = 0; i < GESTURE_MAX_CONTACTS; i++) {
+        const gesture_contact_t *ct = &g->contacts[i];
+        if (ct->active && (primary == NULL || ct->start_us < primary->start_us)) {
+            primary = ct;
+        }
+    }
+    return primary;
+}
@@ -0,0 +1,182 @@
+/*****************************************************************************
+ * | File         :   gesture.h
+ * | Author       :   Waveshare team
+ * | Function     :   Multi-touch gesture recognizer
+ * | Info         :
+ * |                 Tracks up to five contacts with stable ids and reports
+ * |                 long press, swipe, pinch, rotate and two-finger swipe.
+ * |                 Pure C without allocations, so it can be fed from the
+ * |                 touch reader at the full report rate.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#ifndef __GESTURE_H
+#define __GESTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GESTURE_MAX_CONTACTS    (5)     // Maximum number of tracked contacts, matches the GT911
+#define GESTURE_MAX_EVENTS      (4)     // Maximum number of events produced by one frame
+
+/**
+ * @brief Gesture types
+ */
+typedef enum {
+    GESTURE_TYPE_LONG_PRESS = 0,    /*!< One finger held still, BEGIN when recognized, END on release */
+    GESTURE_TYPE_SWIPE,             /*!< One finger flick, single shot reported with END */
+    GESTURE_TYPE_PINCH,             /*!< Two fingers moving apart or together, see `scale` */
+    GESTURE_TYPE_ROTATE,            /*!< Two fingers turning around their center, see `rotation` */
+    GESTURE_TYPE_TWO_FINGER_SWIPE,  /*!< Two fingers flicked together, single shot reported with END */
+} gesture_type_t;
+
+/**
+ * @brief Gesture phases
+ */
+typedef enum {
+    GESTURE_PHASE_BEGIN = 0,        /*!< The gesture is recognized */
+    GESTURE_PHASE_UPDATE,           /*!< The gesture continues with new values */
+    GESTURE_PHASE_END,              /*!< The fingers involved were lifted */
+} gesture_phase_t;
+
+/**
+ * @brief Direction of swipes
+ */
+typedef enum {
+    GESTURE_DIR_NONE = 0,
+    GESTURE_DIR_LEFT,
+    GESTURE_DIR_RIGHT,
+    GESTURE_DIR_UP,
+    GESTURE_DIR_DOWN,
+} gesture_dir_t;
+
+/**
+ * @brief Raw touch point, as reported by the controller
+ */
+typedef struct {
+    uint16_t x;             /*!< X coordinate */
+    uint16_t y;             /*!< Y coordinate */
+    uint16_t strength;      /*!< Touch strength, 0 if unknown */
+} gesture_point_t;
+
+/**
+ * @brief Gesture event
+ */
+typedef struct {
+    gesture_type_t type;        /*!< Gesture type */
+    gesture_phase_t phase;      /*!< Gesture phase */
+    gesture_dir_t dir;          /*!< Direction, swipes only */
+    uint8_t fingers;            /*!< Number of fingers involved */
+    int16_t x;                  /*!< X of the finger, or of the center between two fingers */
+    int16_t y;                  /*!< Y of the finger, or of the center between two fingers */
+    int16_t dx;                 /*!< X translation since the fingers went down */
+    int16_t dy;                 /*!< Y translation since the fingers went down */
+    int32_t vx;                 /*!< X velocity in px/s */
+    int32_t vy;                 /*!< Y velocity in px/s */
+    int32_t scale;              /*!< Distance ratio between the two fingers in permille, 1000 = unchanged */
+    int32_t scale_speed;        /*!< Scale change in permille/s */
+    int32_t rotation;           /*!< Rotation in centidegrees, positive is clockwise on screen */
+    int32_t rotation_speed;     /*!< Rotation speed in centidegrees/s */
+    int64_t timestamp_us;       /*!< Timestamp of the frame which produced the event */
+} gesture_event_t;
+
+/**
+ * @brief Recognizer thresholds
+ */
+typedef struct {
+    uint16_t match_radius;      /*!< Maximum jump of a contact between two frames, px */
+    uint16_t slop;              /*!< Movement below this is considered still, px */
+    uint16_t long_press_ms;     /*!< Hold time of a long press, ms */
+    uint16_t swipe_min_dist;    /*!< Minimum travel of a swipe, px */
+    uint16_t swipe_min_speed;   /*!< Minimum release speed of a swipe, px/s */
+    uint16_t pinch_threshold;   /*!< Scale change which starts a pinch, permille */
+    uint16_t rotate_threshold;  /*!< Rotation which starts a rotate, centidegrees */
+} gesture_config_t;
+
+#define GESTURE_CONFIG_DEFAULT()        \
+    {                                   \
+        .match_radius = 120,            \
+        .slop = 12,                     \
+        .long_press_ms = 500,           \
+        .swipe_min_dist = 60,           \
+        .swipe_min_speed = 300,         \
+        .pinch_threshold = 80,          \
+        .rotate_threshold = 1000,       \
+    }
+
+/**
+ * @brief Tracked contact
+ */
+typedef struct {
+    bool active;            /*!< The contact is down */
+    uint8_t id;             /*!< Stable id, kept while the finger stays down */
+    int16_t x;              /*!< Current X */
+    int16_t y;              /*!< Current Y */
+    int16_t start_x;        /*!< X when the finger went down */
+    int16_t start_y;        /*!< Y when the finger went down */
+    uint16_t strength;      /*!< Current strength */
+    float vx;               /*!< Smoothed X velocity, px/s */
+    float vy;               /*!< Smoothed Y velocity, px/s */
+    int64_t start_us;       /*!< Time the finger went down */
+    int64_t last_us;        /*!< Time of the last update */
+} gesture_contact_t;
+
+/**
+ * @brief Recognizer state, allocated by the caller
+ */
+typedef struct {
+    gesture_config_t config;                            /*!< Thresholds */
+    gesture_contact_t contacts[GESTURE_MAX_CONTACTS];   /*!< Contact slots */
+    uint8_t next_id;                                    /*!< Id given to the next new contact */
+    uint8_t mode;                                       /*!< Internal state machine */
+    uint8_t ids[2];                                     /*!< Ids of the fingers driving the current gesture */
+    bool moved;                                         /*!< The single finger left the slop */
+    bool long_press;                                    /*!< A long press is active */
+    bool pinch;                                         /*!< A pinch is active */
+    bool rotate;                                        /*!< A rotate is active */
+    float dist0;                                        /*!< Two finger distance at the start */
+    float angle0;                                       /*!< Two finger angle at the start, rad */
+    int16_t cx0;                                        /*!< Two finger center X at the start */
+    int16_t cy0;                                        /*!< Two finger center Y at the start */
+    int32_t last_scale;                                 /*!< Scale of the previous frame */
+    int32_t last_rotation;                              /*!< Rotation of the previous frame */
+    int64_t last_us;                                    /*!< Time of the previous frame */
+} gesture_t;
+
+/**
+ * @brief Initialize the recognizer
+ *
+ * @param g Recognizer state
+ * @param config Thresholds, NULL to use GESTURE_CONFIG_DEFAULT()
+ */
+void gesture_init(gesture_t *g, const gesture_config_t *config);
+
+/**
+ * @brief Feed one frame of raw points
+ *
+ * A frame with `cnt == 0` reports that all fingers were lifted.
+ *
+ * @param g Recognizer state
+ * @param points Points of the frame, in controller order
+ * @param cnt Number of points
+ * @param timestamp_us Time of the frame
+ * @param events Output events
+ * @param max_events Size of `events`, GESTURE_MAX_EVENTS is always enough
+ * @return Number of events written
+ */
+uint8_t gesture_process(gesture_t *g, const gesture_point_t *points, uint8_t cnt, int64_t timestamp_us,
+                        gesture_event_t *events, uint8_t max_events);
+
+/**
+ * @brief Get the oldest contact still down, to drive a single pointer
+ *
+ * @param g Recognizer state
+ * @return The contact, or NULL if no finger is down
+ */
+const gesture_contact_t *gesture_get_primary(const gesture_t *g);
+
+#endif
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * | File         :   test_gesture.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the gesture recognizer
+ * | Info         :
+ * |                 Replays a touch trace through gesture_process() and
+ * |                 compares the gestures with the `expect` lines of the
+ * |                 trace. Runs of UPDATE events count as one.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+/*
+ * Trace format, one line each:
+ *   # comment
+ *   expect <TYPE> <PHASE> [DIR]
+ *   frame <timestamp_us> <cnt> [<x> <y> <strength>]...
+ * The frame lines are what lvgl_port logs with LVGL_PORT_GESTURE_TRACE, any
+ * text before "frame " (the log prefix) is skipped.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "gesture.h"
+
+#define TEST_MAX_GESTURES   (64)    // Gestures kept per trace, after merging the updates
+#define TEST_NAME_LEN       (48)    // Length of "TYPE PHASE DIR"
+
+static const char *type_names[] = { "LONG_PRESS", "SWIPE", "PINCH", "ROTATE", "TWO_FINGER_SWIPE" };
+static const char *phase_names[] = { "BEGIN", "UPDATE", "END" };
+static const char *dir_names[] = { "", "LEFT", "RIGHT", "UP", "DOWN" };
+
+static void gesture_name(const gesture_event_t *e, char *name)
+{
+    snprintf(name, TEST_NAME_LEN, "%s %s%s%s", type_names[e->type], phase_names[e->phase],
+             e->dir != GESTURE_DIR_NONE ? " " : "", dir_names[e->dir]);
+}
+
+int main(int argc, char **argv)
+{
+    static char expected[TEST_MAX_GESTURES][TEST_NAME_LEN];
+    static char got[TEST_MAX_GESTURES][TEST_NAME_LEN];
+    int expected_cnt = 0, got_cnt = 0, frame_cnt = 0;
+    char line[512];
+    gesture_t g;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace>\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "r");
+    if (f == NULL) {
+        perror(argv[1]);
+        return 2;
+    }
+
+    gesture_init(&g, NULL);
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strncmp(line, "expect ", 7) == 0) {
+            if (expected_cnt < TEST_MAX_GESTURES) {
+                snprintf(expected[expected_cnt++], TEST_NAME_LEN, "%.*s", TEST_NAME_LEN - 1, line + 7);
+            }
+            continue;
+        }
+        char *p = strstr(line, "frame ");
+        if (line[0] == '#' || p == NULL) {
+            continue;
+        }
+
+        gesture_point_t points[GESTURE_MAX_CONTACTS];
+        gesture_event_t events[GESTURE_MAX_EVENTS];
+        int64_t timestamp_us;
+        int cnt, used;
+        p += 6;
+        if (sscanf(p, "%" SCNd64 " %d%n", &timestamp_us, &cnt, &used) != 2 || cnt < 0 || cnt > GESTURE_MAX_CONTACTS) {
+            fprintf(stderr, "bad frame: %s\n", line);
+            fclose(f);
+            return 2;
+        }
+        p += used;
+        for (int i = 0; i < cnt; i++) {
+            unsigned x, y, s;
+            if (sscanf(p, " %u %u %u%n", &x, &y, &s, &used) != 3) {
+                fprintf(stderr, "bad point: %s\n", line);
+                fclose(f);
+                return 2;
+            }
+            points[i] = (gesture_point_t){ .x = x, .y = y, .strength = s };
+            p += used;
+        }
+        frame_cnt++;
+
+        uint8_t n = gesture_process(&g, points, cnt, timestamp_us, events, GESTURE_MAX_EVENTS);
+        for (int i = 0; i < n; i++) {
+            char name[TEST_NAME_LEN];
+            gesture_name(&events[i], name);
+            if (events[i].phase == GESTURE_PHASE_UPDATE && got_cnt > 0 && strcmp(got[got_cnt - 1], name) == 0) {
+                continue; // Merge the updates of a continuing gesture
+            }
+            if (got_cnt < TEST_MAX_GESTURES) {
+                strcpy(got[got_cnt++], name);
+            }
+        }
+    }
+    fclose(f);
+
+    int ok = (got_cnt == expected_cnt);
+    for (int i = 0; ok && i < got_cnt; i++) {
+        ok = (strcmp(got[i], expected[i]) == 0);
+    }
+    printf("%s: %d frames, %d gestures\n", argv[1], frame_cnt, got_cnt);
+    if (!ok) {
+        printf("expected:\n");
+        for (int i = 0; i < expected_cnt; i++) {
+            printf("  %s\n", expected[i]);
+        }
+        printf("got:\n");
+        for (int i = 0; i < got_cnt; i++) {
+            printf("  %s\n", got[i]);
+        }
+    }
+    if (gesture_get_primary(&g) != NULL) {
+        printf("a contact is still down after the trace\n");
+        ok = 0;
+    }
+
+    return ok ? 0 : 1;
+}
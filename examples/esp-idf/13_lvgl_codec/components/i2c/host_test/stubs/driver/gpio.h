@@ -0,0 +1,13 @@
+/* Host stub of the ESP-IDF GPIO driver */
+#pragma once
+
+#include <stdint.h>
+
+typedef int gpio_num_t;
+typedef void (*gpio_isr_t)(void *arg);
+
+#define GPIO_NUM_6  (6)
+#define GPIO_NUM_8  (8)
+#define GPIO_NUM_9  (9)
+
+int gpio_get_level(gpio_num_t gpio_num);
@@ -0,0 +1,33 @@
+/* Host stub of the ESP-IDF I2C master driver, the test simulates the bus */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct i2c_master_bus_t *i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t *i2c_master_dev_handle_t;
+
+typedef struct {
+    int clk_source;
+    int i2c_port;
+    int scl_io_num;
+    int sda_io_num;
+    int glitch_ignore_cnt;
+} i2c_master_bus_config_t;
+
+typedef struct {
+    uint32_t scl_speed_hz;
+    uint16_t device_address;
+} i2c_device_config_t;
+
+#define I2C_CLK_SRC_DEFAULT (0)
+#define I2C_NUM_0           (0)
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *config, i2c_master_bus_handle_t *ret_bus);
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t *config, i2c_master_dev_handle_t *ret_dev);
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t bus);
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t *tx, size_t tx_len, int timeout_ms);
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t dev, uint8_t *rx, size_t rx_len, int timeout_ms);
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t dev, const uint8_t *tx, size_t tx_len,
+                                      uint8_t *rx, size_t rx_len, int timeout_ms);
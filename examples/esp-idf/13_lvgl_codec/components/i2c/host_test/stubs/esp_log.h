@@ -0,0 +1,12 @@
+/* Host stub of the ESP-IDF logging, prints to stdout */
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "esp_err.h"
+
+#define ESP_LOGE(tag, fmt, ...) printf("E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) printf("W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) printf("I %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) do { } while (0)
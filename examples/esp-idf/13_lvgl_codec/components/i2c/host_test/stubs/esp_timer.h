@@ -0,0 +1,6 @@
+/* Host stub of the ESP-IDF timer, the test drives the clock */
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
@@ -0,0 +1,6 @@
+/* Host stub of the FreeRTOS tasks, a delay advances the simulated clock */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+void vTaskDelay(TickType_t ticks);
@@ -0,0 +1,312 @@
+/*****************************************************************************
+ * | File         :   test_i2c.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the I2C retry and recovery policy
+ * | Info         :
+ * |                 Runs i2c.c on a simulated bus: a slave which NACKs,
+ * |                 one which holds SDA low until the bus is reset, and
+ * |                 one which keeps holding it. Checks the return values,
+ * |                 the attempts, the bus resets and the statistics.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "i2c.h"
+
+#define SIM_ATTEMPT_US  (200)   // Wire time of an attempt which gets an answer
+
+// Simulated bus and clock
+static struct {
+    int64_t now_us;             // Simulated time
+    int nack_left;              // Attempts still answered with a NACK
+    esp_err_t fail_once;        // Error returned by the next attempt, ESP_OK for none
+    bool sda_stuck;             // A slave holds SDA low, attempts time out
+    bool stuck_hard;            // A bus reset doesn't release SDA
+    int attempts;               // Transfer attempts
+    int resets;                 // Bus resets
+} sim;
+
+static int failures;
+
+#define CHECK(cond) do {                                                    \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/* Stubs of the driver, the scheduler and the OS */
+
+int64_t esp_timer_get_time(void)
+{
+    return sim.now_us;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    sim.now_us += (int64_t)ticks * 1000;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return (SemaphoreHandle_t)&sim;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    return pdTRUE;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    return (code == ESP_OK) ? "ESP_OK" : (code == ESP_ERR_TIMEOUT) ? "ESP_ERR_TIMEOUT" :
+           (code == ESP_FAIL) ? "ESP_FAIL" : "ESP_ERR";
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    return (gpio_num == EXAMPLE_I2C_MASTER_SDA && sim.sda_stuck) ? 0 : 1;
+}
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *config, i2c_master_bus_handle_t *ret_bus)
+{
+    *ret_bus = (i2c_master_bus_handle_t)&sim;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus, const i2c_device_config_t *config, i2c_master_dev_handle_t *ret_dev)
+{
+    static uint8_t handles[128];
+    *ret_dev = (i2c_master_dev_handle_t)&handles[config->device_address & 0x7f];
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t bus)
+{
+    sim.resets++;
+    sim.now_us += 100;  // 9 clocks and a stop
+    if (!sim.stuck_hard) {
+        sim.sda_stuck = false;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_attempt(int timeout_ms)
+{
+    sim.attempts++;
+    if (sim.sda_stuck) {
+        sim.now_us += (int64_t)timeout_ms * 1000;
+        return ESP_ERR_TIMEOUT;
+    }
+    sim.now_us += SIM_ATTEMPT_US;
+    if (sim.fail_once != ESP_OK) {
+        esp_err_t ret = sim.fail_once;
+        sim.fail_once = ESP_OK;
+        return ret;
+    }
+    if (sim.nack_left > 0) {
+        sim.nack_left--;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t *tx, size_t tx_len, int timeout_ms)
+{
+    return sim_attempt(timeout_ms);
+}
+
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t dev, uint8_t *rx, size_t rx_len, int timeout_ms)
+{
+    esp_err_t ret = sim_attempt(timeout_ms);
+    for (size_t i = 0; ret == ESP_OK && i < rx_len; i++) {
+        rx[i] = 0xa5;
+    }
+    return ret;
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t dev, const uint8_t *tx, size_t tx_len,
+                                      uint8_t *rx, size_t rx_len, int timeout_ms)
+{
+    return i2c_master_receive(dev, rx, rx_len, timeout_ms);
+}
+
+esp_err_t i2c_sched_init(void)
+{
+    return ESP_OK;
+}
+
+bool i2c_sched_is_running(void)
+{
+    return false;   // Transfers go straight to the driver
+}
+
+esp_err_t i2c_sched_register_device(i2c_master_dev_handle_t dev, uint8_t addr, const char *name, i2c_sched_prio_t prio)
+{
+    return ESP_OK;
+}
+
+esp_err_t i2c_sched_transfer(const i2c_sched_trans_t *trans)
+{
+    return ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t i2c_sched_call(i2c_sched_call_t call, void *arg)
+{
+    return ESP_ERR_INVALID_STATE;
+}
+
+/* Scenarios */
+
+static i2c_master_dev_handle_t add_device(uint8_t addr)
+{
+    i2c_master_dev_handle_t dev = NULL;
+    CHECK(DEV_I2C_Add_Device(addr, 0, &dev) == ESP_OK);
+    return dev;
+}
+
+static void sim_reset(void)
+{
+    int64_t now_us = sim.now_us;
+    sim = (typeof(sim)) { .now_us = now_us };
+}
+
+// A NACK is retried once and ends a short outage
+static void test_nack_once(void)
+{
+    i2c_master_dev_handle_t dev = add_device(0x10);
+    DEV_I2C_Stats st;
+
+    sim_reset();
+    sim.nack_left = 1;
+    CHECK(DEV_I2C_Write_Reg(dev, 0x01, 0x02) == ESP_OK);
+    CHECK(sim.attempts == 2);
+    CHECK(sim.resets == 0);
+    CHECK(DEV_I2C_Get_Stats(dev, &st, true) == ESP_OK);
+    CHECK(st.ok_cnt == 1 && st.err_cnt == 1 && st.retry_cnt == 1 && st.fail_cnt == 0 && st.recover_cnt == 0);
+    CHECK(st.last_err == ESP_FAIL);
+    CHECK(st.outage_cnt == 1);
+    CHECK(st.outage_us_last == EXAMPLE_I2C_RETRY_DELAY_MS * 1000 + SIM_ATTEMPT_US);
+}
+
+// SDA held low: two timeouts, the bus reset releases it, the third attempt succeeds
+static void test_stuck_recovered(void)
+{
+    i2c_master_dev_handle_t dev = add_device(0x11);
+    DEV_I2C_Stats st;
+    uint8_t buf[2] = { 0 };
+
+    sim_reset();
+    sim.sda_stuck = true;
+    CHECK(DEV_I2C_Read_Reg(dev, 0x20, buf, sizeof(buf)) == ESP_OK);
+    CHECK(buf[0] == 0xa5 && buf[1] == 0xa5);
+    CHECK(sim.attempts == EXAMPLE_I2C_RECOVER_AFTER + 1);
+    CHECK(sim.resets == 1);
+    CHECK(DEV_I2C_Get_Stats(dev, &st, true) == ESP_OK);
+    CHECK(st.ok_cnt == 1 && st.err_cnt == 2 && st.retry_cnt == 2 && st.fail_cnt == 0 && st.recover_cnt == 1);
+    CHECK(st.outage_cnt == 1);
+    CHECK(st.outage_us_last >= EXAMPLE_I2C_TIMEOUT_MS * 1000);
+}
+
+// SDA held through the resets: every transfer fails after its retries until the slave lets go
+static void test_stuck_hard(void)
+{
+    i2c_master_dev_handle_t dev = add_device(0x12);
+    DEV_I2C_Stats st;
+
+    sim_reset();
+    sim.sda_stuck = true;
+    sim.stuck_hard = true;
+
+    // 3 attempts, the reset after the second one fails
+    CHECK(DEV_I2C_Write_Reg(dev, 0x01, 0x02) == ESP_ERR_TIMEOUT);
+    CHECK(sim.attempts == EXAMPLE_I2C_RETRIES + 1);
+    CHECK(sim.resets == 1);
+
+    // The failure streak carries over: the 4th and the 6th attempts in a row reset the bus,
+    // the 6th is the last attempt of the transfer
+    CHECK(DEV_I2C_Read_Byte(dev) == 0);
+    CHECK(sim.attempts == 2 * (EXAMPLE_I2C_RETRIES + 1));
+    CHECK(sim.resets == 3);
+    CHECK(DEV_I2C_Write_Byte(dev, 0x01, 0x02) == ESP_ERR_TIMEOUT);
+    CHECK(sim.resets == 4);
+
+    CHECK(DEV_I2C_Get_Stats(dev, &st, false) == ESP_OK);
+    CHECK(st.ok_cnt == 0 && st.err_cnt == 9 && st.retry_cnt == 6 && st.fail_cnt == 3 && st.recover_cnt == 4);
+    CHECK(st.recover_cnt == (uint32_t)sim.resets);
+    CHECK(st.outage_cnt == 0); // Still out
+
+    // The slave lets go at the reset after the 10th attempt, the retry gets through
+    sim.stuck_hard = false;
+    CHECK(DEV_I2C_Read_Word(dev, 0x30) == 0xa5a5);
+    CHECK(sim.resets == 5);
+    CHECK(DEV_I2C_Get_Stats(dev, &st, true) == ESP_OK);
+    CHECK(st.ok_cnt == 1 && st.err_cnt == 10 && st.fail_cnt == 3 && st.recover_cnt == 5);
+    CHECK(st.outage_cnt == 1);
+    CHECK(st.outage_us_last >= 9 * EXAMPLE_I2C_TIMEOUT_MS * 1000);
+}
+
+// An argument error is not a bus error, it is returned at once
+static void test_no_retry(void)
+{
+    i2c_master_dev_handle_t dev = add_device(0x13);
+    DEV_I2C_Stats st;
+
+    sim_reset();
+    sim.fail_once = ESP_ERR_INVALID_ARG;
+    CHECK(DEV_I2C_Write_Reg(dev, 0x01, 0x02) == ESP_ERR_INVALID_ARG);
+    CHECK(sim.attempts == 1);
+    CHECK(sim.resets == 0);
+    CHECK(DEV_I2C_Get_Stats(dev, &st, true) == ESP_OK);
+    CHECK(st.err_cnt == 1 && st.retry_cnt == 0 && st.fail_cnt == 1 && st.recover_cnt == 0);
+}
+
+// A policy without recovery never resets the bus, and its own retry count applies
+static void test_policy(void)
+{
+    i2c_master_dev_handle_t dev = add_device(0x14);
+    DEV_I2C_Policy policy = DEV_I2C_POLICY_DEFAULT();
+    DEV_I2C_Stats st;
+
+    policy.retries = 4;
+    policy.recover_after = 0;
+    policy.timeout_ms = 10;
+    CHECK(DEV_I2C_Set_Policy(dev, &policy) == ESP_OK);
+
+    sim_reset();
+    sim.sda_stuck = true;
+    int64_t start_us = sim.now_us;
+    CHECK(DEV_I2C_Write_Reg(dev, 0x01, 0x02) == ESP_ERR_TIMEOUT);
+    CHECK(sim.attempts == 5);
+    CHECK(sim.resets == 0);
+    CHECK(sim.now_us - start_us == 5 * 10000 + 4 * EXAMPLE_I2C_RETRY_DELAY_MS * 1000);
+    CHECK(DEV_I2C_Get_Stats(dev, &st, true) == ESP_OK);
+    CHECK(st.err_cnt == 5 && st.retry_cnt == 4 && st.fail_cnt == 1 && st.recover_cnt == 0);
+}
+
+int main(void)
+{
+    DEV_I2C_Init();
+
+    test_nack_once();
+    test_stuck_recovered();
+    test_stuck_hard();
+    test_no_retry();
+    test_policy();
+
+    printf("%s\n", failures ? "FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
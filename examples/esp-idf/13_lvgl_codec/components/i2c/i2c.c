@@ -12,11 +12,49 @@
  ******************************************************************************/
 
 #include "i2c.h"  // Include I2C driver header for I2C functions
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_check.h"
 static const char *TAG = "i2c";  // Define a tag for logging
 
 // Global handle for the I2C master bus
 // i2c_master_bus_handle_t bus_handle = NULL;
 DEV_I2C_Port handle;
+
+// Retry policy and error statistics of one device
+typedef struct {
+    i2c_master_dev_handle_t dev;    // Device handle, NULL if the entry is free
+    uint8_t addr;                   // 7-bit address
+    uint32_t speed_hz;              // SCL speed
+    DEV_I2C_Policy policy;          // Retry policy
+    DEV_I2C_Stats stats;            // Error statistics
+    uint8_t fail_streak;            // Consecutive failed attempts
+    int64_t outage_start_us;        // Time of the first failure of the current outage, 0 if none
+} DEV_I2C_Device;
+
+static DEV_I2C_Device devices[EXAMPLE_I2C_MAX_DEVICES];              // Device registry
+static portMUX_TYPE devices_lock = portMUX_INITIALIZER_UNLOCKED;     // Protects devices, bus_stats and recover_stats
+static SemaphoreHandle_t registry_lock;                             // Serializes the creation of devices
+static DEV_I2C_Bus_Stats bus_stats;                                 // Bus utilization
+static int64_t bus_stats_since_us;                                  // Time bus_stats was last reset
+static struct {
+    uint32_t cnt;                   // Bus recoveries
+    uint32_t fail_cnt;              // Recoveries that left SDA low
+    uint32_t us_last;               // Duration of the last recovery
+    uint32_t us_max;                // Duration of the longest recovery
+} recover_stats;
+
+static DEV_I2C_Device *DEV_I2C_Find(i2c_master_dev_handle_t dev_handle)
+{
+    for (int i = 0; i < EXAMPLE_I2C_MAX_DEVICES && dev_handle; i++) {
+        if (devices[i].dev == dev_handle) {
+            return &devices[i];
+        }
+    }
+    return NULL;
+}
 /**
  * @brief Initialize the I2C master interface.
  * 
@@ -39,17 +77,16 @@ DEV_I2C_Port DEV_I2C_Init()
 
     // Create a new I2C master bus with the above configuration
     ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_bus_config, &handle.bus));
-    
-    // Configure the device's I2C parameters
-    i2c_device_config_t i2c_dev_conf = {
-        .scl_speed_hz = EXAMPLE_I2C_MASTER_FREQUENCY,  // Set I2C communication speed
-    };
-    
-    // Add the I2C device to the bus
-    // i2c_master_dev_handle_t dev_handle = NULL;
-    if (i2c_master_bus_add_device(handle.bus, &i2c_dev_conf, &handle.dev) != ESP_OK) {
-        ESP_LOGE(TAG, "I2C device creation failed");  // Log error if device creation fails
-    }
+
+    // Devices are added by their drivers through the registry
+    registry_lock = xSemaphoreCreateMutex();
+    assert(registry_lock);
+    bus_stats_since_us = esp_timer_get_time();
+
+#if EXAMPLE_I2C_USE_SCHED
+    // Start the scheduler that orders the transfers of all devices on the bus
+    ESP_ERROR_CHECK(i2c_sched_init());
+#endif
 
     return handle;  // Return the device handle if successful
 }
@@ -64,23 +101,352 @@ DEV_I2C_Port DEV_I2C_Init()
  */
 void DEV_I2C_Set_Slave_Addr(i2c_master_dev_handle_t *dev_handle, uint8_t Addr)
 {
-    // Configure the new device address
-    i2c_device_config_t i2c_dev_conf = {
-        .scl_speed_hz = EXAMPLE_I2C_MASTER_FREQUENCY,  // I2C frequency
-        .device_address = Addr,                        // Set new device address
-    };
-    
-    // Update the device with the new address
-    if (i2c_master_bus_add_device(handle.bus, &i2c_dev_conf, dev_handle) != ESP_OK) {
+    // Reuse the handle of the address, or create it at the default speed
+    if (DEV_I2C_Add_Device(Addr, EXAMPLE_I2C_MASTER_FREQUENCY, dev_handle) != ESP_OK) {
         ESP_LOGE(TAG, "I2C address modification failed");  // Log error if address modification fails
     }
 }
 
+esp_err_t DEV_I2C_Add_Device(uint8_t Addr, uint32_t scl_speed_hz, i2c_master_dev_handle_t *dev_handle)
+{
+    esp_err_t ret = ESP_OK;
+    DEV_I2C_Device *d = NULL;
+
+    scl_speed_hz = scl_speed_hz ? scl_speed_hz : EXAMPLE_I2C_MASTER_FREQUENCY;
+    xSemaphoreTake(registry_lock, portMAX_DELAY);
+
+    // Known address: hand out the existing handle
+    for (int i = 0; i < EXAMPLE_I2C_MAX_DEVICES; i++) {
+        if (devices[i].dev && devices[i].addr == Addr) {
+            d = &devices[i];
+            break;
+        }
+    }
+    if (d) {
+        if (d->speed_hz != scl_speed_hz) {
+            ESP_LOGW(TAG, "Device 0x%02x already runs at %"PRIu32" Hz, keeping it", Addr, d->speed_hz);
+        }
+        *dev_handle = d->dev;
+        xSemaphoreGive(registry_lock);
+        return ESP_OK;
+    }
+
+    for (int i = 0; i < EXAMPLE_I2C_MAX_DEVICES && d == NULL; i++) {
+        d = (devices[i].dev == NULL) ? &devices[i] : NULL;  // Take a free entry
+    }
+    if (d == NULL) {
+        ESP_LOGE(TAG, "I2C device registry full, 0x%02x not added", Addr);
+        ret = ESP_ERR_NO_MEM;
+    } else {
+        // Configure the device address and speed
+        i2c_device_config_t i2c_dev_conf = {
+            .scl_speed_hz = scl_speed_hz,   // I2C frequency
+            .device_address = Addr,         // Device address
+        };
+        i2c_master_dev_handle_t dev = NULL;
+        ret = i2c_master_bus_add_device(handle.bus, &i2c_dev_conf, &dev);
+        if (ret == ESP_OK) {
+            // Default retry policy, drivers may change it with DEV_I2C_Set_Policy()
+            portENTER_CRITICAL(&devices_lock);
+            *d = (DEV_I2C_Device) {
+                .dev = dev,
+                .addr = Addr,
+                .speed_hz = scl_speed_hz,
+                .policy = DEV_I2C_POLICY_DEFAULT(),
+            };
+            portEXIT_CRITICAL(&devices_lock);
+
+            // Known to the scheduler at normal priority, drivers may register again with their name and priority
+            i2c_sched_register_device(dev, Addr, NULL, I2C_SCHED_PRIO_NORMAL);
+            *dev_handle = dev;
+        }
+    }
+
+    xSemaphoreGive(registry_lock);
+    return ret;
+}
+
+i2c_master_dev_handle_t DEV_I2C_Find_Device(uint8_t Addr)
+{
+    i2c_master_dev_handle_t dev = NULL;
+
+    portENTER_CRITICAL(&devices_lock);
+    for (int i = 0; i < EXAMPLE_I2C_MAX_DEVICES && dev == NULL; i++) {
+        dev = (devices[i].dev && devices[i].addr == Addr) ? devices[i].dev : NULL;
+    }
+    portEXIT_CRITICAL(&devices_lock);
+
+    return dev;
+}
+
 i2c_master_bus_handle_t DEV_I2C_Get_Bus_Device()
 {
     return handle.bus;
 }
 
+/**
+ * @brief Run one transfer attempt, through the scheduler when it is running.
+ * 
+ * @param dev_handle The handle to the I2C device.
+ * @param tx Data to write, may be NULL if tx_len is 0.
+ * @param tx_len Number of bytes to write.
+ * @param rx Buffer for the data read, may be NULL if rx_len is 0.
+ * @param rx_len Number of bytes to read.
+ * @param timeout_ms Timeout of the attempt.
+ * @return ESP_OK on success, or the error of the driver.
+ */
+static esp_err_t DEV_I2C_Transfer_Once(i2c_master_dev_handle_t dev_handle, const uint8_t *tx, size_t tx_len,
+                                       uint8_t *rx, size_t rx_len, int timeout_ms)
+{
+    if (i2c_sched_is_running()) {
+        i2c_sched_trans_t trans = {
+            .dev = dev_handle,
+            .prio = I2C_SCHED_PRIO_DEVICE,  // Priority the device was registered with
+            .tx = tx,
+            .tx_len = tx_len,
+            .rx = rx,
+            .rx_len = rx_len,
+            .timeout_ms = timeout_ms,
+        };
+        return i2c_sched_transfer(&trans);  // Wait for the scheduler to run it
+    }
+
+    if (tx_len && rx_len) {
+        return i2c_master_transmit_receive(dev_handle, tx, tx_len, rx, rx_len, timeout_ms);
+    } else if (tx_len) {
+        return i2c_master_transmit(dev_handle, tx, tx_len, timeout_ms);
+    }
+    return i2c_master_receive(dev_handle, rx, rx_len, timeout_ms);
+}
+
+/**
+ * @brief Run one transfer with the retry policy of the device.
+ * 
+ * A NACK, a timeout or a bus error is retried. When the device keeps failing,
+ * the bus is recovered, even after the last attempt.
+ * 
+ * @return ESP_OK on success, or the error of the last attempt.
+ */
+static esp_err_t DEV_I2C_Transfer(i2c_master_dev_handle_t dev_handle, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    DEV_I2C_Policy policy = DEV_I2C_POLICY_DEFAULT();
+    uint32_t speed_hz = EXAMPLE_I2C_MASTER_FREQUENCY;
+    esp_err_t ret;
+
+    portENTER_CRITICAL(&devices_lock);
+    DEV_I2C_Device *d = DEV_I2C_Find(dev_handle);
+    if (d) {
+        policy = d->policy;
+        speed_hz = d->speed_hz;
+    }
+    portEXIT_CRITICAL(&devices_lock);
+
+    // Wire time of one attempt: 9 clocks per data and address byte, start, repeated start and stop
+    uint32_t segments = (tx_len ? 1 : 0) + (rx_len ? 1 : 0);
+    uint32_t clocks = 9 * (tx_len + rx_len + segments) + segments + 1;
+    uint32_t wire_us = (uint32_t)((uint64_t)clocks * 1000000 / speed_hz);
+
+    for (int attempt = 0; ; attempt++) {
+        ret = DEV_I2C_Transfer_Once(dev_handle, tx, tx_len, rx, rx_len, policy.timeout_ms);
+
+        // Only bus level errors are worth another attempt or a bus recovery
+        bool retryable = (ret == ESP_FAIL || ret == ESP_ERR_TIMEOUT || ret == ESP_ERR_INVALID_STATE);
+        bool recover = false;
+        int64_t now_us = esp_timer_get_time();
+        portENTER_CRITICAL(&devices_lock);
+        bus_stats.transfer_cnt++;
+        bus_stats.byte_cnt += tx_len + rx_len;
+        bus_stats.busy_us += wire_us;
+        if (d) {
+            d->stats.byte_cnt += tx_len + rx_len;
+            d->stats.busy_us += wire_us;
+        }
+        if (d && ret == ESP_OK) {
+            d->stats.ok_cnt++;
+            d->fail_streak = 0;
+            if (d->outage_start_us) {
+                // Back after an outage, record how long it lasted
+                uint32_t outage_us = (uint32_t)(now_us - d->outage_start_us);
+                d->stats.outage_cnt++;
+                d->stats.outage_us_last = outage_us;
+                d->stats.outage_us_max = (outage_us > d->stats.outage_us_max) ? outage_us : d->stats.outage_us_max;
+                d->outage_start_us = 0;
+            }
+        } else if (d) {
+            d->stats.err_cnt++;
+            d->stats.last_err = ret;
+            d->fail_streak++;
+            d->outage_start_us = d->outage_start_us ? d->outage_start_us : now_us;
+            recover = retryable && policy.recover_after && (d->fail_streak % policy.recover_after) == 0;
+            d->stats.recover_cnt += recover ? 1 : 0;
+        }
+        portEXIT_CRITICAL(&devices_lock);
+
+        // Also after the last attempt, so the next transfer finds a free bus
+        if (recover) {
+            DEV_I2C_Bus_Recover();
+        }
+        if (ret == ESP_OK || !retryable || attempt >= policy.retries) {
+            break;
+        }
+
+        if (policy.retry_delay_ms) {
+            vTaskDelay(pdMS_TO_TICKS(policy.retry_delay_ms) ? pdMS_TO_TICKS(policy.retry_delay_ms) : 1);
+        }
+        if (d) {
+            portENTER_CRITICAL(&devices_lock);
+            d->stats.retry_cnt++;
+            portEXIT_CRITICAL(&devices_lock);
+        }
+    }
+
+    if (ret != ESP_OK) {
+        if (d) {
+            portENTER_CRITICAL(&devices_lock);
+            d->stats.fail_cnt++;
+            portEXIT_CRITICAL(&devices_lock);
+        }
+        ESP_LOGW(TAG, "Transfer to 0x%02x failed: %s", d ? d->addr : 0, esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Bus recovery, run with nothing else on the bus.
+ */
+static esp_err_t DEV_I2C_Bus_Recover_Cb(void *arg)
+{
+    int64_t start_us = esp_timer_get_time();
+
+    // The driver clocks SCL until the slave releases SDA, then resets the controller state machine
+    esp_err_t ret = i2c_master_bus_reset(handle.bus);
+    if (ret == ESP_OK && gpio_get_level(EXAMPLE_I2C_MASTER_SDA) == 0) {
+        ret = ESP_FAIL;  // A slave still holds SDA low
+    }
+
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start_us);
+    portENTER_CRITICAL(&devices_lock);
+    recover_stats.cnt++;
+    recover_stats.fail_cnt += (ret != ESP_OK) ? 1 : 0;
+    recover_stats.us_last = elapsed_us;
+    recover_stats.us_max = (elapsed_us > recover_stats.us_max) ? elapsed_us : recover_stats.us_max;
+    portEXIT_CRITICAL(&devices_lock);
+
+    return ret;
+}
+
+esp_err_t DEV_I2C_Bus_Recover(void)
+{
+    esp_err_t ret;
+
+    if (i2c_sched_is_running()) {
+        ret = i2c_sched_call(DEV_I2C_Bus_Recover_Cb, NULL);  // Between two scheduled transfers
+    } else {
+        ret = DEV_I2C_Bus_Recover_Cb(NULL);
+    }
+    ESP_LOGW(TAG, "Bus recovery %s", (ret == ESP_OK) ? "done" : "failed, SDA held low");
+
+    return ret;
+}
+
+esp_err_t DEV_I2C_Write(i2c_master_dev_handle_t dev_handle, const uint8_t *pdata, size_t len)
+{
+    return DEV_I2C_Transfer(dev_handle, pdata, len, NULL, 0);
+}
+
+esp_err_t DEV_I2C_Read(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, size_t len)
+{
+    return DEV_I2C_Transfer(dev_handle, NULL, 0, pdata, len);
+}
+
+esp_err_t DEV_I2C_Write_Read(i2c_master_dev_handle_t dev_handle, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    return DEV_I2C_Transfer(dev_handle, tx, tx_len, rx, rx_len);
+}
+
+esp_err_t DEV_I2C_Write_Reg(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t value)
+{
+    uint8_t data[2] = {Cmd, value};  // Register address followed by the value
+    return DEV_I2C_Transfer(dev_handle, data, sizeof(data), NULL, 0);
+}
+
+esp_err_t DEV_I2C_Read_Reg(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t *pdata, size_t len)
+{
+    return DEV_I2C_Transfer(dev_handle, &Cmd, 1, pdata, len);
+}
+
+esp_err_t DEV_I2C_Set_Policy(i2c_master_dev_handle_t dev_handle, const DEV_I2C_Policy *policy)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL(&devices_lock);
+    DEV_I2C_Device *d = DEV_I2C_Find(dev_handle);
+    if (d) {
+        d->policy = *policy;
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&devices_lock);
+
+    return ret;
+}
+
+esp_err_t DEV_I2C_Get_Stats(i2c_master_dev_handle_t dev_handle, DEV_I2C_Stats *stats, bool reset)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL(&devices_lock);
+    DEV_I2C_Device *d = DEV_I2C_Find(dev_handle);
+    if (d) {
+        *stats = d->stats;
+        if (reset) {
+            memset(&d->stats, 0, sizeof(d->stats));
+        }
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&devices_lock);
+
+    return ret;
+}
+
+void DEV_I2C_Get_Bus_Stats(DEV_I2C_Bus_Stats *stats, bool reset)
+{
+    int64_t now_us = esp_timer_get_time();
+
+    portENTER_CRITICAL(&devices_lock);
+    *stats = bus_stats;
+    stats->elapsed_us = now_us - bus_stats_since_us;
+    if (reset) {
+        memset(&bus_stats, 0, sizeof(bus_stats));
+        bus_stats_since_us = now_us;
+    }
+    portEXIT_CRITICAL(&devices_lock);
+}
+
+void DEV_I2C_Log_Stats(void)
+{
+    DEV_I2C_Bus_Stats bus;
+    DEV_I2C_Get_Bus_Stats(&bus, true);
+
+    for (int i = 0; i < EXAMPLE_I2C_MAX_DEVICES; i++) {
+        DEV_I2C_Stats st;
+        if (devices[i].dev == NULL || DEV_I2C_Get_Stats(devices[i].dev, &st, false) != ESP_OK) {
+            continue;
+        }
+        ESP_LOGI(TAG, "0x%02x @ %"PRIu32" kHz: ok %"PRIu32", err %"PRIu32", retry %"PRIu32", fail %"PRIu32", recover %"PRIu32
+                 ", outages %"PRIu32" (last %"PRIu32" us, max %"PRIu32" us), %"PRIu32" B, busy %"PRIu64" us",
+                 devices[i].addr, devices[i].speed_hz / 1000, st.ok_cnt, st.err_cnt, st.retry_cnt, st.fail_cnt, st.recover_cnt,
+                 st.outage_cnt, st.outage_us_last, st.outage_us_max, st.byte_cnt, st.busy_us);
+    }
+    if (bus.elapsed_us > 0) {
+        ESP_LOGI(TAG, "Bus: %.1f transfers/s, %.1f B/s, utilization %.2f%%",
+                 bus.transfer_cnt * 1e6 / bus.elapsed_us, bus.byte_cnt * 1e6 / bus.elapsed_us,
+                 bus.busy_us * 100.0 / bus.elapsed_us);
+    }
+    ESP_LOGI(TAG, "Bus recoveries: %"PRIu32" (failed %"PRIu32"), last %"PRIu32" us, max %"PRIu32" us",
+             recover_stats.cnt, recover_stats.fail_cnt, recover_stats.us_last, recover_stats.us_max);
+}
+
 /**
  * @brief Write a single byte to the I2C device.
  * 
@@ -89,11 +455,13 @@ i2c_master_bus_handle_t DEV_I2C_Get_Bus_Device()
  * @param dev_handle The handle to the I2C device.
  * @param Cmd The command byte to send.
  * @param value The value byte to send.
+ * @return ESP_OK, or the error of the last attempt.
  */
-void DEV_I2C_Write_Byte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t value)
+esp_err_t DEV_I2C_Write_Byte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t value)
 {
     uint8_t data[2] = {Cmd, value};  // Create an array with command and value
-    ESP_ERROR_CHECK(i2c_master_transmit(dev_handle, data, sizeof(data), 100));  // Send the data to the device
+    ESP_RETURN_ON_ERROR(DEV_I2C_Transfer(dev_handle, data, sizeof(data), NULL, 0), TAG, "Write byte failed");  // Send the data to the device
+    return ESP_OK;
 }
 
 /**
@@ -102,12 +470,15 @@ void DEV_I2C_Write_Byte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t
  * This function reads a byte of data from the I2C device.
  * 
  * @param dev_handle The handle to the I2C device.
- * @return The byte read from the device.
+ * @return The byte read from the device, 0 if the read failed.
  */
 uint8_t DEV_I2C_Read_Byte(i2c_master_dev_handle_t dev_handle)
 {
     uint8_t data[1] = {0};  // Create a buffer to store the received byte
-    ESP_ERROR_CHECK(i2c_master_receive(dev_handle, data, 1, 100));  // Read a byte from the device
+    if (DEV_I2C_Transfer(dev_handle, NULL, 0, data, 1) != ESP_OK) {  // Read a byte from the device
+        ESP_LOGE(TAG, "Read byte failed");
+        return 0;
+    }
     return data[0];  // Return the received byte
 }
 
@@ -119,12 +490,15 @@ uint8_t DEV_I2C_Read_Byte(i2c_master_dev_handle_t dev_handle)
  * 
  * @param dev_handle The handle to the I2C device.
  * @param Cmd The command byte to send.
- * @return The word read from the device (combined two bytes).
+ * @return The word read from the device (combined two bytes), 0 if the read failed.
  */
 uint16_t DEV_I2C_Read_Word(i2c_master_dev_handle_t dev_handle, uint8_t Cmd)
 {
-    uint8_t data[2] = {Cmd};  // Create an array with the command byte
-    ESP_ERROR_CHECK(i2c_master_transmit_receive(dev_handle, data, 1, data, 2, 100));  // Send command and receive two bytes
+    uint8_t data[2] = {0};  // Create a buffer for the two bytes, the command is sent from its own variable so a retry resends it
+    if (DEV_I2C_Transfer(dev_handle, &Cmd, 1, data, 2) != ESP_OK) {  // Send command and receive two bytes
+        ESP_LOGE(TAG, "Read word from 0x%02x failed", Cmd);
+        return 0;
+    }
     return data[1] << 8 | data[0];  // Combine the two bytes into a word (16-bit)
 }
 
@@ -136,10 +510,12 @@ uint16_t DEV_I2C_Read_Word(i2c_master_dev_handle_t dev_handle, uint8_t Cmd)
  * @param dev_handle The handle to the I2C device.
  * @param pdata Pointer to the data to send.
  * @param len The number of bytes to send.
+ * @return ESP_OK, or the error of the last attempt.
  */
-void DEV_I2C_Write_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, uint8_t len)
+esp_err_t DEV_I2C_Write_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, uint8_t len)
 {
-    ESP_ERROR_CHECK(i2c_master_transmit(dev_handle, pdata, len, 100));  // Transmit the data block
+    ESP_RETURN_ON_ERROR(DEV_I2C_Transfer(dev_handle, pdata, len, NULL, 0), TAG, "Write %d bytes failed", len);  // Transmit the data block
+    return ESP_OK;
 }
 
 /**
@@ -152,8 +528,10 @@ void DEV_I2C_Write_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, uin
  * @param Cmd The command byte to send.
  * @param pdata Pointer to the buffer where received data will be stored.
  * @param len The number of bytes to read.
+ * @return ESP_OK, or the error of the last attempt.
  */
-void DEV_I2C_Read_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t *pdata, uint8_t len)
+esp_err_t DEV_I2C_Read_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t *pdata, uint8_t len)
 {
-    ESP_ERROR_CHECK(i2c_master_transmit_receive(dev_handle, &Cmd, 1, pdata, len, 100));  // Send command and receive data
+    ESP_RETURN_ON_ERROR(DEV_I2C_Transfer(dev_handle, &Cmd, 1, pdata, len), TAG, "Read %d bytes from 0x%02x failed", len, Cmd);  // Send command and receive data
+    return ESP_OK;
 }
@@ -19,6 +19,7 @@
 #include "driver/i2c_master.h"    // ESP32 I2C master driver library
 #include "esp_log.h"        // ESP32 logging library for debugging
 #include "gpio.h"           // GPIO header for pin configuration
+#include "i2c_sched.h"      // Shared bus scheduler
 
 // Define the SDA (data) and SCL (clock) pins for I2C communication
 #define EXAMPLE_I2C_MASTER_SDA GPIO_NUM_8  // SDA pin
@@ -30,11 +31,76 @@
 // Define the I2C master port number (I2C_NUM_0 in this case)
 #define EXAMPLE_I2C_MASTER_NUM I2C_NUM_0
 
+// Route every transfer through the priority scheduler (1) or call the driver directly (0)
+#define EXAMPLE_I2C_USE_SCHED (1)
+
+/**
+ * Error handling parameters, can be adjusted by users
+ *
+ */
+#define EXAMPLE_I2C_MAX_DEVICES      (8)    // Maximum number of devices in the registry
+#define EXAMPLE_I2C_TIMEOUT_MS       (100)  // Default transfer timeout
+#define EXAMPLE_I2C_RETRIES          (2)    // Default number of retries after a failed transfer
+#define EXAMPLE_I2C_RETRY_DELAY_MS   (2)    // Default delay before a retry
+#define EXAMPLE_I2C_RECOVER_AFTER    (2)    // Default number of consecutive failures before the bus is recovered, 0 never
+
 
 typedef struct {
     i2c_master_bus_handle_t bus;
-    i2c_master_dev_handle_t dev;
+    i2c_master_dev_handle_t dev;    // Unused, devices are created with DEV_I2C_Add_Device()
 } DEV_I2C_Port;
+
+/**
+ * @brief Retry policy of a device
+ */
+typedef struct {
+    uint16_t timeout_ms;        /*!< Timeout of one attempt */
+    uint8_t retries;            /*!< Retries after a failed attempt */
+    uint16_t retry_delay_ms;    /*!< Delay before a retry */
+    uint8_t recover_after;      /*!< Consecutive failed attempts before the bus is recovered, 0 never */
+} DEV_I2C_Policy;
+
+#define DEV_I2C_POLICY_DEFAULT()                        \
+    {                                                   \
+        .timeout_ms = EXAMPLE_I2C_TIMEOUT_MS,           \
+        .retries = EXAMPLE_I2C_RETRIES,                 \
+        .retry_delay_ms = EXAMPLE_I2C_RETRY_DELAY_MS,   \
+        .recover_after = EXAMPLE_I2C_RECOVER_AFTER,     \
+    }
+
+/**
+ * @brief Error statistics of a device
+ *
+ * An outage starts with a failed attempt and ends with the next successful
+ * transfer, its length is the time the device was unavailable.
+ */
+typedef struct {
+    uint32_t ok_cnt;            /*!< Successful transfers */
+    uint32_t err_cnt;           /*!< Failed attempts, retries included */
+    uint32_t retry_cnt;         /*!< Retries */
+    uint32_t fail_cnt;          /*!< Transfers that failed after all retries */
+    uint32_t recover_cnt;       /*!< Bus recoveries triggered by this device */
+    uint32_t outage_cnt;        /*!< Outages that ended */
+    uint32_t outage_us_last;    /*!< Length of the last outage */
+    uint32_t outage_us_max;     /*!< Length of the longest outage */
+    esp_err_t last_err;         /*!< Last error */
+    uint32_t byte_cnt;          /*!< Bytes written and read, failed attempts included */
+    uint64_t busy_us;           /*!< Time the transfers kept the bus busy */
+} DEV_I2C_Stats;
+
+/**
+ * @brief Bus utilization
+ *
+ * Busy time is the wire time of every attempt at the SCL speed of its device
+ * (9 clocks per byte, address bytes, start, repeated start and stop), so it
+ * does not include queueing or task switches. Clock stretching is not counted.
+ */
+typedef struct {
+    uint32_t transfer_cnt;      /*!< Transfer attempts */
+    uint32_t byte_cnt;          /*!< Bytes written and read */
+    uint64_t busy_us;           /*!< Time the bus was busy */
+    uint64_t elapsed_us;        /*!< Time covered by the counters */
+} DEV_I2C_Bus_Stats;
 // Function prototypes for I2C communication
 
 /**
@@ -51,13 +117,35 @@ DEV_I2C_Port DEV_I2C_Init();
 /**
  * @brief Set a new I2C slave address for the device.
  * 
- * This function allows you to change the slave address of an I2C device during runtime.
+ * Same as DEV_I2C_Add_Device() at EXAMPLE_I2C_MASTER_FREQUENCY: the handle of the
+ * address is created on the first call and returned on the next ones.
  * 
  * @param dev_handle The handle to the I2C device.
  * @param Addr The new I2C address to set for the device.
  */
 void DEV_I2C_Set_Slave_Addr(i2c_master_dev_handle_t *dev_handle, uint8_t Addr);
 
+/**
+ * @brief Get the handle of a device, creating it on the first call.
+ * 
+ * Each address has one handle for the life of the bus. The SCL speed is set when
+ * the handle is created, a later call with another speed keeps the first one.
+ * 
+ * @param Addr The 7-bit I2C address.
+ * @param scl_speed_hz SCL speed of the device, 0 for EXAMPLE_I2C_MASTER_FREQUENCY.
+ * @param dev_handle Output handle.
+ * @return ESP_OK, ESP_ERR_NO_MEM if the registry is full, or the error of the driver.
+ */
+esp_err_t DEV_I2C_Add_Device(uint8_t Addr, uint32_t scl_speed_hz, i2c_master_dev_handle_t *dev_handle);
+
+/**
+ * @brief Look up the handle of a device by address.
+ * 
+ * @param Addr The 7-bit I2C address.
+ * @return The handle, or NULL if the device was never added.
+ */
+i2c_master_dev_handle_t DEV_I2C_Find_Device(uint8_t Addr);
+
 i2c_master_bus_handle_t DEV_I2C_Get_Bus_Device();
 /**
  * @brief Write a single byte to the I2C device.
@@ -67,8 +155,9 @@ i2c_master_bus_handle_t DEV_I2C_Get_Bus_Device();
  * @param dev_handle The handle to the I2C device.
  * @param Cmd The command byte to send to the device.
  * @param value The value byte to send to the device.
+ * @return ESP_OK, or the error of the last attempt.
  */
-void DEV_I2C_Write_Byte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t value);
+esp_err_t DEV_I2C_Write_Byte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t value);
 
 /**
  * @brief Read a single byte from the I2C device.
@@ -76,7 +165,7 @@ void DEV_I2C_Write_Byte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t
  * This function reads one byte of data from the I2C device.
  * 
  * @param dev_handle The handle to the I2C device.
- * @return The byte read from the I2C device.
+ * @return The byte read from the I2C device, 0 if the read failed.
  */
 uint8_t DEV_I2C_Read_Byte(i2c_master_dev_handle_t dev_handle);
 
@@ -88,7 +177,7 @@ uint8_t DEV_I2C_Read_Byte(i2c_master_dev_handle_t dev_handle);
  * 
  * @param dev_handle The handle to the I2C device.
  * @param Cmd The command byte to send.
- * @return The 16-bit word read from the device.
+ * @return The 16-bit word read from the device, 0 if the read failed.
  */
 uint16_t DEV_I2C_Read_Word(i2c_master_dev_handle_t dev_handle, uint8_t Cmd);
 
@@ -100,8 +189,9 @@ uint16_t DEV_I2C_Read_Word(i2c_master_dev_handle_t dev_handle, uint8_t Cmd);
  * @param dev_handle The handle to the I2C device.
  * @param pdata A pointer to the data to write.
  * @param len The number of bytes to write.
+ * @return ESP_OK, or the error of the last attempt.
  */
-void DEV_I2C_Write_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, uint8_t len);
+esp_err_t DEV_I2C_Write_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, uint8_t len);
 
 /**
  * @brief Read multiple bytes from the I2C device.
@@ -112,7 +202,111 @@ void DEV_I2C_Write_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, uin
  * @param Cmd The command byte to send.
  * @param pdata A pointer to the buffer to store the received data.
  * @param len The number of bytes to read.
+ * @return ESP_OK, or the error of the last attempt.
+ */
+esp_err_t DEV_I2C_Read_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t *pdata, uint8_t len);
+
+/*
+ * Transfer API
+ *
+ * Failed attempts are retried following the policy of the device, and the bus is
+ * recovered when a device keeps failing. These return the error of the last attempt,
+ * as do the functions above except DEV_I2C_Read_Byte() and DEV_I2C_Read_Word(),
+ * which return 0 when the transfer failed.
+ */
+
+/**
+ * @brief Write data to the I2C device.
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param pdata Data to write.
+ * @param len Number of bytes to write.
+ * @return ESP_OK, or the error of the last attempt.
+ */
+esp_err_t DEV_I2C_Write(i2c_master_dev_handle_t dev_handle, const uint8_t *pdata, size_t len);
+
+/**
+ * @brief Read data from the I2C device.
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param pdata Buffer for the data read.
+ * @param len Number of bytes to read.
+ * @return ESP_OK, or the error of the last attempt.
+ */
+esp_err_t DEV_I2C_Read(i2c_master_dev_handle_t dev_handle, uint8_t *pdata, size_t len);
+
+/**
+ * @brief Write data then read data with a repeated start.
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param tx Data to write.
+ * @param tx_len Number of bytes to write.
+ * @param rx Buffer for the data read.
+ * @param rx_len Number of bytes to read.
+ * @return ESP_OK, or the error of the last attempt.
+ */
+esp_err_t DEV_I2C_Write_Read(i2c_master_dev_handle_t dev_handle, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len);
+
+/**
+ * @brief Write one register.
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param Cmd The register address.
+ * @param value The value to write.
+ * @return ESP_OK, or the error of the last attempt.
+ */
+esp_err_t DEV_I2C_Write_Reg(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t value);
+
+/**
+ * @brief Read registers starting at an address.
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param Cmd The first register address.
+ * @param pdata Buffer for the data read.
+ * @param len Number of bytes to read.
+ * @return ESP_OK, or the error of the last attempt.
+ */
+esp_err_t DEV_I2C_Read_Reg(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t *pdata, size_t len);
+
+/**
+ * @brief Set the retry policy of a device added with DEV_I2C_Set_Slave_Addr().
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param policy The new policy.
+ * @return ESP_OK, or ESP_ERR_NOT_FOUND if the device is unknown.
+ */
+esp_err_t DEV_I2C_Set_Policy(i2c_master_dev_handle_t dev_handle, const DEV_I2C_Policy *policy);
+
+/**
+ * @brief Recover the bus: clock SCL until a stuck slave releases SDA, then reset the controller.
+ *
+ * Runs in the scheduler task when it is running, so no scheduled transfer is on the bus meanwhile.
+ *
+ * @return ESP_OK, or ESP_FAIL if SDA is still held low.
+ */
+esp_err_t DEV_I2C_Bus_Recover(void);
+
+/**
+ * @brief Get the error statistics of a device.
+ *
+ * @param dev_handle The handle to the I2C device.
+ * @param stats Output statistics.
+ * @param reset Set to true to restart the counters after reading them.
+ * @return ESP_OK, or ESP_ERR_NOT_FOUND if the device is unknown.
+ */
+esp_err_t DEV_I2C_Get_Stats(i2c_master_dev_handle_t dev_handle, DEV_I2C_Stats *stats, bool reset);
+
+/**
+ * @brief Get the bus utilization.
+ *
+ * @param stats Output statistics.
+ * @param reset Set to true to restart the counters after reading them.
+ */
+void DEV_I2C_Get_Bus_Stats(DEV_I2C_Bus_Stats *stats, bool reset);
+
+/**
+ * @brief Log the statistics of every device, the bus utilization and the bus recoveries.
  */
-void DEV_I2C_Read_Nbyte(i2c_master_dev_handle_t dev_handle, uint8_t Cmd, uint8_t *pdata, uint8_t len);
+void DEV_I2C_Log_Stats(void);
 
 #endif
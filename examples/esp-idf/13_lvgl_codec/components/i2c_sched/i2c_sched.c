@@ -0,0 +1,407 @@
+/*****************************************************************************
+ * | File         :   i2c_sched.c
+ * | Author       :   Waveshare team
+ * | Function     :   Shared I2C bus scheduler
+ * | Info         :
+ * |                 Priority queues, device grouping and statistics.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "i2c_sched.h"
+
+static const char *TAG = "i2c_sched";
+
+#define I2C_SCHED_NONE      (-1)    // End of a list
+
+/* Queued transaction */
+typedef struct {
+    i2c_sched_trans_t trans;            // Copy of the submitted transaction
+    uint8_t tx_buf[I2C_SCHED_TX_MAX];   // Copy of the write data
+    int64_t submit_us;                  // Time of submission
+    esp_err_t result;                   // Result, for synchronous callers
+    SemaphoreHandle_t done;             // Given on completion of a synchronous transaction
+    bool sync;                          // A caller waits on `done`
+    i2c_sched_call_t call;              // Function to run instead of a transfer, see i2c_sched_call()
+    void *call_arg;                     // Argument of the function
+    int next;                           // Next slot in the same list
+} i2c_sched_slot_t;
+
+/* Registered device */
+typedef struct {
+    i2c_master_dev_handle_t dev;        // Device handle, NULL if the entry is free
+    i2c_sched_prio_t prio;              // Priority used with I2C_SCHED_PRIO_DEVICE
+    i2c_sched_dev_stats_t stats;        // Statistics
+} i2c_sched_dev_t;
+
+static struct {
+    TaskHandle_t task;                              // Scheduler task
+    portMUX_TYPE lock;                              // Protects the lists and the statistics
+    SemaphoreHandle_t free_cnt;                     // Counts the free slots
+    i2c_sched_slot_t slots[I2C_SCHED_POOL_SIZE];    // Transaction pool
+    int free_head;                                  // Free slots
+    int head[I2C_SCHED_PRIO_NUM];                   // Pending slots per priority, oldest first
+    int tail[I2C_SCHED_PRIO_NUM];
+    i2c_sched_dev_t devs[I2C_SCHED_MAX_DEVICES];    // Registered devices
+    i2c_master_dev_handle_t last_dev;               // Device of the last transaction, for grouping
+    int64_t stats_since_us;                         // Time the statistics were last reset
+} sched = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static i2c_sched_dev_t *i2c_sched_find_dev(i2c_master_dev_handle_t dev)
+{
+    for (int i = 0; i < I2C_SCHED_MAX_DEVICES; i++) {
+        if (sched.devs[i].dev == dev) {
+            return &sched.devs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Take the next transaction to run, called with the lock held */
+static int i2c_sched_pick(int64_t now_us)
+{
+    int prio = -1;
+
+    /* Calls are queued at the head of the high priority list and go before everything */
+    int first = sched.head[I2C_SCHED_PRIO_HIGH];
+    bool call = (first != I2C_SCHED_NONE && sched.slots[first].call);
+
+    /* A transaction waiting too long runs first, so low priorities don't starve */
+    int64_t oldest_us = now_us - I2C_SCHED_AGING_MS * 1000;
+    for (int p = 0; p < I2C_SCHED_PRIO_NUM && !call; p++) {
+        int h = sched.head[p];
+        if (h != I2C_SCHED_NONE && sched.slots[h].submit_us < oldest_us) {
+            oldest_us = sched.slots[h].submit_us;
+            prio = p;
+        }
+    }
+    if (prio < 0) {
+        for (int p = 0; p < I2C_SCHED_PRIO_NUM && prio < 0; p++) {
+            prio = (sched.head[p] != I2C_SCHED_NONE) ? p : -1;
+        }
+    }
+    if (prio < 0) {
+        return I2C_SCHED_NONE;
+    }
+
+    /* Within the priority, keep talking to the same device while it has work queued */
+    int prev = I2C_SCHED_NONE;
+    int pick = sched.head[prio];
+    for (int s = sched.head[prio], p = I2C_SCHED_NONE; s != I2C_SCHED_NONE && !call; p = s, s = sched.slots[s].next) {
+        if (sched.slots[s].trans.dev == sched.last_dev) {
+            pick = s;
+            prev = p;
+            break;
+        }
+    }
+
+    /* Unlink */
+    if (prev == I2C_SCHED_NONE) {
+        sched.head[prio] = sched.slots[pick].next;
+    } else {
+        sched.slots[prev].next = sched.slots[pick].next;
+    }
+    if (sched.tail[prio] == pick) {
+        sched.tail[prio] = prev;
+    }
+    sched.slots[pick].next = I2C_SCHED_NONE;
+
+    return pick;
+}
+
+static esp_err_t i2c_sched_run(const i2c_sched_trans_t *t)
+{
+    int timeout = t->timeout_ms ? t->timeout_ms : I2C_SCHED_TIMEOUT_MS;
+
+    if (t->tx_len && t->rx_len) {
+        return i2c_master_transmit_receive(t->dev, t->tx, t->tx_len, t->rx, t->rx_len, timeout);
+    } else if (t->tx_len) {
+        return i2c_master_transmit(t->dev, t->tx, t->tx_len, timeout);
+    }
+    return i2c_master_receive(t->dev, t->rx, t->rx_len, timeout);
+}
+
+static void i2c_sched_task(void *arg)
+{
+    while (1) {
+        int64_t now_us = esp_timer_get_time();
+
+        portENTER_CRITICAL(&sched.lock);
+        int s = i2c_sched_pick(now_us);
+        portEXIT_CRITICAL(&sched.lock);
+
+        if (s == I2C_SCHED_NONE) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Sleep until the next submission
+            continue;
+        }
+
+        i2c_sched_slot_t *slot = &sched.slots[s];
+        if (slot->call) {
+            slot->result = slot->call(slot->call_arg);
+            xSemaphoreGive(slot->done); // Calls are always synchronous
+            continue;
+        }
+
+        int64_t start_us = esp_timer_get_time();
+        esp_err_t ret = i2c_sched_run(&slot->trans);
+        int64_t end_us = esp_timer_get_time();
+        sched.last_dev = slot->trans.dev;
+
+        portENTER_CRITICAL(&sched.lock);
+        i2c_sched_dev_t *d = i2c_sched_find_dev(slot->trans.dev);
+        if (d) {
+            uint32_t latency_us = (uint32_t)(end_us - slot->submit_us);
+            d->stats.trans_cnt++;
+            d->stats.err_cnt += (ret != ESP_OK) ? 1 : 0;
+            d->stats.byte_cnt += slot->trans.tx_len + slot->trans.rx_len;
+            d->stats.busy_us += end_us - start_us;
+            d->stats.latency_us += latency_us;
+            d->stats.latency_max_us = (latency_us > d->stats.latency_max_us) ? latency_us : d->stats.latency_max_us;
+        }
+        portEXIT_CRITICAL(&sched.lock);
+
+        if (slot->trans.done_cb) {
+            slot->trans.done_cb(ret, slot->trans.arg);
+        }
+
+        if (slot->sync) {
+            slot->result = ret;
+            xSemaphoreGive(slot->done); // The waiting caller releases the slot
+        } else {
+            portENTER_CRITICAL(&sched.lock);
+            slot->next = sched.free_head;
+            sched.free_head = s;
+            portEXIT_CRITICAL(&sched.lock);
+            xSemaphoreGive(sched.free_cnt);
+        }
+    }
+}
+
+esp_err_t i2c_sched_init(void)
+{
+    if (sched.task) {
+        return ESP_OK;
+    }
+
+    sched.free_cnt = xSemaphoreCreateCounting(I2C_SCHED_POOL_SIZE, I2C_SCHED_POOL_SIZE);
+    ESP_RETURN_ON_FALSE(sched.free_cnt, ESP_ERR_NO_MEM, TAG, "no mem for semaphore");
+    for (int i = 0; i < I2C_SCHED_POOL_SIZE; i++) {
+        sched.slots[i].done = xSemaphoreCreateBinary();
+        ESP_RETURN_ON_FALSE(sched.slots[i].done, ESP_ERR_NO_MEM, TAG, "no mem for semaphore");
+        sched.slots[i].next = (i + 1 < I2C_SCHED_POOL_SIZE) ? i + 1 : I2C_SCHED_NONE;
+    }
+    sched.free_head = 0;
+    for (int p = 0; p < I2C_SCHED_PRIO_NUM; p++) {
+        sched.head[p] = sched.tail[p] = I2C_SCHED_NONE;
+    }
+    sched.stats_since_us = esp_timer_get_time();
+
+    BaseType_t core_id = (I2C_SCHED_TASK_CORE < 0) ? tskNO_AFFINITY : I2C_SCHED_TASK_CORE;
+    BaseType_t ret = xTaskCreatePinnedToCore(i2c_sched_task, "i2c_sched", I2C_SCHED_TASK_STACK_SIZE, NULL,
+                                             I2C_SCHED_TASK_PRIORITY, &sched.task, core_id);
+    ESP_RETURN_ON_FALSE(ret == pdPASS, ESP_ERR_NO_MEM, TAG, "Failed to create scheduler task");
+
+    return ESP_OK;
+}
+
+bool i2c_sched_is_running(void)
+{
+    return (sched.task != NULL);
+}
+
+esp_err_t i2c_sched_register_device(i2c_master_dev_handle_t dev, uint8_t addr, const char *name, i2c_sched_prio_t prio)
+{
+    esp_err_t ret = ESP_ERR_NO_MEM;
+
+    ESP_RETURN_ON_FALSE(dev && prio < I2C_SCHED_PRIO_NUM, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&sched.lock);
+    i2c_sched_dev_t *d = i2c_sched_find_dev(dev);
+    if (d == NULL) {
+        d = i2c_sched_find_dev(NULL); // Take a free entry
+        if (d) {
+            memset(d, 0, sizeof(*d));
+            d->dev = dev;
+        }
+    }
+    if (d) {
+        d->prio = prio;
+        d->stats.addr = addr;
+        d->stats.name = name;
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&sched.lock);
+
+    return ret;
+}
+
+/* Copy the transaction into a free slot and append it to its priority list */
+static esp_err_t i2c_sched_enqueue(const i2c_sched_trans_t *trans, TickType_t wait, bool sync, int *out_slot)
+{
+    ESP_RETURN_ON_FALSE(trans && trans->dev && (trans->tx_len || trans->rx_len), ESP_ERR_INVALID_ARG, TAG, "invalid transaction");
+    ESP_RETURN_ON_FALSE(!trans->rx_len || trans->rx, ESP_ERR_INVALID_ARG, TAG, "no rx buffer");
+    ESP_RETURN_ON_FALSE(sync || trans->tx_len <= I2C_SCHED_TX_MAX, ESP_ERR_INVALID_ARG, TAG, "tx too long to queue");
+
+    if (xSemaphoreTake(sched.free_cnt, wait) != pdTRUE) {
+        return sync ? ESP_ERR_TIMEOUT : ESP_ERR_NO_MEM;
+    }
+
+    portENTER_CRITICAL(&sched.lock);
+    int s = sched.free_head;
+    sched.free_head = sched.slots[s].next;
+
+    i2c_sched_slot_t *slot = &sched.slots[s];
+    slot->trans = *trans;
+    if (trans->tx_len <= I2C_SCHED_TX_MAX) {
+        memcpy(slot->tx_buf, trans->tx, trans->tx_len);
+        slot->trans.tx = slot->tx_buf; // Long writes are only accepted from synchronous callers, who keep the buffer
+    }
+    slot->submit_us = esp_timer_get_time();
+    slot->sync = sync;
+    slot->call = NULL;
+    slot->next = I2C_SCHED_NONE;
+
+    int prio = trans->prio;
+    if (prio >= I2C_SCHED_PRIO_NUM) {
+        i2c_sched_dev_t *d = i2c_sched_find_dev(trans->dev);
+        prio = d ? d->prio : I2C_SCHED_PRIO_NORMAL;
+    }
+    if (sched.tail[prio] == I2C_SCHED_NONE) {
+        sched.head[prio] = s;
+    } else {
+        sched.slots[sched.tail[prio]].next = s;
+    }
+    sched.tail[prio] = s;
+    portEXIT_CRITICAL(&sched.lock);
+
+    xTaskNotifyGive(sched.task); // Wake the scheduler
+    *out_slot = s;
+
+    return ESP_OK;
+}
+
+/* Wait for a synchronous slot to complete, then release it */
+static esp_err_t i2c_sched_wait(int s)
+{
+    xSemaphoreTake(sched.slots[s].done, portMAX_DELAY);
+    esp_err_t ret = sched.slots[s].result;
+
+    portENTER_CRITICAL(&sched.lock);
+    sched.slots[s].next = sched.free_head;
+    sched.free_head = s;
+    portEXIT_CRITICAL(&sched.lock);
+    xSemaphoreGive(sched.free_cnt);
+
+    return ret;
+}
+
+esp_err_t i2c_sched_submit(const i2c_sched_trans_t *trans)
+{
+    int s;
+
+    ESP_RETURN_ON_FALSE(sched.task, ESP_ERR_INVALID_STATE, TAG, "scheduler not started");
+    return i2c_sched_enqueue(trans, 0, false, &s);
+}
+
+esp_err_t i2c_sched_transfer(const i2c_sched_trans_t *trans)
+{
+    int s;
+
+    ESP_RETURN_ON_FALSE(sched.task, ESP_ERR_INVALID_STATE, TAG, "scheduler not started");
+    /* The scheduler would wait for itself, e.g. a done_cb starting another transfer */
+    ESP_RETURN_ON_FALSE(xTaskGetCurrentTaskHandle() != sched.task, ESP_ERR_INVALID_STATE, TAG, "called from the scheduler task");
+    int timeout = trans->timeout_ms ? trans->timeout_ms : I2C_SCHED_TIMEOUT_MS;
+    ESP_RETURN_ON_ERROR(i2c_sched_enqueue(trans, pdMS_TO_TICKS(timeout), true, &s), TAG, "enqueue failed");
+
+    /* The scheduler always completes the transaction, the driver applies the timeout */
+    return i2c_sched_wait(s);
+}
+
+esp_err_t i2c_sched_call(i2c_sched_call_t call, void *arg)
+{
+    ESP_RETURN_ON_FALSE(call, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(sched.task, ESP_ERR_INVALID_STATE, TAG, "scheduler not started");
+    ESP_RETURN_ON_FALSE(xTaskGetCurrentTaskHandle() != sched.task, ESP_ERR_INVALID_STATE, TAG, "called from the scheduler task");
+
+    xSemaphoreTake(sched.free_cnt, portMAX_DELAY);
+
+    portENTER_CRITICAL(&sched.lock);
+    int s = sched.free_head;
+    sched.free_head = sched.slots[s].next;
+
+    i2c_sched_slot_t *slot = &sched.slots[s];
+    memset(&slot->trans, 0, sizeof(slot->trans));
+    slot->submit_us = esp_timer_get_time();
+    slot->sync = true;
+    slot->call = call;
+    slot->call_arg = arg;
+
+    /* Ahead of everything queued */
+    slot->next = sched.head[I2C_SCHED_PRIO_HIGH];
+    sched.head[I2C_SCHED_PRIO_HIGH] = s;
+    if (sched.tail[I2C_SCHED_PRIO_HIGH] == I2C_SCHED_NONE) {
+        sched.tail[I2C_SCHED_PRIO_HIGH] = s;
+    }
+    portEXIT_CRITICAL(&sched.lock);
+
+    xTaskNotifyGive(sched.task); // Wake the scheduler
+
+    return i2c_sched_wait(s);
+}
+
+esp_err_t i2c_sched_get_stats(int index, i2c_sched_dev_stats_t *stats, bool reset)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    ESP_RETURN_ON_FALSE(stats && index >= 0 && index < I2C_SCHED_MAX_DEVICES, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&sched.lock);
+    i2c_sched_dev_t *d = &sched.devs[index];
+    if (d->dev) {
+        *stats = d->stats;
+        if (reset) {
+            uint8_t addr = d->stats.addr;
+            const char *name = d->stats.name;
+            memset(&d->stats, 0, sizeof(d->stats));
+            d->stats.addr = addr;
+            d->stats.name = name;
+        }
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&sched.lock);
+
+    return ret;
+}
+
+void i2c_sched_log_stats(void)
+{
+    int64_t now_us = esp_timer_get_time();
+    int64_t elapsed_us = now_us - sched.stats_since_us;
+    sched.stats_since_us = now_us;
+
+    if (elapsed_us <= 0) {
+        return;
+    }
+    for (int i = 0; i < I2C_SCHED_MAX_DEVICES; i++) {
+        i2c_sched_dev_stats_t st;
+        if (i2c_sched_get_stats(i, &st, true) != ESP_OK || st.trans_cnt == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG, "%-8s 0x%02x: %.1f trans/s, %.1f B/s, err %"PRIu32", busy %.2f%%, latency avg %"PRIu32" us max %"PRIu32" us",
+                 st.name ? st.name : "?", st.addr,
+                 st.trans_cnt * 1e6 / elapsed_us, st.byte_cnt * 1e6 / elapsed_us, st.err_cnt,
+                 st.busy_us * 100.0 / elapsed_us, (uint32_t)(st.latency_us / st.trans_cnt), st.latency_max_us);
+    }
+}
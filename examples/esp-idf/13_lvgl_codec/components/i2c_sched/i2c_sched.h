@@ -0,0 +1,185 @@
+/*****************************************************************************
+ * | File         :   i2c_sched.h
+ * | Author       :   Waveshare team
+ * | Function     :   Shared I2C bus scheduler
+ * | Info         :
+ * |                 One task owns the bus and runs queued transactions by
+ * |                 priority, so a touch read is never stuck behind a batch
+ * |                 of housekeeping writes. Transactions of the same
+ * |                 priority are grouped per device, and every device keeps
+ * |                 latency, throughput and error statistics.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#ifndef __I2C_SCHED_H
+#define __I2C_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+/**
+ * Scheduler related parameters, can be adjusted by users
+ *
+ */
+#define I2C_SCHED_TASK_STACK_SIZE   (3 * 1024)  // The stack size of the scheduler task, in bytes
+#define I2C_SCHED_TASK_PRIORITY     (6)         // The priority of the scheduler task, above every client
+#define I2C_SCHED_TASK_CORE         (-1)        // The core of the scheduler task, `-1` means don't specify the core
+#define I2C_SCHED_POOL_SIZE         (16)        // Maximum number of queued transactions
+#define I2C_SCHED_TX_MAX            (32)        // Write data up to this size is copied, so the caller can release it
+#define I2C_SCHED_MAX_DEVICES       (8)         // Maximum number of registered devices
+#define I2C_SCHED_AGING_MS          (50)        // A transaction waiting longer than this runs first, whatever its priority
+#define I2C_SCHED_TIMEOUT_MS        (100)       // Default transfer timeout
+
+/**
+ * @brief Transaction priorities
+ */
+typedef enum {
+    I2C_SCHED_PRIO_HIGH = 0,        /*!< Latency critical, e.g. touch reads */
+    I2C_SCHED_PRIO_NORMAL,          /*!< Regular control, e.g. IO expander, codecs */
+    I2C_SCHED_PRIO_LOW,             /*!< Housekeeping, e.g. RTC polling */
+    I2C_SCHED_PRIO_NUM,
+    I2C_SCHED_PRIO_DEVICE = 0xff,   /*!< Use the priority the device was registered with */
+} i2c_sched_prio_t;
+
+/**
+ * @brief Completion callback, called from the scheduler task
+ *
+ * It must not wait for the bus: i2c_sched_transfer() and i2c_sched_call() return
+ * ESP_ERR_INVALID_STATE there, use i2c_sched_submit() to chain a transaction.
+ *
+ * @param result ESP_OK or the error returned by the I2C driver
+ * @param arg User argument of the transaction
+ */
+typedef void (*i2c_sched_done_cb_t)(esp_err_t result, void *arg);
+
+/**
+ * @brief Function run by the scheduler task with exclusive use of the bus, see i2c_sched_call()
+ *
+ * @param arg User argument
+ * @return Result passed back to the caller
+ */
+typedef esp_err_t (*i2c_sched_call_t)(void *arg);
+
+/**
+ * @brief Transaction description
+ *
+ * - tx_len > 0, rx_len == 0: write
+ * - tx_len == 0, rx_len > 0: read
+ * - tx_len > 0, rx_len > 0: write then read with a repeated start
+ */
+typedef struct {
+    i2c_master_dev_handle_t dev;    /*!< Target device */
+    i2c_sched_prio_t prio;          /*!< Priority, or I2C_SCHED_PRIO_DEVICE */
+    const uint8_t *tx;              /*!< Data to write, copied when not larger than I2C_SCHED_TX_MAX */
+    size_t tx_len;                  /*!< Length of the data to write */
+    uint8_t *rx;                    /*!< Buffer for the data read, must stay valid until completion */
+    size_t rx_len;                  /*!< Length of the data to read */
+    int timeout_ms;                 /*!< Transfer timeout, 0 for I2C_SCHED_TIMEOUT_MS */
+    i2c_sched_done_cb_t done_cb;    /*!< Completion callback, may be NULL */
+    void *arg;                      /*!< Argument of the callback */
+} i2c_sched_trans_t;
+
+/**
+ * @brief Statistics of one device
+ */
+typedef struct {
+    uint8_t addr;               /*!< 7-bit address */
+    const char *name;           /*!< Name given at registration */
+    uint32_t trans_cnt;         /*!< Completed transactions */
+    uint32_t err_cnt;           /*!< Failed transactions */
+    uint32_t byte_cnt;          /*!< Bytes written and read */
+    uint64_t busy_us;           /*!< Time spent on the bus */
+    uint64_t latency_us;        /*!< Sum of submit to completion times */
+    uint32_t latency_max_us;    /*!< Worst submit to completion time */
+} i2c_sched_dev_stats_t;
+
+/**
+ * @brief Start the scheduler task
+ *
+ * @return
+ *      - ESP_OK: Success (also when it is running already)
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t i2c_sched_init(void);
+
+/**
+ * @brief Check whether the scheduler is running
+ *
+ * @return true if transactions go through the scheduler
+ */
+bool i2c_sched_is_running(void);
+
+/**
+ * @brief Register a device, or update the name and priority of a registered one
+ *
+ * Unregistered devices can still be used, they run at I2C_SCHED_PRIO_NORMAL without statistics.
+ *
+ * @param dev Device handle
+ * @param addr 7-bit address, for the statistics
+ * @param name Name, for the statistics
+ * @param prio Priority used with I2C_SCHED_PRIO_DEVICE
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NO_MEM: The device table is full
+ */
+esp_err_t i2c_sched_register_device(i2c_master_dev_handle_t dev, uint8_t addr, const char *name, i2c_sched_prio_t prio);
+
+/**
+ * @brief Queue a transaction and return immediately
+ *
+ * @param trans Transaction, the structure itself can be released after the call
+ * @return
+ *      - ESP_OK: Queued, the callback reports the result
+ *      - ESP_ERR_INVALID_ARG: Invalid transaction
+ *      - ESP_ERR_NO_MEM: The queue is full
+ */
+esp_err_t i2c_sched_submit(const i2c_sched_trans_t *trans);
+
+/**
+ * @brief Queue a transaction and wait for its completion
+ *
+ * @note Not allowed in the scheduler task, i.e. in a `done_cb` or an i2c_sched_call() function.
+ *
+ * @param trans Transaction, `done_cb` is called before returning if set
+ * @return
+ *      - Result of the transfer
+ *      - ESP_ERR_TIMEOUT: No queue slot freed up in time
+ *      - ESP_ERR_INVALID_STATE: The scheduler is not running, or this is the scheduler task
+ */
+esp_err_t i2c_sched_transfer(const i2c_sched_trans_t *trans);
+
+/**
+ * @brief Run a function in the scheduler task, ahead of every queued transaction, and wait for its result
+ *
+ * No scheduled transfer runs at the same time, which makes it the place for bus recovery.
+ *
+ * @param call Function to run
+ * @param arg Argument of the function
+ * @return Result of the function, or ESP_ERR_INVALID_STATE if the scheduler is not running or this is the scheduler task
+ */
+esp_err_t i2c_sched_call(i2c_sched_call_t call, void *arg);
+
+/**
+ * @brief Get the statistics of a registered device
+ *
+ * @param index Index of the device, 0 to I2C_SCHED_MAX_DEVICES - 1
+ * @param stats Output statistics
+ * @param reset Set to true to restart the counters after reading them
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_FOUND: No device at this index
+ */
+esp_err_t i2c_sched_get_stats(int index, i2c_sched_dev_stats_t *stats, bool reset);
+
+/**
+ * @brief Log the statistics of every device since the last call, then reset them
+ */
+void i2c_sched_log_stats(void);
+
+#endif
@@ -5,33 +5,99 @@
  * | Info         :
  * |                 I2C driver code for controlling GPIO pins using IO_EXTENSION chip.
  * ----------------
- * | This version :   V1.0
- * | Date         :   2024-11-27
- * | Info         :   Basic version, includes functions to read and write 
- * |                 GPIO pins using I2C communication with IO_EXTENSION.
+ * | This version :   V1.1
+ * | Date         :   2026-10-19
+ * | Info         :   Shadow registers: output changes are coalesced into
+ * |                 one write, unchanged registers are not rewritten and
+ * |                 input reads are cached.
  *
  ******************************************************************************/
 #include "io_extension.h"  // Include IO_EXTENSION driver header for GPIO functions
- 
-io_extension_obj_t IO_EXTENSION;  // Define the global IO_EXTENSION object
+
+static const char *TAG = "io_extension";  // Define a tag for logging
+
+io_extension_obj_t IO_EXTENSION = {  // Define the global IO_EXTENSION object
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+/**
+ * @brief Increment one of the bus transaction counters.
+ */
+static void IO_EXTENSION_Count(uint32_t *cnt)
+{
+    portENTER_CRITICAL(&IO_EXTENSION.lock);
+    (*cnt)++;
+    portEXIT_CRITICAL(&IO_EXTENSION.lock);
+}
+
+/**
+ * @brief Write one register of the IO_EXTENSION device and count the transaction.
+ *
+ * @param reg The register address.
+ * @param value The value to write.
+ * @return ESP_OK, or the I2C error after the retries.
+ */
+static esp_err_t IO_EXTENSION_Write_Reg(uint8_t reg, uint8_t value)
+{
+    IO_EXTENSION_Count(&IO_EXTENSION.stats.write_cnt);
+    return DEV_I2C_Write_Reg(IO_EXTENSION.addr, reg, value);
+}
+
+/**
+ * @brief Coalescing timer callback, wakes the flush task.
+ *
+ * The write blocks on the bus and may retry, so it does not run in the esp_timer task.
+ */
+static void IO_EXTENSION_Flush_Timer_Cb(void *arg)
+{
+    xTaskNotifyGive(IO_EXTENSION.flush_task);
+}
+
+/**
+ * @brief Flush task, sends the output changes gathered during the window.
+ */
+static void IO_EXTENSION_Flush_Task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        IO_EXTENSION_Flush();
+    }
+}
+
+/**
+ * @brief Interrupt handler of the expander INT pin, the inputs have changed.
+ */
+static void IRAM_ATTR IO_EXTENSION_Int_Isr(void *arg)
+{
+    IO_EXTENSION.in_valid = false;
+}
 
 /**
  * @brief Set the IO mode for the specified pins.
- * 
+ *
  * This function sets the specified pins to input or output mode by writing to the mode register.
- * 
+ * The write is skipped if the mode register already holds the value.
+ *
  * @param pin An 8-bit value where each bit represents a pin (0 = input, 1 = output).
  */
-void IO_EXTENSION_IO_Mode(uint8_t pin) 
+void IO_EXTENSION_IO_Mode(uint8_t pin)
 {
-    uint8_t data[2] = {IO_EXTENSION_Mode, pin}; // Prepare the data to write to the mode register
-    // Write the 8-bit value to the IO mode register
-    DEV_I2C_Write_Nbyte(IO_EXTENSION.addr, data, 2);
+    xSemaphoreTake(IO_EXTENSION.bus_lock, portMAX_DELAY);
+    if (IO_EXTENSION.Last_mode_value != pin) {
+        // Write the 8-bit value to the IO mode register, the shadow only follows a successful write
+        if (IO_EXTENSION_Write_Reg(IO_EXTENSION_Mode, pin) == ESP_OK) {
+            IO_EXTENSION.Last_mode_value = pin;
+        }
+        IO_EXTENSION.in_valid = false; // Pins switched to input have no cached value yet
+    } else {
+        IO_EXTENSION_Count(&IO_EXTENSION.stats.skipped_cnt);
+    }
+    xSemaphoreGive(IO_EXTENSION.bus_lock);
 }
 
 /**
  * @brief Initialize the IO_EXTENSION device.
- * 
+ *
  * This function configures the slave addresses for different registers of the
  * IO_EXTENSION chip via I2C, and sets the control flags for input/output modes.
  */
@@ -39,61 +105,189 @@ void IO_EXTENSION_Init()
 {
     // Set the I2C slave address for the IO_EXTENSION device
     DEV_I2C_Set_Slave_Addr(&IO_EXTENSION.addr, IO_EXTENSION_ADDR);
+    i2c_sched_register_device(IO_EXTENSION.addr, IO_EXTENSION_ADDR, "io_ext", I2C_SCHED_PRIO_NORMAL);
 
+    // Serializes the register writes, so a late flush never overwrites a newer value
+    IO_EXTENSION.bus_lock = xSemaphoreCreateMutex();
+    assert(IO_EXTENSION.bus_lock);
+
+    // One-shot timer that sends the coalesced output changes
+    const esp_timer_create_args_t timer_args = {
+        .callback = IO_EXTENSION_Flush_Timer_Cb,
+        .name = "io_ext_flush",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &IO_EXTENSION.flush_timer));
+    BaseType_t ret = xTaskCreate(IO_EXTENSION_Flush_Task, "io_ext_flush", IO_EXTENSION_FLUSH_TASK_STACK_SIZE, NULL,
+                                 IO_EXTENSION_FLUSH_TASK_PRIORITY, &IO_EXTENSION.flush_task);
+    assert(ret == pdPASS);
+
+    IO_EXTENSION.Last_mode_value = 0x00; // Make sure the first mode write goes out
     IO_EXTENSION_IO_Mode(0xff); // Set all pins to output mode
 
     // Initialize control flags for IO output enable and open-drain output mode
     IO_EXTENSION.Last_io_value = 0xF7; // All pins are initially set to high (output mode)
     IO_EXTENSION.Last_od_value = 0xF7; // All pins are initially set to high (open-drain mode)
+    IO_EXTENSION.sent_valid = false; // Unknown, the first output write always goes out
+    IO_EXTENSION.Last_pwm_value = 0xff; // Unknown, the first PWM write always goes out
+
+    // Inputs stay cached until the expander signals a change
+    if (IO_EXTENSION_INT_GPIO != GPIO_NUM_NC) {
+        DEV_GPIO_INT(IO_EXTENSION_INT_GPIO, IO_EXTENSION_Int_Isr);
+    }
+
+    IO_EXTENSION.stats_since_us = esp_timer_get_time();
+}
+
+/**
+ * @brief Set several IO output pins in one update.
+ *
+ * The shadow output register is updated at once. The chip is written when the
+ * coalescing window ends, so changes made in quick succession cost one transaction.
+ *
+ * @param mask The pins to change, one bit per pin.
+ * @param values The new levels of the pins in `mask`, one bit per pin.
+ */
+void IO_EXTENSION_Output_Mask(uint8_t mask, uint8_t values)
+{
+    bool start_timer = false;
+
+    portENTER_CRITICAL(&IO_EXTENSION.lock);
+    IO_EXTENSION.Last_io_value = (IO_EXTENSION.Last_io_value & ~mask) | (values & mask);
+    if (IO_EXTENSION.io_dirty) {
+        IO_EXTENSION.stats.coalesced_cnt++; // Rides along with the pending write
+    } else {
+        IO_EXTENSION.io_dirty = true;
+        start_timer = true;
+    }
+    portEXIT_CRITICAL(&IO_EXTENSION.lock);
+
+    if (IO_EXTENSION_COALESCE_US == 0) {
+        IO_EXTENSION_Flush();
+    } else if (start_timer) {
+        esp_timer_start_once(IO_EXTENSION.flush_timer, IO_EXTENSION_COALESCE_US);
+    }
 }
 
 /**
  * @brief Set the value of the IO output pins on the IO_EXTENSION device.
- * 
- * This function writes an 8-bit value to the IO output register. The value
- * determines the high or low state of the pins.
- * 
+ *
+ * This function updates one bit of the shadow output register, see IO_EXTENSION_Output_Mask().
+ *
  * @param pin The pin number to set (0-7).
  * @param value The value to set on the specified pin (0 = low, 1 = high).
  */
-void IO_EXTENSION_Output(uint8_t pin, uint8_t value) 
+void IO_EXTENSION_Output(uint8_t pin, uint8_t value)
 {
     // Update the output value based on the pin and value
-    if (value == 1)
-        IO_EXTENSION.Last_io_value |= (1 << pin); // Set the pin high
-    else
-        IO_EXTENSION.Last_io_value &= (~(1 << pin)); // Set the pin low
+    IO_EXTENSION_Output_Mask(1 << pin, value ? (1 << pin) : 0);
+}
+
+/**
+ * @brief Send the pending output changes now.
+ *
+ * Call this when a pin must have its new level before continuing, e.g. before
+ * using a chip select driven by the expander.
+ */
+void IO_EXTENSION_Flush()
+{
+    xSemaphoreTake(IO_EXTENSION.bus_lock, portMAX_DELAY);
+
+    portENTER_CRITICAL(&IO_EXTENSION.lock);
+    bool dirty = IO_EXTENSION.io_dirty;
+    uint8_t value = IO_EXTENSION.Last_io_value;
+    IO_EXTENSION.io_dirty = false;
+    portEXIT_CRITICAL(&IO_EXTENSION.lock);
 
-    uint8_t data[2] = {IO_EXTENSION_IO_OUTPUT_ADDR, IO_EXTENSION.Last_io_value}; // Prepare the data to write to the output register
-    // Write the 8-bit value to the IO output register
-    DEV_I2C_Write_Nbyte(IO_EXTENSION.addr, data, 2);
+    if (dirty) {
+        if (!IO_EXTENSION.sent_valid || value != IO_EXTENSION.Sent_io_value) {
+            // Write the 8-bit value to the IO output register
+            if (IO_EXTENSION_Write_Reg(IO_EXTENSION_IO_OUTPUT_ADDR, value) == ESP_OK) {
+                IO_EXTENSION.Sent_io_value = value;
+                IO_EXTENSION.sent_valid = true;
+            } else {
+                // Keep the change pending and try again later instead of giving up on it
+                portENTER_CRITICAL(&IO_EXTENSION.lock);
+                IO_EXTENSION.io_dirty = true;
+                portEXIT_CRITICAL(&IO_EXTENSION.lock);
+                esp_timer_start_once(IO_EXTENSION.flush_timer, IO_EXTENSION_FLUSH_RETRY_US);
+            }
+            IO_EXTENSION.in_valid = false; // Outputs may be looped back to inputs
+        } else {
+            IO_EXTENSION_Count(&IO_EXTENSION.stats.skipped_cnt); // Changes cancelled each other
+        }
+    }
+
+    xSemaphoreGive(IO_EXTENSION.bus_lock);
+}
+
+/**
+ * @brief Read all IO input pins on the IO_EXTENSION device.
+ *
+ * Pending output changes are sent first. The value is served from the cache
+ * while it is younger than IO_EXTENSION_INPUT_CACHE_US, or, when the expander
+ * interrupt is wired, until the interrupt reports a change.
+ *
+ * @return The input register, one bit per pin (0 = low, 1 = high).
+ */
+uint8_t IO_EXTENSION_Input_All()
+{
+    IO_EXTENSION_Flush();
+
+    xSemaphoreTake(IO_EXTENSION.bus_lock, portMAX_DELAY);
+    int64_t now_us = esp_timer_get_time();
+    bool fresh = IO_EXTENSION.in_valid &&
+                 (IO_EXTENSION_INT_GPIO != GPIO_NUM_NC || now_us - IO_EXTENSION.in_time_us < IO_EXTENSION_INPUT_CACHE_US);
+    if (fresh) {
+        IO_EXTENSION_Count(&IO_EXTENSION.stats.cache_hit_cnt);
+    } else {
+        uint8_t in = 0;
+        IO_EXTENSION.in_valid = true; // Set before the read so an interrupt during it invalidates the result
+        // Read the value of the input pins, keep the last known value if that fails
+        if (DEV_I2C_Read_Reg(IO_EXTENSION.addr, IO_EXTENSION_IO_INPUT_ADDR, &in, 1) == ESP_OK) {
+            IO_EXTENSION.In_value = in;
+            IO_EXTENSION.in_time_us = now_us;
+        } else {
+            IO_EXTENSION.in_valid = false;
+        }
+        IO_EXTENSION_Count(&IO_EXTENSION.stats.read_cnt);
+    }
+    uint8_t value = IO_EXTENSION.In_value;
+    xSemaphoreGive(IO_EXTENSION.bus_lock);
+
+    return value;
 }
 
 /**
  * @brief Read the value from the IO input pins on the IO_EXTENSION device.
- * 
+ *
  * This function reads the value of the IO input register and returns the state
  * of the specified pins.
- * 
- * @param pin The bit mask to specify which pin to read (e.g., 0x01 for the first pin).
+ *
+ * @param pin The pin number to read (0-7).
  * @return The value of the specified pin(s) (0 = low, 1 = high).
  */
-uint8_t IO_EXTENSION_Input(uint8_t pin) 
+uint8_t IO_EXTENSION_Input(uint8_t pin)
 {
-    uint8_t value = 0;
-
-    // Read the value of the input pins
-    DEV_I2C_Read_Nbyte(IO_EXTENSION.addr, IO_EXTENSION_IO_INPUT_ADDR, &value, 1);
     // Return the value of the specific pin(s) by masking with the provided bit mask
-    return ((value & (1 << pin)) > 0);
+    return ((IO_EXTENSION_Input_All() & (1 << pin)) > 0);
+}
+
+/**
+ * @brief Force the next input read to go to the bus.
+ *
+ * Safe to call from an interrupt handler.
+ */
+void IO_EXTENSION_Input_Invalidate()
+{
+    IO_EXTENSION.in_valid = false;
 }
 
 /**
  * @brief Set the PWM output value on the IO_EXTENSION device.
- * 
+ *
  * This function sets the PWM output value, which controls the duty cycle of the PWM signal.
  * The duty cycle is calculated based on the input value and the resolution (12 bits).
- * 
+ *
  * @param Value The input value to set the PWM duty cycle (0-100).
  */
 void IO_EXTENSION_Pwm_Output(uint8_t Value)
@@ -104,28 +298,104 @@ void IO_EXTENSION_Pwm_Output(uint8_t Value)
         Value = 97;
     }
 
-    uint8_t data[2] = {IO_EXTENSION_PWM_ADDR, Value}; // Prepare the data to write to the PWM register
     // Calculate the duty cycle based on the resolution (12 bits)
-    data[1] = Value * (255 / 100.0);
-    // Write the 8-bit value to the PWM output register
-    DEV_I2C_Write_Nbyte(IO_EXTENSION.addr, data, 2);
+    IO_EXTENSION_Pwm_Duty(Value * (255 / 100.0));
+}
+
+/**
+ * @brief Write the raw 8-bit PWM register, for fine steps such as gamma corrected fades.
+ *
+ * @param duty The register value, limited to IO_EXTENSION_PWM_DUTY_MAX.
+ */
+void IO_EXTENSION_Pwm_Duty(uint8_t duty)
+{
+    // Prevent the screen from completely turning off
+    if (duty > IO_EXTENSION_PWM_DUTY_MAX)
+    {
+        duty = IO_EXTENSION_PWM_DUTY_MAX;
+    }
+
+    xSemaphoreTake(IO_EXTENSION.bus_lock, portMAX_DELAY);
+    if (IO_EXTENSION.Last_pwm_value != duty) {
+        // Write the 8-bit value to the PWM output register, the shadow only follows a successful write
+        if (IO_EXTENSION_Write_Reg(IO_EXTENSION_PWM_ADDR, duty) == ESP_OK) {
+            IO_EXTENSION.Last_pwm_value = duty;
+        }
+    } else {
+        IO_EXTENSION_Count(&IO_EXTENSION.stats.skipped_cnt);
+    }
+    xSemaphoreGive(IO_EXTENSION.bus_lock);
 }
 
 /**
  * @brief Read the ADC input value from the IO_EXTENSION device.
- * 
+ *
  * This function reads the ADC input value from the IO_EXTENSION device.
- * 
- * @return The ADC input value.
+ *
+ * @return The ADC input value, 0 if the read failed.
  */
 uint16_t IO_EXTENSION_Adc_Input()
 {
+    uint8_t data[2] = {0};
+
+    xSemaphoreTake(IO_EXTENSION.bus_lock, portMAX_DELAY);
     // Read the ADC input value from the IO_EXTENSION device
-    return DEV_I2C_Read_Word(IO_EXTENSION.addr, IO_EXTENSION_ADC_ADDR);
+    if (DEV_I2C_Read_Reg(IO_EXTENSION.addr, IO_EXTENSION_ADC_ADDR, data, 2) != ESP_OK) {
+        data[0] = data[1] = 0;
+    }
+    IO_EXTENSION_Count(&IO_EXTENSION.stats.read_cnt);
+    xSemaphoreGive(IO_EXTENSION.bus_lock);
+
+    return data[1] << 8 | data[0];
 }
 
 uint8_t IO_EXTENSION_RTC_INT_READ()
 {
-    // Read the ADC input value from the IO_EXTENSION device
-    return DEV_I2C_Read_Word(IO_EXTENSION.addr, IO_EXTENSION_RTC_INT_ADDR);
-}
\ No newline at end of file
+    uint8_t data[2] = {0};
+
+    xSemaphoreTake(IO_EXTENSION.bus_lock, portMAX_DELAY);
+    // Read the RTC interrupt state from the IO_EXTENSION device, 0 if the read failed
+    if (DEV_I2C_Read_Reg(IO_EXTENSION.addr, IO_EXTENSION_RTC_INT_ADDR, data, 2) != ESP_OK) {
+        data[0] = 0;
+    }
+    IO_EXTENSION_Count(&IO_EXTENSION.stats.read_cnt);
+    xSemaphoreGive(IO_EXTENSION.bus_lock);
+
+    return data[0];
+}
+
+/**
+ * @brief Read the bus transaction counters.
+ *
+ * @param stats Output counters.
+ * @param reset Set to true to restart the counters after reading them.
+ */
+void IO_EXTENSION_Get_Stats(io_extension_stats_t *stats, bool reset)
+{
+    portENTER_CRITICAL(&IO_EXTENSION.lock);
+    *stats = IO_EXTENSION.stats;
+    if (reset) {
+        memset(&IO_EXTENSION.stats, 0, sizeof(IO_EXTENSION.stats));
+    }
+    portEXIT_CRITICAL(&IO_EXTENSION.lock);
+}
+
+/**
+ * @brief Log the bus transactions per second since the last call, then reset the counters.
+ */
+void IO_EXTENSION_Log_Stats()
+{
+    io_extension_stats_t st;
+    int64_t now_us = esp_timer_get_time();
+    float elapsed_s = (now_us - IO_EXTENSION.stats_since_us) / 1e6f;
+
+    IO_EXTENSION_Get_Stats(&st, true);
+    IO_EXTENSION.stats_since_us = now_us;
+    if (elapsed_s <= 0) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "%.1f transactions/s (write %.1f/s, read %.1f/s), saved: coalesced %"PRIu32", skipped %"PRIu32", cached %"PRIu32,
+             (st.write_cnt + st.read_cnt) / elapsed_s, st.write_cnt / elapsed_s, st.read_cnt / elapsed_s,
+             st.coalesced_cnt, st.skipped_cnt, st.cache_hit_cnt);
+}
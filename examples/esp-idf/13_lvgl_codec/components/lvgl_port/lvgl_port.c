@@ -1,3 +1,4 @@
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
@@ -5,12 +6,36 @@
 #include "esp_lcd_panel_rgb.h"
 #include "esp_timer.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include "lvgl_port.h"
+#include "lvgl_private.h"
+#include "gt911.h"
+#include "gesture.h"
+#if LVGL_PORT_BACKLIGHT_ENABLE
+#include "backlight.h"
+#endif
+#include "file_source.h"
 
 static const char *TAG = "lv_port";                      // Tag for logging
 static SemaphoreHandle_t lvgl_mux;                       // LVGL mutex for synchronization
 static TaskHandle_t lvgl_task_handle = NULL;             // Handle for the LVGL task
 
+// Decoding sessions kept open to pin images in the cache
+static struct {
+    lv_image_decoder_dsc_t dsc[LVGL_PORT_IMG_PIN_MAX];   // Open decoder descriptors
+    bool used[LVGL_PORT_IMG_PIN_MAX];                    // Slot in use flags
+    uint32_t prefetch_hit;                               // Prefetches found in the cache
+    uint32_t prefetch_miss;                              // Prefetches which decoded the image
+    uint32_t alloc_fail;                                 // Failed decoded buffer allocations
+    uint32_t fs_open_cnt;                                // Files opened through the LVGL driver
+    uint32_t fs_open_now;                                // Of these, still open
+    uint32_t fs_read_bytes;                              // Bytes read through the LVGL driver
+} img_pin;
+
+#if LVGL_PORT_IMG_CACHE_SIZE && !LV_BIN_DECODER_RAM_LOAD
+#warning "Set CONFIG_LV_BIN_DECODER_RAM_LOAD, otherwise .bin images are read line by line and never cached"
+#endif
+
 #if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
 // Function to get the next frame buffer for double buffering
 static void *get_next_frame_buffer(esp_lcd_panel_handle_t panel_handle)
@@ -441,25 +466,118 @@ static lv_display_t *display_init(esp_lcd_panel_handle_t panel_handle)
     return display; // Register the display driver
 }
 
+#if LVGL_PORT_GESTURE_ENABLE
+static gesture_t gesture;                       // Multi-touch gesture recognizer state
+static uint32_t gesture_event_code;             // LVGL event code of the gesture events
+static int64_t gesture_last_us = -1;            // Timestamp of the last frame fed to the recognizer
+
+// Feed one frame to the recognizer and send the gestures to the object under the fingers
+static void gesture_feed(const touch_gt911_event_t *frame)
+{
+    gesture_point_t points[ESP_LCD_TOUCH_MAX_POINTS]; // Points in recognizer format
+    gesture_event_t events[GESTURE_MAX_EVENTS]; // Gestures produced by this frame
+
+    if (frame->timestamp_us == gesture_last_us) {
+        return; // Same frame again, don't let it decay the velocities
+    }
+    gesture_last_us = frame->timestamp_us;
+
+    for (int i = 0; i < frame->cnt; i++) {
+        points[i].x = frame->x[i];
+        points[i].y = frame->y[i];
+        points[i].strength = frame->strength[i];
+    }
+#if LVGL_PORT_GESTURE_TRACE
+    char trace[ESP_LCD_TOUCH_MAX_POINTS * 18 + 1]; // " x y strength" per point
+    int len = 0;
+    trace[0] = '\0';
+    for (int i = 0; i < frame->cnt; i++) {
+        len += snprintf(trace + len, sizeof(trace) - len, " %d %d %d", points[i].x, points[i].y, points[i].strength);
+    }
+    ESP_LOGI(TAG, "frame %"PRId64" %d%s", frame->timestamp_us, frame->cnt, trace);
+#endif
+    uint8_t cnt = gesture_process(&gesture, points, frame->cnt, frame->timestamp_us, events, GESTURE_MAX_EVENTS);
+
+    for (int i = 0; i < cnt; i++) {
+#if LVGL_PORT_GESTURE_LOG
+        ESP_LOGI(TAG, "Gesture type %d phase %d dir %d fingers %d at %d,%d d %d,%d v %"PRId32",%"PRId32" scale %"PRId32" rot %"PRId32,
+                 events[i].type, events[i].phase, events[i].dir, events[i].fingers, events[i].x, events[i].y,
+                 events[i].dx, events[i].dy, events[i].vx, events[i].vy, events[i].scale, events[i].rotation);
+#endif
+        lv_point_t center = { .x = events[i].x, .y = events[i].y };
+        lv_obj_t *target = lv_indev_search_obj(lv_screen_active(), &center); // Object under the fingers
+        lv_obj_send_event(target ? target : lv_screen_active(), gesture_event_code, &events[i]);
+    }
+}
+#endif
+
+// Tune the touch prediction to the measured delay between the INT edge and LVGL reading the sample
+static void touch_latency_update(int64_t timestamp_us)
+{
+    static int64_t age_avg_us = 0; // Smoothed sample age
+    static uint32_t sample_cnt = 0; // Samples since the last update of the filter
+
+    int64_t age_us = esp_timer_get_time() - timestamp_us;
+    age_avg_us += (age_us - age_avg_us) / 16; // Exponential average over ~16 samples
+    if (++sample_cnt >= 32) {
+        sample_cnt = 0;
+        touch_gt911_filter_set_prediction((uint32_t)age_avg_us + LVGL_PORT_RENDER_LATENCY_US);
+    }
+}
+
 static void touchpad_read(lv_indev_t *indev, lv_indev_data_t *data)
 {
     esp_lcd_touch_handle_t tp = lv_indev_get_user_data(indev);; // Get touchpad handle from user data
     assert(tp); // Ensure touchpad handle is valid
 
-    uint16_t touchpad_x; // Variable for X coordinate
-    uint16_t touchpad_y; // Variable for Y coordinate
-    uint8_t touchpad_cnt = 0; // Variable for touch count
+    touch_gt911_event_t frame; // All points of the current sample
+
+    /* Drain the samples queued by the interrupt driven reader, no bus access here */
+    if (touch_gt911_reader_is_running()) {
+        if (touch_gt911_event_get(&frame)) {
+            touch_latency_update(frame.timestamp_us); // Measure how old the samples are when LVGL sees them
+        } else {
+            touch_gt911_get_latest(&frame); // Queue empty, keep reporting the current state
+        }
+        data->continue_reading = touch_gt911_event_pending(); // Let LVGL replay every queued sample
+    } else {
+        /* Read data from touch controller into memory */
+        esp_lcd_touch_read_data(tp); // Read data from touch controller
+
+        /* Read data from touch controller */
+        frame.timestamp_us = esp_timer_get_time(); // Time of the sample
+        esp_lcd_touch_get_coordinates(tp, frame.x, frame.y, frame.strength, &frame.cnt, ESP_LCD_TOUCH_MAX_POINTS); // Get touch coordinates
+    }
+
+#if LVGL_PORT_BACKLIGHT_ENABLE
+    /* Hide the whole touch that wakes the blank screen, so it doesn't press a widget nobody could see */
+    static bool waking;
+    if (frame.cnt > 0) {
+        waking |= backlight_notify_activity();
+    } else {
+        waking = false;
+    }
+    if (waking) {
+        frame.cnt = 0;
+    }
+#endif
 
-    /* Read data from touch controller into memory */
-    esp_lcd_touch_read_data(tp); // Read data from touch controller
+#if LVGL_PORT_GESTURE_ENABLE
+    gesture_feed(&frame); // Recognize multi-touch gestures
 
-    /* Read data from touch controller */
-    bool touchpad_pressed = esp_lcd_touch_get_coordinates(tp, &touchpad_x, &touchpad_y, NULL, &touchpad_cnt, 1); // Get touch coordinates
-    if (touchpad_pressed && touchpad_cnt > 0) {
-        data->point.x = touchpad_x; // Set the X coordinate
-        data->point.y = touchpad_y; // Set the Y coordinate
+    /* Drive the pointer with the oldest finger, so it doesn't jump when the controller reorders the points */
+    const gesture_contact_t *primary = gesture_get_primary(&gesture);
+    if (primary) {
+        frame.x[0] = primary->x;
+        frame.y[0] = primary->y;
+    }
+#endif
+
+    if (frame.cnt > 0) {
+        data->point.x = frame.x[0]; // Set the X coordinate
+        data->point.y = frame.y[0]; // Set the Y coordinate
         data->state = LV_INDEV_STATE_PRESSED; // Set state to pressed
-        ESP_LOGD(TAG, "Touch position: %d,%d", touchpad_x, touchpad_y); // Log touch position
+        ESP_LOGD(TAG, "Touch position: %d,%d", frame.x[0], frame.y[0]); // Log touch position
     } else {
         data->state = LV_INDEV_STATE_RELEASED; // Set state to released
     }
@@ -480,9 +598,292 @@ static lv_indev_t *indev_init(esp_lcd_touch_handle_t tp)
     lv_indev_set_user_data(indev, tp);
     lv_indev_set_read_cb(indev, touchpad_read);
 
+#if LVGL_PORT_GESTURE_ENABLE
+    gesture_init(&gesture, NULL); // Default thresholds
+    gesture_event_code = lv_event_register_id(); // Custom event carrying `gesture_event_t *`
+#endif
+
     return indev; // Register the input device driver
 }
 
+static void *img_cache_buf_malloc(size_t size, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+    // Keep room for aligning the buffer, as the default LVGL allocator does
+    void *buf = heap_caps_malloc(size + LV_DRAW_BUF_ALIGN - 1, LVGL_PORT_IMG_CACHE_MALLOC_CAPS);
+    if (buf == NULL) {
+        img_pin.alloc_fail++; // The decoder reports the failure, just count it
+    }
+    return buf;
+}
+
+static void img_cache_buf_free(void *buf)
+{
+    heap_caps_free(buf); // Release the decoded image buffer
+}
+
+// Compare two image sources: paths by content, descriptors by address
+static bool img_src_equal(const void *a, const void *b)
+{
+    lv_image_src_t type = lv_image_src_get_type(a);
+    if (type != lv_image_src_get_type(b)) {
+        return false;
+    }
+    return (type == LV_IMAGE_SRC_FILE) ? (strcmp(a, b) == 0) : (a == b);
+}
+
+#if LVGL_PORT_IMG_CACHE_MONITOR && LV_USE_PERF_MONITOR
+// Notified after the sysmon observer has written the performance text, the cache usage goes below it
+static void img_cache_monitor_cb(lv_observer_t *observer, lv_subject_t *subject)
+{
+    lv_obj_t *label = lv_observer_get_target(observer); // Performance monitor label of the display
+    lvgl_port_img_cache_stats_t stats;
+    char text[96];
+
+    LV_UNUSED(subject);
+    lvgl_port_img_cache_get_stats(&stats);
+    lv_snprintf(text, sizeof(text), "\nimg %" LV_PRIu32 "/%" LV_PRIu32 " KB, pin %" LV_PRIu32 "\nhit %" LV_PRIu32 " miss %" LV_PRIu32 " oom %" LV_PRIu32,
+                stats.used_size / 1024, stats.max_size / 1024, stats.pinned_cnt,
+                stats.prefetch_hit, stats.prefetch_miss, stats.alloc_fail);
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, text);
+}
+
+static void img_cache_monitor_init(void)
+{
+    // Add the cache usage to the sysmon performance monitor, refreshed with it
+    lv_display_t *disp = lv_display_get_default();
+    if (disp && disp->perf_label) {
+        lv_subject_add_observer_obj(&disp->perf_sysmon_backend.subject, img_cache_monitor_cb, disp->perf_label, NULL);
+    }
+}
+#endif
+
+esp_err_t lvgl_port_img_cache_config(uint32_t budget_bytes, uint32_t header_cnt)
+{
+    if (!lv_is_initialized()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Decoded images live in PSRAM, the internal RAM stays free for DMA and stacks
+    lv_draw_buf_handlers_t *handlers = &LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers;
+    handlers->buf_malloc_cb = img_cache_buf_malloc;
+    handlers->buf_free_cb = img_cache_buf_free;
+
+    lv_image_cache_resize(budget_bytes, true);         // Evict immediately when shrinking
+    lv_image_header_cache_resize(header_cnt, true);
+    ESP_LOGI(TAG, "Image cache: %"PRIu32" KB, %"PRIu32" headers", budget_bytes / 1024, header_cnt);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_img_prefetch(const void *src)
+{
+    if (src == NULL || lv_image_src_get_type(src) == LV_IMAGE_SRC_UNKNOWN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Check the cache without decoding
+    if (lv_image_cache_is_enabled()) {
+        lv_image_cache_data_t search_key = {
+            .src = src,
+            .src_type = lv_image_src_get_type(src),
+        };
+        lv_cache_entry_t *entry = lv_cache_acquire(LV_GLOBAL_DEFAULT()->img_cache, &search_key, NULL);
+        if (entry) {
+            lv_cache_release(LV_GLOBAL_DEFAULT()->img_cache, entry, NULL);
+            img_pin.prefetch_hit++;
+            return ESP_OK;
+        }
+    }
+
+    // Opening the image decodes it into the cache, closing only drops the reference
+    lv_image_decoder_dsc_t dsc;
+    if (lv_image_decoder_open(&dsc, src, NULL) != LV_RESULT_OK) {
+        ESP_LOGW(TAG, "Prefetch failed");
+        return ESP_FAIL;
+    }
+    lv_image_decoder_close(&dsc);
+    img_pin.prefetch_miss++;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_img_pin(const void *src)
+{
+    int free_slot = -1;
+
+    if (src == NULL || lv_image_src_get_type(src) == LV_IMAGE_SRC_UNKNOWN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < LVGL_PORT_IMG_PIN_MAX; i++) {
+        if (img_pin.used[i] && img_src_equal(img_pin.dsc[i].src, src)) {
+            return ESP_OK; // Already pinned
+        }
+        if (!img_pin.used[i] && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+    if (free_slot < 0) {
+        ESP_LOGW(TAG, "No free slot to pin the image");
+        return ESP_ERR_NO_MEM;
+    }
+
+    // An open decoder session holds a reference on the cache entry, so it won't be evicted
+    if (lv_image_decoder_open(&img_pin.dsc[free_slot], src, NULL) != LV_RESULT_OK) {
+        ESP_LOGW(TAG, "Pin failed");
+        return ESP_FAIL;
+    }
+    img_pin.used[free_slot] = true;
+
+    return ESP_OK;
+}
+
+void lvgl_port_img_unpin(const void *src)
+{
+    if (src == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < LVGL_PORT_IMG_PIN_MAX; i++) {
+        if (img_pin.used[i] && img_src_equal(img_pin.dsc[i].src, src)) {
+            lv_image_decoder_close(&img_pin.dsc[i]); // Drop the reference, the entry stays cached until evicted
+            img_pin.used[i] = false;
+            return;
+        }
+    }
+}
+
+void lvgl_port_img_unpin_all(void)
+{
+    for (int i = 0; i < LVGL_PORT_IMG_PIN_MAX; i++) {
+        if (img_pin.used[i]) {
+            lv_image_decoder_close(&img_pin.dsc[i]);
+            img_pin.used[i] = false;
+        }
+    }
+}
+
+void lvgl_port_img_cache_get_stats(lvgl_port_img_cache_stats_t *stats)
+{
+    assert(stats);
+
+    lv_cache_t *img_cache = LV_GLOBAL_DEFAULT()->img_cache;
+    lv_cache_t *header_cache = LV_GLOBAL_DEFAULT()->img_header_cache;
+
+    stats->max_size = img_cache ? lv_cache_get_max_size(img_cache, NULL) : 0;
+    stats->used_size = img_cache ? lv_cache_get_size(img_cache, NULL) : 0;
+    stats->header_cnt = header_cache ? lv_cache_get_max_size(header_cache, NULL) : 0;
+    stats->pinned_cnt = 0;
+    for (int i = 0; i < LVGL_PORT_IMG_PIN_MAX; i++) {
+        stats->pinned_cnt += img_pin.used[i] ? 1 : 0;
+    }
+    stats->prefetch_hit = img_pin.prefetch_hit;
+    stats->prefetch_miss = img_pin.prefetch_miss;
+    stats->alloc_fail = img_pin.alloc_fail;
+    stats->fs_open_cnt = img_pin.fs_open_cnt;
+    stats->fs_read_bytes = img_pin.fs_read_bytes;
+}
+
+void lvgl_port_img_cache_log_stats(void)
+{
+    lvgl_port_img_cache_stats_t stats;
+
+    if (!lvgl_port_lock(-1)) {
+        return;
+    }
+    lvgl_port_img_cache_get_stats(&stats);
+    lvgl_port_unlock();
+
+    ESP_LOGI(TAG, "Image cache: %" PRIu32 "/%" PRIu32 " KB, %" PRIu32 " pinned, prefetch hit %" PRIu32 " miss %" PRIu32 ", %" PRIu32 " alloc failures, card %" PRIu32 " opens %" PRIu32 " KB",
+             stats.used_size / 1024, stats.max_size / 1024, stats.pinned_cnt,
+             stats.prefetch_hit, stats.prefetch_miss, stats.alloc_fail,
+             stats.fs_open_cnt, stats.fs_read_bytes / 1024);
+}
+
+// LVGL file system driver on file_source, the drive root is kept in user_data
+static void *fs_open_cb(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode)
+{
+    char full[128];
+
+    if (mode != LV_FS_MODE_RD) {
+        return NULL;                                     // Read only
+    }
+    if (snprintf(full, sizeof(full), "%s%s", (const char *)drv->user_data, path) >= (int)sizeof(full)) {
+        return NULL;
+    }
+    // The file source slots are shared with the player, LVGL only gets its own share
+    if (img_pin.fs_open_now >= LVGL_PORT_FS_MAX_OPEN) {
+        ESP_LOGW(TAG, "%d files already open by LVGL, '%s' not opened", LVGL_PORT_FS_MAX_OPEN, full);
+        return NULL;
+    }
+    file_source_t *src = file_source_open_ring(full, LVGL_PORT_FS_RING_SIZE);
+    if (src) {
+        img_pin.fs_open_cnt++;
+        img_pin.fs_open_now++;
+    }
+    return src;
+}
+
+static lv_fs_res_t fs_close_cb(lv_fs_drv_t *drv, void *file_p)
+{
+    file_source_close(file_p);
+    img_pin.fs_open_now--;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read_cb(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    *br = file_source_read(file_p, buf, btr);
+    img_pin.fs_read_bytes += *br;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek_cb(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    int w = (whence == LV_FS_SEEK_END) ? SEEK_END : (whence == LV_FS_SEEK_CUR) ? SEEK_CUR : SEEK_SET;
+    long offset = (whence == LV_FS_SEEK_SET) ? (long)pos : (long)(int32_t)pos; // Relative seeks may go back
+
+    return file_source_seek(file_p, offset, w) < 0 ? LV_FS_RES_INV_PARAM : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell_cb(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p)
+{
+    *pos_p = file_source_tell(file_p);
+    return LV_FS_RES_OK;
+}
+
+esp_err_t lvgl_port_fs_register(char letter, const char *root)
+{
+    static lv_fs_drv_t drv;                              // LVGL keeps a pointer to the driver
+
+    if (letter < 'A' || letter > 'Z' || root == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!lv_is_initialized()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (drv.letter) {
+        drv.letter = letter;                             // Registered already, only move it
+        drv.user_data = (void *)root;
+        return ESP_OK;
+    }
+
+    lv_fs_drv_init(&drv);
+    drv.letter = letter;
+    drv.cache_size = 0;                                  // file_source buffers already
+    drv.open_cb = fs_open_cb;
+    drv.close_cb = fs_close_cb;
+    drv.read_cb = fs_read_cb;
+    drv.seek_cb = fs_seek_cb;
+    drv.tell_cb = fs_tell_cb;
+    drv.user_data = (void *)root;
+    lv_fs_drv_register(&drv);
+    ESP_LOGI(TAG, "File system '%c:' on %s through file_source", letter, root);
+
+    return ESP_OK;
+}
+
 static void tick_increment(void *arg)
 {
     /* Tell LVGL how many milliseconds have elapsed */
@@ -525,6 +926,7 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
 {
     lv_init(); // Initialize LVGL
     ESP_ERROR_CHECK(tick_init()); // Initialize the tick timer
+    ESP_ERROR_CHECK(lvgl_port_img_cache_config(LVGL_PORT_IMG_CACHE_SIZE, LVGL_PORT_IMG_HEADER_CACHE_CNT)); // Set up the image cache in PSRAM
 
     lv_display_t *disp = display_init(lcd_handle); // Initialize the display
     assert(disp); // Ensure the display initialization was successful
@@ -546,6 +948,10 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
 #endif
     }
 
+#if LVGL_PORT_IMG_CACHE_MONITOR && LV_USE_PERF_MONITOR
+    img_cache_monitor_init(); // Show the image cache usage
+#endif
+
     lvgl_mux = xSemaphoreCreateRecursiveMutex(); // Create a recursive mutex for LVGL
     assert(lvgl_mux); // Ensure mutex creation was successful
 
@@ -561,6 +967,15 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
     return ESP_OK; // Return success
 }
 
+uint32_t lvgl_port_get_gesture_event_code(void)
+{
+#if LVGL_PORT_GESTURE_ENABLE
+    return gesture_event_code; // Registered in indev_init
+#else
+    return 0;
+#endif
+}
+
 bool lvgl_port_lock(int timeout_ms)
 {
     assert(lvgl_mux && "lvgl_port_init must be called first"); // Ensure the mutex is initialized
@@ -14,6 +14,11 @@
 #define LVGL_PORT_H_RES             (800)
 #define LVGL_PORT_V_RES             (480)
 #define LVGL_PORT_TICK_PERIOD_MS    (2)
+#define LVGL_PORT_GESTURE_ENABLE    (1)     // Set to 1 to recognize multi-touch gestures, see lvgl_port_get_gesture_event_code()
+#define LVGL_PORT_GESTURE_LOG       (0)     // Set to 1 to log every recognized gesture, to check the thresholds on the board
+#define LVGL_PORT_GESTURE_TRACE     (0)     // Set to 1 to log every touch frame, in the trace format of components/gesture/host_test
+#define LVGL_PORT_RENDER_LATENCY_US (16000) // Render and scan-out time added to the measured touch delivery time for prediction
+#define LVGL_PORT_BACKLIGHT_ENABLE  (1)     // Set to 1 to report touches to the backlight service, a touch on the blank screen only wakes it
 
 
 /**
@@ -48,6 +53,20 @@
 #endif
 #define LVGL_PORT_BUFFER_HEIGHT         (100)
 
+/**
+ * LVGL image cache related parameters, can be adjusted by users:
+ *  (Only decoded sources such as files on the SD card or compressed images use the cache,
+ *   uncompressed C arrays are drawn directly from flash)
+ *
+ */
+#define LVGL_PORT_IMG_CACHE_SIZE        (4 * 1024 * 1024)                   // Budget of the decoded image cache, in bytes, `0` disables it
+#define LVGL_PORT_IMG_HEADER_CACHE_CNT  (32)                                // Number of cached image headers, `0` disables it
+#define LVGL_PORT_IMG_CACHE_MALLOC_CAPS (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) // Memory type of the decoded images
+#define LVGL_PORT_IMG_PIN_MAX           (8)                                 // Maximum number of images pinned at the same time
+#define LVGL_PORT_IMG_CACHE_MONITOR     (1)                                 // Set to 1 to add the cache usage to the sysmon performance monitor
+#define LVGL_PORT_FS_RING_SIZE          (16 * 1024)                         // Read-ahead ring of a file opened by LVGL, read in halves
+#define LVGL_PORT_FS_MAX_OPEN           (2)                                 // Files LVGL may hold open, an image being decoded and a header probe
+
 /**
  * Avoid tering related configurations, can be adjusted by users.
  *
@@ -115,6 +134,22 @@
 #define LVGL_PORT_DIRECT_MODE           (0)
 #endif /* LVGL_PORT_AVOID_TEAR_ENABLE */
 
+/**
+ * @brief Image cache statistics
+ *
+ */
+typedef struct {
+    uint32_t max_size;      // Budget of the decoded image cache, in bytes
+    uint32_t used_size;     // Bytes currently held by decoded images
+    uint32_t header_cnt;    // Capacity of the image header cache
+    uint32_t pinned_cnt;    // Number of pinned images
+    uint32_t prefetch_hit;  // Prefetches which found the image already decoded
+    uint32_t prefetch_miss; // Prefetches which had to decode the image
+    uint32_t alloc_fail;    // Failed allocations of decoded image buffers
+    uint32_t fs_open_cnt;   // Files opened through `lvgl_port_fs_register()`, counts cache misses on the card
+    uint32_t fs_read_bytes; // Bytes read through `lvgl_port_fs_register()`
+} lvgl_port_img_cache_stats_t;
+
 /**
  * @brief Initialize LVGL port
  *
@@ -153,3 +188,113 @@ void lvgl_port_unlock(void);
  *      - false: The tasks don't need to be re-scheduled
  */
 bool lvgl_port_notify_rgb_vsync(void);
+
+/**
+ * @brief Get the LVGL event code of multi-touch gestures
+ *
+ * Gestures (long press, swipe, pinch, rotate, two-finger swipe) are sent to the object
+ * under the fingers, or to the active screen. Use `lv_event_get_param(e)` to get the
+ * `const gesture_event_t *`, see gesture.h.
+ *
+ * @return Event code to pass to `lv_obj_add_event_cb()`, 0 if gestures are disabled
+ */
+uint32_t lvgl_port_get_gesture_event_code(void);
+
+/**
+ * @brief Resize the image cache, decoded images are allocated with `LVGL_PORT_IMG_CACHE_MALLOC_CAPS`
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ *
+ * @param[in] budget_bytes: Budget of the decoded image cache in bytes, `0` disables it
+ * @param[in] header_cnt: Number of cached image headers, `0` disables it
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: LVGL is not initialized
+ */
+esp_err_t lvgl_port_img_cache_config(uint32_t budget_bytes, uint32_t header_cnt);
+
+/**
+ * @brief Decode an image into the cache ahead of its first draw
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ *
+ * @param[in] src: Image source, a file path (e.g. "S:/music/cover.bin") or an `lv_image_dsc_t`
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_FAIL: The image can't be decoded
+ */
+esp_err_t lvgl_port_img_prefetch(const void *src);
+
+/**
+ * @brief Decode an image and keep it in the cache until it is unpinned
+ *
+ * `.bin` files are decoded whole and closed only with CONFIG_LV_BIN_DECODER_RAM_LOAD,
+ * without it LVGL reads them line by line at each draw and nothing is cached.
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ *
+ * @param[in] src: Image source, a file path or an `lv_image_dsc_t`
+ *
+ * @return
+ *      - ESP_OK: Success (also when the image is pinned already)
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Too many pinned images
+ *      - ESP_FAIL: The image can't be decoded
+ */
+esp_err_t lvgl_port_img_pin(const void *src);
+
+/**
+ * @brief Release an image pinned by `lvgl_port_img_pin()`, it can be evicted afterwards
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ *
+ * @param[in] src: Image source passed to `lvgl_port_img_pin()`
+ */
+void lvgl_port_img_unpin(const void *src);
+
+/**
+ * @brief Release all pinned images
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ */
+void lvgl_port_img_unpin_all(void);
+
+/**
+ * @brief Get the image cache statistics
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ *
+ * @param[out] stats: Statistics of the image cache
+ */
+void lvgl_port_img_cache_get_stats(lvgl_port_img_cache_stats_t *stats);
+
+/**
+ * @brief Log the image cache statistics, the card opens stay flat while cached images are drawn
+ *
+ * @note This function takes the LVGL mutex.
+ */
+void lvgl_port_img_cache_log_stats(void);
+
+/**
+ * @brief Register an LVGL file system driver that reads through `file_source`
+ *
+ * Images and fonts loaded with paths such as "S:/music/cover.bin" are then read from a
+ * small PSRAM ring of `LVGL_PORT_FS_RING_SIZE` filled by the file source reader task, so
+ * a header probe costs one short SD read. At most `LVGL_PORT_FS_MAX_OPEN` files are open
+ * at once, the other file source slots stay free for the player. Read only. Don't enable
+ * an LVGL driver such as CONFIG_LV_USE_FS_STDIO on the same letter.
+ *
+ * @note The LVGL mutex must be taken before calling this function.
+ *
+ * @param[in] letter: Drive letter, e.g. 'S'
+ * @param[in] root: Directory the drive starts at, e.g. "/sdcard", kept by reference
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_STATE: LVGL is not initialized
+ */
+esp_err_t lvgl_port_fs_register(char letter, const char *root);
@@ -21,53 +21,55 @@ const unsigned char MonthStr[12][4] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
 /**
  * Initialize PCF85063A 
  **/
-void PCF85063A_Init()
+esp_err_t PCF85063A_Init()
 {
 	// Set the I2C slave address for the IO_EXTENSION device
     DEV_I2C_Set_Slave_Addr(&RTC_DEV, PCF85063A_ADDRESS);
+    // Time keeping is housekeeping, let touch and control traffic go first
+    i2c_sched_register_device(RTC_DEV, PCF85063A_ADDRESS, "rtc", I2C_SCHED_PRIO_LOW);
 
 	uint8_t Value = RTC_CTRL_1_DEFAULT | RTC_CTRL_1_CAP_SEL;
-	DEV_I2C_Write_Byte(RTC_DEV, RTC_CTRL_1_ADDR, Value);
+	return DEV_I2C_Write_Reg(RTC_DEV, RTC_CTRL_1_ADDR, Value);
 }
 
 /**
  * Software reset PCF85063A 
  **/
-void PCF85063A_Reset()
+esp_err_t PCF85063A_Reset()
 {
 	uint8_t Value = RTC_CTRL_1_DEFAULT | RTC_CTRL_1_CAP_SEL | RTC_CTRL_1_SR;
-	DEV_I2C_Write_Byte(RTC_DEV, RTC_CTRL_1_ADDR, Value);
+	return DEV_I2C_Write_Reg(RTC_DEV, RTC_CTRL_1_ADDR, Value);
 }
 
 /**
  * Set RTC time 
  **/
-void PCF85063A_Set_Time(datetime_t time)
+esp_err_t PCF85063A_Set_Time(datetime_t time)
 {
 	uint8_t buf[4] = {RTC_SECOND_ADDR,
 					  decToBcd(time.sec),
 					  decToBcd(time.min),
 					  decToBcd(time.hour)};
-	DEV_I2C_Write_Nbyte(RTC_DEV, buf, 4);
+	return DEV_I2C_Write(RTC_DEV, buf, 4);
 }
 
 /**
  * Set RTC date 
  **/
-void PCF85063A_Set_Date(datetime_t date)
+esp_err_t PCF85063A_Set_Date(datetime_t date)
 {
 	uint8_t buf[5] = {RTC_DAY_ADDR,
 					  decToBcd(date.day),
 					  decToBcd(date.dotw),
 					  decToBcd(date.month),
 					  decToBcd(date.year - YEAR_OFFSET)};
-	DEV_I2C_Write_Nbyte(RTC_DEV, buf, 5);
+	return DEV_I2C_Write(RTC_DEV, buf, 5);
 }
 
 /**
  * Set both RTC time and date 
  **/
-void PCF85063A_Set_All(datetime_t time)
+esp_err_t PCF85063A_Set_All(datetime_t time)
 {
 	uint8_t buf[8] = {RTC_SECOND_ADDR,
 					  decToBcd(time.sec),
@@ -77,16 +79,19 @@ void PCF85063A_Set_All(datetime_t time)
 					  decToBcd(time.dotw),
 					  decToBcd(time.month),
 					  decToBcd(time.year - YEAR_OFFSET)};
-	DEV_I2C_Write_Nbyte(RTC_DEV, buf, 8);
+	return DEV_I2C_Write(RTC_DEV, buf, 8);
 }
 
 /**
  * Read current RTC time and date 
  **/
-void PCF85063A_Read_now(datetime_t *time)
+esp_err_t PCF85063A_Read_now(datetime_t *time)
 {
 	uint8_t bufss[7] = {0};
-	DEV_I2C_Read_Nbyte(RTC_DEV, RTC_SECOND_ADDR, bufss, 7);
+	esp_err_t ret = DEV_I2C_Read_Reg(RTC_DEV, RTC_SECOND_ADDR, bufss, 7);
+	if (ret != ESP_OK) {
+		return ret; // Leave the previous time untouched
+	}
 	time->sec = bcdToDec(bufss[0] & 0x7F);
 	time->min = bcdToDec(bufss[1] & 0x7F);
 	time->hour = bcdToDec(bufss[2] & 0x3F);
@@ -94,16 +99,17 @@ void PCF85063A_Read_now(datetime_t *time)
 	time->dotw = bcdToDec(bufss[4] & 0x07);
 	time->month = bcdToDec(bufss[5] & 0x1F);
 	time->year = bcdToDec(bufss[6]) + YEAR_OFFSET;
+	return ESP_OK;
 }
 
 /**
  * Enable Alarm and Clear Alarm flag 
  **/
-void PCF85063A_Enable_Alarm()
+esp_err_t PCF85063A_Enable_Alarm()
 {
 	uint8_t Value = RTC_CTRL_2_DEFAULT | RTC_CTRL_2_AIE;
 	Value &= ~RTC_CTRL_2_AF;
-	DEV_I2C_Write_Byte(RTC_DEV, RTC_CTRL_2_ADDR, Value);
+	return DEV_I2C_Write_Reg(RTC_DEV, RTC_CTRL_2_ADDR, Value);
 }
 
 /**
@@ -112,7 +118,9 @@ void PCF85063A_Enable_Alarm()
 uint8_t PCF85063A_Get_Alarm_Flag()
 {
 	uint8_t Value = 0;
-	DEV_I2C_Read_Nbyte(RTC_DEV, RTC_CTRL_2_ADDR, &Value, 1);
+	if (DEV_I2C_Read_Reg(RTC_DEV, RTC_CTRL_2_ADDR, &Value, 1) != ESP_OK) {
+		return 0; // Report no alarm when the RTC can't be read
+	}
 	Value &= RTC_CTRL_2_AF | RTC_CTRL_2_AIE;
 	return Value;
 }
@@ -120,7 +128,7 @@ uint8_t PCF85063A_Get_Alarm_Flag()
 /**
  * Set Alarm time 
  **/
-void PCF85063A_Set_Alarm(datetime_t time)
+esp_err_t PCF85063A_Set_Alarm(datetime_t time)
 {
 	uint8_t buf[6] = {
 		RTC_SECOND_ALARM,
@@ -130,19 +138,22 @@ void PCF85063A_Set_Alarm(datetime_t time)
 		RTC_ALARM, // Disable day 
 		RTC_ALARM  // Disable weekday 
 	};
-	DEV_I2C_Write_Nbyte(RTC_DEV, buf, 6);
+	return DEV_I2C_Write(RTC_DEV, buf, 6);
 }
 
 /**
  * Read the alarm time set 
  **/
-void PCF85063A_Read_Alarm(datetime_t *time)
+esp_err_t PCF85063A_Read_Alarm(datetime_t *time)
 {
 	// Define a buffer to store the alarm time
 	uint8_t bufss[7] = {0};
 
 	// Read 7 bytes of data from the RTC alarm register
-	DEV_I2C_Read_Nbyte(RTC_DEV, RTC_SECOND_ALARM, bufss, 7);
+	esp_err_t ret = DEV_I2C_Read_Reg(RTC_DEV, RTC_SECOND_ALARM, bufss, 7);
+	if (ret != ESP_OK) {
+		return ret;
+	}
 	
 	// Convert the BCD format seconds, minutes, hours, day, and weekday into decimal and store them in the time structure
 	time->sec = bcdToDec(bufss[0] & 0x7F);	// Seconds, up to 7 valid bits, mask processing 										
@@ -150,6 +161,7 @@ void PCF85063A_Read_Alarm(datetime_t *time)
 	time->hour = bcdToDec(bufss[2] & 0x3F); // Hours, 24-hour format, up to 6 valid bits, mask processing 										 
 	time->day = bcdToDec(bufss[3] & 0x3F);	// Date, up to 6 valid bits, mask processing 										
 	time->dotw = bcdToDec(bufss[4] & 0x07); // Day of the week, up to 3 valid bits, mask processing 									
+	return ESP_OK;
 }
 
 /**
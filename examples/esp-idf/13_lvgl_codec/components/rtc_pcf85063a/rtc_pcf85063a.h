@@ -98,19 +98,19 @@ typedef struct {
     uint8_t sec;      // Second 
 } datetime_t;
 
-void PCF85063A_Init(void); // Initialize PCF85063A 
-void PCF85063A_Reset(void); // Reset PCF85063A 
+esp_err_t PCF85063A_Init(void); // Initialize PCF85063A 
+esp_err_t PCF85063A_Reset(void); // Reset PCF85063A 
 
-void PCF85063A_Set_Time(datetime_t time); // Set time on PCF85063A 
-void PCF85063A_Set_Date(datetime_t date); // Set date on PCF85063A 
-void PCF85063A_Set_All(datetime_t time); // Set both time and date on PCF85063A 
+esp_err_t PCF85063A_Set_Time(datetime_t time); // Set time on PCF85063A 
+esp_err_t PCF85063A_Set_Date(datetime_t date); // Set date on PCF85063A 
+esp_err_t PCF85063A_Set_All(datetime_t time); // Set both time and date on PCF85063A 
 
-void PCF85063A_Read_now(datetime_t *time); // Read current time from PCF85063A 
+esp_err_t PCF85063A_Read_now(datetime_t *time); // Read current time from PCF85063A 
 
-void PCF85063A_Enable_Alarm(void); // Enable alarm on PCF85063A 
+esp_err_t PCF85063A_Enable_Alarm(void); // Enable alarm on PCF85063A 
 uint8_t PCF85063A_Get_Alarm_Flag(); // Get alarm flag from PCF85063A 
-void PCF85063A_Set_Alarm(datetime_t time); // Set alarm time on PCF85063A 
-void PCF85063A_Read_Alarm(datetime_t *time); // Read alarm time from PCF85063A 
+esp_err_t PCF85063A_Set_Alarm(datetime_t time); // Set alarm time on PCF85063A 
+esp_err_t PCF85063A_Read_Alarm(datetime_t *time); // Read alarm time from PCF85063A 
 
 void datetime_to_str(char *datetime_str, datetime_t time); // Convert datetime to string 
 
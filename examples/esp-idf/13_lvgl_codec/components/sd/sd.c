@@ -33,6 +33,7 @@ esp_err_t sd_mmc_init() {
     esp_err_t ret;
 
     IO_EXTENSION_Output(IO_EXTENSION_IO_4, true) ;
+    IO_EXTENSION_Flush(); // The card must see CS high before it is probed
     // Configuration for mounting the FAT filesystem
     esp_vfs_fat_sdmmc_mount_config_t mount_config = {
         .format_if_mount_failed = EXAMPLE_FORMAT_IF_MOUNT_FAILED, // Format if mount fails
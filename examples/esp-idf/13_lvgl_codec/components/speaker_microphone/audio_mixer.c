@@ -0,0 +1,578 @@
+/*****************************************************************************
+ * | File         :   audio_mixer.c
+ * | Author       :   Waveshare team
+ * | Function     :   Software mixer for the speaker
+ * | Info         :
+ * |                 Sources write into their own frame ring. The mixer
+ * |                 task resamples every ring to the codec rate with a
+ * |                 windowed-sinc polyphase filter, sums them with their
+ * |                 gains and writes the soft clipped result to I2S.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include "audio_mixer.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "codec_dev.h"
+
+static const char *TAG = "audio_mixer";
+
+#define SRC_HALF            (AUDIO_MIXER_SRC_TAPS / 2)
+#define SRC_PHASE_SHIFT     (16 - __builtin_ctz(AUDIO_MIXER_SRC_PHASES))
+#define SRC_HISTORY         (AUDIO_MIXER_SRC_TAPS - 1)
+#define WORK_FRAMES         (AUDIO_MIXER_SRC_TAPS + AUDIO_MIXER_FRAME_SAMPLES * AUDIO_MIXER_MAX_RATIO + 1)
+#define RING_MASK           (AUDIO_MIXER_SOURCE_FRAMES - 1)
+#define BLOCK_US            ((uint32_t)((uint64_t)AUDIO_MIXER_FRAME_SAMPLES * 1000000 / AUDIO_MIXER_SAMPLE_RATE))
+
+#if (AUDIO_MIXER_SOURCE_FRAMES & RING_MASK) || (AUDIO_MIXER_SRC_PHASES & (AUDIO_MIXER_SRC_PHASES - 1))
+#error "AUDIO_MIXER_SOURCE_FRAMES and AUDIO_MIXER_SRC_PHASES must be powers of two"
+#endif
+
+struct audio_mixer_source {
+    int16_t *ring;                  // Stereo frames at the source rate
+    uint32_t head;                  // Frames written, free running, writer only
+    uint32_t tail;                  // Frames taken, free running, mixer only
+    SemaphoreHandle_t space;        // Given by the mixer after taking frames
+    volatile uint32_t gain;         // Q14
+    volatile bool mute;
+    volatile uint32_t rate_req;     // Rate of the frames written from now on
+    uint8_t bits;                   // Writer side format
+    uint8_t ch;
+
+    // Resampler state, owned by the mixer task
+    volatile uint32_t rate;
+    uint32_t step;                  // Source frames per output frame, Q16
+    uint32_t pos;                   // Position of the next output frame in work[], Q16
+    uint32_t fill;                  // Frames in work[]
+    bool bypass;                    // Same rate as the codec, frames are copied
+    bool active;                    // Filled the last block
+    int16_t coef[AUDIO_MIXER_SRC_PHASES + 1][AUDIO_MIXER_SRC_TAPS];  // The extra phase closes the interpolation
+    int16_t work[WORK_FRAMES * 2];
+
+    audio_mixer_source_stats_t stats;
+};
+
+static TaskHandle_t s_task;
+static SemaphoreHandle_t s_lock;    // Guards the source slots, held by the mixer while it mixes a block
+static SemaphoreHandle_t s_data;    // Wakes the idle mixer
+static audio_mixer_source_t *s_sources[AUDIO_MIXER_MAX_SOURCES];
+static int32_t s_acc[AUDIO_MIXER_FRAME_SAMPLES * 2];
+static int16_t s_out[AUDIO_MIXER_FRAME_SAMPLES * 2];
+
+static uint32_t s_frames;
+static uint32_t s_clipped;
+static uint32_t s_mix_blocks;
+static uint64_t s_mix_us_total;
+static uint32_t s_mix_us_max;
+
+/**************************************************************************************************
+ *
+ * Resampler
+ *
+ **************************************************************************************************/
+
+// Build the filter bank for a source rate and clear the history
+static void src_design(audio_mixer_source_t *src, uint32_t rate)
+{
+    memset(src->work, 0, sizeof(src->work));
+    src->step = ((uint64_t)rate << 16) / AUDIO_MIXER_SAMPLE_RATE;
+    src->bypass = (rate == AUDIO_MIXER_SAMPLE_RATE);
+    src->pos = src->bypass ? 0 : (SRC_HALF - 1) << 16;
+    src->fill = src->bypass ? 0 : SRC_HISTORY;
+    src->rate = rate;
+    if (src->bypass) {
+        return;
+    }
+
+    // Cutoff at 90% of the lower Nyquist frequency, in cycles per source frame
+    const float fc = 0.45f * (rate <= AUDIO_MIXER_SAMPLE_RATE ? 1.0f : (float)AUDIO_MIXER_SAMPLE_RATE / rate);
+    float h[AUDIO_MIXER_SRC_TAPS];
+
+    for (int p = 0; p <= AUDIO_MIXER_SRC_PHASES; p++) {
+        const float frac = (float)p / AUDIO_MIXER_SRC_PHASES;
+        float sum = 0.0f;
+
+        for (int k = 0; k < AUDIO_MIXER_SRC_TAPS; k++) {
+            const float x = k - (SRC_HALF - 1) - frac;      // Distance of the tap from the output
+            const float t = (x + SRC_HALF) / AUDIO_MIXER_SRC_TAPS;
+            const float w = 0.42f - 0.5f * cosf(2.0f * (float)M_PI * t) + 0.08f * cosf(4.0f * (float)M_PI * t);
+            const float a = 2.0f * (float)M_PI * fc * x;
+            h[k] = w * (x == 0.0f ? 1.0f : sinf(a) / a);
+            sum += h[k];
+        }
+        for (int k = 0; k < AUDIO_MIXER_SRC_TAPS; k++) {
+            src->coef[p][k] = (int16_t)lrintf(h[k] / sum * 32767.0f);
+        }
+    }
+}
+
+static uint32_t src_ring_count(audio_mixer_source_t *src)
+{
+    return __atomic_load_n(&src->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&src->tail, __ATOMIC_ACQUIRE);
+}
+
+// Move frames from the ring into work[] until it holds `needed` frames
+static void src_pull(audio_mixer_source_t *src, uint32_t needed)
+{
+    uint32_t avail = src_ring_count(src);
+    uint32_t take;
+
+    if (needed > WORK_FRAMES) {
+        needed = WORK_FRAMES;
+    }
+    if (needed <= src->fill || avail == 0) {
+        return;
+    }
+    take = needed - src->fill;
+    if (take > avail) {
+        take = avail;
+    }
+
+    for (uint32_t done = 0; done < take;) {
+        uint32_t idx = (src->tail + done) & RING_MASK;
+        uint32_t n = AUDIO_MIXER_SOURCE_FRAMES - idx;
+        if (n > take - done) {
+            n = take - done;
+        }
+        memcpy(&src->work[(src->fill + done) * 2], &src->ring[idx * 2], n * 2 * sizeof(int16_t));
+        done += n;
+    }
+    src->fill += take;
+    __atomic_store_n(&src->tail, src->tail + take, __ATOMIC_RELEASE);
+    xSemaphoreGive(src->space);
+}
+
+static bool src_has_audio(audio_mixer_source_t *src)
+{
+    if (src_ring_count(src)) {
+        return true;
+    }
+    return src->bypass ? src->fill > 0 : (src->pos >> 16) + SRC_HALF < src->fill;
+}
+
+// Resample up to `frames` output frames of a source and add them to acc, returns the frames made
+static uint32_t src_mix(audio_mixer_source_t *src, int32_t *acc, uint32_t frames)
+{
+    const int32_t gain = src->mute ? 0 : src->gain;
+    uint32_t shift;
+    uint32_t n = 0;
+
+    if (src->bypass) {
+        src_pull(src, frames);
+        n = frames < src->fill ? frames : src->fill;
+        for (uint32_t i = 0; i < n * 2; i++) {
+            acc[i] += (src->work[i] * gain) >> 14;
+        }
+        shift = n;
+    } else {
+        src_pull(src, ((src->pos + (frames - 1) * src->step) >> 16) + SRC_HALF + 1);
+        while (n < frames) {
+            const uint32_t i = src->pos >> 16;
+            if (i + SRC_HALF >= src->fill) {
+                break;
+            }
+            const int16_t *x = &src->work[(i - (SRC_HALF - 1)) * 2];
+            const uint32_t phase = (src->pos >> SRC_PHASE_SHIFT) & (AUDIO_MIXER_SRC_PHASES - 1);
+            const int32_t frac = src->pos & ((1 << SRC_PHASE_SHIFT) - 1);
+            const int16_t *h0 = src->coef[phase];
+            const int16_t *h1 = src->coef[phase + 1];
+            int32_t l = 0;
+            int32_t r = 0;
+            // Interpolate between neighbouring phases, nearest phase alone limits the SNR to about 40 dB
+            for (int k = 0; k < AUDIO_MIXER_SRC_TAPS; k++) {
+                const int32_t h = h0[k] + (((h1[k] - h0[k]) * frac) >> SRC_PHASE_SHIFT);
+                l += x[2 * k] * h;
+                r += x[2 * k + 1] * h;
+            }
+            acc[2 * n] += ((l >> 15) * gain) >> 14;
+            acc[2 * n + 1] += ((r >> 15) * gain) >> 14;
+            src->pos += src->step;
+            n++;
+        }
+        // Keep the taps still needed by the next output as history
+        shift = (src->pos >> 16) - (SRC_HALF - 1);
+        if (shift > src->fill) {
+            shift = src->fill;
+        }
+        src->pos -= shift << 16;
+    }
+
+    if (shift) {
+        memmove(src->work, &src->work[shift * 2], (src->fill - shift) * 2 * sizeof(int16_t));
+        src->fill -= shift;
+    }
+    return n;
+}
+
+// Pass quiet sums, bend loud ones towards full scale instead of cutting them off
+static inline int16_t soft_clip(int32_t x)
+{
+    const int32_t range = 32767 - AUDIO_MIXER_SOFT_KNEE;
+    int32_t a = x < 0 ? -x : x;
+
+    if (a <= AUDIO_MIXER_SOFT_KNEE) {
+        return x;
+    }
+    s_clipped++;
+    a -= AUDIO_MIXER_SOFT_KNEE;
+    a = AUDIO_MIXER_SOFT_KNEE + (int32_t)((int64_t)a * range / (a + range));
+    return x < 0 ? -a : a;
+}
+
+/**************************************************************************************************
+ *
+ * Mixer Task
+ *
+ **************************************************************************************************/
+
+static void mixer_task(void *arg)
+{
+    size_t written;
+
+    while (1) {
+        const int64_t start_us = esp_timer_get_time();
+        bool any = false;
+
+        memset(s_acc, 0, sizeof(s_acc));
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+            audio_mixer_source_t *src = s_sources[i];
+            if (!src) {
+                continue;
+            }
+            // A new format starts once the frames of the old one are gone, from the ring and from work[]
+            if (src->rate_req != src->rate && !src_has_audio(src)) {
+                src_design(src, src->rate_req);
+            }
+            if (!src_has_audio(src)) {
+                src->active = false;
+                continue;
+            }
+
+            uint32_t n = src_mix(src, s_acc, AUDIO_MIXER_FRAME_SAMPLES);
+            if (n < AUDIO_MIXER_FRAME_SAMPLES && src->active) {
+                src->stats.underruns++;
+            }
+            src->active = (n == AUDIO_MIXER_FRAME_SAMPLES);
+            src->stats.frames_out += n;
+            any |= (n > 0);
+        }
+        xSemaphoreGive(s_lock);
+
+        if (!any) {
+            // Nothing to play, the I2S DMA sends silence on its own
+            xSemaphoreTake(s_data, pdMS_TO_TICKS(20));
+            continue;
+        }
+
+        for (int i = 0; i < AUDIO_MIXER_FRAME_SAMPLES * 2; i++) {
+            s_out[i] = soft_clip(s_acc[i]);
+        }
+
+        uint32_t mix_us = esp_timer_get_time() - start_us;
+        s_mix_blocks++;
+        s_mix_us_total += mix_us;
+        if (mix_us > s_mix_us_max) {
+            s_mix_us_max = mix_us;
+        }
+
+        speaker_i2s_write(s_out, sizeof(s_out), &written, portMAX_DELAY);
+        s_frames += AUDIO_MIXER_FRAME_SAMPLES;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Mixer Function
+ *
+ **************************************************************************************************/
+
+static bool format_supported(uint32_t rate, uint32_t bits, uint32_t ch)
+{
+    return rate > 0 && rate <= AUDIO_MIXER_SAMPLE_RATE * AUDIO_MIXER_MAX_RATIO &&
+           (bits == 16 || bits == 32) && (ch == 1 || ch == 2);
+}
+
+esp_err_t audio_mixer_init(void)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+
+    ESP_RETURN_ON_ERROR(speaker_codec_set_fs(AUDIO_MIXER_SAMPLE_RATE, 16, 2), TAG, "codec open failed");
+
+    s_lock = xSemaphoreCreateMutex();
+    s_data = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(s_lock && s_data, ESP_ERR_NO_MEM, TAG, "semaphore create failed");
+
+    BaseType_t core_id = (AUDIO_MIXER_TASK_CORE < 0) ? tskNO_AFFINITY : AUDIO_MIXER_TASK_CORE;
+    if (xTaskCreatePinnedToCore(mixer_task, "audio_mixer", AUDIO_MIXER_TASK_STACK_SIZE, NULL,
+                                AUDIO_MIXER_TASK_PRIORITY, &s_task, core_id) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Mixing %d sources at %d Hz, %d-tap resampler", AUDIO_MIXER_MAX_SOURCES,
+             AUDIO_MIXER_SAMPLE_RATE, AUDIO_MIXER_SRC_TAPS);
+    return ESP_OK;
+}
+
+bool audio_mixer_is_running(void)
+{
+    return s_task != NULL;
+}
+
+audio_mixer_source_t *audio_mixer_source_new(const char *name, uint32_t rate, uint32_t bits, uint32_t ch)
+{
+    audio_mixer_source_t *src;
+    int slot = -1;
+
+    if (!s_task || !format_supported(rate, bits, ch)) {
+        return NULL;
+    }
+
+    src = heap_caps_calloc(1, sizeof(audio_mixer_source_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!src) {
+        return NULL;
+    }
+    src->ring = heap_caps_malloc(AUDIO_MIXER_SOURCE_FRAMES * 2 * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!src->ring) {
+        src->ring = heap_caps_malloc(AUDIO_MIXER_SOURCE_FRAMES * 2 * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    src->space = xSemaphoreCreateBinary();
+    if (!src->ring || !src->space) {
+        goto err;
+    }
+
+    src->stats.name = name;
+    src->gain = AUDIO_MIXER_GAIN_UNITY;
+    src->bits = bits;
+    src->ch = ch;
+    src->rate_req = rate;
+    src_design(src, rate);
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        if (!s_sources[i]) {
+            s_sources[i] = src;
+            slot = i;
+            break;
+        }
+    }
+    xSemaphoreGive(s_lock);
+    if (slot >= 0) {
+        return src;
+    }
+    ESP_LOGW(TAG, "No free source slot for '%s'", name);
+
+err:
+    if (src->space) {
+        vSemaphoreDelete(src->space);
+    }
+    heap_caps_free(src->ring);
+    heap_caps_free(src);
+    return NULL;
+}
+
+void audio_mixer_source_delete(audio_mixer_source_t *src)
+{
+    if (!src) {
+        return;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        if (s_sources[i] == src) {
+            s_sources[i] = NULL;
+        }
+    }
+    xSemaphoreGive(s_lock);
+
+    vSemaphoreDelete(src->space);
+    heap_caps_free(src->ring);
+    heap_caps_free(src);
+}
+
+esp_err_t audio_mixer_source_set_format(audio_mixer_source_t *src, uint32_t rate, uint32_t bits, uint32_t ch)
+{
+    esp_err_t ret = ESP_OK;
+    int waited_ms = 0;
+
+    ESP_RETURN_ON_FALSE(src && format_supported(rate, bits, ch), ESP_ERR_INVALID_ARG, TAG, "format not supported");
+
+    src->bits = bits;
+    src->ch = ch;
+    if (rate == src->rate_req) {
+        return ESP_OK;
+    }
+
+    // Let the frames at the old rate play out, then wait for the mixer to switch
+    while (src_ring_count(src) && waited_ms < AUDIO_MIXER_FORMAT_WAIT_MS) {
+        vTaskDelay(pdMS_TO_TICKS(5));
+        waited_ms += 5;
+    }
+    src->rate_req = rate;
+    xSemaphoreGive(s_data);
+    while (src->rate != rate && waited_ms < AUDIO_MIXER_FORMAT_WAIT_MS) {
+        vTaskDelay(pdMS_TO_TICKS(5));
+        waited_ms += 5;
+    }
+    if (src->rate != rate) {
+        ESP_LOGW(TAG, "'%s' changed to %" PRIu32 " Hz before it played out", src->stats.name, rate);
+        ret = ESP_ERR_TIMEOUT;
+    }
+    return ret;
+}
+
+void audio_mixer_source_set_gain(audio_mixer_source_t *src, uint32_t gain)
+{
+    src->gain = gain < 2 * AUDIO_MIXER_GAIN_UNITY ? gain : 2 * AUDIO_MIXER_GAIN_UNITY;
+}
+
+void audio_mixer_source_set_mute(audio_mixer_source_t *src, bool mute)
+{
+    src->mute = mute;
+}
+
+size_t audio_mixer_source_write(audio_mixer_source_t *src, const void *pcm, size_t len, uint32_t timeout_ms)
+{
+    const TickType_t wait = (timeout_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    const uint32_t ch = src->ch;
+    const uint32_t frame_bytes = (src->bits / 8) * ch;
+    const uint32_t frames = len / frame_bytes;
+    uint32_t done = 0;
+
+    while (done < frames) {
+        uint32_t space = AUDIO_MIXER_SOURCE_FRAMES - src_ring_count(src);
+        if (space == 0) {
+            src->stats.waits++;
+            if (xSemaphoreTake(src->space, wait) != pdTRUE) {
+                break;
+            }
+            continue;
+        }
+
+        uint32_t idx = src->head & RING_MASK;
+        uint32_t n = AUDIO_MIXER_SOURCE_FRAMES - idx;
+        n = n < space ? n : space;
+        n = n < frames - done ? n : frames - done;
+
+        int16_t *dst = &src->ring[idx * 2];
+        if (src->bits == 16) {
+            const int16_t *in = (const int16_t *)pcm + done * ch;
+            for (uint32_t i = 0; i < n; i++, in += ch) {
+                dst[2 * i] = in[0];
+                dst[2 * i + 1] = in[ch - 1];
+            }
+        } else {
+            const int32_t *in = (const int32_t *)pcm + done * ch;
+            for (uint32_t i = 0; i < n; i++, in += ch) {
+                dst[2 * i] = in[0] >> 16;
+                dst[2 * i + 1] = in[ch - 1] >> 16;
+            }
+        }
+        __atomic_store_n(&src->head, src->head + n, __ATOMIC_RELEASE);
+        done += n;
+        xSemaphoreGive(s_data);
+    }
+
+    src->stats.frames_in += done;
+    return done * frame_bytes;
+}
+
+uint32_t audio_mixer_source_queued(audio_mixer_source_t *src)
+{
+    return src_ring_count(src);
+}
+
+uint32_t audio_mixer_benchmark(uint32_t rate, uint32_t rounds)
+{
+    audio_mixer_source_t *src;
+    int64_t start_us;
+    uint32_t us;
+
+    if (rounds == 0 || !format_supported(rate, 16, 2)) {
+        return 0;
+    }
+    src = heap_caps_calloc(1, sizeof(audio_mixer_source_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    int32_t *acc = heap_caps_calloc(AUDIO_MIXER_FRAME_SAMPLES * 2, sizeof(int32_t), MALLOC_CAP_INTERNAL);
+    if (!src || !acc) {
+        heap_caps_free(src);
+        heap_caps_free(acc);
+        return 0;
+    }
+
+    src->gain = AUDIO_MIXER_GAIN_UNITY;
+    src_design(src, rate);
+    srand(1);
+    start_us = esp_timer_get_time();
+    for (uint32_t r = 0; r < rounds; r++) {
+        // Refill work[] as if the ring had delivered, the refill is not part of the mixing cost
+        int64_t fill_us = esp_timer_get_time();
+        for (uint32_t i = src->fill * 2; i < WORK_FRAMES * 2; i++) {
+            src->work[i] = (int16_t)(rand() - RAND_MAX / 2);
+        }
+        src->fill = WORK_FRAMES;
+        start_us += esp_timer_get_time() - fill_us;
+
+        src_mix(src, acc, AUDIO_MIXER_FRAME_SAMPLES);
+    }
+    us = (esp_timer_get_time() - start_us) / rounds;
+
+    heap_caps_free(src);
+    heap_caps_free(acc);
+
+    ESP_LOGI(TAG, "Benchmark: %" PRIu32 " Hz stereo source, %" PRIu32 " us per %d-frame block, %" PRIu32 " per mille of a core",
+             rate, us, AUDIO_MIXER_FRAME_SAMPLES, us * 1000 / BLOCK_US);
+    return us * 1000 / BLOCK_US;
+}
+
+void audio_mixer_get_stats(audio_mixer_stats_t *stats)
+{
+    memset(stats, 0, sizeof(audio_mixer_stats_t));
+    stats->frames = s_frames;
+    stats->clipped = s_clipped;
+    stats->mix_us_avg = s_mix_blocks ? s_mix_us_total / s_mix_blocks : 0;
+    stats->mix_us_max = s_mix_us_max;
+    stats->cpu_permille = stats->mix_us_avg * 1000 / BLOCK_US;
+
+    if (!s_lock) {
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        if (s_sources[i]) {
+            stats->sources[i] = s_sources[i]->stats;
+            stats->sources[i].rate = s_sources[i]->rate;
+        }
+    }
+    xSemaphoreGive(s_lock);
+}
+
+void audio_mixer_log_stats(void)
+{
+    audio_mixer_stats_t stats;
+
+    audio_mixer_get_stats(&stats);
+    ESP_LOGI(TAG, "%" PRIu32 " frames, %" PRIu32 " soft clipped, mix %" PRIu32 " us (max %" PRIu32 " us), %u per mille of a core",
+             stats.frames, stats.clipped, stats.mix_us_avg, stats.mix_us_max, stats.cpu_permille);
+    for (int i = 0; i < AUDIO_MIXER_MAX_SOURCES; i++) {
+        const audio_mixer_source_stats_t *s = &stats.sources[i];
+        if (s->name) {
+            ESP_LOGI(TAG, "'%s' %" PRIu32 " Hz: %" PRIu32 " in, %" PRIu32 " out, %" PRIu32 " underruns, %" PRIu32 " waits",
+                     s->name, s->rate, s->frames_in, s->frames_out, s->underruns, s->waits);
+        }
+    }
+}
@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * | File         :   audio_mixer.h
+ * | Author       :   Waveshare team
+ * | Function     :   Software mixer for the speaker
+ * | Info         :
+ * |                 Runs the codec at one fixed format and mixes several
+ * |                 PCM sources into it. Each source has its own sample
+ * |                 rate, converted by a fixed point polyphase resampler,
+ * |                 and its own gain. The sum is soft clipped.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#ifndef __AUDIO_MIXER_H
+#define __AUDIO_MIXER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * Mixer parameters, can be adjusted by users
+ *
+ */
+#define AUDIO_MIXER_SAMPLE_RATE         (44100)     // Codec rate, MP3s at 44.1 kHz pass without resampling
+#define AUDIO_MIXER_FRAME_SAMPLES       (256)       // Output frames mixed per I2S write, 5.8 ms
+#define AUDIO_MIXER_MAX_SOURCES         (4)
+#define AUDIO_MIXER_SOURCE_FRAMES       (4096)      // Ring depth of one source, in stereo frames
+#define AUDIO_MIXER_MAX_RATIO           (4)         // Highest source rate over the codec rate
+#define AUDIO_MIXER_SRC_TAPS            (16)        // Resampler taps per output sample
+#define AUDIO_MIXER_SRC_PHASES          (64)        // Resampler filter phases
+#define AUDIO_MIXER_SOFT_KNEE           (24576)     // Sums above this level (0.75 full scale) are compressed instead of clipped
+#define AUDIO_MIXER_FORMAT_WAIT_MS      (200)       // How long a format change waits for the source ring to play out
+#define AUDIO_MIXER_TASK_PRIORITY       (6)         // Above the audio player that feeds it
+#define AUDIO_MIXER_TASK_STACK_SIZE     (3 * 1024)
+#define AUDIO_MIXER_TASK_CORE           (0)         // Away from LVGL_PORT_TASK_CORE
+
+#define AUDIO_MIXER_GAIN_UNITY          (1 << 14)   // Source gain of 1.0
+
+typedef struct audio_mixer_source audio_mixer_source_t;
+
+/**
+ * @brief Per-source statistics
+ */
+typedef struct {
+    const char *name;               /*!< Name given at creation, NULL for a free slot */
+    uint32_t rate;                  /*!< Current sample rate */
+    uint32_t frames_in;             /*!< Frames written by the source */
+    uint32_t frames_out;            /*!< Frames mixed at the codec rate */
+    uint32_t underruns;             /*!< Times the source ran dry while playing, the end of a stream counts once */
+    uint32_t waits;                 /*!< Writes that blocked on a full ring */
+} audio_mixer_source_stats_t;
+
+/**
+ * @brief Mixer statistics
+ */
+typedef struct {
+    uint32_t frames;                /*!< Output frames written to I2S */
+    uint32_t clipped;               /*!< Output samples that went through the soft clipper */
+    uint32_t mix_us_avg;            /*!< Resample and mix time of one output block */
+    uint32_t mix_us_max;
+    uint16_t cpu_permille;          /*!< Share of one core used by the mixing */
+    audio_mixer_source_stats_t sources[AUDIO_MIXER_MAX_SOURCES];
+} audio_mixer_stats_t;
+
+/**
+ * @brief Start the mixer and set the codec to AUDIO_MIXER_SAMPLE_RATE, 16-bit stereo
+ *
+ * Call after speaker_codec_init(). The codec format is not changed again while the
+ * mixer runs.
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ *      - Others: The codec could not be opened
+ */
+esp_err_t audio_mixer_init(void);
+
+/**
+ * @brief Check whether the mixer is running
+ *
+ * @return
+ *      - true: Running
+ *      - false: Not started
+ */
+bool audio_mixer_is_running(void);
+
+/**
+ * @brief Add a source
+ *
+ * @param name Name shown in the statistics, kept by reference
+ * @param rate Sample rate of the source
+ * @param bits Bits per sample, 16 or 32 (the upper 16 bits are used)
+ * @param ch Channels, 1 or 2
+ *
+ * @return The source, NULL if all slots are taken, memory is short or the format is not supported
+ */
+audio_mixer_source_t *audio_mixer_source_new(const char *name, uint32_t rate, uint32_t bits, uint32_t ch);
+
+/**
+ * @brief Remove a source, what it still holds is dropped
+ *
+ * @param src The source
+ */
+void audio_mixer_source_delete(audio_mixer_source_t *src);
+
+/**
+ * @brief Change the format of a source
+ *
+ * Waits up to AUDIO_MIXER_FORMAT_WAIT_MS for the audio already written to play out,
+ * so call it from the task that writes the source.
+ *
+ * @param src The source
+ * @param rate Sample rate
+ * @param bits Bits per sample, 16 or 32
+ * @param ch Channels, 1 or 2
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: The format is not supported
+ *      - ESP_ERR_TIMEOUT: The source did not play out in time, the format was changed anyway
+ */
+esp_err_t audio_mixer_source_set_format(audio_mixer_source_t *src, uint32_t rate, uint32_t bits, uint32_t ch);
+
+/**
+ * @brief Set the gain of a source
+ *
+ * @param src The source
+ * @param gain Gain in Q14, AUDIO_MIXER_GAIN_UNITY is 1.0, limited to 2 * AUDIO_MIXER_GAIN_UNITY
+ */
+void audio_mixer_source_set_gain(audio_mixer_source_t *src, uint32_t gain);
+
+/**
+ * @brief Mute a source without dropping its audio
+ *
+ * @param src The source
+ * @param mute true to mute
+ */
+void audio_mixer_source_set_mute(audio_mixer_source_t *src, bool mute);
+
+/**
+ * @brief Write PCM to a source
+ *
+ * Blocks while the source ring is full, so the writer runs at the pace of the codec.
+ *
+ * @param src The source
+ * @param pcm Interleaved samples in the format of the source
+ * @param len Bytes to write
+ * @param timeout_ms Max block time for each wait on ring space, portMAX_DELAY to wait forever
+ *
+ * @return Bytes actually written
+ */
+size_t audio_mixer_source_write(audio_mixer_source_t *src, const void *pcm, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Get the number of frames a source still holds
+ *
+ * @param src The source
+ * @return Frames waiting in the ring, at the source rate
+ */
+uint32_t audio_mixer_source_queued(audio_mixer_source_t *src);
+
+/**
+ * @brief Measure the cost of resampling and mixing one stereo source
+ *
+ * Runs the resampler on noise, outside the mixer task. Takes a few milliseconds.
+ *
+ * @param rate Source rate to convert from
+ * @param rounds Output blocks to time
+ * @return Share of one core one source at this rate needs, in per mille of a core
+ */
+uint32_t audio_mixer_benchmark(uint32_t rate, uint32_t rounds);
+
+/**
+ * @brief Get the statistics
+ *
+ * @param stats Output statistics
+ */
+void audio_mixer_get_stats(audio_mixer_stats_t *stats);
+
+/**
+ * @brief Log the statistics
+ */
+void audio_mixer_log_stats(void);
+
+#endif
@@ -13,6 +13,20 @@
 
 #include "codec_dev.h"  // Include I2C driver header for I2C functions
 #include "speaker_microphone.h" 
+#include "audio_mixer.h"
+#if SPEAKER_PLAYER_USE_FILE_SOURCE
+#include "file_source.h"
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
 
 static const char *TAG = "codec_dev";  // Define a tag for logging
 
@@ -27,12 +41,56 @@ static audio_player_cb_t audio_idle_callback = NULL;
 static void *audio_idle_cb_user_data = NULL;
 static char audio_file_path[128];
 
+static speaker_pcm_tap_t pcm_tap = NULL;
+static void *pcm_tap_user_data = NULL;
+static uint32_t _fs_rate = CODEC_DEFAULT_SAMPLE_RATE;
+static uint32_t _fs_bits = CODEC_DEFAULT_BIT_WIDTH;
+static uint32_t _fs_channel = CODEC_DEFAULT_CHANNEL;
+#if SPEAKER_PLAYER_USE_MIXER
+static audio_mixer_source_t *music_source = NULL;
+#endif
+#if SPEAKER_PLAYER_USE_MIXER && SPEAKER_PLAYER_CLICK_ENABLE
+#define CLICK_SAMPLES (SPEAKER_PLAYER_CLICK_RATE * SPEAKER_PLAYER_CLICK_MS / 1000)
+static audio_mixer_source_t *click_source = NULL;
+static int16_t click_pcm[CLICK_SAMPLES];
+#endif
+
+/* A track as the decoder sees it: the audio data of one file, without its ID3 tags */
+typedef struct {
+    FILE *fp;
+    uint8_t *head;              // First bytes of the audio data, in PSRAM, NULL if not pre-buffered
+    size_t head_len;
+    long data_start;            // File offset of the audio data
+    long data_len;              // Audio data bytes
+    long pos;                   // Read position in the audio data
+    long fp_pos;                // Position of fp in the audio data
+    char path[128];
+} player_track_t;
+
+/* The FILE given to the player, runs from one track into the queued one */
+typedef struct {
+    player_track_t track;
+} player_stream_t;
+
+static SemaphoreHandle_t next_lock;         // Guards the queued track below
+static QueueHandle_t prefetch_queue;        // Path to pre-open, only the latest request is kept
+static player_track_t next_track;           // Queued track, valid when next_ready
+static char next_path[128];                 // Queued path, empty when the queue is clear
+static bool next_ready = false;
+static bool next_pending = false;           // Queued, the pre-open is still running
+
+static speaker_track_cb_t track_callback = NULL;
+static void *track_cb_user_data = NULL;
+static speaker_player_gapless_stats_t gapless_stats;
+static portMUX_TYPE gapless_stats_lock = portMUX_INITIALIZER_UNLOCKED;   // Protects gapless_stats, written by the player and prefetch tasks
+
 /**************************************************************************************************
  *
  * Player Function
  *
  **************************************************************************************************/
 
+#if !SPEAKER_PLAYER_USE_MIXER
 static esp_err_t audio_mute_function(AUDIO_PLAYER_MUTE_SETTING setting)
 {
     // Volume saved when muting and restored when unmuting. Restoring volume is necessary
@@ -47,6 +105,7 @@ static esp_err_t audio_mute_function(AUDIO_PLAYER_MUTE_SETTING setting)
 
     return ESP_OK;
 }
+#endif
 
 static void audio_callback(audio_player_cb_ctx_t *ctx)
 {
@@ -72,10 +131,345 @@ esp_err_t speaker_i2s_write(void *audio_buffer, size_t len, size_t *bytes_writte
     return ret;
 }
 
+#if !SPEAKER_PLAYER_USE_MIXER
+// Player output: hand the PCM to the tap, then to I2S
+static esp_err_t player_i2s_write(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms)
+{
+    if (pcm_tap && _fs_bits == 16) {
+        pcm_tap(audio_buffer, len / sizeof(int16_t), _fs_rate, _fs_channel, pcm_tap_user_data);
+    }
+    return speaker_i2s_write(audio_buffer, len, bytes_written, timeout_ms);
+}
+#else
+// Player output through the mixer: the codec stays at the mixer rate, only the source format changes
+static esp_err_t player_mixer_mute(AUDIO_PLAYER_MUTE_SETTING setting)
+{
+    audio_mixer_source_set_mute(music_source, setting == AUDIO_PLAYER_MUTE);
+    return ESP_OK;
+}
+
+static esp_err_t player_mixer_write(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms)
+{
+    if (pcm_tap && _fs_bits == 16) {
+        pcm_tap(audio_buffer, len / sizeof(int16_t), _fs_rate, _fs_channel, pcm_tap_user_data);
+    }
+    *bytes_written = audio_mixer_source_write(music_source, audio_buffer, len, timeout_ms);
+    return (*bytes_written == len) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+static esp_err_t player_mixer_set_fs(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch)
+{
+    esp_err_t ret;
+
+    _fs_rate = rate;
+    _fs_bits = bits_cfg;
+    _fs_channel = ch;
+
+    // A timeout only means a few milliseconds of the old track ran at the new rate
+    ret = audio_mixer_source_set_format(music_source, rate, bits_cfg, ch);
+    return (ret == ESP_ERR_TIMEOUT) ? ESP_OK : ret;
+}
+#endif
+
+/**************************************************************************************************
+ *
+ * Gapless Track Function
+ *
+ **************************************************************************************************/
+
+static bool track_is_mp3(const char *path)
+{
+    const char *ext = strrchr(path, '.');
+    return ext && strcasecmp(ext, ".mp3") == 0;
+}
+
+static void track_close(player_track_t *track)
+{
+    if (track->fp) {
+        fclose(track->fp);
+    }
+    if (track->head) {
+        heap_caps_free(track->head);
+    }
+    memset(track, 0, sizeof(player_track_t));
+}
+
+// Open a track, skip its ID3 tags and optionally read the start of the audio into PSRAM.
+// With file_source the reader task already buffers the file, so there is no pre-buffer.
+static esp_err_t track_open(player_track_t *track, const char *path, bool prebuffer)
+{
+    uint8_t tag[10];
+    long size;
+
+    memset(track, 0, sizeof(player_track_t));
+    ESP_RETURN_ON_FALSE(strlen(path) < sizeof(track->path), ESP_ERR_INVALID_ARG, TAG, "path too long");
+#if SPEAKER_PLAYER_USE_FILE_SOURCE
+    track->fp = file_source_fopen(path);
+    (void)prebuffer;
+#else
+    track->fp = fopen(path, "rb");
+#endif
+    ESP_RETURN_ON_FALSE(track->fp, ESP_FAIL, TAG, "unable to open file");
+    strcpy(track->path, path);
+
+    fseek(track->fp, 0, SEEK_END);
+    size = ftell(track->fp);
+    if (size < 0) {
+        size = 0;
+    }
+
+    // ID3v1: 128 bytes at the end, decoded as audio it clicks between joined tracks
+    if (size >= 128 && fseek(track->fp, size - 128, SEEK_SET) == 0 &&
+        fread(tag, 1, 3, track->fp) == 3 && memcmp(tag, "TAG", 3) == 0) {
+        size -= 128;
+    }
+
+    // ID3v2: header, syncsafe length and an optional footer at the start
+    fseek(track->fp, 0, SEEK_SET);
+    if (fread(tag, 1, 10, track->fp) == 10 && memcmp(tag, "ID3", 3) == 0) {
+        track->data_start = 10 + (((long)(tag[6] & 0x7f) << 21) | ((tag[7] & 0x7f) << 14) |
+                                  ((tag[8] & 0x7f) << 7) | (tag[9] & 0x7f));
+        if (tag[5] & 0x10) {
+            track->data_start += 10;
+        }
+        if (track->data_start > size) {
+            track->data_start = size;
+        }
+    }
+    track->data_len = size - track->data_start;
+    fseek(track->fp, track->data_start, SEEK_SET);
+
+#if !SPEAKER_PLAYER_USE_FILE_SOURCE
+    if (prebuffer && track->data_len > 0) {
+        size_t want = track->data_len < SPEAKER_PLAYER_PREBUFFER_SIZE ? track->data_len : SPEAKER_PLAYER_PREBUFFER_SIZE;
+        track->head = heap_caps_malloc(want, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (track->head) {
+            track->head_len = fread(track->head, 1, want, track->fp);
+            track->fp_pos = track->head_len;
+        } else {
+            ESP_LOGW(TAG, "No PSRAM for the pre-buffer of '%s'", path);
+        }
+    }
+#endif
+    return ESP_OK;
+}
+
+static int track_read(player_track_t *track, char *buf, int len)
+{
+    size_t n;
+
+    if (track->pos >= track->data_len) {
+        return 0;
+    }
+    if (len > track->data_len - track->pos) {
+        len = track->data_len - track->pos;
+    }
+
+    if ((size_t)track->pos < track->head_len) {
+        n = track->head_len - track->pos;
+        if (n > (size_t)len) {
+            n = len;
+        }
+        memcpy(buf, track->head + track->pos, n);
+        track->pos += n;
+        return n;
+    }
+
+    if (track->fp_pos != track->pos) {
+        if (fseek(track->fp, track->data_start + track->pos, SEEK_SET) != 0) {
+            return -1;
+        }
+        track->fp_pos = track->pos;
+    }
+    n = fread(buf, 1, len, track->fp);
+    track->pos += n;
+    track->fp_pos += n;
+    return n;
+}
+
+// End of a track: continue with the queued one if it is ready or about to be
+static bool stream_next_track(player_stream_t *stream, int64_t eof_us)
+{
+    player_track_t old;
+    bool waited = false;
+    bool joined;
+    bool missed;
+
+    if (!track_is_mp3(stream->track.path)) {
+        return false;
+    }
+    while (next_pending && !next_ready &&
+           esp_timer_get_time() - eof_us < SPEAKER_PLAYER_PREFETCH_WAIT_MS * 1000) {
+        vTaskDelay(pdMS_TO_TICKS(5));
+        waited = true;
+    }
+
+    xSemaphoreTake(next_lock, portMAX_DELAY);
+    joined = next_ready && track_is_mp3(next_track.path);
+    missed = !joined && (next_pending || next_ready);
+    if (joined) {
+        old = stream->track;
+        stream->track = next_track;
+        memset(&next_track, 0, sizeof(player_track_t));
+        next_path[0] = '\0';
+        next_ready = false;
+    }
+    xSemaphoreGive(next_lock);
+
+    if (missed) {
+        portENTER_CRITICAL(&gapless_stats_lock);
+        gapless_stats.missed++;
+        portEXIT_CRITICAL(&gapless_stats_lock);
+    }
+
+    if (!joined) {
+        return false;
+    }
+    track_close(&old);
+
+    memcpy(audio_file_path, stream->track.path, sizeof(audio_file_path));
+    portENTER_CRITICAL(&gapless_stats_lock);
+    gapless_stats.transitions++;
+    if (waited) {
+        gapless_stats.late++;
+    }
+    portEXIT_CRITICAL(&gapless_stats_lock);
+    ESP_LOGI(TAG, "Gapless change to '%s'", stream->track.path);
+    if (track_callback) {
+        track_callback(stream->track.path, track_cb_user_data);
+    }
+    return true;
+}
+
+static int stream_read(void *cookie, char *buf, int len)
+{
+    player_stream_t *stream = (player_stream_t *)cookie;
+    int64_t eof_us;
+    uint32_t gap_us;
+    int ret;
+
+    ret = track_read(&stream->track, buf, len);
+    if (ret != 0) {
+        return ret;
+    }
+
+    eof_us = esp_timer_get_time();
+    if (!stream_next_track(stream, eof_us)) {
+        return 0;
+    }
+    ret = track_read(&stream->track, buf, len);
+
+    gap_us = esp_timer_get_time() - eof_us;
+    portENTER_CRITICAL(&gapless_stats_lock);
+    gapless_stats.gap_us_last = gap_us;
+    if (gap_us > gapless_stats.gap_us_max) {
+        gapless_stats.gap_us_max = gap_us;
+    }
+    portEXIT_CRITICAL(&gapless_stats_lock);
+    return ret;
+}
+
+// Seeks stay within the current track, the player only rewinds after probing the format
+static fpos_t stream_seek(void *cookie, fpos_t offset, int whence)
+{
+    player_stream_t *stream = (player_stream_t *)cookie;
+    long pos;
+
+    switch (whence) {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = stream->track.pos + offset;
+        break;
+    case SEEK_END:
+        pos = stream->track.data_len + offset;
+        break;
+    default:
+        return -1;
+    }
+    if (pos < 0 || pos > stream->track.data_len) {
+        return -1;
+    }
+    stream->track.pos = pos;
+    return pos;
+}
+
+static int stream_close(void *cookie)
+{
+    player_stream_t *stream = (player_stream_t *)cookie;
+
+    track_close(&stream->track);
+    free(stream);
+    return 0;
+}
+
+// Hand an open track to a new player stream, the track is closed on failure
+static FILE *stream_open(player_track_t *track)
+{
+    player_stream_t *stream = calloc(1, sizeof(player_stream_t));
+    FILE *fp = NULL;
+
+    if (stream) {
+        stream->track = *track;
+        fp = funopen(stream, stream_read, NULL, stream_seek, stream_close);
+    }
+    if (!fp) {
+        track_close(track);
+        free(stream);
+    }
+    return fp;
+}
+
+static void prefetch_task(void *arg)
+{
+    char path[sizeof(next_path)];
+    player_track_t track;
+    player_track_t old;
+    int64_t start_us;
+    uint32_t cost_us;
+
+    while (1) {
+        xQueueReceive(prefetch_queue, path, portMAX_DELAY);
+
+        memset(&track, 0, sizeof(player_track_t));
+        if (path[0]) {
+            start_us = esp_timer_get_time();
+            if (track_open(&track, path, true) == ESP_OK) {
+                cost_us = esp_timer_get_time() - start_us;
+                portENTER_CRITICAL(&gapless_stats_lock);
+                gapless_stats.prefetched++;
+                gapless_stats.prefetch_us_last = cost_us;
+                if (cost_us > gapless_stats.prefetch_us_max) {
+                    gapless_stats.prefetch_us_max = cost_us;
+                }
+                portEXIT_CRITICAL(&gapless_stats_lock);
+            }
+        }
+
+        xSemaphoreTake(next_lock, portMAX_DELAY);
+        if (strcmp(next_path, path) == 0) {
+            old = next_track;
+            next_track = track;
+            next_ready = (track.fp != NULL);
+            next_pending = false;
+        } else {
+            old = track;        // Replaced while opening, the newer request is already queued
+        }
+        xSemaphoreGive(next_lock);
+
+        track_close(&old);
+    }
+}
+
 esp_err_t speaker_codec_set_fs(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch)
 {
     esp_err_t ret = ESP_OK;
 
+    _fs_rate = rate;
+    _fs_bits = bits_cfg;
+    _fs_channel = ch;
+
     esp_codec_dev_sample_info_t fs = {
         .sample_rate = rate,
         .channel = ch,
@@ -165,19 +559,61 @@ esp_err_t speaker_player_init(void)
         return ESP_OK;
     }
 
+#if SPEAKER_PLAYER_USE_MIXER
+    ESP_RETURN_ON_ERROR(audio_mixer_init(), TAG, "audio_mixer_init failed");
+    music_source = audio_mixer_source_new("music", AUDIO_MIXER_SAMPLE_RATE, 16, 2);
+    ESP_RETURN_ON_FALSE(music_source, ESP_ERR_NO_MEM, TAG, "music source create failed");
+#if SPEAKER_PLAYER_CLICK_ENABLE
+    // A 2 kHz tone with a fast exponential decay
+    for (int i = 0; i < CLICK_SAMPLES; i++) {
+        const float t = (float)i / SPEAKER_PLAYER_CLICK_RATE;
+        click_pcm[i] = (int16_t)(12000.0f * expf(-t * 250.0f) * sinf(2.0f * (float)M_PI * 2000.0f * t));
+    }
+    click_source = audio_mixer_source_new("click", SPEAKER_PLAYER_CLICK_RATE, 16, 1);
+    ESP_RETURN_ON_FALSE(click_source, ESP_ERR_NO_MEM, TAG, "click source create failed");
+#endif
+
+    audio_player_config_t config = { .mute_fn = player_mixer_mute,
+                                     .write_fn = player_mixer_write,
+                                     .clk_set_fn = player_mixer_set_fs,
+                                     .priority = 5
+                                   };
+#else
     audio_player_config_t config = { .mute_fn = audio_mute_function,
-                                     .write_fn = speaker_i2s_write,
+                                     .write_fn = player_i2s_write,
                                      .clk_set_fn = speaker_codec_set_fs,
                                      .priority = 5
                                    };
+#endif
     ESP_RETURN_ON_ERROR(audio_player_new(config), TAG, "audio_player_init failed");
     audio_player_callback_register(audio_callback, NULL);
 
+    next_lock = xSemaphoreCreateMutex();
+    prefetch_queue = xQueueCreate(1, sizeof(next_path));
+    ESP_RETURN_ON_FALSE(next_lock && prefetch_queue, ESP_ERR_NO_MEM, TAG, "gapless queue create failed");
+    ESP_RETURN_ON_FALSE(xTaskCreate(prefetch_task, "player_prefetch", SPEAKER_PLAYER_PREFETCH_STACK_SIZE, NULL,
+                                    SPEAKER_PLAYER_PREFETCH_PRIORITY, NULL) == pdPASS,
+                        ESP_ERR_NO_MEM, TAG, "prefetch task create failed");
+
     _is_player_init = true;
 
     return ESP_OK;
 }
 
+esp_err_t speaker_player_click(void)
+{
+#if SPEAKER_PLAYER_USE_MIXER && SPEAKER_PLAYER_CLICK_ENABLE
+    ESP_RETURN_ON_FALSE(click_source, ESP_ERR_INVALID_STATE, TAG, "player not initialized");
+    if (audio_mixer_source_queued(click_source) > AUDIO_MIXER_SOURCE_FRAMES - CLICK_SAMPLES) {
+        return ESP_ERR_TIMEOUT;
+    }
+    audio_mixer_source_write(click_source, click_pcm, sizeof(click_pcm), 0);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 esp_err_t speaker_player_del(void)
 {
     _is_player_init = false;
@@ -210,7 +646,11 @@ esp_err_t speaker_player_play_index(file_iterator_instance_t *instance, int inde
     ESP_RETURN_ON_FALSE(retval != 0, ESP_FAIL, TAG, "file_iterator_get_full_path_from_index failed");
 
     ESP_LOGI(TAG, "opening file '%s'", filename);
+#if SPEAKER_PLAYER_USE_FILE_SOURCE
+    FILE *fp = file_source_fopen(filename);
+#else
     FILE *fp = fopen(filename, "rb");
+#endif
     ESP_RETURN_ON_FALSE(fp, ESP_FAIL, TAG, "unable to open file");
 
     ESP_LOGI(TAG, "Playing '%s'", filename);
@@ -223,9 +663,32 @@ esp_err_t speaker_player_play_index(file_iterator_instance_t *instance, int inde
 
 esp_err_t speaker_player_play_file(const char *file_path)
 {
-    ESP_LOGI(TAG, "opening file '%s'", file_path);
-    FILE *fp = fopen(file_path, "rb");
-    ESP_RETURN_ON_FALSE(fp, ESP_FAIL, TAG, "unable to open file");
+    player_track_t track;
+    bool queued = false;
+
+    // The queued track is already open and buffered, take it instead of opening the file again
+    if (next_lock) {
+        xSemaphoreTake(next_lock, portMAX_DELAY);
+        queued = next_ready && strcmp(next_path, file_path) == 0;
+        if (queued) {
+            track = next_track;
+            memset(&next_track, 0, sizeof(player_track_t));
+            next_path[0] = '\0';
+            next_ready = false;
+        }
+        xSemaphoreGive(next_lock);
+    }
+
+    if (queued) {
+        portENTER_CRITICAL(&gapless_stats_lock);
+        gapless_stats.started_from_queue++;
+        portEXIT_CRITICAL(&gapless_stats_lock);
+    } else {
+        ESP_LOGI(TAG, "opening file '%s'", file_path);
+        ESP_RETURN_ON_ERROR(track_open(&track, file_path, false), TAG, "unable to open file");
+    }
+    FILE *fp = stream_open(&track);
+    ESP_RETURN_ON_FALSE(fp, ESP_ERR_NO_MEM, TAG, "unable to create the player stream");
 
     ESP_LOGI(TAG, "Playing '%s'", file_path);
     ESP_RETURN_ON_ERROR(audio_player_play(fp), TAG, "audio_player_play failed");
@@ -235,12 +698,74 @@ esp_err_t speaker_player_play_file(const char *file_path)
     return ESP_OK;
 }
 
+esp_err_t speaker_player_queue_file(const char *file_path)
+{
+    char path[sizeof(next_path)] = { 0 };
+
+    ESP_RETURN_ON_FALSE(_is_player_init, ESP_ERR_INVALID_STATE, TAG, "player not initialized");
+    if (file_path) {
+        ESP_RETURN_ON_FALSE(strlen(file_path) < sizeof(path), ESP_ERR_INVALID_ARG, TAG, "path too long");
+        strcpy(path, file_path);
+    }
+
+    xSemaphoreTake(next_lock, portMAX_DELAY);
+    if (strcmp(next_path, path) == 0 && (next_ready || next_pending)) {
+        xSemaphoreGive(next_lock);
+        return ESP_OK;
+    }
+    // The old track stays in next_track until the prefetch task swaps it out and closes it
+    memcpy(next_path, path, sizeof(next_path));
+    next_ready = false;
+    next_pending = (path[0] != '\0');
+    xSemaphoreGive(next_lock);
+
+    if (path[0]) {
+        portENTER_CRITICAL(&gapless_stats_lock);
+        gapless_stats.queued++;
+        portEXIT_CRITICAL(&gapless_stats_lock);
+    }
+    xQueueOverwrite(prefetch_queue, path);
+
+    return ESP_OK;
+}
+
 void speaker_player_register_callback(audio_player_cb_t cb, void *user_data)
 {
     audio_idle_callback = cb;
     audio_idle_cb_user_data = user_data;
 }
 
+void speaker_player_register_pcm_tap(speaker_pcm_tap_t tap, void *user_data)
+{
+    pcm_tap_user_data = user_data;
+    pcm_tap = tap;
+}
+
+void speaker_player_register_track_callback(speaker_track_cb_t cb, void *user_data)
+{
+    track_cb_user_data = user_data;
+    track_callback = cb;
+}
+
+void speaker_player_get_gapless_stats(speaker_player_gapless_stats_t *stats)
+{
+    portENTER_CRITICAL(&gapless_stats_lock);
+    *stats = gapless_stats;
+    portEXIT_CRITICAL(&gapless_stats_lock);
+}
+
+void speaker_player_log_gapless_stats(void)
+{
+    speaker_player_gapless_stats_t stats;
+
+    speaker_player_get_gapless_stats(&stats);
+    ESP_LOGI(TAG, "Gapless: %" PRIu32 " queued, %" PRIu32 " pre-opened, %" PRIu32 " started from the queue",
+             stats.queued, stats.prefetched, stats.started_from_queue);
+    ESP_LOGI(TAG, "Gapless: %" PRIu32 " changes, %" PRIu32 " late, %" PRIu32 " missed, gap %" PRIu32 " us (max %" PRIu32 " us)",
+             stats.transitions, stats.late, stats.missed, stats.gap_us_last, stats.gap_us_max);
+    ESP_LOGI(TAG, "Gapless: pre-open %" PRIu32 " us (max %" PRIu32 " us)", stats.prefetch_us_last, stats.prefetch_us_max);
+}
+
 bool speaker_player_is_playing_by_path(const char *file_path)
 {
     return (strcmp(audio_file_path, file_path) == 0);
@@ -21,6 +21,59 @@
 #define CODEC_DEFAULT_CHANNEL               (2)
 #define CODEC_DEFAULT_VOLUME                (60)
 
+/**
+ * Gapless playback parameters, can be adjusted by users
+ *
+ */
+#define SPEAKER_PLAYER_PREBUFFER_SIZE       (64 * 1024) // Bytes of the queued track read into PSRAM ahead of its turn, unused with file_source
+#define SPEAKER_PLAYER_PREFETCH_WAIT_MS     (500)       // How long the end of a track waits for a pre-open still in progress
+#define SPEAKER_PLAYER_PREFETCH_PRIORITY    (3)         // Below the audio player, the pre-open only has to finish before the track ends
+#define SPEAKER_PLAYER_PREFETCH_STACK_SIZE  (3 * 1024)
+#define SPEAKER_PLAYER_USE_MIXER            (1)         // Play through audio_mixer at a fixed codec rate instead of reopening the codec per track
+#define SPEAKER_PLAYER_USE_FILE_SOURCE      (1)         // Read tracks through file_source, which reads the SD card ahead in large chunks
+#define SPEAKER_PLAYER_CLICK_ENABLE         (1)         // Set to 1 to mix a click for the UI buttons into the music, needs the mixer
+#define SPEAKER_PLAYER_CLICK_RATE           (16000)     // Sample rate of the click, resampled to the codec rate by the mixer
+#define SPEAKER_PLAYER_CLICK_MS             (20)        // Length of the click
+
+/**
+ * @brief Player PCM tap, sees every buffer the player sends to I2S.
+ *
+ * Runs in the player task right before the I2S write, so it must not block.
+ *
+ * @param pcm: Interleaved 16-bit samples
+ * @param samples: Number of samples, all channels counted
+ * @param rate: Sample rate
+ * @param ch: Channels
+ * @param user_data: User data given at registration
+ */
+typedef void (*speaker_pcm_tap_t)(const int16_t *pcm, size_t samples, uint32_t rate, uint32_t ch, void *user_data);
+
+/**
+ * @brief Gapless track change, called when the player runs from one track into the queued one.
+ *
+ * Runs in the player task, so it must not block. No player event is sent for the change.
+ *
+ * @param file_path: Path of the track now playing
+ * @param user_data: User data given at registration
+ */
+typedef void (*speaker_track_cb_t)(const char *file_path, void *user_data);
+
+/**
+ * @brief Gapless playback statistics
+ */
+typedef struct {
+    uint32_t queued;                /*!< Tracks queued with speaker_player_queue_file() */
+    uint32_t prefetched;            /*!< Queued tracks opened and pre-buffered */
+    uint32_t transitions;           /*!< Gapless track changes */
+    uint32_t late;                  /*!< Track ends that had to wait for the pre-open */
+    uint32_t missed;                /*!< Track ends with a queued track that was not ready in time */
+    uint32_t started_from_queue;    /*!< speaker_player_play_file() calls served by the pre-opened track */
+    uint32_t prefetch_us_last;      /*!< Open, tag scan and pre-buffer time of the last queued track */
+    uint32_t prefetch_us_max;
+    uint32_t gap_us_last;           /*!< Last byte of one track to the first byte of the next, at the decoder input */
+    uint32_t gap_us_max;
+} speaker_player_gapless_stats_t;
+
 /**
  * @brief Player set mute.
  *
@@ -131,6 +184,20 @@ esp_err_t speaker_codec_init();
  */
 esp_err_t speaker_player_init(void);
 
+/**
+ * @brief Play a short click over the music, as feedback for a button
+ *
+ * The click is a second mixer source at SPEAKER_PLAYER_CLICK_RATE, mono. Never blocks,
+ * so it can be called from LVGL event callbacks.
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NOT_SUPPORTED: SPEAKER_PLAYER_CLICK_ENABLE or SPEAKER_PLAYER_USE_MIXER is 0
+ *      - ESP_ERR_INVALID_STATE: The player is not initialized
+ *      - ESP_ERR_TIMEOUT: Earlier clicks still fill the source, this one is skipped
+ */
+esp_err_t speaker_player_click(void);
+
 /**
  * @brief Delete audio player task.
  *
@@ -172,6 +239,23 @@ esp_err_t speaker_player_play_index(file_iterator_instance_t *instance, int inde
  */
 esp_err_t speaker_player_play_file(const char *file_path);
 
+/**
+ * @brief Queue the track to play after the current one
+ *
+ * The track is opened in the background. With SPEAKER_PLAYER_USE_FILE_SOURCE the file_source
+ * reader then fills its ring from the card, otherwise the first SPEAKER_PLAYER_PREBUFFER_SIZE
+ * bytes are read into PSRAM. When the current track ends, the decoder goes on with the queued one
+ * without a gap, and the track callback is called instead of the IDLE event. Only MP3 tracks
+ * are joined, other files end as before. A later call replaces the queued track.
+ *
+ * @param file_path The path to the next audio file, NULL to clear the queue.
+ * @return
+ *     - ESP_OK: Track queued.
+ *     - ESP_ERR_INVALID_STATE: The player is not initialized.
+ *     - ESP_ERR_INVALID_ARG: The path is too long.
+ */
+esp_err_t speaker_player_queue_file(const char *file_path);
+
 /**
  * @brief Register a callback function for the audio player
  *
@@ -180,6 +264,34 @@ esp_err_t speaker_player_play_file(const char *file_path);
  */
 void speaker_player_register_callback(audio_player_cb_t cb, void *user_data);
 
+/**
+ * @brief Register a tap on the PCM output of the audio player
+ *
+ * @param tap The tap function, NULL to remove it. Only 16-bit output is passed on.
+ * @param user_data User data to be passed to the tap function.
+ */
+void speaker_player_register_pcm_tap(speaker_pcm_tap_t tap, void *user_data);
+
+/**
+ * @brief Register a callback for gapless track changes
+ *
+ * @param cb The callback function, NULL to remove it.
+ * @param user_data User data to be passed to the callback function.
+ */
+void speaker_player_register_track_callback(speaker_track_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the gapless playback statistics
+ *
+ * @param stats Output statistics
+ */
+void speaker_player_get_gapless_stats(speaker_player_gapless_stats_t *stats);
+
+/**
+ * @brief Log the gapless playback statistics
+ */
+void speaker_player_log_gapless_stats(void);
+
 /**
  * @brief Check if the specified audio file is currently playing
  *
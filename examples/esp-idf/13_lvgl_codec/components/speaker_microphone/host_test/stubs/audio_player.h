@@ -0,0 +1,32 @@
+/* Host stub of the esp-audio-player API, the test implements the calls */
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/i2s_std.h"
+
+typedef enum {
+    AUDIO_PLAYER_MUTE,
+    AUDIO_PLAYER_UNMUTE,
+} AUDIO_PLAYER_MUTE_SETTING;
+
+typedef struct {
+    int audio_event;
+    void *user_ctx;
+} audio_player_cb_ctx_t;
+
+typedef void (*audio_player_cb_t)(audio_player_cb_ctx_t *ctx);
+
+typedef struct {
+    esp_err_t (*mute_fn)(AUDIO_PLAYER_MUTE_SETTING setting);
+    esp_err_t (*write_fn)(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms);
+    esp_err_t (*clk_set_fn)(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch);
+    int priority;
+} audio_player_config_t;
+
+esp_err_t audio_player_new(audio_player_config_t config);
+esp_err_t audio_player_callback_register(audio_player_cb_t call_back, void *user_ctx);
+esp_err_t audio_player_play(FILE *fp);
+esp_err_t audio_player_delete(void);
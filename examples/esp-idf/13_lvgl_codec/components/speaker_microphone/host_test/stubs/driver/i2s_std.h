@@ -0,0 +1,7 @@
+/* Host stub of the I2S driver types used by the player */
+#pragma once
+
+typedef enum {
+    I2S_SLOT_MODE_MONO = 1,
+    I2S_SLOT_MODE_STEREO = 2,
+} i2s_slot_mode_t;
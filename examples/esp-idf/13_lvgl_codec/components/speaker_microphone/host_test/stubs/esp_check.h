@@ -0,0 +1,19 @@
+/* Host stub of the ESP-IDF error check macros */
+#pragma once
+
+#include "esp_log.h"
+
+#define ESP_RETURN_ON_ERROR(x, tag, fmt, ...) do {                  \
+        esp_err_t err_ = (x);                                       \
+        if (err_ != ESP_OK) {                                       \
+            ESP_LOGE(tag, fmt, ##__VA_ARGS__);                      \
+            return err_;                                            \
+        }                                                           \
+    } while (0)
+
+#define ESP_RETURN_ON_FALSE(a, err, tag, fmt, ...) do {             \
+        if (!(a)) {                                                 \
+            ESP_LOGE(tag, fmt, ##__VA_ARGS__);                      \
+            return err;                                             \
+        }                                                           \
+    } while (0)
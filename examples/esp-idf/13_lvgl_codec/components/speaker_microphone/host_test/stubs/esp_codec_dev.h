@@ -0,0 +1,21 @@
+/* Host stub of the esp_codec_dev API, the test implements the calls */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef void *esp_codec_dev_handle_t;
+
+typedef struct {
+    int bits_per_sample;
+    int channel;
+    int sample_rate;
+} esp_codec_dev_sample_info_t;
+
+int esp_codec_dev_open(esp_codec_dev_handle_t dev, esp_codec_dev_sample_info_t *fs);
+int esp_codec_dev_close(esp_codec_dev_handle_t dev);
+int esp_codec_dev_read(esp_codec_dev_handle_t dev, void *data, int len);
+int esp_codec_dev_write(esp_codec_dev_handle_t dev, void *data, int len);
+int esp_codec_dev_set_out_vol(esp_codec_dev_handle_t dev, int volume);
+int esp_codec_dev_set_out_mute(esp_codec_dev_handle_t dev, bool mute);
+int esp_codec_dev_set_in_gain(esp_codec_dev_handle_t dev, float db);
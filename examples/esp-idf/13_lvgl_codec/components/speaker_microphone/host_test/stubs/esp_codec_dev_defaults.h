@@ -0,0 +1,2 @@
+/* Host stub of the esp_codec_dev default interfaces, nothing is used from it */
+#pragma once
@@ -0,0 +1,10 @@
+/* Host stub of the esp-file-iterator API, the test implements the calls */
+#pragma once
+
+#include <stddef.h>
+
+typedef struct file_iterator_instance file_iterator_instance_t;
+
+file_iterator_instance_t *file_iterator_new(const char *base_path);
+int file_iterator_get_full_path_from_index(file_iterator_instance_t *i, int index, char *path, size_t len);
+int file_iterator_get_index(file_iterator_instance_t *i);
@@ -0,0 +1,8 @@
+/* Host stub of the FreeRTOS queues, the test implements the calls */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t item_size);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item);
@@ -0,0 +1,28 @@
+/* Host stub of the FreeRTOS semaphores, single threaded so they always succeed */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return (SemaphoreHandle_t)1;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    return pdTRUE;
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return (SemaphoreHandle_t)1;
+}
+
+static inline void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+}
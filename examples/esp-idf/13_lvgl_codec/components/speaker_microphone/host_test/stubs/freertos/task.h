@@ -0,0 +1,10 @@
+/* Host stub of the FreeRTOS tasks, the test implements the calls */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+BaseType_t xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg, int prio, TaskHandle_t *handle);
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack, void *arg, int prio,
+                                   TaskHandle_t *handle, int core);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelete(TaskHandle_t handle);
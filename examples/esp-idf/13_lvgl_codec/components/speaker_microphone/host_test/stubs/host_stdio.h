@@ -0,0 +1,10 @@
+/* Host stub of the newlib stdio extras, included ahead of every file: fpos_t is a
+ * number and funopen() exists, as on the ESP32. The test implements funopen(). */
+#pragma once
+
+#include <stdio.h>
+
+#define fpos_t long
+
+FILE *funopen(const void *cookie, int (*readfn)(void *, char *, int), int (*writefn)(void *, const char *, int),
+              fpos_t (*seekfn)(void *, fpos_t, int), int (*closefn)(void *));
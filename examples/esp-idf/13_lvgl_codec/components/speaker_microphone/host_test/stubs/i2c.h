@@ -0,0 +1,2 @@
+/* Host stub of the board I2C header, nothing is used from it */
+#pragma once
@@ -0,0 +1,2 @@
+/* Host stub of the IO expander header, nothing is used from it */
+#pragma once
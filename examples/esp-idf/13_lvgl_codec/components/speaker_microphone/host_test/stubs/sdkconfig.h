@@ -0,0 +1,2 @@
+/* Host stub of the generated configuration, nothing is read from it */
+#pragma once
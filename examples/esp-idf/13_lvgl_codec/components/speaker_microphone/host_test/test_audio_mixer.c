@@ -0,0 +1,233 @@
+/*****************************************************************************
+ * | File         :   test_audio_mixer.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the mixer resampler
+ * | Info         :
+ * |                 Runs src_design() and src_mix() of audio_mixer.c on pure
+ * |                 tones at 16, 22.05 and 48 kHz: checks the passband gain,
+ * |                 the images and aliases in the stopband and measures the
+ * |                 cost of one source per output block.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "../audio_mixer.c"
+
+#define OUT_FRAMES      (AUDIO_MIXER_SAMPLE_RATE)       // One second of output per tone
+#define SETTLE_FRAMES   (AUDIO_MIXER_FRAME_SAMPLES)     // Output skipped while the filter history fills
+#define TONE_AMP        (16000.0)
+#define COST_BLOCKS     (2000)
+
+static int failures;
+
+#define CHECK(cond) do {                                                    \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/**************************************************************************************************
+ *
+ * Stubs
+ *
+ **************************************************************************************************/
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name, uint32_t stack, void *arg, int prio,
+                                   TaskHandle_t *handle, int core)
+{
+    *handle = (TaskHandle_t)1;
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) { }
+esp_err_t speaker_codec_set_fs(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch) { return ESP_OK; }
+esp_err_t speaker_i2s_write(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms)
+{
+    *bytes_written = len;
+    return ESP_OK;
+}
+
+/**************************************************************************************************
+ *
+ * Measurement
+ *
+ **************************************************************************************************/
+
+static float out[OUT_FRAMES];
+static uint32_t out_step;                   // Step of the last run, the output tone is off by its rounding
+
+// Resample a tone through a fresh source, the left channel of the output lands in out[]
+static void run_tone(uint32_t rate, double freq)
+{
+    static audio_mixer_source_t src;
+    static int32_t acc[AUDIO_MIXER_FRAME_SAMPLES * 2];
+    uint64_t in = 0;
+    uint32_t done = 0;
+
+    memset(&src, 0, sizeof(src));
+    src.gain = AUDIO_MIXER_GAIN_UNITY;
+    src_design(&src, rate);
+    out_step = src.step;
+
+    while (done < OUT_FRAMES) {
+        // Top up work[] as the ring would, the source never runs dry
+        for (uint32_t i = src.fill; i < WORK_FRAMES; i++, in++) {
+            const int16_t v = (int16_t)lrint(TONE_AMP * sin(2.0 * M_PI * freq * in / rate));
+            src.work[2 * i] = v;
+            src.work[2 * i + 1] = v;
+        }
+        src.fill = WORK_FRAMES;
+
+        memset(acc, 0, sizeof(acc));
+        uint32_t n = src_mix(&src, acc, AUDIO_MIXER_FRAME_SAMPLES);
+        for (uint32_t i = 0; i < n && done < OUT_FRAMES; i++) {
+            out[done++] = acc[2 * i];
+        }
+    }
+}
+
+// Fit a sine at the tone to out[], return its gain and the rest in dB below the tone
+static double fit_tone(uint32_t rate, double freq, double *rest_db)
+{
+    const double w = 2.0 * M_PI * freq / rate * out_step / 65536.0;
+    double ss = 0, cc = 0, sc = 0, ys = 0, yc = 0, err = 0;
+
+    for (int i = SETTLE_FRAMES; i < OUT_FRAMES; i++) {
+        const double s = sin(w * i);
+        const double c = cos(w * i);
+        ss += s * s;
+        cc += c * c;
+        sc += s * c;
+        ys += out[i] * s;
+        yc += out[i] * c;
+    }
+    const double det = ss * cc - sc * sc;
+    const double a = (ys * cc - yc * sc) / det;
+    const double b = (yc * ss - ys * sc) / det;
+
+    for (int i = SETTLE_FRAMES; i < OUT_FRAMES; i++) {
+        const double e = out[i] - (a * sin(w * i) + b * cos(w * i));
+        err += e * e;
+    }
+    err /= OUT_FRAMES - SETTLE_FRAMES;
+    *rest_db = 10.0 * log10(err / (TONE_AMP * TONE_AMP / 2));
+    return sqrt(a * a + b * b) / TONE_AMP;
+}
+
+// Everything in out[], in dB relative to the tone
+static double level_db(void)
+{
+    double sum = 0;
+
+    for (int i = SETTLE_FRAMES; i < OUT_FRAMES; i++) {
+        sum += (double)out[i] * out[i];
+    }
+    sum /= OUT_FRAMES - SETTLE_FRAMES;
+    return 10.0 * log10(sum / (TONE_AMP * TONE_AMP / 2));
+}
+
+// A tone the output can carry: passes at unity gain, images and aliases stay below max_rest_db
+static void check_pass(uint32_t rate, double freq, double max_dev_db, double max_rest_db)
+{
+    double rest_db;
+    double gain_db;
+
+    run_tone(rate, freq);
+    gain_db = 20.0 * log10(fit_tone(rate, freq, &rest_db));
+    printf("  %5" PRIu32 " Hz in, %5.0f Hz tone: gain %+6.2f dB, rest %6.1f dB\n", rate, freq, gain_db, rest_db);
+    CHECK(fabs(gain_db) <= max_dev_db);
+    CHECK(rest_db <= max_rest_db);
+}
+
+// A tone near the source Nyquist frequency: its image above it stays below max_db
+static void check_image(uint32_t rate, double freq, double max_db)
+{
+    double rest_db;
+
+    run_tone(rate, freq);
+    fit_tone(rate, freq, &rest_db);
+    printf("  %5" PRIu32 " Hz in, %5.0f Hz tone: image at %5.0f Hz %6.1f dB\n", rate, freq, rate - freq, rest_db);
+    CHECK(rest_db <= max_db);
+}
+
+// A tone above the output Nyquist frequency: whatever folds back stays below max_db
+static void check_stop(uint32_t rate, double freq, double max_db)
+{
+    double db;
+
+    run_tone(rate, freq);
+    db = level_db();
+    printf("  %5" PRIu32 " Hz in, %5.0f Hz tone: %6.1f dB folded back\n", rate, freq, db);
+    CHECK(db <= max_db);
+}
+
+// Time of one source in src_mix() per output block, as the mixer task sees it
+static void measure_cost(uint32_t rate)
+{
+    static audio_mixer_source_t src;
+    static int32_t acc[AUDIO_MIXER_FRAME_SAMPLES * 2];
+    int64_t mix_us = 0;
+
+    memset(&src, 0, sizeof(src));
+    src.gain = AUDIO_MIXER_GAIN_UNITY;
+    src_design(&src, rate);
+    srand(1);
+    for (int b = 0; b < COST_BLOCKS; b++) {
+        for (uint32_t i = src.fill * 2; i < WORK_FRAMES * 2; i++) {
+            src.work[i] = (int16_t)(rand() - RAND_MAX / 2);
+        }
+        src.fill = WORK_FRAMES;
+
+        const int64_t start_us = esp_timer_get_time();
+        src_mix(&src, acc, AUDIO_MIXER_FRAME_SAMPLES);
+        mix_us += esp_timer_get_time() - start_us;
+    }
+    printf("  %5" PRIu32 " Hz in: %.2f us per %d-frame block, %.1f per mille of a host core\n", rate,
+           (double)mix_us / COST_BLOCKS, AUDIO_MIXER_FRAME_SAMPLES, (double)mix_us * 1000 / COST_BLOCKS / BLOCK_US);
+    CHECK(mix_us > 0);
+}
+
+int main(void)
+{
+    static const uint32_t rates[] = { 16000, 22050, 48000 };
+
+    // Flat up to 30% of the lower rate, the 16-tap window is down less than 1 dB at 36%
+    printf("passband\n");
+    for (int i = 0; i < 3; i++) {
+        const double low = rates[i] < AUDIO_MIXER_SAMPLE_RATE ? rates[i] : AUDIO_MIXER_SAMPLE_RATE;
+        check_pass(rates[i], 1000, 0.1, -70);
+        check_pass(rates[i], 0.30 * low, 0.1, -70);
+        check_pass(rates[i], 0.36 * low, 1.0, -70);
+    }
+    check_pass(AUDIO_MIXER_SAMPLE_RATE, 1000, 0.01, -90);
+
+    // Upsampling leaves images at the source rate minus the tone, downsampling folds back
+    // what lies above 22.05 kHz; the short filter only has a few kHz to fall off in
+    printf("stopband\n");
+    check_image(16000, 0.40 * 16000, -50);
+    check_image(22050, 0.40 * 22050, -50);
+    check_stop(48000, 23000, -15);
+    check_stop(48000, 23500, -15);
+
+    printf("cost per source\n");
+    for (int i = 0; i < 3; i++) {
+        measure_cost(rates[i]);
+    }
+    measure_cost(AUDIO_MIXER_SAMPLE_RATE);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,372 @@
+/*****************************************************************************
+ * | File         :   test_codec_stream.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the gapless player stream
+ * | Info         :
+ * |                 Runs codec_dev.c on tagged MP3 stand-ins: checks that the
+ * |                 ID3 tags are stripped, that the decoder sees the bytes of
+ * |                 the queued track right after the current one, and that
+ * |                 other files, late pre-opens and replays are handled.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+#include "codec_dev.h"
+#include "speaker_microphone.h"
+#include "audio_mixer.h"
+#include "file_source.h"
+
+#define PAYLOAD_A   (100000)    // Audio bytes of the first track
+#define PAYLOAD_B   (70000)     // Audio bytes of the queued track
+#define READ_CHUNK  (1940)      // Odd read size, so reads straddle the track join
+
+static int failures;
+
+#define CHECK(cond) do {                                                    \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/**************************************************************************************************
+ *
+ * Simulated system
+ *
+ **************************************************************************************************/
+
+static int64_t now_us;                      // Simulated clock, moved by vTaskDelay()
+static void (*prefetch_fn)(void *);         // The task created by speaker_player_init()
+static char queue_item[128];
+static bool queue_full;
+static jmp_buf prefetch_exit;               // Leaves the prefetch task once its queue is empty
+static int file_opens;
+static FILE *played;                        // Stream handed to audio_player_play()
+static int track_changes;
+static char track_path[128];
+
+int64_t esp_timer_get_time(void)
+{
+    return now_us;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    now_us += (int64_t)ticks * 1000;
+}
+
+BaseType_t xTaskCreate(void (*fn)(void *), const char *name, uint32_t stack, void *arg, int prio, TaskHandle_t *handle)
+{
+    prefetch_fn = fn;
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t item_size)
+{
+    return (item_size == sizeof(queue_item)) ? (QueueHandle_t)1 : NULL;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item)
+{
+    memcpy(queue_item, item, sizeof(queue_item));
+    queue_full = true;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    if (!queue_full) {
+        longjmp(prefetch_exit, 1);
+    }
+    memcpy(item, queue_item, sizeof(queue_item));
+    queue_full = false;
+    return pdTRUE;
+}
+
+// Run the prefetch task until it waits for the next request
+static void run_prefetch(void)
+{
+    if (setjmp(prefetch_exit) == 0) {
+        prefetch_fn(NULL);
+    }
+}
+
+FILE *file_source_fopen(const char *path)
+{
+    file_opens++;
+    return fopen(path, "rb");
+}
+
+/* funopen() on top of the glibc cookie streams */
+typedef struct {
+    void *cookie;
+    int (*readfn)(void *, char *, int);
+    fpos_t (*seekfn)(void *, fpos_t, int);
+    int (*closefn)(void *);
+} host_cookie_t;
+
+static ssize_t host_read(void *c, char *buf, size_t len)
+{
+    host_cookie_t *hc = c;
+    return hc->readfn(hc->cookie, buf, (int)len);
+}
+
+static int host_seek(void *c, off64_t *offset, int whence)
+{
+    host_cookie_t *hc = c;
+    fpos_t pos = hc->seekfn(hc->cookie, (fpos_t)*offset, whence);
+
+    if (pos < 0) {
+        return -1;
+    }
+    *offset = pos;
+    return 0;
+}
+
+static int host_close(void *c)
+{
+    host_cookie_t *hc = c;
+    int ret = hc->closefn(hc->cookie);
+
+    free(hc);
+    return ret;
+}
+
+FILE *funopen(const void *cookie, int (*readfn)(void *, char *, int), int (*writefn)(void *, const char *, int),
+              fpos_t (*seekfn)(void *, fpos_t, int), int (*closefn)(void *))
+{
+    cookie_io_functions_t io = { .read = host_read, .seek = host_seek, .close = host_close };
+    host_cookie_t *hc = malloc(sizeof(host_cookie_t));
+
+    hc->cookie = (void *)cookie;
+    hc->readfn = readfn;
+    hc->seekfn = seekfn;
+    hc->closefn = closefn;
+    return fopencookie(hc, "r", io);
+}
+
+esp_err_t audio_player_new(audio_player_config_t config) { return ESP_OK; }
+esp_err_t audio_player_callback_register(audio_player_cb_t call_back, void *user_ctx) { return ESP_OK; }
+esp_err_t audio_player_delete(void) { return ESP_OK; }
+
+esp_err_t audio_player_play(FILE *fp)
+{
+    played = fp;
+    return ESP_OK;
+}
+
+static int mixer_source;
+esp_err_t audio_mixer_init(void) { return ESP_OK; }
+audio_mixer_source_t *audio_mixer_source_new(const char *name, uint32_t rate, uint32_t bits, uint32_t ch)
+{
+    return (audio_mixer_source_t *)&mixer_source;
+}
+esp_err_t audio_mixer_source_set_format(audio_mixer_source_t *src, uint32_t rate, uint32_t bits, uint32_t ch) { return ESP_OK; }
+void audio_mixer_source_set_mute(audio_mixer_source_t *src, bool mute) { }
+size_t audio_mixer_source_write(audio_mixer_source_t *src, const void *pcm, size_t len, uint32_t timeout_ms) { return len; }
+uint32_t audio_mixer_source_queued(audio_mixer_source_t *src) { return 0; }
+
+int esp_codec_dev_open(esp_codec_dev_handle_t dev, esp_codec_dev_sample_info_t *fs) { return 0; }
+int esp_codec_dev_close(esp_codec_dev_handle_t dev) { return 0; }
+int esp_codec_dev_read(esp_codec_dev_handle_t dev, void *data, int len) { return 0; }
+int esp_codec_dev_write(esp_codec_dev_handle_t dev, void *data, int len) { return 0; }
+int esp_codec_dev_set_out_vol(esp_codec_dev_handle_t dev, int volume) { return 0; }
+int esp_codec_dev_set_out_mute(esp_codec_dev_handle_t dev, bool mute) { return 0; }
+int esp_codec_dev_set_in_gain(esp_codec_dev_handle_t dev, float db) { return 0; }
+esp_codec_dev_handle_t speaker_init(void) { return NULL; }
+esp_codec_dev_handle_t microphone_init(void) { return NULL; }
+
+file_iterator_instance_t *file_iterator_new(const char *base_path) { return NULL; }
+int file_iterator_get_full_path_from_index(file_iterator_instance_t *i, int index, char *path, size_t len) { return 0; }
+int file_iterator_get_index(file_iterator_instance_t *i) { return 0; }
+
+/**************************************************************************************************
+ *
+ * Test tracks
+ *
+ **************************************************************************************************/
+
+// Audio byte i of a track, different per track so a wrong join shows
+static uint8_t payload_byte(int seed, long i)
+{
+    return (uint8_t)((i * 7 + (i >> 8) + seed) & 0xff);
+}
+
+// A stand-in MP3: optional ID3v2 tag (with footer), audio bytes, optional ID3v1 tag
+static void write_track(const char *path, int seed, long len, long id3v2_len, bool footer, bool id3v1)
+{
+    FILE *fp = fopen(path, "wb");
+
+    if (id3v2_len) {
+        uint8_t hdr[10] = { 'I', 'D', '3', 4, 0, footer ? 0x10 : 0,
+                            (id3v2_len >> 21) & 0x7f, (id3v2_len >> 14) & 0x7f, (id3v2_len >> 7) & 0x7f, id3v2_len & 0x7f
+                          };
+        fwrite(hdr, 1, sizeof(hdr), fp);
+        for (long i = 0; i < id3v2_len; i++) {
+            fputc(0xff, fp);                // Looks like a frame sync if it leaks into the audio
+        }
+        if (footer) {
+            hdr[0] = '3';
+            hdr[1] = 'D';
+            hdr[2] = 'I';
+            fwrite(hdr, 1, sizeof(hdr), fp);
+        }
+    }
+    for (long i = 0; i < len; i++) {
+        fputc(payload_byte(seed, i), fp);
+    }
+    if (id3v1) {
+        fwrite("TAG", 1, 3, fp);
+        for (int i = 3; i < 128; i++) {
+            fputc('t', fp);
+        }
+    }
+    fclose(fp);
+}
+
+static void track_cb(const char *file_path, void *user_data)
+{
+    track_changes++;
+    snprintf(track_path, sizeof(track_path), "%s", file_path);
+}
+
+// Read the stream to its end, return how many bytes follow the expected tracks in order
+static long read_stream(FILE *fp, int seed_a, long len_a, int seed_b, long len_b)
+{
+    static char buf[READ_CHUNK];
+    long pos = 0;
+    long bad = 0;
+    size_t n;
+
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        for (size_t i = 0; i < n; i++, pos++) {
+            uint8_t want = (pos < len_a) ? payload_byte(seed_a, pos) : payload_byte(seed_b, pos - len_a);
+            if ((uint8_t)buf[i] != want && bad++ == 0) {
+                printf("  first wrong byte at %ld\n", pos);
+            }
+        }
+    }
+    if (pos != len_a + len_b) {
+        printf("  read %ld bytes, expected %ld\n", pos, len_a + len_b);
+        bad++;
+    }
+    return bad;
+}
+
+/**************************************************************************************************
+ *
+ * Tests
+ *
+ **************************************************************************************************/
+
+// The player probes the format, rewinds, then decodes through to the queued track
+static void test_gapless_join(void)
+{
+    speaker_player_gapless_stats_t stats;
+    char probe[4096];
+
+    printf("gapless join\n");
+    write_track("a.mp3", 1, PAYLOAD_A, 20, false, true);
+    write_track("b.mp3", 2, PAYLOAD_B, 30, true, true);
+
+    CHECK(speaker_player_play_file("a.mp3") == ESP_OK);
+    CHECK(speaker_player_queue_file("b.mp3") == ESP_OK);
+    run_prefetch();
+    CHECK(file_opens == 2);
+
+    CHECK(fread(probe, 1, sizeof(probe), played) == sizeof(probe));
+    CHECK((uint8_t)probe[0] == payload_byte(1, 0));
+    CHECK(fseek(played, 0, SEEK_SET) == 0);
+    CHECK(read_stream(played, 1, PAYLOAD_A, 2, PAYLOAD_B) == 0);
+    CHECK(track_changes == 1 && strcmp(track_path, "b.mp3") == 0);
+    CHECK(speaker_player_is_playing_by_path("b.mp3"));
+    fclose(played);
+
+    speaker_player_get_gapless_stats(&stats);
+    CHECK(stats.queued == 1 && stats.prefetched == 1);
+    CHECK(stats.transitions == 1 && stats.late == 0 && stats.missed == 0);
+}
+
+// Only MP3s are joined, a queued WAV leaves the current track to end on its own
+static void test_no_join_other_format(void)
+{
+    speaker_player_gapless_stats_t stats;
+
+    printf("no join into a WAV\n");
+    write_track("c.wav", 3, 5000, 0, false, false);
+
+    CHECK(speaker_player_play_file("a.mp3") == ESP_OK);
+    CHECK(speaker_player_queue_file("c.wav") == ESP_OK);
+    run_prefetch();
+    CHECK(read_stream(played, 1, PAYLOAD_A, 0, 0) == 0);
+    CHECK(track_changes == 1);
+    fclose(played);
+
+    speaker_player_get_gapless_stats(&stats);
+    CHECK(stats.transitions == 1 && stats.missed == 1);
+    CHECK(speaker_player_queue_file(NULL) == ESP_OK);
+    run_prefetch();
+}
+
+// A pre-open which doesn't finish in time: the track end waits, then gives up
+static void test_late_prefetch(void)
+{
+    speaker_player_gapless_stats_t stats;
+    int64_t start_us;
+
+    printf("late pre-open\n");
+    CHECK(speaker_player_play_file("a.mp3") == ESP_OK);
+    CHECK(speaker_player_queue_file("b.mp3") == ESP_OK);
+    start_us = now_us;
+    CHECK(read_stream(played, 1, PAYLOAD_A, 0, 0) == 0);
+    CHECK(now_us - start_us >= SPEAKER_PLAYER_PREFETCH_WAIT_MS * 1000);
+    CHECK(track_changes == 1);
+    fclose(played);
+
+    speaker_player_get_gapless_stats(&stats);
+    CHECK(stats.transitions == 1 && stats.missed == 2);
+}
+
+// Playing the queued path takes the pre-opened track instead of opening the file again
+static void test_play_queued(void)
+{
+    speaker_player_gapless_stats_t stats;
+    int opens;
+
+    printf("play the queued track\n");
+    run_prefetch();                         // Finish the pre-open left by the last test
+    opens = file_opens;
+    CHECK(speaker_player_play_file("b.mp3") == ESP_OK);
+    CHECK(file_opens == opens);
+    CHECK(read_stream(played, 2, PAYLOAD_B, 0, 0) == 0);
+    fclose(played);
+
+    speaker_player_get_gapless_stats(&stats);
+    CHECK(stats.started_from_queue == 1);
+}
+
+int main(void)
+{
+    CHECK(speaker_player_init() == ESP_OK);
+    CHECK(prefetch_fn != NULL);
+    speaker_player_register_track_callback(track_cb, NULL);
+
+    test_gapless_join();
+    test_no_join_other_format();
+    test_late_prefetch();
+    test_play_queued();
+    speaker_player_log_gapless_stats();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
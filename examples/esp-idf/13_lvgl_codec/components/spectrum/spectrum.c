@@ -0,0 +1,380 @@
+/*****************************************************************************
+ * | File         :   spectrum.c
+ * | Author       :   Waveshare team
+ * | Function     :   Real-time spectrum analyzer
+ * | Info         :
+ * |                 The player tap averages the PCM down to about 11 kHz mono
+ * |                 into a circular window guarded by a sequence counter. The
+ * |                 analyzer copies the window and drops the frame if the tap
+ * |                 wrote meanwhile, so the audio path never waits.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "codec_dev.h"
+#include "spectrum.h"
+#if SPECTRUM_USE_ESP_DSP
+#include "dsps_fft2r.h"
+#endif
+
+static const char *TAG = "spectrum";
+
+#define SPECTRUM_WIN_MASK (SPECTRUM_FFT_SIZE - 1)
+
+/* Tap side, written by the audio player task only */
+static int16_t s_win[SPECTRUM_FFT_SIZE];            // Circular window of decimated mono samples
+static volatile uint32_t s_win_pos = 0;             // Next write position, free running
+static volatile uint32_t s_seq = 0;                 // Odd while the tap writes s_win
+static volatile uint32_t s_rate = 0;                // Rate of the samples in s_win
+static uint32_t s_in_rate = 0;
+static uint32_t s_decim = 1;
+static int32_t s_acc = 0;
+static uint32_t s_acc_cnt = 0;
+
+/* Analyzer side */
+static int16_t s_frame[SPECTRUM_FFT_SIZE];          // Copy of the window in time order
+static int16_t s_fft[SPECTRUM_FFT_SIZE * 2] __attribute__((aligned(16)));   // Interleaved re, im
+static int16_t s_hann[SPECTRUM_FFT_SIZE];           // Q15
+#if !SPECTRUM_USE_ESP_DSP
+static int16_t s_twiddle[SPECTRUM_FFT_SIZE];        // Q15 cos, -sin pairs for k < N / 2
+#endif
+static uint16_t s_edge_bin[SPECTRUM_BAND_CNT + 1];
+static uint32_t s_edge_rate = 0;                    // Rate s_edge_bin was computed for
+static uint32_t s_last_seq = 0;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t s_bands[SPECTRUM_BAND_CNT];
+static bool s_bands_new = false;
+static uint64_t s_frame_us_sum = 0;
+static spectrum_stats_t s_stats;
+static TaskHandle_t s_task = NULL;
+
+/**************************************************************************************************
+ *
+ * FFT
+ *
+ **************************************************************************************************/
+
+#if !SPECTRUM_USE_ESP_DSP
+// Radix-2 decimation in time on Q15 data, every stage halves the values so nothing overflows
+static void spectrum_fft_c(int16_t *x)
+{
+    const int n = SPECTRUM_FFT_SIZE;
+
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            int16_t t = x[2 * i];
+            x[2 * i] = x[2 * j];
+            x[2 * j] = t;
+            t = x[2 * i + 1];
+            x[2 * i + 1] = x[2 * j + 1];
+            x[2 * j + 1] = t;
+        }
+    }
+
+    for (int len = 2; len <= n; len <<= 1) {
+        const int half = len >> 1;
+        const int step = n / len;
+        for (int i = 0; i < n; i += len) {
+            for (int k = 0; k < half; k++) {
+                const int32_t wr = s_twiddle[2 * k * step];
+                const int32_t wi = s_twiddle[2 * k * step + 1];
+                int16_t *a = &x[2 * (i + k)];
+                int16_t *b = &x[2 * (i + k + half)];
+                const int32_t tr = (b[0] * wr - b[1] * wi) >> 15;
+                const int32_t ti = (b[0] * wi + b[1] * wr) >> 15;
+                const int32_t ar = a[0], ai = a[1];
+                a[0] = (ar + tr) >> 1;
+                a[1] = (ai + ti) >> 1;
+                b[0] = (ar - tr) >> 1;
+                b[1] = (ai - ti) >> 1;
+            }
+        }
+    }
+}
+#endif
+
+static void spectrum_fft(int16_t *x)
+{
+#if SPECTRUM_USE_ESP_DSP
+    // Scales by 1/2 per stage like the C version, output in bit reversed order
+    dsps_fft2r_sc16(x, SPECTRUM_FFT_SIZE);
+    dsps_bit_rev_sc16_ansi(x, SPECTRUM_FFT_SIZE);
+#else
+    spectrum_fft_c(x);
+#endif
+}
+
+/**************************************************************************************************
+ *
+ * Analysis
+ *
+ **************************************************************************************************/
+
+static void spectrum_update_edges(uint32_t rate)
+{
+    static const uint16_t edges_hz[SPECTRUM_BAND_CNT + 1] = SPECTRUM_BAND_EDGES_HZ;
+
+    for (int b = 0; b <= SPECTRUM_BAND_CNT; b++) {
+        uint32_t bin = (edges_hz[b] * SPECTRUM_FFT_SIZE + rate / 2) / rate;
+        if (bin < 1) {
+            bin = 1;    // Skip DC
+        }
+        if (bin > SPECTRUM_FFT_SIZE / 2) {
+            bin = SPECTRUM_FFT_SIZE / 2;
+        }
+        s_edge_bin[b] = bin;
+    }
+    s_edge_rate = rate;
+}
+
+// Window, transform and sum the magnitudes of each band
+static void spectrum_analyze(const int16_t *frame, int16_t *fft, uint32_t rate, uint16_t bands[SPECTRUM_BAND_CNT])
+{
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        fft[2 * i] = (int16_t)(((int32_t)frame[i] * s_hann[i]) >> 15);
+        fft[2 * i + 1] = 0;
+    }
+
+    spectrum_fft(fft);
+
+    if (rate != s_edge_rate) {
+        spectrum_update_edges(rate);
+    }
+    for (int b = 0; b < SPECTRUM_BAND_CNT; b++) {
+        uint32_t sum = 0;
+        for (int k = s_edge_bin[b]; k < s_edge_bin[b + 1]; k++) {
+            // Alpha max plus beta min, within 7% of the true magnitude
+            const uint32_t re = abs(fft[2 * k]);
+            const uint32_t im = abs(fft[2 * k + 1]);
+            sum += re > im ? re + (im * 3 >> 3) : im + (re * 3 >> 3);
+        }
+        const uint32_t v = sum / SPECTRUM_BAND_DIV;
+        bands[b] = v > UINT16_MAX ? UINT16_MAX : v;
+    }
+}
+
+// Rising bars jump, falling bars decay
+static void spectrum_publish(const uint16_t bands[SPECTRUM_BAND_CNT])
+{
+    portENTER_CRITICAL(&s_lock);
+    for (int b = 0; b < SPECTRUM_BAND_CNT; b++) {
+        const uint16_t decayed = s_bands[b] - (s_bands[b] >> SPECTRUM_DECAY_SHIFT) - (s_bands[b] ? 1 : 0);
+        s_bands[b] = bands[b] > decayed ? bands[b] : decayed;
+    }
+    s_bands_new = true;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// Copy the window in time order, false if the tap wrote meanwhile
+static bool spectrum_snapshot(uint32_t *seq, uint32_t *rate)
+{
+    const uint32_t seq_start = __atomic_load_n(&s_seq, __ATOMIC_ACQUIRE);
+    if (seq_start & 1) {
+        return false;
+    }
+
+    const uint32_t pos = s_win_pos & SPECTRUM_WIN_MASK;
+    memcpy(s_frame, &s_win[pos], (SPECTRUM_FFT_SIZE - pos) * sizeof(int16_t));
+    memcpy(&s_frame[SPECTRUM_FFT_SIZE - pos], s_win, pos * sizeof(int16_t));
+    *rate = s_rate;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    *seq = seq_start;
+    return __atomic_load_n(&s_seq, __ATOMIC_RELAXED) == seq_start;
+}
+
+static void spectrum_task(void *arg)
+{
+    static const uint16_t silence[SPECTRUM_BAND_CNT] = { 0 };
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (1) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(1000 / SPECTRUM_RATE_HZ));
+
+        // No new audio: paused or stopped, let the bars fall
+        if (__atomic_load_n(&s_seq, __ATOMIC_ACQUIRE) == s_last_seq) {
+            spectrum_publish(silence);
+            portENTER_CRITICAL(&s_lock);
+            s_stats.idle++;
+            portEXIT_CRITICAL(&s_lock);
+            continue;
+        }
+
+        uint32_t seq, rate;
+        if (!spectrum_snapshot(&seq, &rate) || rate == 0) {
+            portENTER_CRITICAL(&s_lock);
+            s_stats.dropped++;
+            portEXIT_CRITICAL(&s_lock);
+            continue;
+        }
+        s_last_seq = seq;
+
+        uint16_t bands[SPECTRUM_BAND_CNT];
+        const int64_t start_us = esp_timer_get_time();
+        spectrum_analyze(s_frame, s_fft, rate, bands);
+        const uint32_t frame_us = (uint32_t)(esp_timer_get_time() - start_us);
+        spectrum_publish(bands);
+
+        portENTER_CRITICAL(&s_lock);
+        s_stats.frames++;
+        s_stats.frame_us_last = frame_us;
+        if (frame_us > s_stats.frame_us_max) {
+            s_stats.frame_us_max = frame_us;
+        }
+        s_frame_us_sum += frame_us;
+        portEXIT_CRITICAL(&s_lock);
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Spectrum Functions
+ *
+ **************************************************************************************************/
+
+void spectrum_feed(const int16_t *pcm, size_t samples, uint32_t rate, uint32_t ch, void *user_data)
+{
+    if (ch == 0 || rate == 0) {
+        return;
+    }
+
+    if (rate != s_in_rate) {
+        s_in_rate = rate;
+        s_decim = (rate + SPECTRUM_ANALYSIS_RATE / 2) / SPECTRUM_ANALYSIS_RATE;
+        if (s_decim < 1) {
+            s_decim = 1;
+        }
+        s_acc = 0;
+        s_acc_cnt = 0;
+        s_rate = rate / s_decim;
+    }
+
+    // Boxcar average over the decimation factor and the channels, a cheap anti-alias filter
+    const uint32_t div = s_decim * ch;
+    uint32_t pos = s_win_pos;
+    __atomic_fetch_add(&s_seq, 1, __ATOMIC_ACQ_REL);
+    for (size_t i = 0; i < samples; i++) {
+        s_acc += pcm[i];
+        if (++s_acc_cnt == div) {
+            s_win[pos++ & SPECTRUM_WIN_MASK] = (int16_t)(s_acc / (int32_t)div);
+            s_acc = 0;
+            s_acc_cnt = 0;
+        }
+    }
+    s_win_pos = pos;
+    __atomic_fetch_add(&s_seq, 1, __ATOMIC_RELEASE);
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.tap_samples += samples / div;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+bool spectrum_get_bands(uint16_t bands[SPECTRUM_BAND_CNT])
+{
+    portENTER_CRITICAL(&s_lock);
+    memcpy(bands, s_bands, sizeof(s_bands));
+    const bool changed = s_bands_new;
+    s_bands_new = false;
+    portEXIT_CRITICAL(&s_lock);
+    return changed;
+}
+
+esp_err_t spectrum_init(void)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        const float w = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * i / (SPECTRUM_FFT_SIZE - 1)));
+        s_hann[i] = (int16_t)(w * 32767.0f);
+    }
+#if SPECTRUM_USE_ESP_DSP
+    ESP_RETURN_ON_ERROR(dsps_fft2r_init_sc16(NULL, SPECTRUM_FFT_SIZE), TAG, "FFT init failed");
+#else
+    for (int k = 0; k < SPECTRUM_FFT_SIZE / 2; k++) {
+        const float a = 2.0f * (float)M_PI * k / SPECTRUM_FFT_SIZE;
+        s_twiddle[2 * k] = (int16_t)(cosf(a) * 32767.0f);
+        s_twiddle[2 * k + 1] = (int16_t)(-sinf(a) * 32767.0f);
+    }
+#endif
+
+    BaseType_t core_id = (SPECTRUM_TASK_CORE < 0) ? tskNO_AFFINITY : SPECTRUM_TASK_CORE;
+    if (xTaskCreatePinnedToCore(spectrum_task, "spectrum", SPECTRUM_TASK_STACK_SIZE, NULL,
+                                SPECTRUM_TASK_PRIORITY, &s_task, core_id) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    speaker_player_register_pcm_tap(spectrum_feed, NULL);
+    ESP_LOGI(TAG, "%d-point FFT at %d Hz on core %d", SPECTRUM_FFT_SIZE, SPECTRUM_RATE_HZ, SPECTRUM_TASK_CORE);
+    return ESP_OK;
+}
+
+uint32_t spectrum_benchmark(uint32_t rounds)
+{
+    static int16_t frame[SPECTRUM_FFT_SIZE];
+    static int16_t fft[SPECTRUM_FFT_SIZE * 2] __attribute__((aligned(16)));
+    uint16_t bands[SPECTRUM_BAND_CNT];
+
+    if (rounds == 0) {
+        return 0;
+    }
+
+    // A chirp, so the result does not depend on whether music is playing
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        frame[i] = (int16_t)(16000.0f * sinf((float)M_PI * i * i / SPECTRUM_FFT_SIZE));
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+    for (uint32_t i = 0; i < rounds; i++) {
+        spectrum_analyze(frame, fft, s_edge_rate ? s_edge_rate : SPECTRUM_ANALYSIS_RATE, bands);
+    }
+    const uint32_t avg_us = (uint32_t)((esp_timer_get_time() - start_us) / rounds);
+
+    ESP_LOGI(TAG, "Benchmark: %" PRIu32 " us per analysis (%s FFT), %" PRIu32 ".%" PRIu32 "%% of a core at %d Hz",
+             avg_us, SPECTRUM_USE_ESP_DSP ? "esp-dsp" : "C", avg_us * SPECTRUM_RATE_HZ / 10000,
+             avg_us * SPECTRUM_RATE_HZ / 1000 % 10, SPECTRUM_RATE_HZ);
+    return avg_us;
+}
+
+void spectrum_get_stats(spectrum_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    const uint64_t sum = s_frame_us_sum;
+    portEXIT_CRITICAL(&s_lock);
+
+    stats->analysis_rate = s_rate;
+    stats->frame_us_avg = stats->frames ? (uint32_t)(sum / stats->frames) : 0;
+    stats->cpu_permille = (uint16_t)(stats->frame_us_avg * SPECTRUM_RATE_HZ / 1000);
+}
+
+void spectrum_log_stats(void)
+{
+    spectrum_stats_t stats;
+    spectrum_get_stats(&stats);
+
+    ESP_LOGI(TAG, "%" PRIu32 " frames, %" PRIu32 " dropped, %" PRIu32 " idle, %" PRIu32 " samples at %" PRIu32 " Hz, "
+             "%" PRIu32 " us last, %" PRIu32 " us avg, %" PRIu32 " us max, cpu %u.%u%%",
+             stats.frames, stats.dropped, stats.idle, stats.tap_samples, stats.analysis_rate,
+             stats.frame_us_last, stats.frame_us_avg, stats.frame_us_max,
+             stats.cpu_permille / 10, stats.cpu_permille % 10);
+}
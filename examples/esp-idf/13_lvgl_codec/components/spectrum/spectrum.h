@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * | File         :   spectrum.h
+ * | Author       :   Waveshare team
+ * | Function     :   Real-time spectrum analyzer
+ * | Info         :
+ * |                 Taps the PCM output of the audio player, runs a fixed
+ * |                 point FFT on its own core and reduces the bins to the
+ * |                 four bands drawn by the music demo.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#ifndef __SPECTRUM_H
+#define __SPECTRUM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+/**
+ * Spectrum analyzer parameters, can be adjusted by users
+ *
+ */
+#define SPECTRUM_TASK_STACK_SIZE        (3 * 1024)  // The stack size of the analyzer task, in bytes
+#define SPECTRUM_TASK_PRIORITY          (2)         // The priority of the analyzer task, below the audio player
+#define SPECTRUM_TASK_CORE              (0)         // The core of the analyzer task, away from LVGL_PORT_TASK_CORE
+
+#define SPECTRUM_RATE_HZ                (30)        // Analyses per second, also the UI refresh rate of the bars
+#define SPECTRUM_FFT_BITS               (9)         // 512-point FFT
+#define SPECTRUM_FFT_SIZE               (1 << SPECTRUM_FFT_BITS)
+#define SPECTRUM_ANALYSIS_RATE          (11025)     // The tap averages the player output down to about this rate
+#define SPECTRUM_BAND_CNT               (4)
+#define SPECTRUM_BAND_EDGES_HZ          { 20, 60, 340, 2250, 4500 } // Band limits, as used for the old precomputed tables
+#define SPECTRUM_BAND_DIV               (480)       // Magnitude sum to bar height, full scale gives about 35
+#define SPECTRUM_DECAY_SHIFT            (2)         // Falling bars lose 1/4 of their height per analysis
+#define SPECTRUM_USE_ESP_DSP            (1)         // Use the esp-dsp FFT (PIE optimized on the ESP32-S3) instead of the C version
+
+/**
+ * @brief Spectrum analyzer statistics
+ */
+typedef struct {
+    uint32_t frames;                /*!< Analyses done */
+    uint32_t dropped;               /*!< Analyses skipped because the tap was writing the window */
+    uint32_t idle;                  /*!< Analyses skipped because no new audio arrived */
+    uint32_t tap_samples;           /*!< Decimated samples received from the player */
+    uint32_t analysis_rate;         /*!< Sample rate of the analysis window */
+    uint32_t frame_us_last;         /*!< Window, FFT and band reduction time of the last analysis */
+    uint32_t frame_us_avg;          /*!< Average of the above */
+    uint32_t frame_us_max;          /*!< Maximum of the above */
+    uint16_t cpu_permille;          /*!< Share of one core used at SPECTRUM_RATE_HZ */
+} spectrum_stats_t;
+
+/**
+ * @brief Start the analyzer task and tap the audio player output
+ *
+ * Call after speaker_player_init().
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t spectrum_init(void);
+
+/**
+ * @brief Feed PCM to the analyzer
+ *
+ * Registered as the audio player tap by spectrum_init(). Never blocks: the analyzer
+ * drops its frame when it catches the tap writing.
+ *
+ * @param pcm Interleaved 16-bit samples
+ * @param samples Number of samples, all channels counted
+ * @param rate Sample rate
+ * @param ch Channels
+ * @param user_data Not used
+ */
+void spectrum_feed(const int16_t *pcm, size_t samples, uint32_t rate, uint32_t ch, void *user_data);
+
+/**
+ * @brief Get the latest band levels
+ *
+ * @param bands Output levels, low to high, in the format of the music demo tables
+ * @return true if the levels changed since the last call
+ */
+bool spectrum_get_bands(uint16_t bands[SPECTRUM_BAND_CNT]);
+
+/**
+ * @brief Measure the cost of one analysis
+ *
+ * Runs the window, FFT and band reduction on a chirp. Takes a few milliseconds,
+ * call it from a task that may block, after spectrum_init() and before playback
+ * starts, as it shares the band edges with the analyzer task.
+ *
+ * @param rounds Number of analyses to time
+ * @return Average time of one analysis, in microseconds
+ */
+uint32_t spectrum_benchmark(uint32_t rounds);
+
+/**
+ * @brief Get the statistics
+ *
+ * @param stats Output statistics
+ */
+void spectrum_get_stats(spectrum_stats_t *stats);
+
+/**
+ * @brief Log the statistics
+ */
+void spectrum_log_stats(void);
+
+#endif
@@ -6,12 +6,14 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 
 #include "gt911.h"
 
@@ -27,7 +29,36 @@ static const char *TAG = "GT911";
 /* GT911 support key num */
 #define ESP_GT911_TOUCH_MAX_BUTTONS         (4)
 
+/* GT911 status byte plus 5 point slots of 8 bytes */
+#define ESP_GT911_TOUCH_MAX_POINTS          (5)
+#define ESP_GT911_READ_XY_BLOCK_LEN         (1 + ESP_GT911_TOUCH_MAX_POINTS * 8)
+
 esp_lcd_touch_handle_t tp_handle = NULL; // Declare a handle for the touch panel
+
+/* Interrupt driven reader: one producer (reader task), one consumer (queue) */
+static struct {
+    TaskHandle_t task;                                          // Reader task, woken by the INT edge
+    volatile int64_t irq_time_us;                               // Time of the last INT edge
+    touch_gt911_event_t ring[TOUCH_GT911_EVENT_QUEUE_LEN];      // Event queue storage
+    atomic_uint head;                                           // Written by the producer only
+    atomic_uint tail;                                           // Written by the consumer only
+    portMUX_TYPE lock;                                          // Protects latest
+    touch_gt911_event_t latest;                                 // Latest sample for raw consumers
+    touch_gt911_reader_stats_t stats;                           // Reader statistics
+} reader = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static uint8_t track_id[ESP_LCD_TOUCH_MAX_POINTS];                          // Track ids of the last sample, under tp->data.lock
+#if TOUCH_GT911_FILTER_ENABLE
+static touch_filter_t filter;                                               // Jitter filter and prediction of the reader
+static touch_filter_stats_t filter_stats;                                    // Statistics published by the reader
+static portMUX_TYPE filter_lock = portMUX_INITIALIZER_UNLOCKED;             // Protects the filter statistics read by other tasks
+#endif
+static touch_gt911_read_mode_t read_mode = TOUCH_GT911_DEFAULT_READ_MODE;   // How read_data fetches a sample
+static touch_gt911_bus_stats_t bus_stats;                                   // Bus usage counters
+static portMUX_TYPE bus_stats_lock = portMUX_INITIALIZER_UNLOCKED;          // Protects bus_stats
+static i2c_master_dev_handle_t bus_dev;                                     // GT911 through DEV_I2C (scheduler, retries), NULL to use the panel IO
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -208,19 +239,25 @@ static esp_err_t esp_lcd_touch_gt911_exit_sleep(esp_lcd_touch_handle_t tp)
 static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
 {
     esp_err_t err;
-    uint8_t buf[41];
+    uint8_t buf[ESP_GT911_READ_XY_BLOCK_LEN];
     uint8_t touch_cnt = 0;
     uint8_t clear = 0;
     size_t i = 0;
 
     assert(tp != NULL);
 
-    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, 1);
+    portENTER_CRITICAL(&bus_stats_lock);
+    bus_stats.sample_cnt++;
+    portEXIT_CRITICAL(&bus_stats_lock);
+
+    /* Burst mode fetches the status and every point slot in the same transaction */
+    bool burst = (read_mode == TOUCH_GT911_READ_MODE_BURST);
+    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, burst ? sizeof(buf) : 1);
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
 
-    /* Any touch data? */
+    /* Any touch data? Nothing to acknowledge while the buffer is not ready, so skip the clear write */
     if ((buf[0] & 0x80) == 0x00) {
-        touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
+        return ESP_OK;
 #if (ESP_LCD_TOUCH_MAX_BUTTONS > 0)
     } else if ((buf[0] & 0x10) == 0x10) {
         /* Read all keys */
@@ -258,9 +295,11 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
             return ESP_OK;
         }
 
-        /* Read all points */
-        err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG + 1, &buf[1], touch_cnt * 8);
-        ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+        /* Read all points, unless they came with the status already */
+        if (!burst) {
+            err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG + 1, &buf[1], touch_cnt * 8);
+            ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+        }
 
         /* Clear all */
         err = touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
@@ -274,6 +313,7 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
 
         /* Fill all coordinates */
         for (i = 0; i < touch_cnt; i++) {
+            track_id[i] = buf[(i * 8) + 1];
             tp->data.coords[i].x = ((uint16_t)buf[(i * 8) + 3] << 8) + buf[(i * 8) + 2];
             tp->data.coords[i].y = (((uint16_t)buf[(i * 8) + 5] << 8) + buf[(i * 8) + 4]);
             tp->data.coords[i].strength = (((uint16_t)buf[(i * 8) + 7] << 8) + buf[(i * 8) + 6]);
@@ -404,6 +444,23 @@ esp_lcd_touch_handle_t touch_gt911_init(i2c_master_bus_handle_t bus_device)
     // Create a new touch controller instance using the configured I2C and settings
     ESP_ERROR_CHECK(esp_lcd_touch_new_i2c_gt911(tp_io_handle, &tp_cfg, &tp_handle));
 
+    // Touch reads go through the bus scheduler ahead of all other traffic
+    ESP_ERROR_CHECK(DEV_I2C_Add_Device(tp_io_config.dev_addr, 400 * 1000, &bus_dev)); // The GT911 supports fast mode
+    i2c_sched_register_device(bus_dev, tp_io_config.dev_addr, "gt911", I2C_SCHED_PRIO_HIGH);
+    // A late sample is worth less than the next one: retry once, at once, and recover the bus on the second failure
+    const DEV_I2C_Policy tp_policy = {
+        .timeout_ms = 20,
+        .retries = 1,
+        .retry_delay_ms = 0,
+        .recover_after = 2,
+    };
+    DEV_I2C_Set_Policy(bus_dev, &tp_policy);
+
+#if TOUCH_GT911_USE_IRQ_READER
+    // Read the controller only when it signals new data on the INT pin
+    ESP_ERROR_CHECK(touch_gt911_reader_start(tp_handle));
+#endif
+
     return tp_handle;  // Return the touch controller handle
 }
 
@@ -412,6 +469,16 @@ touch_gt911_point_t touch_gt911_read_point(uint8_t max_touch_cnt)
 {
     touch_gt911_point_t data;  // Declare a structure to hold touch point data
 
+    /* The reader task owns the bus access, just return its latest sample */
+    if (touch_gt911_reader_is_running()) {
+        touch_gt911_event_t event;
+        touch_gt911_get_latest(&event);
+        data.cnt = (event.cnt > max_touch_cnt) ? max_touch_cnt : event.cnt;
+        memcpy(data.x, event.x, sizeof(data.x));
+        memcpy(data.y, event.y, sizeof(data.y));
+        return data;
+    }
+
     /* Read touch data from the touch controller */
     esp_lcd_touch_read_data(tp_handle);  // Read raw data from the touch controller
 
@@ -421,6 +488,232 @@ touch_gt911_point_t touch_gt911_read_point(uint8_t max_touch_cnt)
     return data;  // Return the touch point data
 }
 
+void touch_gt911_set_read_mode(touch_gt911_read_mode_t mode)
+{
+    read_mode = mode;
+    ESP_LOGI(TAG, "Read mode: %s", (mode == TOUCH_GT911_READ_MODE_BURST) ? "burst" : "split");
+}
+
+void touch_gt911_get_bus_stats(touch_gt911_bus_stats_t *stats, bool reset)
+{
+    assert(stats != NULL);
+
+    portENTER_CRITICAL(&bus_stats_lock);
+    *stats = bus_stats;
+    if (reset) {
+        memset(&bus_stats, 0, sizeof(bus_stats));
+        bus_stats.since_us = esp_timer_get_time();
+    }
+    portEXIT_CRITICAL(&bus_stats_lock);
+}
+
+void touch_gt911_log_bus_stats(void)
+{
+    touch_gt911_bus_stats_t stats;
+    touch_gt911_get_bus_stats(&stats, true);
+
+    int64_t elapsed_us = esp_timer_get_time() - stats.since_us;
+    if (elapsed_us <= 0 || stats.sample_cnt == 0) {
+        ESP_LOGI(TAG, "No samples");
+        return;
+    }
+    ESP_LOGI(TAG, "%s: %.1f samples/s, %.2f transactions/sample, %.1f bytes/sample, %.1f us/sample, bus busy %.2f%%",
+             (read_mode == TOUCH_GT911_READ_MODE_BURST) ? "burst" : "split",
+             stats.sample_cnt * 1e6 / elapsed_us,
+             (double)stats.transaction_cnt / stats.sample_cnt,
+             (double)stats.byte_cnt / stats.sample_cnt,
+             (double)stats.bus_time_us / stats.sample_cnt,
+             stats.bus_time_us * 100.0 / elapsed_us);
+}
+
+/*******************************************************************************
+* Interrupt driven reader
+*******************************************************************************/
+
+static void IRAM_ATTR touch_gt911_isr(esp_lcd_touch_handle_t tp)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    reader.irq_time_us = esp_timer_get_time();
+    reader.stats.irq_cnt++;
+    vTaskNotifyGiveFromISR(reader.task, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void touch_gt911_event_push(const touch_gt911_event_t *event)
+{
+    unsigned head = atomic_load_explicit(&reader.head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&reader.tail, memory_order_acquire);
+
+    portENTER_CRITICAL(&reader.lock);
+    reader.latest = *event;
+    portEXIT_CRITICAL(&reader.lock);
+
+    /* Keep the queued history, the latest copy above always reflects the current state */
+    if (head - tail >= TOUCH_GT911_EVENT_QUEUE_LEN) {
+        reader.stats.drop_cnt++;
+        return;
+    }
+    reader.ring[head & (TOUCH_GT911_EVENT_QUEUE_LEN - 1)] = *event;
+    atomic_store_explicit(&reader.head, head + 1, memory_order_release);
+    reader.stats.sample_cnt++;
+}
+
+static void touch_gt911_reader_task(void *arg)
+{
+    esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)arg;
+    touch_gt911_event_t event;
+    bool pressed = false;
+
+    while (1) {
+        /* Sleep until the next INT edge, only time out while a touch is held so a lost release edge is recovered */
+        TickType_t wait = pressed ? pdMS_TO_TICKS(TOUCH_GT911_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        if (ulTaskNotifyTake(pdTRUE, wait) > 0) {
+            event.timestamp_us = reader.irq_time_us;
+        } else {
+            event.timestamp_us = esp_timer_get_time();
+            reader.stats.poll_cnt++;
+        }
+
+        if (esp_lcd_touch_read_data(tp) != ESP_OK) {
+            reader.stats.err_cnt++;
+            continue;
+        }
+        esp_lcd_touch_get_coordinates(tp, event.x, event.y, event.strength, &event.cnt, ESP_LCD_TOUCH_MAX_POINTS);
+        portENTER_CRITICAL(&tp->data.lock);
+        memcpy(event.id, track_id, sizeof(event.id));
+        portEXIT_CRITICAL(&tp->data.lock);
+
+        /* Report a release only once */
+        if (event.cnt == 0 && !pressed) {
+            continue;
+        }
+#if TOUCH_GT911_FILTER_ENABLE
+        /* Only this task touches the filter state, the lock covers publishing its statistics */
+        touch_filter_stats_t delta;
+        touch_filter_apply(&filter, event.id, event.x, event.y, event.cnt, event.timestamp_us,
+                           tp->config.flags.swap_xy ? tp->config.y_max : tp->config.x_max,
+                           tp->config.flags.swap_xy ? tp->config.x_max : tp->config.y_max);
+        touch_filter_get_stats(&filter, &delta, true);
+        portENTER_CRITICAL(&filter_lock);
+        filter_stats.sample_cnt += delta.sample_cnt;
+        filter_stats.raw_jitter_q4 += delta.raw_jitter_q4;
+        filter_stats.out_jitter_q4 += delta.out_jitter_q4;
+        filter_stats.lag_q4 += delta.lag_q4;
+        portEXIT_CRITICAL(&filter_lock);
+#endif
+        pressed = (event.cnt > 0);
+        touch_gt911_event_push(&event);
+    }
+}
+
+esp_err_t touch_gt911_reader_start(esp_lcd_touch_handle_t tp)
+{
+    ESP_RETURN_ON_FALSE(tp && tp->config.int_gpio_num != GPIO_NUM_NC, ESP_ERR_INVALID_ARG, TAG, "INT pin is required");
+    if (reader.task) {
+        return ESP_OK;
+    }
+
+#if TOUCH_GT911_FILTER_ENABLE
+    touch_filter_init(&filter, NULL); // Default parameters
+#endif
+
+    BaseType_t core_id = (TOUCH_GT911_READER_TASK_CORE < 0) ? tskNO_AFFINITY : TOUCH_GT911_READER_TASK_CORE;
+    BaseType_t ret = xTaskCreatePinnedToCore(touch_gt911_reader_task, "gt911", TOUCH_GT911_READER_TASK_STACK_SIZE, tp,
+                                             TOUCH_GT911_READER_TASK_PRIORITY, &reader.task, core_id);
+    ESP_RETURN_ON_FALSE(ret == pdPASS, ESP_FAIL, TAG, "Failed to create reader task");
+
+    /* Clear the pending status so the controller raises a fresh edge */
+    touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, 0);
+    ESP_RETURN_ON_ERROR(esp_lcd_touch_register_interrupt_callback(tp, touch_gt911_isr), TAG, "Register ISR failed");
+    ESP_LOGI(TAG, "Interrupt driven reader started");
+
+    return ESP_OK;
+}
+
+bool touch_gt911_reader_is_running(void)
+{
+    return (reader.task != NULL);
+}
+
+bool touch_gt911_event_get(touch_gt911_event_t *event)
+{
+    unsigned tail = atomic_load_explicit(&reader.tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&reader.head, memory_order_acquire);
+
+    assert(event != NULL);
+
+    if (head == tail) {
+        return false;
+    }
+    *event = reader.ring[tail & (TOUCH_GT911_EVENT_QUEUE_LEN - 1)];
+    atomic_store_explicit(&reader.tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+bool touch_gt911_event_pending(void)
+{
+    return atomic_load_explicit(&reader.head, memory_order_acquire) != atomic_load_explicit(&reader.tail, memory_order_relaxed);
+}
+
+void touch_gt911_get_latest(touch_gt911_event_t *event)
+{
+    assert(event != NULL);
+
+    portENTER_CRITICAL(&reader.lock);
+    *event = reader.latest;
+    portEXIT_CRITICAL(&reader.lock);
+}
+
+void touch_gt911_filter_set_prediction(uint32_t predict_us)
+{
+#if TOUCH_GT911_FILTER_ENABLE
+    touch_filter_set_prediction(&filter, predict_us); // Single word write, picked up by the next sample
+#endif
+}
+
+void touch_gt911_filter_get_stats(touch_filter_stats_t *stats, bool reset)
+{
+    assert(stats != NULL);
+
+#if TOUCH_GT911_FILTER_ENABLE
+    portENTER_CRITICAL(&filter_lock);
+    *stats = filter_stats;
+    if (reset) {
+        memset(&filter_stats, 0, sizeof(filter_stats));
+    }
+    portEXIT_CRITICAL(&filter_lock);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void touch_gt911_log_filter_stats(void)
+{
+    touch_filter_stats_t stats;
+    touch_gt911_filter_get_stats(&stats, true);
+
+    if (stats.sample_cnt == 0) {
+        ESP_LOGI(TAG, "Filter: no samples");
+        return;
+    }
+    ESP_LOGI(TAG, "Filter: %"PRIu32" samples, jitter raw %.2f px, filtered %.2f px, lag %.2f px",
+             stats.sample_cnt,
+             stats.raw_jitter_q4 / 16.0 / stats.sample_cnt,
+             stats.out_jitter_q4 / 16.0 / stats.sample_cnt,
+             stats.lag_q4 / 16.0 / stats.sample_cnt);
+}
+
+void touch_gt911_reader_get_stats(touch_gt911_reader_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    *stats = reader.stats;
+}
+
 
 /*******************************************************************************
 * Private API function
@@ -455,13 +748,31 @@ static esp_err_t touch_gt911_read_cfg(esp_lcd_touch_handle_t tp)
     return ESP_OK;
 }
 
+static void touch_gt911_bus_account(uint32_t len, int64_t time_us)
+{
+    portENTER_CRITICAL(&bus_stats_lock);
+    bus_stats.transaction_cnt++;
+    bus_stats.byte_cnt += len;
+    bus_stats.bus_time_us += time_us;
+    portEXIT_CRITICAL(&bus_stats_lock);
+}
+
 static esp_err_t touch_gt911_i2c_read(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t *data, uint8_t len)
 {
     assert(tp != NULL);
     assert(data != NULL);
 
     /* Read data */
-    return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t ret;
+    if (bus_dev) {
+        ret = DEV_I2C_Write_Read(bus_dev, (uint8_t[]){reg >> 8, reg & 0xff}, 2, data, len);
+    } else {
+        ret = esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+    }
+    touch_gt911_bus_account(len, esp_timer_get_time() - start_us);
+
+    return ret;
 }
 
 static esp_err_t touch_gt911_i2c_write(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t data)
@@ -470,6 +781,15 @@ static esp_err_t touch_gt911_i2c_write(esp_lcd_touch_handle_t tp, uint16_t reg,
 
     // *INDENT-OFF*
     /* Write data */
-    return esp_lcd_panel_io_tx_param(tp->io, reg, (uint8_t[]){data}, 1);
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t ret;
+    if (bus_dev) {
+        ret = DEV_I2C_Write(bus_dev, (uint8_t[]){reg >> 8, reg & 0xff, data}, 3);
+    } else {
+        ret = esp_lcd_panel_io_tx_param(tp->io, reg, (uint8_t[]){data}, 1);
+    }
+    touch_gt911_bus_account(1, esp_timer_get_time() - start_us);
     // *INDENT-ON*
+
+    return ret;
 }
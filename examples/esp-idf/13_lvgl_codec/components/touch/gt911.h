@@ -19,6 +19,7 @@
 #include "rgb_lcd_port.h"
 
 #include "touch.h"
+#include "touch_filter.h"
 
 /**
  * @brief I2C address of the GT911 controller
@@ -33,6 +34,26 @@
 #define EXAMPLE_PIN_NUM_TOUCH_RST       (-1)            // Reset pin for the touch controller (set to -1 if not used)
 #define EXAMPLE_PIN_NUM_TOUCH_INT       (GPIO_NUM_4)    // Interrupt pin for the touch controller
 
+/**
+ * Interrupt driven reader related parameters, can be adjusted by users
+ *
+ * When enabled, the INT edge wakes a reader task which fetches all points in one go,
+ * so the bus stays idle while nobody touches the screen.
+ */
+#define TOUCH_GT911_USE_IRQ_READER          (1)         // Set to 1 to start the reader in touch_gt911_init()
+#define TOUCH_GT911_READER_TASK_STACK_SIZE  (3 * 1024)  // The stack size of the reader task, in bytes
+#define TOUCH_GT911_READER_TASK_PRIORITY    (4)         // The priority of the reader task
+#define TOUCH_GT911_READER_TASK_CORE        (0)         // The core of the reader task, `-1` means don't specify the core
+#define TOUCH_GT911_EVENT_QUEUE_LEN         (16)        // Length of the event queue, must be a power of 2
+#define TOUCH_GT911_RELEASE_TIMEOUT_MS      (100)       // Poll once if no interrupt arrives for this long while pressed
+#define TOUCH_GT911_FILTER_ENABLE           (1)         // Set to 1 to filter and predict the samples of the reader, see touch_filter.h
+
+/**
+ * Default read mode, see touch_gt911_read_mode_t
+ *
+ */
+#define TOUCH_GT911_DEFAULT_READ_MODE       (TOUCH_GT911_READ_MODE_BURST)
+
 /**
  * @brief GT911 Configuration Structure
  *
@@ -55,6 +76,50 @@ typedef struct {
     uint8_t cnt;                          /*!< Number of detected touch points */
 } touch_gt911_point_t;
 
+/**
+ * @brief How a sample is fetched from the controller
+ */
+typedef enum {
+    TOUCH_GT911_READ_MODE_SPLIT = 0,    /*!< Read status, then the touched points, then clear: 3 transactions */
+    TOUCH_GT911_READ_MODE_BURST,        /*!< Read status and all point slots at once, then clear: 2 transactions */
+} touch_gt911_read_mode_t;
+
+/**
+ * @brief Bus usage statistics of the touch controller
+ */
+typedef struct {
+    uint32_t sample_cnt;        /*!< Number of read_data calls */
+    uint32_t transaction_cnt;   /*!< Number of I2C transactions */
+    uint32_t byte_cnt;          /*!< Payload bytes transferred, register addresses excluded */
+    uint64_t bus_time_us;       /*!< Time spent inside I2C transactions, including the wait for the bus scheduler */
+    int64_t since_us;           /*!< Time the counters were last reset */
+} touch_gt911_bus_stats_t;
+
+/**
+ * @brief Timestamped touch sample produced by the interrupt driven reader
+ *
+ * A sample with `cnt == 0` reports the release of all points.
+ */
+typedef struct {
+    int64_t timestamp_us;                           /*!< Time of the INT edge, from esp_timer_get_time() */
+    uint16_t x[ESP_LCD_TOUCH_MAX_POINTS];           /*!< X coordinates of touch points */
+    uint16_t y[ESP_LCD_TOUCH_MAX_POINTS];           /*!< Y coordinates of touch points */
+    uint16_t strength[ESP_LCD_TOUCH_MAX_POINTS];    /*!< Strength of touch points */
+    uint8_t id[ESP_LCD_TOUCH_MAX_POINTS];           /*!< Track ids, stable while a finger stays down */
+    uint8_t cnt;                                    /*!< Number of detected touch points */
+} touch_gt911_event_t;
+
+/**
+ * @brief Statistics of the interrupt driven reader
+ */
+typedef struct {
+    uint32_t irq_cnt;       /*!< Number of INT edges */
+    uint32_t sample_cnt;    /*!< Number of samples pushed into the queue */
+    uint32_t drop_cnt;      /*!< Number of samples dropped because the queue was full */
+    uint32_t poll_cnt;      /*!< Number of reads triggered by the release timeout */
+    uint32_t err_cnt;       /*!< Number of failed reads */
+} touch_gt911_reader_stats_t;
+
 /**
  * @brief Create a new GT911 touch driver instance
  *
@@ -93,6 +158,101 @@ esp_lcd_touch_handle_t touch_gt911_init(i2c_master_bus_handle_t bus_device);
  */
 touch_gt911_point_t touch_gt911_read_point(uint8_t max_touch_cnt);
 
+/**
+ * @brief Select how samples are fetched from the controller
+ *
+ * @param mode Read mode
+ */
+void touch_gt911_set_read_mode(touch_gt911_read_mode_t mode);
+
+/**
+ * @brief Get the bus usage statistics
+ *
+ * @param stats Output statistics
+ * @param reset Set to true to restart the counters after reading them
+ */
+void touch_gt911_get_bus_stats(touch_gt911_bus_stats_t *stats, bool reset);
+
+/**
+ * @brief Log samples per second and bus occupancy since the last reset, then reset the counters
+ *
+ * Call it periodically after switching modes with touch_gt911_set_read_mode() to compare them.
+ */
+void touch_gt911_log_bus_stats(void);
+
+/**
+ * @brief Start the interrupt driven reader
+ *
+ * The INT edge wakes a task which reads the points, timestamps them and pushes
+ * them into a lock-free queue. Once started, touch_gt911_read_point() returns the
+ * latest sample without accessing the bus.
+ *
+ * @param tp Touch handle returned by touch_gt911_init()
+ * @return
+ *      - ESP_OK: Success (also when the reader is running already)
+ *      - ESP_ERR_INVALID_ARG: The INT pin is not connected
+ *      - ESP_FAIL: Failed to create the task
+ */
+esp_err_t touch_gt911_reader_start(esp_lcd_touch_handle_t tp);
+
+/**
+ * @brief Check whether the interrupt driven reader is running
+ *
+ * @return true if the reader is running
+ */
+bool touch_gt911_reader_is_running(void);
+
+/**
+ * @brief Take the oldest sample from the event queue
+ *
+ * @note The queue has a single consumer, normally the LVGL input device.
+ *
+ * @param event Output sample
+ * @return true if a sample was taken, false if the queue is empty
+ */
+bool touch_gt911_event_get(touch_gt911_event_t *event);
+
+/**
+ * @brief Check whether the event queue holds samples
+ *
+ * @return true if at least one sample is queued
+ */
+bool touch_gt911_event_pending(void);
+
+/**
+ * @brief Get a copy of the latest sample, it can be called from any task
+ *
+ * @param event Output sample
+ */
+void touch_gt911_get_latest(touch_gt911_event_t *event);
+
+/**
+ * @brief Set the prediction horizon of the reader filter
+ *
+ * @param predict_us Time from the INT edge until the point is visible, in us
+ */
+void touch_gt911_filter_set_prediction(uint32_t predict_us);
+
+/**
+ * @brief Get the jitter and lag statistics of the reader filter
+ *
+ * @param stats Output statistics
+ * @param reset Set to true to restart the counters after reading them
+ */
+void touch_gt911_filter_get_stats(touch_filter_stats_t *stats, bool reset);
+
+/**
+ * @brief Log the mean raw and filtered jitter and the lag since the last call, then reset the counters
+ */
+void touch_gt911_log_filter_stats(void);
+
+/**
+ * @brief Get the statistics of the interrupt driven reader
+ *
+ * @param stats Output statistics
+ */
+void touch_gt911_reader_get_stats(touch_gt911_reader_stats_t *stats);
+
 /**
  * @brief Touch IO configuration structure for GT911
  *
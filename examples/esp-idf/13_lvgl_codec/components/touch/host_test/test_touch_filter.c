@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * | File         :   test_touch_filter.c
+ * | Author       :   Waveshare team
+ * | Function     :   Host test of the touch filter
+ * | Info         :
+ * |                 Replays strokes with controller noise through
+ * |                 touch_filter_apply() with the default parameters and
+ * |                 checks the jitter and the lag against the true path.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "touch_filter.h"
+
+#define TEST_PERIOD_US      (10000)     // GT911 report period
+#define TEST_NOISE_PX       (2)         // Uniform noise of the reported points, +-px
+#define TEST_X_MAX          (800)
+#define TEST_Y_MAX          (480)
+
+typedef struct {
+    const char *name;
+    float speed;            // Finger speed along X, px/s
+    uint32_t duration_ms;   // Length of the stroke
+    uint8_t predict_order;  // Prediction of the filter, 0 measures the bare filter lag
+    float max_jitter_ratio; // Maximum filtered / raw jitter
+    float max_error_px;     // Maximum mean distance to the true position
+} test_stroke_t;
+
+static const test_stroke_t strokes[] = {
+    // A held finger is smoothed hard
+    { "hold",          0, 2000, 1, 0.20f,  1.0f },
+    // The bare filter trails a moving finger by about 28, 16 and 9 ms, the cutoff grows with the speed
+    { "slow 200",    200, 1500, 0, 0.25f,  7.0f },
+    { "drag 600",    600, 1000, 0, 0.40f, 12.0f },
+    { "flick 2000", 2000,  300, 0, 0.70f, 23.0f },
+    // The prediction brings the output close to where the finger will be at scan-out
+    { "drag 600 predicted",    600, 1000, 1, 0.45f,  5.5f },
+    // 40 px ahead at this speed, more than predict_max_px allows
+    { "flick 2000 predicted", 2000,  300, 1, 0.70f, 40.0f },
+};
+
+static uint32_t rng_state = 30;
+
+static int test_noise(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (int)((rng_state >> 16) % (2 * TEST_NOISE_PX + 1)) - TEST_NOISE_PX;
+}
+
+static int test_stroke(const test_stroke_t *s)
+{
+    touch_filter_config_t config = TOUCH_FILTER_CONFIG_DEFAULT();
+    touch_filter_t f;
+    touch_filter_stats_t stats;
+    const uint32_t settle = 5;  // Samples the filter needs to catch up with a finger already moving
+    uint32_t n = s->duration_ms * 1000 / TEST_PERIOD_US;
+    double error_sum = 0;
+    uint32_t error_cnt = 0;
+
+    config.predict_order = s->predict_order;
+    touch_filter_init(&f, &config);
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t t_us = 1000000 + (int64_t)i * TEST_PERIOD_US;
+        float x = 100 + s->speed * i * TEST_PERIOD_US / 1e6f;
+        uint8_t id = 1;
+        uint16_t px = (uint16_t)lrintf(x) + test_noise();
+        uint16_t py = 240 + test_noise();
+        touch_filter_apply(&f, &id, &px, &py, 1, t_us, TEST_X_MAX, TEST_Y_MAX);
+
+        // Compare with the finger at the time the output is meant for
+        float ahead_us = s->predict_order ? config.predict_us : 0;
+        float target = x + s->speed * ahead_us / 1e6f;
+        if (i >= settle) {
+            error_sum += hypotf(px - target, py - 240.0f);
+            error_cnt++;
+        }
+    }
+    touch_filter_get_stats(&f, &stats, false);
+
+    double raw = stats.raw_jitter_q4 / 16.0 / stats.sample_cnt;
+    double out = stats.out_jitter_q4 / 16.0 / stats.sample_cnt;
+    double error = error_sum / error_cnt;
+    int ok = (out <= raw * s->max_jitter_ratio) && (error <= s->max_error_px);
+    printf("%-22s jitter raw %.2f px, filtered %.2f px (%.0f%%, max %.0f%%), error %.2f px (max %.1f)",
+           s->name, raw, out, 100 * out / raw, 100 * s->max_jitter_ratio, error, s->max_error_px);
+    if (s->speed > 0) {
+        printf(", %.1f ms", error * 1000 / s->speed);
+    }
+    printf(" %s\n", ok ? "ok" : "FAIL");
+
+    return ok;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(strokes) / sizeof(strokes[0]); i++) {
+        failed += !test_stroke(&strokes[i]);
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/*****************************************************************************
+ * | File         :   touch_filter.c
+ * | Author       :   Waveshare team
+ * | Function     :   Touch coordinate filter and motion prediction
+ * | Info         :
+ * |                 1 Euro filter in fixed point, see touch_filter.h
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "touch_filter.h"
+
+#define TOUCH_FILTER_Q              (4)             // Positions are kept in 1/16 px
+#define TOUCH_FILTER_ALPHA_SHIFT    (15)            // Smoothing factors are Q15
+#define TOUCH_FILTER_TAU_NUM        (159154943LL)   // 1e9 / (2 * pi): tau[us] = TAU_NUM / fc[mHz]
+
+/* Smoothing factor of a first order low-pass: alpha = Te / (Te + tau) */
+static int32_t touch_filter_alpha(int64_t te_us, uint32_t cutoff_mhz)
+{
+    int64_t tau_us = TOUCH_FILTER_TAU_NUM / (cutoff_mhz ? cutoff_mhz : 1);
+    return (int32_t)((te_us << TOUCH_FILTER_ALPHA_SHIFT) / (te_us + tau_us));
+}
+
+static int32_t touch_filter_lowpass(int32_t prev, int32_t in, int32_t alpha)
+{
+    return prev + (int32_t)(((int64_t)(in - prev) * alpha) >> TOUCH_FILTER_ALPHA_SHIFT);
+}
+
+static uint32_t touch_filter_isqrt(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+static int32_t touch_filter_clamp(int32_t v, int32_t lo, int32_t hi)
+{
+    return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+static touch_filter_contact_t *touch_filter_get_contact(touch_filter_t *f, uint8_t id)
+{
+    touch_filter_contact_t *free_slot = NULL;
+
+    for (int i = 0; i < TOUCH_FILTER_MAX_CONTACTS; i++) {
+        if (f->contacts[i].active && f->contacts[i].id == id) {
+            return &f->contacts[i];
+        }
+        if (!f->contacts[i].active && free_slot == NULL) {
+            free_slot = &f->contacts[i];
+        }
+    }
+    if (free_slot) {
+        memset(free_slot, 0, sizeof(*free_slot));
+        free_slot->active = true;
+        free_slot->id = id;
+    }
+    return free_slot;
+}
+
+/* Filter one axis, returns the output position in 1/16 px */
+static int32_t touch_filter_axis(const touch_filter_config_t *cfg, int32_t raw_q4, int32_t *pos_q4, int32_t vel_q4,
+                                 int32_t prev_vel_q4, int32_t *acc_q4, int64_t te_us, int32_t alpha, int32_t alpha_d)
+{
+    *pos_q4 = touch_filter_lowpass(*pos_q4, raw_q4, alpha);
+
+    /* Acceleration from the change of the already filtered velocity */
+    int32_t acc_raw = (int32_t)(((int64_t)(vel_q4 - prev_vel_q4) * 1000000) / te_us);
+    *acc_q4 = touch_filter_lowpass(*acc_q4, acc_raw, alpha_d);
+
+    /* Predict where the finger will be after the pipeline latency */
+    int64_t t = cfg->predict_us;
+    int64_t shift = 0;
+    if (cfg->predict_order >= 1) {
+        shift += ((int64_t)vel_q4 * t) / 1000000;
+    }
+    if (cfg->predict_order >= 2) {
+        shift += ((int64_t)*acc_q4 * t / 1000000 * t) / 2000000;
+    }
+    int32_t max_shift = (int32_t)cfg->predict_max_px << TOUCH_FILTER_Q;
+    return *pos_q4 + touch_filter_clamp((int32_t)shift, -max_shift, max_shift);
+}
+
+void touch_filter_init(touch_filter_t *f, const touch_filter_config_t *config)
+{
+    const touch_filter_config_t def = TOUCH_FILTER_CONFIG_DEFAULT();
+
+    memset(f, 0, sizeof(*f));
+    f->config = config ? *config : def;
+}
+
+void touch_filter_set_prediction(touch_filter_t *f, uint32_t predict_us)
+{
+    f->config.predict_us = predict_us;
+}
+
+void touch_filter_apply(touch_filter_t *f, const uint8_t *id, uint16_t *x, uint16_t *y, uint8_t cnt,
+                        int64_t timestamp_us, uint16_t x_max, uint16_t y_max)
+{
+    bool seen[TOUCH_FILTER_MAX_CONTACTS] = { false };
+    const touch_filter_config_t *cfg = &f->config;
+
+    cnt = (cnt > TOUCH_FILTER_MAX_CONTACTS) ? TOUCH_FILTER_MAX_CONTACTS : cnt;
+
+    for (int i = 0; i < cnt; i++) {
+        touch_filter_contact_t *c = touch_filter_get_contact(f, id[i]);
+        if (c == NULL) {
+            continue;
+        }
+        seen[c - f->contacts] = true;
+
+        int32_t raw_x = (int32_t)x[i] << TOUCH_FILTER_Q;
+        int32_t raw_y = (int32_t)y[i] << TOUCH_FILTER_Q;
+        int64_t te_us = timestamp_us - c->last_us;
+
+        /* New contact or long gap: start from the raw point without history */
+        if (c->samples == 0 || te_us <= 0 || te_us > cfg->reset_gap_us) {
+            uint8_t keep_id = c->id;
+            memset(c, 0, sizeof(*c));
+            c->active = true;
+            c->id = keep_id;
+            c->x_q4[0] = c->x_q4[1] = c->x_q4[2] = raw_x;
+            c->y_q4[0] = c->y_q4[1] = c->y_q4[2] = raw_y;
+            c->out_x_q4[0] = c->out_x_q4[1] = raw_x;
+            c->out_y_q4[0] = c->out_y_q4[1] = raw_y;
+            c->last_us = timestamp_us;
+            c->samples = 1;
+            continue;
+        }
+
+        /* Velocity of the raw point against the last estimate, smoothed with the fixed derivative cutoff */
+        int32_t alpha_d = touch_filter_alpha(te_us, cfg->d_cutoff_mhz);
+        int32_t prev_vx = c->vx_q4;
+        int32_t prev_vy = c->vy_q4;
+        int32_t vx_raw = (int32_t)(((int64_t)(raw_x - c->x_q4[0]) * 1000000) / te_us);
+        int32_t vy_raw = (int32_t)(((int64_t)(raw_y - c->y_q4[0]) * 1000000) / te_us);
+        c->vx_q4 = touch_filter_lowpass(c->vx_q4, vx_raw, alpha_d);
+        c->vy_q4 = touch_filter_lowpass(c->vy_q4, vy_raw, alpha_d);
+
+        /* Cutoff grows with speed: heavy smoothing when still, little lag when moving */
+        uint32_t speed = touch_filter_isqrt((uint64_t)((int64_t)c->vx_q4 * c->vx_q4 + (int64_t)c->vy_q4 * c->vy_q4)) >> TOUCH_FILTER_Q;
+        uint32_t cutoff = cfg->min_cutoff_mhz + cfg->beta * speed;
+        int32_t alpha = touch_filter_alpha(te_us, cutoff);
+
+        int32_t out_x = touch_filter_axis(cfg, raw_x, &c->x_q4[0], c->vx_q4, prev_vx, &c->ax_q4, te_us, alpha, alpha_d);
+        int32_t out_y = touch_filter_axis(cfg, raw_y, &c->y_q4[0], c->vy_q4, prev_vy, &c->ay_q4, te_us, alpha, alpha_d);
+        out_x = touch_filter_clamp(out_x, 0, ((int32_t)x_max - 1) << TOUCH_FILTER_Q);
+        out_y = touch_filter_clamp(out_y, 0, ((int32_t)y_max - 1) << TOUCH_FILTER_Q);
+
+        /* Statistics once three samples of history exist */
+        if (c->samples >= 2) {
+            f->stats.sample_cnt++;
+            f->stats.raw_jitter_q4 += abs(raw_x - 2 * c->x_q4[1] + c->x_q4[2]) + abs(raw_y - 2 * c->y_q4[1] + c->y_q4[2]);
+            f->stats.out_jitter_q4 += abs(out_x - 2 * c->out_x_q4[0] + c->out_x_q4[1]) + abs(out_y - 2 * c->out_y_q4[0] + c->out_y_q4[1]);
+            f->stats.lag_q4 += touch_filter_isqrt((uint64_t)((int64_t)(out_x - raw_x) * (out_x - raw_x) + (int64_t)(out_y - raw_y) * (out_y - raw_y)));
+        }
+        c->x_q4[2] = c->x_q4[1];
+        c->x_q4[1] = raw_x;
+        c->y_q4[2] = c->y_q4[1];
+        c->y_q4[1] = raw_y;
+        c->out_x_q4[1] = c->out_x_q4[0];
+        c->out_x_q4[0] = out_x;
+        c->out_y_q4[1] = c->out_y_q4[0];
+        c->out_y_q4[0] = out_y;
+        c->last_us = timestamp_us;
+        c->samples++;
+
+        x[i] = (uint16_t)((out_x + (1 << (TOUCH_FILTER_Q - 1))) >> TOUCH_FILTER_Q);
+        y[i] = (uint16_t)((out_y + (1 << (TOUCH_FILTER_Q - 1))) >> TOUCH_FILTER_Q);
+    }
+
+    /* Contacts missing from this sample were lifted */
+    for (int i = 0; i < TOUCH_FILTER_MAX_CONTACTS; i++) {
+        if (!seen[i]) {
+            f->contacts[i].active = false;
+        }
+    }
+}
+
+void touch_filter_get_stats(touch_filter_t *f, touch_filter_stats_t *stats, bool reset)
+{
+    *stats = f->stats;
+    if (reset) {
+        memset(&f->stats, 0, sizeof(f->stats));
+    }
+}
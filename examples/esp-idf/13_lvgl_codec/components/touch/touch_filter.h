@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * | File         :   touch_filter.h
+ * | Author       :   Waveshare team
+ * | Function     :   Touch coordinate filter and motion prediction
+ * | Info         :
+ * |                 Per-contact 1 Euro filter (adaptive low-pass: smooth
+ * |                 when still, responsive when moving) followed by a
+ * |                 linear or quadratic prediction of where the finger
+ * |                 will be when the frame reaches the screen.
+ * |                 Fixed point only, positions are kept in 1/16 px.
+ * ----------------
+ * | This version :   V1.0
+ * | Date         :   2026-10-19
+ * | Info         :   Basic version
+ *
+ ******************************************************************************/
+
+#ifndef __TOUCH_FILTER_H
+#define __TOUCH_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TOUCH_FILTER_MAX_CONTACTS   (5)     // Matches ESP_LCD_TOUCH_MAX_POINTS
+
+/**
+ * @brief Filter parameters
+ */
+typedef struct {
+    uint32_t min_cutoff_mhz;    /*!< Cutoff frequency when still, in mHz. Lower removes more jitter */
+    uint32_t beta;              /*!< Cutoff increase per px/s of speed, in mHz. Higher reduces lag when moving */
+    uint32_t d_cutoff_mhz;      /*!< Cutoff frequency of the velocity estimate, in mHz */
+    uint8_t predict_order;      /*!< 0: no prediction, 1: linear, 2: quadratic */
+    uint32_t predict_us;        /*!< Prediction horizon, normally the pipeline latency, in us */
+    uint16_t predict_max_px;    /*!< Maximum distance the prediction may move a point, in px */
+    uint32_t reset_gap_us;      /*!< A contact idle for this long restarts without history, in us */
+} touch_filter_config_t;
+
+#define TOUCH_FILTER_CONFIG_DEFAULT()   \
+    {                                   \
+        .min_cutoff_mhz = 1000,         \
+        .beta = 7,                      \
+        .d_cutoff_mhz = 1000,           \
+        .predict_order = 1,             \
+        .predict_us = 20000,            \
+        .predict_max_px = 24,           \
+        .reset_gap_us = 100000,         \
+    }
+
+/**
+ * @brief Filter statistics, to tune the parameters against recorded traces
+ *
+ * Jitter is the mean absolute second difference of consecutive positions, which is
+ * close to zero for a steady or uniformly moving finger and grows with noise.
+ * Lag is the mean distance between the raw and the output position.
+ */
+typedef struct {
+    uint32_t sample_cnt;        /*!< Points filtered with enough history to be measured */
+    uint64_t raw_jitter_q4;     /*!< Sum of the raw jitter, 1/16 px */
+    uint64_t out_jitter_q4;     /*!< Sum of the output jitter, 1/16 px */
+    uint64_t lag_q4;            /*!< Sum of |output - raw|, 1/16 px */
+} touch_filter_stats_t;
+
+/**
+ * @brief State of one contact
+ */
+typedef struct {
+    bool active;                /*!< Slot in use */
+    uint8_t id;                 /*!< Track id reported by the controller */
+    int64_t last_us;            /*!< Time of the last sample */
+    int32_t x_q4[3];            /*!< Filtered X, and the raw X of the last two samples */
+    int32_t y_q4[3];            /*!< Filtered Y, and the raw Y of the last two samples */
+    int32_t vx_q4;              /*!< Filtered X velocity, 1/16 px/s */
+    int32_t vy_q4;              /*!< Filtered Y velocity, 1/16 px/s */
+    int32_t ax_q4;              /*!< Filtered X acceleration, 1/16 px/s^2 */
+    int32_t ay_q4;              /*!< Filtered Y acceleration, 1/16 px/s^2 */
+    int32_t out_x_q4[2];        /*!< Last two output X */
+    int32_t out_y_q4[2];        /*!< Last two output Y */
+    uint32_t samples;           /*!< Samples since the contact started */
+} touch_filter_contact_t;
+
+/**
+ * @brief Filter state, allocated by the caller
+ */
+typedef struct {
+    touch_filter_config_t config;                               /*!< Parameters */
+    touch_filter_contact_t contacts[TOUCH_FILTER_MAX_CONTACTS]; /*!< Per-contact state */
+    touch_filter_stats_t stats;                                 /*!< Statistics */
+} touch_filter_t;
+
+/**
+ * @brief Initialize the filter
+ *
+ * @param f Filter state
+ * @param config Parameters, NULL to use TOUCH_FILTER_CONFIG_DEFAULT()
+ */
+void touch_filter_init(touch_filter_t *f, const touch_filter_config_t *config);
+
+/**
+ * @brief Change the prediction horizon, e.g. after measuring the pipeline latency
+ *
+ * @param f Filter state
+ * @param predict_us Prediction horizon in us
+ */
+void touch_filter_set_prediction(touch_filter_t *f, uint32_t predict_us);
+
+/**
+ * @brief Filter the points of one sample in place
+ *
+ * Contacts are matched by their track id, ids missing from the sample are released.
+ *
+ * @param f Filter state
+ * @param id Track ids of the points
+ * @param x X coordinates, replaced by the filtered values
+ * @param y Y coordinates, replaced by the filtered values
+ * @param cnt Number of points
+ * @param timestamp_us Time of the sample
+ * @param x_max Output X is clamped to [0, x_max - 1]
+ * @param y_max Output Y is clamped to [0, y_max - 1]
+ */
+void touch_filter_apply(touch_filter_t *f, const uint8_t *id, uint16_t *x, uint16_t *y, uint8_t cnt,
+                        int64_t timestamp_us, uint16_t x_max, uint16_t y_max);
+
+/**
+ * @brief Get the statistics
+ *
+ * @param f Filter state
+ * @param stats Output statistics
+ * @param reset Set to true to restart the counters after reading them
+ */
+void touch_filter_get_stats(touch_filter_t *f, touch_filter_stats_t *stats, bool reset);
+
+#endif
@@ -14,12 +14,24 @@
 #include "codec_dev.h"  // Include I2C driver header for I2C functions
 #include "esp_check.h"    // Error handling macros
 #include "lvgl_port.h"    // LVGL porting functions for integration
+#include "backlight.h"    // Backlight fades and inactivity dimming
+#include "spectrum.h"     // Spectrum of the playing track for the UI
+#include "audio_mixer.h"  // Mixer of the music and the button clicks
+#include "i2c_sched.h"    // Scheduler of the shared I2C bus
 
 
 #include "user_lv_demo_music.h"
 
 static const char *TAG = "main";
 
+#define EXAMPLE_STATS_PERIOD_MS             (10 * 1000) // Period of the statistics logs, in milliseconds
+#define EXAMPLE_TOUCH_COMPARE_READ_MODES    (1)         // Set to 1 to read the touch in split mode for the first period, then in burst mode
+#define EXAMPLE_BACKLIGHT_LEVEL             (BACKLIGHT_DEFAULT_LEVEL) // Brightness chosen by the user, in percent
+#define EXAMPLE_BACKLIGHT_AMBIENT           (BACKLIGHT_AMBIENT_ENABLE) // Set to 1 to scale the brightness with the ambient light
+#define EXAMPLE_SPECTRUM_BENCHMARK_ROUNDS   (100)       // Analyses timed once at startup to log the spectrum cost, `0` skips it
+#define EXAMPLE_MIXER_BENCHMARK_ROUNDS      (100)       // Blocks resampled once at startup to log the mixer cost, `0` skips it
+#define EXAMPLE_MIXER_BENCHMARK_RATE        (48000)     // Source rate of the mixer benchmark, 44100 would not be resampled
+
 void app_main()
 {
     static esp_lcd_panel_handle_t panel_handle = NULL; // Declare a handle for the LCD panel
@@ -63,13 +75,50 @@ void app_main()
     speaker_codec_init();
     speaker_codec_volume_set(50, NULL);
     speaker_player_register_callback(speaker_callback, NULL);
+    speaker_player_register_track_callback(speaker_track_callback, NULL);
     speaker_player_init();
+    spectrum_init();
+#if EXAMPLE_SPECTRUM_BENCHMARK_ROUNDS
+    spectrum_benchmark(EXAMPLE_SPECTRUM_BENCHMARK_ROUNDS); // Before any track plays
+#endif
+#if EXAMPLE_MIXER_BENCHMARK_ROUNDS
+    audio_mixer_benchmark(EXAMPLE_MIXER_BENCHMARK_RATE, EXAMPLE_MIXER_BENCHMARK_ROUNDS);
+#endif
 
     // Lock the mutex due to the LVGL APIs are not thread-safe
     if (lvgl_port_lock(-1)) {
+        ESP_ERROR_CHECK(lvgl_port_fs_register('S', MOUNT_POINT)); // Album covers are read ahead by file_source
         user_lv_demo_music();
         // Release the mutex
         lvgl_port_unlock();
     }
-    wavesahre_rgb_lcd_bl_on(); // Turn on the LCD backlight
+    ESP_ERROR_CHECK(backlight_init()); // Fade the LCD backlight in, then dim it after inactivity
+    backlight_set_ambient(EXAMPLE_BACKLIGHT_AMBIENT);
+    backlight_set_level(EXAMPLE_BACKLIGHT_LEVEL, 0);
+
+    touch_gt911_bus_stats_t touch_stats;
+#if EXAMPLE_TOUCH_COMPARE_READ_MODES
+    // Split is how the touch was read before the burst mode, log one period of each to compare their bus load
+    touch_gt911_set_read_mode(TOUCH_GT911_READ_MODE_SPLIT);
+#endif
+    touch_gt911_get_bus_stats(&touch_stats, true);
+
+    for (int period = 0; ; period++) {
+        vTaskDelay(pdMS_TO_TICKS(EXAMPLE_STATS_PERIOD_MS));
+
+        touch_gt911_log_bus_stats();
+        touch_gt911_log_filter_stats();
+        backlight_log_stats(); // Time dimmed or off and the power saved against the user level
+        spectrum_log_stats();
+        speaker_player_log_gapless_stats(); // Gaps between queued tracks, measured at the decoder input
+        audio_mixer_log_stats();            // Mix time and the underruns of the music and click sources
+        lvgl_port_img_cache_log_stats();    // Swiping pinned covers leaves the card opens unchanged
+        i2c_sched_log_stats();              // Rate, busy time and queue latency of each device on the shared bus
+        DEV_I2C_Log_Stats();                // Retries, bus recoveries and utilization of the I2C bus
+#if EXAMPLE_TOUCH_COMPARE_READ_MODES
+        if (period == 0) {
+            touch_gt911_set_read_mode(TOUCH_GT911_READ_MODE_BURST);
+        }
+#endif
+    }
 }
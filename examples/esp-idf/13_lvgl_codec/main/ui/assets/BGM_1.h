@@ -1,1052 +0,0 @@
-const uint16_t BGM_1[][4] = {
-{ 0, 1, 10, 1, },
-{ 0, 1, 13, 2, },
-{ 0, 0, 18, 3, },
-{ 0, 0, 13, 2, },
-{ 0, 0, 13, 2, },
-{ 0, 0, 20, 2, },
-{ 0, 0, 14, 1, },
-{ 0, 0, 13, 1, },
-{ 0, 0, 16, 2, },
-{ 0, 0, 13, 1, },
-{ 0, 0, 10, 1, },
-{ 0, 0, 10, 1, },
-{ 0, 0, 8, 1, },
-{ 0, 0, 7, 1, },
-{ 0, 0, 8, 1, },
-{ 0, 0, 6, 1, },
-{ 0, 0, 5, 2, },
-{ 0, 0, 5, 1, },
-{ 0, 0, 3, 1, },
-{ 0, 0, 4, 1, },
-{ 0, 0, 5, 1, },
-{ 0, 0, 7, 1, },
-{ 0, 0, 19, 1, },
-{ 0, 0, 20, 2, },
-{ 0, 0, 9, 1, },
-{ 0, 0, 9, 2, },
-{ 0, 0, 11, 1, },
-{ 0, 0, 10, 1, },
-{ 0, 0, 15, 2, },
-{ 0, 0, 16, 2, },
-{ 0, 0, 13, 1, },
-{ 0, 0, 15, 2, },
-{ 0, 0, 13, 2, },
-{ 0, 0, 10, 1, },
-{ 0, 0, 15, 2, },
-{ 0, 0, 16, 2, },
-{ 0, 0, 11, 2, },
-{ 0, 0, 13, 2, },
-{ 0, 0, 15, 2, },
-{ 0, 0, 27, 3, },
-{ 0, 0, 34, 3, },
-{ 0, 0, 16, 2, },
-{ 0, 0, 8, 1, },
-{ 0, 0, 8, 1, },
-{ 0, 0, 7, 1, },
-{ 0, 0, 6, 1, },
-{ 0, 0, 7, 1, },
-{ 0, 0, 5, 1, },
-{ 0, 0, 5, 1, },
-{ 0, 0, 8, 1, },
-{ 0, 0, 7, 1, },
-{ 0, 0, 7, 2, },
-{ 0, 1, 12, 2, },
-{ 0, 0, 10, 1, },
-{ 0, 0, 9, 1, },
-{ 0, 0, 12, 1, },
-{ 0, 0, 11, 1, },
-{ 0, 0, 14, 1, },
-{ 0, 0, 18, 2, },
-{ 0, 1, 14, 1, },
-{ 0, 1, 13, 1, },
-{ 0, 0, 14, 2, },
-{ 0, 0, 12, 2, },
-{ 0, 0, 10, 2, },
-{ 0, 0, 10, 2, },
-{ 0, 0, 10, 1, },
-{ 0, 0, 11, 1, },
-{ 0, 0, 12, 1, },
-{ 0, 0, 11, 1, },
-{ 0, 1, 21, 2, },
-{ 0, 2, 20, 3, },
-{ 0, 1, 9, 2, },
-{ 0, 0, 8, 2, },
-{ 0, 0, 8, 2, },
-{ 0, 0, 6, 1, },
-{ 0, 0, 5, 1, },
-{ 0, 0, 5, 1, },
-{ 0, 0, 4, 2, },
-{ 0, 0, 6, 2, },
-{ 0, 0, 7, 2, },
-{ 0, 0, 6, 2, },
-{ 0, 0, 9, 2, },
-{ 0, 0, 11, 2, },
-{ 0, 0, 9, 2, },
-{ 0, 0, 9, 3, },
-{ 0, 0, 10, 2, },
-{ 0, 1, 16, 2, },
-{ 0, 5, 30, 5, },
-{ 0, 3, 23, 5, },
-{ 0, 0, 13, 3, },
-{ 0, 0, 15, 2, },
-{ 0, 0, 13, 2, },
-{ 0, 1, 10, 3, },
-{ 0, 2, 11, 4, },
-{ 0, 1, 10, 4, },
-{ 0, 0, 9, 4, },
-{ 0, 0, 10, 3, },
-{ 0, 0, 9, 2, },
-{ 0, 2, 10, 3, },
-{ 0, 4, 15, 3, },
-{ 0, 3, 12, 3, },
-{ 0, 2, 8, 4, },
-{ 0, 2, 10, 4, },
-{ 0, 1, 9, 3, },
-{ 0, 1, 7, 3, },
-{ 0, 1, 8, 3, },
-{ 0, 1, 7, 3, },
-{ 0, 2, 9, 3, },
-{ 0, 1, 10, 3, },
-{ 0, 1, 9, 3, },
-{ 0, 1, 9, 4, },
-{ 0, 1, 10, 4, },
-{ 0, 1, 8, 3, },
-{ 0, 2, 11, 3, },
-{ 0, 3, 15, 4, },
-{ 0, 4, 13, 3, },
-{ 0, 4, 18, 5, },
-{ 0, 7, 21, 6, },
-{ 0, 6, 13, 5, },
-{ 0, 3, 15, 5, },
-{ 0, 2, 17, 4, },
-{ 0, 1, 13, 3, },
-{ 0, 1, 17, 3, },
-{ 0, 2, 19, 5, },
-{ 0, 2, 15, 5, },
-{ 0, 1, 16, 4, },
-{ 0, 1, 18, 5, },
-{ 0, 1, 15, 5, },
-{ 0, 1, 11, 4, },
-{ 0, 1, 12, 3, },
-{ 0, 2, 13, 4, },
-{ 0, 2, 15, 4, },
-{ 0, 1, 14, 3, },
-{ 0, 3, 14, 3, },
-{ 0, 8, 23, 7, },
-{ 0, 6, 20, 6, },
-{ 0, 1, 15, 5, },
-{ 0, 1, 14, 3, },
-{ 0, 1, 13, 3, },
-{ 0, 2, 14, 3, },
-{ 0, 3, 19, 4, },
-{ 0, 2, 20, 5, },
-{ 0, 2, 19, 4, },
-{ 0, 4, 19, 3, },
-{ 0, 4, 17, 4, },
-{ 0, 3, 17, 3, },
-{ 0, 3, 18, 3, },
-{ 0, 2, 17, 3, },
-{ 0, 2, 17, 3, },
-{ 0, 2, 19, 3, },
-{ 0, 2, 18, 3, },
-{ 0, 2, 16, 3, },
-{ 0, 2, 18, 3, },
-{ 0, 3, 19, 3, },
-{ 0, 2, 20, 3, },
-{ 0, 2, 19, 2, },
-{ 0, 1, 18, 3, },
-{ 0, 1, 17, 2, },
-{ 0, 1, 18, 2, },
-{ 0, 1, 14, 2, },
-{ 0, 1, 17, 2, },
-{ 0, 1, 20, 2, },
-{ 0, 1, 16, 2, },
-{ 0, 1, 17, 2, },
-{ 0, 1, 17, 2, },
-{ 0, 1, 14, 2, },
-{ 0, 1, 16, 2, },
-{ 0, 1, 18, 2, },
-{ 0, 1, 15, 2, },
-{ 0, 1, 17, 2, },
-{ 0, 1, 20, 3, },
-{ 0, 1, 18, 2, },
-{ 0, 1, 15, 1, },
-{ 0, 1, 20, 2, },
-{ 0, 1, 19, 2, },
-{ 0, 1, 16, 2, },
-{ 0, 1, 14, 1, },
-{ 0, 1, 18, 2, },
-{ 0, 1, 19, 2, },
-{ 0, 1, 15, 2, },
-{ 0, 1, 15, 2, },
-{ 0, 0, 20, 2, },
-{ 0, 0, 21, 2, },
-{ 0, 0, 19, 2, },
-{ 0, 0, 16, 1, },
-{ 0, 0, 13, 1, },
-{ 0, 0, 14, 1, },
-{ 0, 0, 18, 2, },
-{ 0, 0, 17, 2, },
-{ 0, 0, 16, 2, },
-{ 0, 0, 15, 2, },
-{ 0, 2, 14, 1, },
-{ 2, 33, 27, 11, },
-{ 10, 65, 36, 15, },
-{ 13, 46, 20, 10, },
-{ 21, 23, 14, 7, },
-{ 20, 9, 14, 3, },
-{ 14, 5, 13, 4, },
-{ 19, 6, 23, 4, },
-{ 19, 7, 35, 6, },
-{ 18, 7, 28, 5, },
-{ 18, 8, 23, 3, },
-{ 18, 8, 24, 4, },
-{ 18, 8, 20, 4, },
-{ 18, 7, 23, 5, },
-{ 18, 7, 28, 5, },
-{ 18, 8, 25, 4, },
-{ 18, 7, 22, 3, },
-{ 18, 7, 25, 3, },
-{ 18, 7, 20, 2, },
-{ 18, 7, 26, 3, },
-{ 18, 7, 31, 6, },
-{ 17, 7, 21, 5, },
-{ 17, 7, 18, 4, },
-{ 17, 7, 20, 3, },
-{ 17, 8, 25, 9, },
-{ 17, 10, 67, 33, },
-{ 16, 9, 78, 41, },
-{ 17, 7, 49, 25, },
-{ 17, 7, 27, 10, },
-{ 17, 7, 18, 3, },
-{ 17, 7, 16, 2, },
-{ 17, 7, 16, 3, },
-{ 17, 7, 19, 5, },
-{ 17, 6, 16, 4, },
-{ 16, 6, 15, 3, },
-{ 16, 6, 15, 2, },
-{ 15, 5, 17, 2, },
-{ 15, 6, 35, 5, },
-{ 14, 6, 31, 5, },
-{ 13, 5, 19, 4, },
-{ 13, 5, 19, 3, },
-{ 12, 5, 18, 3, },
-{ 11, 4, 18, 2, },
-{ 10, 4, 25, 4, },
-{ 9, 4, 22, 5, },
-{ 8, 4, 18, 3, },
-{ 7, 3, 25, 5, },
-{ 5, 2, 23, 5, },
-{ 4, 2, 17, 3, },
-{ 3, 3, 24, 5, },
-{ 1, 3, 23, 4, },
-{ 0, 4, 17, 3, },
-{ 0, 3, 20, 3, },
-{ 0, 2, 17, 3, },
-{ 0, 2, 18, 3, },
-{ 0, 2, 25, 8, },
-{ 0, 2, 22, 8, },
-{ 0, 2, 19, 3, },
-{ 0, 1, 20, 2, },
-{ 0, 1, 14, 2, },
-{ 0, 2, 17, 3, },
-{ 0, 2, 28, 3, },
-{ 0, 2, 25, 3, },
-{ 0, 1, 18, 2, },
-{ 0, 1, 19, 2, },
-{ 0, 1, 17, 2, },
-{ 0, 1, 21, 4, },
-{ 0, 1, 28, 9, },
-{ 0, 2, 23, 8, },
-{ 0, 2, 19, 4, },
-{ 0, 2, 19, 3, },
-{ 0, 2, 26, 8, },
-{ 0, 5, 69, 34, },
-{ 0, 4, 85, 44, },
-{ 0, 1, 57, 27, },
-{ 0, 1, 30, 12, },
-{ 0, 1, 22, 4, },
-{ 0, 13, 22, 6, },
-{ 6, 55, 34, 15, },
-{ 12, 60, 25, 12, },
-{ 16, 32, 7, 4, },
-{ 22, 15, 5, 1, },
-{ 15, 5, 6, 1, },
-{ 17, 6, 18, 3, },
-{ 19, 10, 43, 6, },
-{ 18, 9, 41, 5, },
-{ 18, 9, 25, 3, },
-{ 17, 14, 18, 3, },
-{ 17, 12, 11, 2, },
-{ 18, 14, 11, 3, },
-{ 15, 25, 17, 9, },
-{ 13, 21, 12, 10, },
-{ 14, 13, 6, 3, },
-{ 17, 7, 8, 1, },
-{ 17, 7, 8, 1, },
-{ 20, 27, 20, 10, },
-{ 19, 62, 36, 16, },
-{ 14, 49, 19, 8, },
-{ 19, 25, 5, 2, },
-{ 20, 10, 7, 1, },
-{ 14, 5, 7, 1, },
-{ 18, 7, 16, 1, },
-{ 19, 8, 30, 4, },
-{ 18, 9, 26, 5, },
-{ 17, 10, 21, 3, },
-{ 17, 9, 24, 3, },
-{ 18, 9, 19, 3, },
-{ 18, 9, 20, 5, },
-{ 18, 8, 28, 6, },
-{ 18, 9, 24, 6, },
-{ 18, 9, 21, 3, },
-{ 18, 8, 23, 2, },
-{ 18, 8, 18, 3, },
-{ 18, 8, 26, 3, },
-{ 17, 8, 38, 5, },
-{ 17, 7, 24, 4, },
-{ 17, 7, 14, 4, },
-{ 17, 7, 15, 3, },
-{ 17, 7, 20, 7, },
-{ 17, 9, 59, 33, },
-{ 16, 9, 73, 45, },
-{ 17, 7, 47, 28, },
-{ 17, 7, 26, 13, },
-{ 17, 7, 15, 4, },
-{ 17, 7, 11, 2, },
-{ 17, 6, 11, 3, },
-{ 17, 6, 16, 6, },
-{ 17, 6, 14, 4, },
-{ 16, 6, 16, 3, },
-{ 16, 6, 21, 3, },
-{ 16, 6, 27, 3, },
-{ 15, 6, 46, 7, },
-{ 14, 6, 36, 9, },
-{ 14, 5, 18, 7, },
-{ 13, 5, 18, 5, },
-{ 12, 5, 17, 3, },
-{ 11, 4, 14, 2, },
-{ 10, 4, 19, 4, },
-{ 9, 4, 21, 6, },
-{ 8, 3, 18, 6, },
-{ 7, 3, 17, 6, },
-{ 5, 2, 15, 4, },
-{ 4, 2, 15, 3, },
-{ 3, 3, 23, 5, },
-{ 1, 4, 20, 6, },
-{ 0, 4, 14, 4, },
-{ 0, 2, 16, 2, },
-{ 0, 1, 11, 2, },
-{ 0, 1, 13, 2, },
-{ 0, 2, 23, 6, },
-{ 0, 3, 21, 6, },
-{ 0, 3, 16, 3, },
-{ 0, 3, 17, 2, },
-{ 0, 4, 16, 2, },
-{ 1, 38, 27, 11, },
-{ 6, 66, 33, 13, },
-{ 15, 44, 14, 4, },
-{ 23, 21, 6, 1, },
-{ 21, 8, 7, 0, },
-{ 18, 3, 9, 1, },
-{ 21, 6, 22, 2, },
-{ 20, 7, 34, 6, },
-{ 18, 8, 25, 6, },
-{ 18, 7, 20, 6, },
-{ 18, 6, 19, 4, },
-{ 18, 6, 23, 6, },
-{ 18, 7, 64, 30, },
-{ 17, 7, 80, 44, },
-{ 17, 6, 50, 29, },
-{ 18, 6, 29, 13, },
-{ 18, 6, 21, 4, },
-{ 18, 12, 21, 5, },
-{ 17, 52, 33, 14, },
-{ 12, 63, 27, 11, },
-{ 15, 36, 10, 3, },
-{ 18, 19, 5, 0, },
-{ 13, 12, 6, 0, },
-{ 7, 16, 15, 1, },
-{ 4, 21, 32, 3, },
-{ 5, 22, 29, 4, },
-{ 10, 17, 21, 4, },
-{ 16, 12, 19, 3, },
-{ 19, 9, 18, 2, },
-{ 19, 6, 17, 2, },
-{ 19, 5, 22, 5, },
-{ 19, 5, 22, 7, },
-{ 18, 6, 18, 4, },
-{ 18, 7, 24, 3, },
-{ 17, 6, 23, 3, },
-{ 18, 24, 25, 9, },
-{ 15, 62, 36, 15, },
-{ 13, 53, 21, 11, },
-{ 18, 27, 9, 9, },
-{ 21, 12, 8, 3, },
-{ 14, 5, 8, 4, },
-{ 18, 6, 14, 4, },
-{ 19, 8, 28, 5, },
-{ 18, 9, 27, 6, },
-{ 18, 9, 20, 3, },
-{ 18, 8, 20, 4, },
-{ 18, 8, 16, 4, },
-{ 18, 8, 16, 4, },
-{ 18, 8, 23, 5, },
-{ 18, 9, 22, 4, },
-{ 18, 8, 15, 2, },
-{ 18, 8, 17, 2, },
-{ 18, 8, 16, 2, },
-{ 18, 8, 17, 2, },
-{ 17, 8, 26, 5, },
-{ 17, 8, 20, 5, },
-{ 17, 8, 15, 3, },
-{ 17, 8, 13, 2, },
-{ 17, 8, 17, 5, },
-{ 17, 9, 57, 29, },
-{ 16, 10, 80, 44, },
-{ 17, 8, 55, 30, },
-{ 17, 8, 32, 13, },
-{ 17, 8, 21, 4, },
-{ 17, 7, 17, 2, },
-{ 17, 7, 16, 3, },
-{ 17, 7, 20, 6, },
-{ 17, 7, 19, 5, },
-{ 16, 7, 17, 4, },
-{ 16, 7, 19, 3, },
-{ 15, 7, 19, 3, },
-{ 15, 7, 34, 5, },
-{ 14, 7, 37, 6, },
-{ 14, 6, 23, 5, },
-{ 13, 5, 21, 4, },
-{ 12, 5, 16, 2, },
-{ 11, 5, 12, 2, },
-{ 10, 5, 16, 4, },
-{ 9, 4, 19, 5, },
-{ 8, 4, 13, 3, },
-{ 7, 3, 16, 4, },
-{ 6, 2, 17, 5, },
-{ 4, 2, 10, 2, },
-{ 3, 2, 16, 3, },
-{ 2, 2, 19, 4, },
-{ 1, 2, 15, 2, },
-{ 0, 2, 16, 2, },
-{ 0, 2, 14, 2, },
-{ 0, 2, 16, 2, },
-{ 0, 2, 29, 7, },
-{ 0, 2, 27, 8, },
-{ 0, 3, 19, 4, },
-{ 0, 3, 19, 3, },
-{ 0, 2, 18, 2, },
-{ 0, 2, 19, 3, },
-{ 0, 2, 32, 5, },
-{ 0, 2, 33, 4, },
-{ 0, 2, 23, 3, },
-{ 0, 1, 23, 3, },
-{ 0, 1, 22, 3, },
-{ 0, 1, 21, 4, },
-{ 0, 1, 27, 9, },
-{ 0, 1, 22, 8, },
-{ 0, 1, 18, 4, },
-{ 0, 2, 19, 3, },
-{ 0, 2, 20, 4, },
-{ 0, 4, 59, 27, },
-{ 0, 4, 84, 44, },
-{ 0, 2, 56, 31, },
-{ 0, 2, 30, 14, },
-{ 0, 1, 16, 5, },
-{ 0, 7, 15, 4, },
-{ 4, 46, 30, 13, },
-{ 11, 64, 28, 13, },
-{ 14, 37, 8, 5, },
-{ 22, 18, 4, 1, },
-{ 17, 7, 4, 0, },
-{ 16, 5, 11, 1, },
-{ 20, 10, 34, 3, },
-{ 19, 10, 40, 5, },
-{ 19, 8, 27, 4, },
-{ 17, 13, 18, 4, },
-{ 16, 13, 12, 3, },
-{ 18, 11, 10, 3, },
-{ 16, 23, 18, 7, },
-{ 14, 23, 16, 10, },
-{ 13, 15, 8, 4, },
-{ 17, 8, 9, 1, },
-{ 16, 7, 14, 2, },
-{ 20, 19, 21, 8, },
-{ 20, 57, 35, 16, },
-{ 15, 55, 24, 11, },
-{ 17, 29, 5, 3, },
-{ 21, 13, 5, 1, },
-{ 14, 5, 5, 1, },
-{ 17, 6, 10, 1, },
-{ 19, 8, 24, 3, },
-{ 18, 8, 25, 4, },
-{ 17, 8, 16, 2, },
-{ 18, 8, 13, 2, },
-{ 17, 9, 10, 2, },
-{ 18, 8, 10, 3, },
-{ 18, 8, 14, 6, },
-{ 18, 8, 15, 6, },
-{ 18, 7, 12, 3, },
-{ 18, 8, 19, 2, },
-{ 18, 8, 19, 2, },
-{ 18, 7, 21, 3, },
-{ 17, 8, 32, 4, },
-{ 17, 8, 29, 5, },
-{ 17, 7, 17, 4, },
-{ 17, 8, 18, 3, },
-{ 17, 8, 20, 4, },
-{ 17, 9, 57, 25, },
-{ 16, 10, 86, 44, },
-{ 16, 9, 60, 33, },
-{ 17, 7, 35, 15, },
-{ 17, 7, 23, 6, },
-{ 17, 7, 21, 3, },
-{ 17, 7, 18, 3, },
-{ 17, 7, 18, 5, },
-{ 17, 7, 18, 5, },
-{ 16, 6, 14, 4, },
-{ 16, 7, 15, 3, },
-{ 15, 6, 20, 2, },
-{ 15, 6, 42, 6, },
-{ 14, 7, 40, 10, },
-{ 14, 6, 18, 9, },
-{ 13, 5, 12, 4, },
-{ 12, 5, 11, 2, },
-{ 12, 5, 9, 2, },
-{ 11, 5, 14, 3, },
-{ 10, 4, 18, 6, },
-{ 8, 4, 14, 6, },
-{ 7, 3, 13, 5, },
-{ 6, 2, 14, 5, },
-{ 4, 2, 14, 3, },
-{ 3, 2, 19, 4, },
-{ 2, 3, 19, 5, },
-{ 1, 3, 15, 5, },
-{ 0, 3, 20, 4, },
-{ 0, 1, 20, 4, },
-{ 0, 0, 17, 5, },
-{ 0, 1, 27, 6, },
-{ 0, 2, 27, 7, },
-{ 0, 2, 19, 4, },
-{ 0, 2, 21, 4, },
-{ 0, 2, 23, 5, },
-{ 1, 26, 28, 11, },
-{ 5, 64, 34, 15, },
-{ 12, 51, 17, 6, },
-{ 21, 26, 7, 1, },
-{ 22, 11, 7, 1, },
-{ 18, 4, 7, 1, },
-{ 20, 5, 13, 2, },
-{ 21, 5, 27, 5, },
-{ 18, 6, 23, 6, },
-{ 18, 5, 13, 4, },
-{ 18, 5, 11, 3, },
-{ 18, 5, 12, 3, },
-{ 18, 6, 47, 24, },
-{ 17, 6, 77, 44, },
-{ 17, 5, 57, 34, },
-{ 18, 5, 32, 15, },
-{ 18, 5, 23, 6, },
-{ 18, 7, 20, 4, },
-{ 18, 41, 32, 13, },
-{ 12, 65, 34, 13, },
-{ 14, 42, 12, 4, },
-{ 18, 23, 5, 1, },
-{ 14, 13, 8, 1, },
-{ 7, 14, 13, 1, },
-{ 4, 20, 31, 3, },
-{ 5, 23, 38, 5, },
-{ 9, 20, 27, 5, },
-{ 15, 13, 20, 4, },
-{ 18, 9, 18, 4, },
-{ 19, 6, 17, 3, },
-{ 19, 5, 20, 4, },
-{ 19, 5, 21, 7, },
-{ 18, 5, 15, 5, },
-{ 18, 6, 18, 3, },
-{ 17, 7, 21, 3, },
-{ 18, 17, 22, 7, },
-{ 16, 54, 35, 20, },
-{ 13, 57, 24, 20, },
-{ 16, 32, 8, 12, },
-{ 21, 15, 5, 4, },
-{ 14, 5, 6, 3, },
-{ 16, 6, 11, 3, },
-{ 19, 7, 23, 5, },
-{ 18, 8, 24, 6, },
-{ 18, 8, 17, 3, },
-{ 17, 8, 19, 4, },
-{ 18, 8, 19, 4, },
-{ 18, 8, 19, 6, },
-{ 18, 8, 22, 14, },
-{ 18, 8, 19, 13, },
-{ 18, 8, 14, 6, },
-{ 18, 8, 15, 5, },
-{ 18, 8, 15, 2, },
-{ 18, 8, 15, 4, },
-{ 17, 7, 24, 6, },
-{ 17, 7, 21, 5, },
-{ 17, 7, 14, 4, },
-{ 17, 7, 16, 3, },
-{ 17, 8, 17, 3, },
-{ 17, 9, 48, 22, },
-{ 16, 9, 77, 44, },
-{ 17, 8, 55, 34, },
-{ 17, 8, 29, 16, },
-{ 17, 8, 19, 6, },
-{ 17, 8, 13, 2, },
-{ 17, 7, 12, 2, },
-{ 17, 7, 16, 5, },
-{ 16, 6, 14, 5, },
-{ 16, 10, 11, 3, },
-{ 16, 13, 11, 2, },
-{ 16, 13, 10, 2, },
-{ 15, 11, 27, 8, },
-{ 14, 9, 36, 15, },
-{ 14, 8, 23, 10, },
-{ 13, 7, 25, 4, },
-{ 12, 6, 26, 2, },
-{ 12, 6, 21, 3, },
-{ 11, 4, 23, 3, },
-{ 10, 6, 24, 5, },
-{ 9, 7, 16, 4, },
-{ 7, 4, 21, 3, },
-{ 6, 7, 25, 5, },
-{ 5, 7, 17, 4, },
-{ 3, 4, 19, 12, },
-{ 2, 5, 27, 16, },
-{ 1, 4, 22, 8, },
-{ 0, 4, 20, 6, },
-{ 0, 5, 25, 4, },
-{ 0, 5, 21, 4, },
-{ 0, 4, 26, 7, },
-{ 0, 4, 30, 9, },
-{ 0, 6, 22, 5, },
-{ 0, 6, 19, 2, },
-{ 0, 5, 23, 2, },
-{ 0, 5, 19, 4, },
-{ 0, 6, 23, 12, },
-{ 0, 5, 30, 13, },
-{ 0, 4, 21, 5, },
-{ 0, 6, 16, 2, },
-{ 0, 7, 21, 3, },
-{ 0, 8, 20, 2, },
-{ 0, 7, 32, 7, },
-{ 0, 5, 31, 12, },
-{ 0, 6, 24, 7, },
-{ 0, 5, 29, 6, },
-{ 0, 3, 34, 9, },
-{ 0, 5, 57, 22, },
-{ 0, 6, 92, 45, },
-{ 0, 5, 70, 39, },
-{ 0, 7, 39, 19, },
-{ 0, 6, 27, 10, },
-{ 0, 5, 25, 12, },
-{ 2, 37, 30, 13, },
-{ 10, 66, 32, 15, },
-{ 13, 44, 14, 9, },
-{ 21, 23, 9, 3, },
-{ 19, 10, 12, 7, },
-{ 15, 6, 17, 11, },
-{ 19, 11, 37, 12, },
-{ 18, 13, 48, 21, },
-{ 18, 10, 34, 20, },
-{ 17, 13, 25, 11, },
-{ 16, 15, 22, 14, },
-{ 18, 11, 21, 15, },
-{ 17, 21, 23, 12, },
-{ 14, 25, 21, 15, },
-{ 13, 18, 14, 12, },
-{ 16, 11, 16, 8, },
-{ 15, 9, 21, 15, },
-{ 19, 15, 23, 16, },
-{ 20, 48, 37, 20, },
-{ 16, 59, 31, 20, },
-{ 15, 34, 11, 9, },
-{ 21, 17, 11, 5, },
-{ 15, 7, 15, 11, },
-{ 16, 8, 21, 13, },
-{ 19, 11, 39, 10, },
-{ 18, 11, 44, 16, },
-{ 18, 10, 33, 16, },
-{ 17, 10, 31, 11, },
-{ 17, 10, 29, 16, },
-{ 18, 10, 25, 15, },
-{ 18, 10, 30, 17, },
-{ 18, 10, 29, 22, },
-{ 18, 11, 25, 16, },
-{ 18, 11, 29, 12, },
-{ 18, 10, 31, 16, },
-{ 18, 11, 29, 12, },
-{ 18, 11, 37, 11, },
-{ 17, 10, 32, 17, },
-{ 17, 8, 23, 14, },
-{ 17, 8, 23, 10, },
-{ 17, 9, 26, 14, },
-{ 17, 11, 44, 21, },
-{ 16, 12, 77, 44, },
-{ 16, 10, 66, 42, },
-{ 17, 11, 38, 21, },
-{ 17, 10, 25, 11, },
-{ 17, 10, 23, 14, },
-{ 17, 10, 20, 8, },
-{ 17, 12, 23, 9, },
-{ 17, 12, 27, 13, },
-{ 16, 12, 28, 8, },
-{ 16, 11, 34, 8, },
-{ 16, 9, 32, 10, },
-{ 15, 9, 45, 10, },
-{ 15, 8, 51, 18, },
-{ 14, 8, 36, 15, },
-{ 13, 8, 30, 7, },
-{ 12, 6, 33, 6, },
-{ 12, 6, 29, 7, },
-{ 11, 7, 26, 5, },
-{ 10, 7, 33, 7, },
-{ 9, 7, 27, 8, },
-{ 7, 7, 22, 6, },
-{ 6, 6, 25, 7, },
-{ 5, 5, 23, 6, },
-{ 3, 6, 20, 11, },
-{ 2, 9, 24, 17, },
-{ 1, 11, 21, 10, },
-{ 0, 10, 17, 4, },
-{ 0, 9, 21, 4, },
-{ 0, 8, 20, 3, },
-{ 0, 7, 21, 4, },
-{ 0, 6, 26, 6, },
-{ 0, 5, 17, 4, },
-{ 0, 4, 15, 2, },
-{ 0, 5, 18, 3, },
-{ 0, 16, 20, 7, },
-{ 4, 57, 32, 20, },
-{ 10, 58, 23, 17, },
-{ 19, 30, 7, 5, },
-{ 23, 14, 5, 1, },
-{ 18, 7, 9, 0, },
-{ 19, 10, 12, 1, },
-{ 21, 15, 28, 4, },
-{ 18, 17, 28, 6, },
-{ 18, 14, 21, 5, },
-{ 18, 11, 25, 4, },
-{ 18, 11, 24, 3, },
-{ 18, 9, 45, 18, },
-{ 17, 8, 81, 43, },
-{ 17, 8, 68, 39, },
-{ 18, 7, 40, 19, },
-{ 18, 7, 26, 9, },
-{ 18, 7, 19, 4, },
-{ 19, 31, 26, 12, },
-{ 13, 65, 35, 16, },
-{ 13, 48, 16, 6, },
-{ 17, 26, 5, 1, },
-{ 16, 14, 6, 1, },
-{ 8, 13, 9, 1, },
-{ 5, 19, 23, 6, },
-{ 4, 24, 31, 14, },
-{ 7, 21, 20, 11, },
-{ 13, 15, 13, 4, },
-{ 18, 10, 12, 2, },
-{ 19, 8, 11, 1, },
-{ 19, 6, 14, 2, },
-{ 19, 5, 19, 5, },
-{ 19, 6, 16, 5, },
-{ 18, 7, 16, 2, },
-{ 17, 9, 20, 2, },
-{ 17, 13, 20, 4, },
-{ 16, 46, 33, 18, },
-{ 14, 62, 30, 21, },
-{ 14, 36, 12, 13, },
-{ 21, 18, 7, 6, },
-{ 16, 7, 7, 3, },
-{ 15, 5, 8, 4, },
-{ 19, 9, 19, 5, },
-{ 18, 10, 26, 7, },
-{ 18, 11, 19, 5, },
-{ 18, 11, 21, 4, },
-{ 18, 9, 21, 5, },
-{ 18, 9, 17, 5, },
-{ 18, 9, 22, 13, },
-{ 18, 8, 25, 14, },
-{ 18, 8, 18, 7, },
-{ 18, 8, 17, 5, },
-{ 18, 7, 16, 3, },
-{ 17, 7, 15, 3, },
-{ 17, 7, 25, 6, },
-{ 17, 7, 26, 6, },
-{ 17, 8, 16, 4, },
-{ 17, 8, 14, 3, },
-{ 17, 8, 13, 2, },
-{ 17, 8, 35, 16, },
-{ 16, 9, 75, 43, },
-{ 16, 8, 66, 42, },
-{ 17, 8, 37, 20, },
-{ 17, 7, 23, 8, },
-{ 17, 7, 18, 3, },
-{ 17, 7, 17, 3, },
-{ 17, 8, 21, 5, },
-{ 17, 8, 24, 6, },
-{ 16, 8, 21, 4, },
-{ 16, 8, 22, 4, },
-{ 16, 7, 18, 3, },
-{ 15, 7, 24, 7, },
-{ 15, 8, 38, 16, },
-{ 14, 7, 26, 13, },
-{ 13, 6, 19, 5, },
-{ 13, 6, 17, 3, },
-{ 12, 5, 16, 3, },
-{ 11, 5, 19, 3, },
-{ 10, 5, 24, 5, },
-{ 9, 5, 19, 5, },
-{ 7, 5, 16, 3, },
-{ 6, 4, 20, 5, },
-{ 5, 2, 17, 5, },
-{ 4, 2, 17, 10, },
-{ 2, 3, 24, 15, },
-{ 1, 3, 18, 9, },
-{ 0, 3, 18, 5, },
-{ 0, 3, 20, 4, },
-{ 0, 3, 16, 2, },
-{ 0, 3, 25, 6, },
-{ 0, 3, 32, 9, },
-{ 0, 3, 22, 6, },
-{ 0, 2, 21, 2, },
-{ 0, 2, 21, 2, },
-{ 0, 2, 15, 3, },
-{ 0, 2, 23, 11, },
-{ 0, 2, 33, 15, },
-{ 0, 1, 25, 7, },
-{ 0, 1, 20, 3, },
-{ 0, 2, 21, 2, },
-{ 0, 2, 17, 2, },
-{ 0, 2, 20, 6, },
-{ 0, 1, 23, 10, },
-{ 0, 1, 15, 6, },
-{ 0, 1, 14, 3, },
-{ 0, 1, 16, 2, },
-{ 0, 2, 36, 16, },
-{ 0, 5, 78, 44, },
-{ 0, 3, 72, 43, },
-{ 0, 1, 41, 21, },
-{ 0, 1, 23, 8, },
-{ 0, 1, 12, 3, },
-{ 1, 25, 20, 9, },
-{ 8, 63, 33, 15, },
-{ 13, 51, 17, 9, },
-{ 19, 26, 5, 2, },
-{ 21, 11, 4, 1, },
-{ 14, 5, 6, 1, },
-{ 19, 7, 26, 7, },
-{ 19, 10, 44, 15, },
-{ 18, 8, 33, 12, },
-{ 18, 11, 21, 7, },
-{ 17, 15, 16, 6, },
-{ 18, 11, 11, 3, },
-{ 18, 18, 14, 7, },
-{ 15, 26, 19, 11, },
-{ 13, 19, 11, 8, },
-{ 16, 11, 8, 2, },
-{ 16, 8, 11, 2, },
-{ 18, 9, 13, 4, },
-{ 20, 40, 28, 16, },
-{ 17, 63, 32, 21, },
-{ 14, 40, 12, 10, },
-{ 21, 20, 5, 3, },
-{ 17, 8, 6, 1, },
-{ 15, 5, 7, 1, },
-{ 19, 8, 19, 2, },
-{ 18, 9, 31, 4, },
-{ 18, 9, 24, 4, },
-{ 17, 8, 18, 3, },
-{ 18, 8, 16, 3, },
-{ 18, 9, 13, 3, },
-{ 18, 9, 18, 11, },
-{ 17, 8, 21, 16, },
-{ 18, 8, 16, 9, },
-{ 18, 8, 17, 6, },
-{ 18, 8, 20, 4, },
-{ 18, 8, 18, 4, },
-{ 18, 7, 26, 6, },
-{ 17, 7, 27, 6, },
-{ 17, 7, 18, 5, },
-{ 17, 7, 17, 4, },
-{ 17, 7, 17, 3, },
-{ 17, 8, 30, 13, },
-{ 16, 10, 70, 40, },
-{ 16, 9, 72, 44, },
-{ 17, 7, 46, 23, },
-{ 17, 7, 31, 9, },
-{ 17, 6, 25, 4, },
-{ 17, 7, 18, 4, },
-{ 17, 7, 17, 4, },
-{ 17, 6, 18, 5, },
-{ 16, 6, 14, 5, },
-{ 16, 7, 16, 5, },
-{ 16, 6, 18, 3, },
-{ 15, 6, 31, 6, },
-{ 15, 7, 47, 17, },
-{ 14, 7, 31, 17, },
-{ 13, 6, 18, 8, },
-{ 13, 6, 16, 4, },
-{ 12, 5, 15, 4, },
-{ 11, 4, 13, 3, },
-{ 10, 4, 17, 5, },
-{ 9, 4, 18, 6, },
-{ 8, 3, 13, 5, },
-{ 6, 3, 14, 5, },
-{ 5, 3, 14, 5, },
-{ 4, 3, 19, 9, },
-{ 2, 5, 29, 16, },
-{ 1, 7, 23, 12, },
-{ 0, 6, 24, 5, },
-{ 0, 4, 28, 4, },
-{ 0, 3, 23, 5, },
-{ 0, 2, 28, 5, },
-{ 0, 2, 36, 7, },
-{ 0, 2, 28, 5, },
-{ 0, 3, 23, 4, },
-{ 0, 3, 25, 5, },
-{ 0, 10, 22, 6, },
-{ 3, 50, 33, 18, },
-{ 8, 63, 29, 20, },
-{ 18, 36, 10, 7, },
-{ 23, 17, 7, 2, },
-{ 19, 6, 8, 2, },
-{ 19, 4, 9, 2, },
-{ 21, 5, 21, 3, },
-{ 19, 5, 26, 6, },
-{ 18, 5, 18, 6, },
-{ 18, 4, 14, 4, },
-{ 18, 4, 14, 3, },
-{ 18, 5, 27, 12, },
-{ 17, 7, 72, 39, },
-{ 17, 7, 73, 44, },
-{ 18, 7, 42, 24, },
-{ 18, 6, 24, 11, },
-{ 18, 6, 19, 5, },
-{ 18, 22, 25, 10, },
-{ 15, 61, 37, 16, },
-{ 12, 55, 23, 9, },
-{ 17, 30, 10, 3, },
-{ 17, 17, 9, 2, },
-{ 10, 12, 13, 2, },
-{ 6, 18, 23, 5, },
-{ 4, 23, 38, 14, },
-{ 6, 22, 34, 14, },
-{ 12, 17, 25, 8, },
-{ 17, 11, 23, 6, },
-{ 19, 8, 23, 4, },
-{ 19, 6, 20, 4, },
-{ 19, 5, 24, 7, },
-{ 19, 5, 22, 8, },
-{ 18, 6, 17, 6, },
-{ 18, 7, 20, 5, },
-{ 17, 8, 20, 4, },
-{ 17, 7, 18, 6, },
-{ 16, 7, 19, 6, },
-{ 15, 6, 15, 5, },
-{ 13, 5, 17, 4, },
-{ 11, 4, 21, 4, },
-{ 9, 3, 16, 4, },
-{ 7, 3, 17, 4, },
-{ 4, 2, 24, 6, },
-{ 2, 1, 19, 5, },
-{ 0, 1, 19, 4, },
-{ 0, 2, 23, 4, },
-{ 0, 2, 20, 4, },
-{ 0, 1, 29, 5, },
-{ 0, 1, 34, 5, },
-{ 0, 2, 28, 4, },
-{ 0, 8, 23, 3, },
-{ 0, 9, 29, 3, },
-{ 0, 7, 24, 3, },
-{ 0, 6, 28, 4, },
-{ 0, 4, 35, 6, },
-{ 0, 3, 27, 4, },
-{ 0, 2, 26, 3, },
-{ 0, 1, 27, 4, },
-{ 0, 1, 22, 3, },
-{ 0, 1, 23, 4, },
-{ 0, 1, 24, 4, },
-{ 0, 1, 20, 3, },
-{ 0, 1, 20, 4, },
-{ 0, 2, 21, 4, },
-{ 0, 1, 17, 4, },
-{ 0, 1, 17, 4, },
-{ 0, 1, 20, 6, },
-{ 0, 1, 16, 4, },
-{ 0, 2, 15, 3, },
-{ 0, 2, 16, 4, },
-{ 0, 2, 13, 4, },
-{ 0, 2, 14, 5, },
-{ 0, 2, 15, 6, },
-{ 0, 1, 14, 5, },
-{ 0, 1, 17, 5, },
-{ 0, 1, 18, 4, },
-{ 0, 1, 17, 4, },
-{ 0, 1, 22, 5, },
-{ 0, 1, 23, 6, },
-{ 0, 1, 26, 4, },
-{ 0, 1, 30, 6, },
-{ 0, 1, 26, 6, },
-{ 0, 1, 23, 4, },
-{ 0, 1, 31, 5, },
-{ 0, 1, 29, 5, },
-{ 0, 2, 26, 4, },
-{ 0, 3, 26, 4, },
-{ 0, 2, 21, 4, },
-{ 0, 2, 21, 4, },
-{ 0, 2, 26, 10, },
-{ 0, 1, 19, 9, },
-{ 0, 0, 13, 4, },
-{ 0, 0, 15, 4, },
-{ 0, 0, 15, 3, },
-{ 0, 0, 18, 3, },
-{ 0, 1, 24, 4, },
-{ 0, 1, 20, 3, },
-{ 0, 1, 14, 2, },
-{ 0, 1, 15, 2, },
-{ 0, 1, 13, 2, },
-{ 0, 1, 13, 4, },
-{ 0, 1, 15, 9, },
-{ 0, 0, 13, 6, },
-{ 0, 0, 13, 3, },
-{ 0, 0, 16, 3, },
-{ 0, 0, 15, 3, },
-{ 0, 0, 19, 4, },
-{ 0, 0, 27, 4, },
-{ 0, 0, 25, 3, },
-{ 0, 0, 22, 3, },
-{ 0, 0, 21, 3, },
-{ 0, 0, 24, 4, },
-{ 0, 0, 28, 7, },
-{ 0, 0, 28, 10, },
-{ 0, 4, 22, 6, },
-{ 0, 10, 19, 4, },
-{ 0, 9, 19, 4, },
-{ 0, 6, 20, 3, },
-{ 0, 4, 27, 4, },
-{ 0, 1, 32, 4, },
-{ 0, 0, 22, 4, },
-{ 0, 1, 15, 4, },
-{ 0, 1, 13, 3, },
-{ 0, 1, 11, 3, },
-{ 0, 1, 13, 9, },
-{ 0, 1, 14, 11, },
-{ 0, 1, 12, 5, },
-{ 0, 0, 12, 4, },
-{ 0, 0, 11, 4, },
-{ 0, 0, 12, 5, },
-{ 0, 1, 16, 7, },
-{ 0, 1, 14, 7, },
-{ 0, 2, 14, 4, },
-{ 0, 2, 20, 3, },
-{ 0, 2, 16, 3, },
-{ 0, 1, 20, 3, },
-{ 0, 1, 34, 5, },
-{ 0, 0, 30, 5, },
-{ 0, 0, 28, 4, },
-{ 0, 0, 29, 4, },
-};
@@ -1,1803 +0,0 @@
-const uint16_t BGM_2[][4] = {
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 4, 6, 1, },
-{ 0, 9, 7, 1, },
-{ 0, 7, 3, 0, },
-{ 0, 7, 1, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 5, 6, 0, },
-{ 1, 6, 9, 1, },
-{ 2, 6, 4, 0, },
-{ 1, 6, 1, 0, },
-{ 1, 6, 0, 0, },
-{ 1, 6, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 2, 5, 0, 1, },
-{ 1, 8, 3, 8, },
-{ 2, 8, 6, 8, },
-{ 2, 3, 4, 2, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 2, 2, 0, },
-{ 0, 6, 4, 0, },
-{ 0, 6, 2, 0, },
-{ 0, 6, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 3, 0, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 1, 0, 0, },
-{ 0, 3, 4, 1, },
-{ 0, 5, 5, 1, },
-{ 0, 5, 3, 0, },
-{ 0, 6, 5, 1, },
-{ 0, 5, 4, 1, },
-{ 0, 3, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 4, 2, 5, },
-{ 1, 8, 6, 9, },
-{ 1, 6, 8, 5, },
-{ 1, 2, 4, 2, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 2, 2, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 0, 0, },
-{ 0, 3, 0, 0, },
-{ 0, 3, 0, 0, },
-{ 0, 3, 0, 0, },
-{ 0, 4, 5, 1, },
-{ 0, 7, 6, 1, },
-{ 0, 7, 2, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 6, 2, 6, },
-{ 1, 7, 5, 9, },
-{ 1, 4, 7, 4, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 1, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 7, 4, 0, },
-{ 1, 8, 7, 1, },
-{ 1, 7, 3, 0, },
-{ 1, 6, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 1, 3, 1, 0, },
-{ 1, 2, 1, 0, },
-{ 1, 3, 4, 0, },
-{ 0, 7, 6, 1, },
-{ 0, 7, 2, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 1, 0, },
-{ 0, 4, 5, 7, },
-{ 0, 7, 7, 10, },
-{ 0, 6, 5, 3, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 3, 2, 0, },
-{ 0, 5, 4, 0, },
-{ 0, 6, 3, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 3, 0, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 4, 4, 0, },
-{ 1, 6, 6, 0, },
-{ 2, 6, 3, 0, },
-{ 1, 6, 1, 0, },
-{ 1, 6, 0, 0, },
-{ 1, 6, 0, 1, },
-{ 1, 6, 0, 0, },
-{ 1, 6, 0, 1, },
-{ 1, 5, 1, 2, },
-{ 1, 5, 1, 2, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 1, 3, },
-{ 1, 5, 1, 3, },
-{ 1, 5, 0, 4, },
-{ 1, 6, 4, 10, },
-{ 1, 7, 7, 9, },
-{ 1, 3, 3, 4, },
-{ 0, 0, 1, 5, },
-{ 0, 0, 0, 3, },
-{ 0, 0, 1, 2, },
-{ 0, 0, 1, 3, },
-{ 0, 1, 2, 3, },
-{ 0, 5, 4, 5, },
-{ 0, 6, 2, 4, },
-{ 0, 6, 2, 3, },
-{ 0, 8, 2, 3, },
-{ 0, 5, 1, 2, },
-{ 0, 5, 1, 2, },
-{ 0, 4, 1, 3, },
-{ 0, 4, 1, 2, },
-{ 0, 5, 1, 2, },
-{ 0, 5, 1, 3, },
-{ 1, 3, 3, 3, },
-{ 0, 5, 5, 3, },
-{ 0, 6, 4, 3, },
-{ 0, 6, 4, 4, },
-{ 0, 5, 3, 3, },
-{ 0, 4, 2, 2, },
-{ 0, 4, 2, 3, },
-{ 0, 4, 1, 4, },
-{ 0, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 5, 2, 6, },
-{ 1, 6, 5, 10, },
-{ 1, 3, 6, 7, },
-{ 0, 1, 2, 3, },
-{ 0, 0, 1, 4, },
-{ 0, 0, 1, 3, },
-{ 0, 0, 0, 2, },
-{ 0, 1, 1, 3, },
-{ 0, 4, 4, 3, },
-{ 0, 6, 4, 2, },
-{ 0, 6, 2, 2, },
-{ 0, 5, 1, 3, },
-{ 0, 2, 1, 3, },
-{ 0, 1, 0, 2, },
-{ 0, 1, 1, 2, },
-{ 0, 3, 2, 3, },
-{ 0, 5, 5, 3, },
-{ 1, 6, 4, 2, },
-{ 0, 6, 2, 2, },
-{ 0, 6, 1, 3, },
-{ 0, 6, 1, 2, },
-{ 0, 6, 1, 2, },
-{ 0, 5, 1, 2, },
-{ 0, 4, 1, 3, },
-{ 0, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 3, 4, 11, },
-{ 0, 1, 5, 11, },
-{ 0, 0, 2, 3, },
-{ 0, 0, 1, 2, },
-{ 0, 0, 0, 2, },
-{ 0, 0, 1, 3, },
-{ 0, 0, 1, 2, },
-{ 0, 2, 2, 2, },
-{ 0, 3, 2, 3, },
-{ 0, 4, 2, 3, },
-{ 0, 4, 3, 2, },
-{ 1, 5, 4, 2, },
-{ 1, 5, 3, 2, },
-{ 0, 5, 2, 2, },
-{ 0, 6, 1, 2, },
-{ 0, 6, 1, 2, },
-{ 0, 4, 1, 1, },
-{ 0, 4, 4, 1, },
-{ 0, 7, 5, 1, },
-{ 0, 6, 2, 1, },
-{ 0, 5, 1, 1, },
-{ 0, 5, 1, 1, },
-{ 0, 5, 2, 1, },
-{ 0, 4, 2, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 2, 7, },
-{ 0, 3, 7, 10, },
-{ 1, 6, 7, 5, },
-{ 2, 5, 3, 1, },
-{ 2, 5, 1, 1, },
-{ 1, 5, 1, 1, },
-{ 2, 5, 1, 1, },
-{ 2, 5, 1, 0, },
-{ 2, 6, 4, 1, },
-{ 2, 7, 4, 1, },
-{ 2, 6, 1, 0, },
-{ 2, 6, 1, 0, },
-{ 2, 6, 0, 0, },
-{ 2, 5, 0, 0, },
-{ 2, 6, 1, 0, },
-{ 1, 8, 7, 3, },
-{ 1, 8, 10, 6, },
-{ 1, 7, 6, 5, },
-{ 1, 7, 5, 5, },
-{ 1, 9, 7, 3, },
-{ 1, 8, 5, 2, },
-{ 1, 6, 2, 2, },
-{ 1, 6, 2, 1, },
-{ 1, 5, 1, 1, },
-{ 1, 5, 1, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 1, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 4, 0, 1, },
-{ 1, 6, 10, 5, },
-{ 1, 7, 20, 8, },
-{ 1, 4, 11, 4, },
-{ 1, 1, 2, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 1, 0, },
-{ 0, 3, 3, 1, },
-{ 0, 6, 4, 1, },
-{ 0, 6, 2, 0, },
-{ 0, 9, 4, 1, },
-{ 0, 9, 4, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 2, 1, 0, },
-{ 0, 3, 3, 0, },
-{ 0, 6, 7, 2, },
-{ 0, 6, 6, 1, },
-{ 0, 5, 5, 1, },
-{ 0, 7, 10, 2, },
-{ 0, 6, 8, 2, },
-{ 0, 4, 5, 0, },
-{ 0, 4, 3, 0, },
-{ 0, 3, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 2, 1, },
-{ 0, 5, 13, 9, },
-{ 1, 8, 17, 11, },
-{ 1, 5, 7, 4, },
-{ 0, 2, 2, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 0, 1, 1, },
-{ 0, 2, 2, 1, },
-{ 0, 4, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 4, 4, 1, },
-{ 0, 10, 8, 2, },
-{ 0, 12, 6, 1, },
-{ 0, 10, 3, 0, },
-{ 0, 11, 5, 1, },
-{ 0, 14, 6, 1, },
-{ 0, 10, 3, 0, },
-{ 0, 8, 2, 0, },
-{ 0, 8, 2, 1, },
-{ 0, 7, 1, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 2, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 2, 3, },
-{ 0, 8, 13, 10, },
-{ 1, 7, 15, 8, },
-{ 1, 3, 4, 1, },
-{ 0, 1, 2, 0, },
-{ 0, 1, 2, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 2, 2, 0, },
-{ 0, 5, 3, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 6, 3, 1, },
-{ 1, 10, 9, 2, },
-{ 1, 12, 8, 1, },
-{ 1, 8, 3, 0, },
-{ 1, 7, 2, 0, },
-{ 1, 5, 1, 0, },
-{ 1, 2, 1, 0, },
-{ 1, 2, 2, 0, },
-{ 0, 6, 8, 1, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 3, 0, },
-{ 0, 7, 3, 0, },
-{ 0, 11, 5, 1, },
-{ 0, 9, 3, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 6, 1, },
-{ 0, 4, 6, 1, },
-{ 0, 1, 3, 0, },
-{ 0, 3, 5, 5, },
-{ 0, 9, 11, 11, },
-{ 0, 12, 11, 6, },
-{ 0, 9, 5, 1, },
-{ 0, 8, 3, 1, },
-{ 0, 9, 4, 1, },
-{ 0, 10, 2, 0, },
-{ 0, 8, 1, 0, },
-{ 0, 7, 4, 1, },
-{ 0, 11, 4, 1, },
-{ 0, 9, 2, 0, },
-{ 0, 9, 2, 0, },
-{ 0, 10, 3, 0, },
-{ 0, 8, 2, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 6, 6, 1, },
-{ 1, 8, 10, 2, },
-{ 2, 8, 6, 3, },
-{ 1, 8, 4, 3, },
-{ 1, 10, 7, 2, },
-{ 1, 8, 5, 1, },
-{ 1, 7, 2, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 5, 1, 1, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 5, 0, 0, },
-{ 1, 6, 6, 5, },
-{ 1, 8, 18, 10, },
-{ 1, 5, 14, 6, },
-{ 1, 1, 4, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 0, 1, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 1, 1, 0, },
-{ 0, 4, 3, 1, },
-{ 0, 6, 3, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 9, 3, 0, },
-{ 0, 11, 5, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 1, 4, 3, 0, },
-{ 1, 6, 7, 1, },
-{ 0, 7, 6, 1, },
-{ 0, 7, 5, 1, },
-{ 0, 7, 8, 2, },
-{ 0, 6, 8, 1, },
-{ 0, 5, 4, 0, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 2, 1, },
-{ 0, 7, 11, 8, },
-{ 1, 6, 18, 9, },
-{ 0, 3, 8, 3, },
-{ 0, 0, 2, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 2, 2, 1, },
-{ 0, 4, 4, 1, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 6, 2, 1, },
-{ 1, 8, 5, 2, },
-{ 1, 10, 7, 1, },
-{ 1, 9, 5, 0, },
-{ 0, 10, 4, 1, },
-{ 0, 12, 6, 1, },
-{ 0, 11, 3, 0, },
-{ 0, 8, 2, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 6, 10, 5, },
-{ 0, 7, 16, 11, },
-{ 0, 3, 8, 7, },
-{ 0, 1, 2, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 0, 1, 0, },
-{ 0, 2, 2, 0, },
-{ 0, 5, 3, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 6, 2, 0, },
-{ 1, 9, 8, 2, },
-{ 1, 12, 9, 1, },
-{ 1, 9, 4, 0, },
-{ 1, 7, 2, 0, },
-{ 1, 6, 2, 1, },
-{ 1, 3, 1, 0, },
-{ 1, 1, 2, 0, },
-{ 0, 5, 7, 1, },
-{ 0, 8, 8, 1, },
-{ 0, 7, 3, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 10, 4, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 9, 2, 0, },
-{ 0, 10, 5, 1, },
-{ 0, 10, 7, 1, },
-{ 0, 9, 3, 0, },
-{ 0, 8, 2, 0, },
-{ 1, 8, 7, 5, },
-{ 0, 11, 13, 10, },
-{ 0, 10, 12, 6, },
-{ 0, 7, 8, 2, },
-{ 0, 10, 7, 2, },
-{ 0, 9, 4, 1, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 2, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 10, 3, 1, },
-{ 0, 11, 4, 1, },
-{ 0, 11, 3, 1, },
-{ 0, 8, 2, 2, },
-{ 0, 9, 6, 3, },
-{ 1, 9, 10, 4, },
-{ 2, 8, 6, 5, },
-{ 2, 7, 4, 4, },
-{ 1, 8, 6, 3, },
-{ 1, 9, 6, 2, },
-{ 1, 7, 3, 1, },
-{ 1, 7, 2, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 6, 0, 1, },
-{ 1, 6, 0, 1, },
-{ 2, 6, 0, 1, },
-{ 2, 6, 0, 1, },
-{ 2, 6, 3, 2, },
-{ 2, 9, 14, 9, },
-{ 2, 7, 15, 10, },
-{ 1, 2, 6, 3, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 3, 3, 1, },
-{ 0, 6, 4, 1, },
-{ 0, 6, 2, 1, },
-{ 0, 7, 3, 0, },
-{ 0, 8, 4, 1, },
-{ 0, 6, 3, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 2, 1, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 2, 2, 0, },
-{ 0, 5, 7, 2, },
-{ 0, 7, 7, 2, },
-{ 0, 6, 5, 1, },
-{ 0, 7, 8, 2, },
-{ 0, 6, 9, 2, },
-{ 0, 4, 6, 1, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 3, 2, 1, },
-{ 0, 3, 1, 0, },
-{ 0, 5, 8, 3, },
-{ 1, 9, 17, 10, },
-{ 1, 5, 12, 8, },
-{ 0, 2, 4, 2, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 0, 1, 1, },
-{ 0, 3, 3, 1, },
-{ 0, 4, 2, 1, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 1, },
-{ 0, 3, 1, 0, },
-{ 0, 3, 1, 1, },
-{ 0, 7, 7, 2, },
-{ 0, 12, 8, 2, },
-{ 0, 10, 4, 0, },
-{ 0, 10, 4, 0, },
-{ 0, 13, 6, 1, },
-{ 0, 12, 4, 0, },
-{ 0, 9, 2, 0, },
-{ 0, 8, 2, 1, },
-{ 0, 7, 2, 1, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 2, 1, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 7, 8, 7, },
-{ 1, 8, 16, 11, },
-{ 1, 4, 12, 5, },
-{ 0, 1, 3, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 1, 1, 0, },
-{ 0, 4, 3, 1, },
-{ 0, 5, 2, 1, },
-{ 0, 5, 1, 0, },
-{ 0, 8, 7, 2, },
-{ 1, 12, 10, 2, },
-{ 1, 10, 5, 0, },
-{ 1, 7, 2, 0, },
-{ 0, 6, 2, 0, },
-{ 1, 3, 1, 0, },
-{ 1, 2, 1, 0, },
-{ 0, 4, 6, 1, },
-{ 0, 8, 8, 1, },
-{ 0, 7, 4, 0, },
-{ 0, 6, 2, 0, },
-{ 0, 9, 4, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 6, 2, 0, },
-{ 0, 5, 4, 1, },
-{ 0, 5, 7, 1, },
-{ 0, 2, 4, 0, },
-{ 0, 2, 3, 0, },
-{ 0, 6, 7, 8, },
-{ 0, 11, 11, 11, },
-{ 0, 10, 7, 4, },
-{ 0, 8, 3, 1, },
-{ 0, 8, 4, 1, },
-{ 0, 10, 3, 1, },
-{ 0, 9, 1, 0, },
-{ 0, 7, 3, 1, },
-{ 0, 10, 5, 1, },
-{ 0, 9, 2, 1, },
-{ 0, 9, 1, 0, },
-{ 0, 9, 2, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 4, 1, },
-{ 0, 7, 10, 4, },
-{ 1, 8, 9, 4, },
-{ 2, 7, 4, 3, },
-{ 1, 9, 6, 2, },
-{ 1, 9, 6, 1, },
-{ 1, 8, 3, 1, },
-{ 1, 7, 2, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 2, 3, },
-{ 1, 8, 15, 10, },
-{ 1, 7, 18, 9, },
-{ 1, 3, 6, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 2, 2, 1, },
-{ 0, 5, 3, 1, },
-{ 0, 5, 1, 1, },
-{ 0, 7, 2, 0, },
-{ 0, 11, 5, 1, },
-{ 0, 9, 3, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 1, 1, },
-{ 0, 6, 0, 0, },
-{ 1, 4, 1, 0, },
-{ 1, 5, 6, 1, },
-{ 0, 8, 7, 1, },
-{ 0, 7, 4, 1, },
-{ 0, 7, 7, 2, },
-{ 0, 6, 9, 2, },
-{ 0, 5, 6, 1, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 6, 6, 4, },
-{ 1, 6, 17, 11, },
-{ 1, 3, 14, 7, },
-{ 1, 1, 4, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 2, 2, 1, },
-{ 0, 4, 2, 1, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 5, 4, 1, },
-{ 0, 10, 7, 2, },
-{ 1, 9, 4, 0, },
-{ 0, 9, 3, 0, },
-{ 0, 12, 5, 1, },
-{ 0, 12, 4, 0, },
-{ 0, 9, 2, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 5, 2, 1, },
-{ 0, 5, 0, 0, },
-{ 0, 5, 0, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 4, 0, 0, },
-{ 0, 5, 6, 2, },
-{ 0, 6, 16, 11, },
-{ 0, 4, 12, 10, },
-{ 0, 1, 3, 2, },
-{ 0, 1, 1, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 3, 2, 1, },
-{ 0, 3, 1, 1, },
-{ 0, 4, 1, 1, },
-{ 1, 6, 5, 3, },
-{ 1, 11, 13, 10, },
-{ 1, 11, 11, 10, },
-{ 0, 9, 6, 6, },
-{ 0, 10, 7, 8, },
-{ 0, 8, 8, 11, },
-{ 0, 4, 4, 7, },
-{ 0, 5, 5, 2, },
-{ 0, 8, 7, 1, },
-{ 0, 7, 4, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 14, 5, 3, },
-{ 0, 18, 7, 4, },
-{ 2, 14, 5, 2, },
-{ 1, 11, 4, 1, },
-{ 1, 10, 7, 1, },
-{ 1, 6, 5, 1, },
-{ 0, 3, 2, 0, },
-{ 0, 5, 9, 11, },
-{ 0, 11, 21, 22, },
-{ 1, 12, 17, 17, },
-{ 2, 8, 7, 9, },
-{ 2, 8, 5, 4, },
-{ 2, 9, 4, 2, },
-{ 2, 9, 2, 1, },
-{ 2, 9, 2, 1, },
-{ 2, 11, 5, 2, },
-{ 2, 10, 4, 2, },
-{ 2, 9, 2, 1, },
-{ 2, 9, 3, 1, },
-{ 2, 11, 4, 1, },
-{ 2, 10, 2, 0, },
-{ 2, 11, 3, 2, },
-{ 1, 14, 12, 8, },
-{ 1, 15, 15, 11, },
-{ 1, 10, 11, 9, },
-{ 1, 9, 9, 8, },
-{ 0, 9, 10, 7, },
-{ 1, 8, 7, 6, },
-{ 1, 7, 4, 5, },
-{ 1, 7, 4, 5, },
-{ 1, 7, 4, 6, },
-{ 1, 6, 3, 5, },
-{ 1, 5, 2, 4, },
-{ 1, 5, 3, 5, },
-{ 1, 5, 5, 5, },
-{ 1, 5, 5, 5, },
-{ 1, 7, 16, 11, },
-{ 1, 8, 24, 17, },
-{ 1, 6, 15, 14, },
-{ 1, 2, 6, 7, },
-{ 0, 1, 3, 4, },
-{ 0, 0, 3, 3, },
-{ 0, 0, 2, 3, },
-{ 0, 0, 2, 3, },
-{ 0, 4, 4, 4, },
-{ 0, 7, 4, 3, },
-{ 0, 7, 3, 2, },
-{ 0, 11, 5, 3, },
-{ 1, 13, 5, 3, },
-{ 1, 10, 3, 2, },
-{ 1, 7, 2, 3, },
-{ 1, 10, 6, 6, },
-{ 1, 10, 8, 7, },
-{ 1, 7, 4, 4, },
-{ 0, 7, 4, 2, },
-{ 1, 8, 8, 4, },
-{ 0, 7, 7, 3, },
-{ 0, 6, 7, 3, },
-{ 0, 9, 11, 4, },
-{ 1, 12, 11, 4, },
-{ 1, 15, 7, 3, },
-{ 1, 13, 4, 2, },
-{ 1, 8, 3, 2, },
-{ 1, 7, 2, 1, },
-{ 0, 5, 5, 3, },
-{ 0, 7, 22, 13, },
-{ 1, 8, 25, 19, },
-{ 1, 6, 12, 13, },
-{ 0, 2, 5, 6, },
-{ 0, 1, 3, 3, },
-{ 0, 0, 3, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 1, 2, 2, },
-{ 0, 3, 3, 2, },
-{ 0, 4, 4, 2, },
-{ 0, 3, 3, 1, },
-{ 0, 4, 2, 1, },
-{ 0, 3, 2, 1, },
-{ 0, 3, 1, 1, },
-{ 0, 7, 6, 4, },
-{ 1, 18, 13, 7, },
-{ 2, 19, 12, 7, },
-{ 1, 14, 7, 4, },
-{ 1, 15, 8, 3, },
-{ 1, 16, 8, 3, },
-{ 0, 11, 5, 2, },
-{ 0, 9, 4, 2, },
-{ 0, 8, 6, 3, },
-{ 0, 8, 5, 3, },
-{ 0, 7, 2, 1, },
-{ 0, 6, 2, 1, },
-{ 0, 6, 5, 1, },
-{ 0, 6, 5, 1, },
-{ 0, 7, 7, 3, },
-{ 0, 12, 23, 15, },
-{ 1, 10, 24, 21, },
-{ 1, 4, 12, 14, },
-{ 0, 1, 5, 5, },
-{ 0, 1, 4, 2, },
-{ 0, 1, 3, 1, },
-{ 0, 1, 1, 1, },
-{ 0, 3, 3, 2, },
-{ 0, 6, 3, 2, },
-{ 0, 5, 2, 1, },
-{ 0, 7, 5, 2, },
-{ 1, 13, 14, 10, },
-{ 1, 14, 13, 12, },
-{ 1, 9, 7, 7, },
-{ 1, 8, 8, 8, },
-{ 1, 6, 11, 13, },
-{ 1, 4, 7, 9, },
-{ 1, 3, 5, 3, },
-{ 0, 7, 9, 2, },
-{ 0, 8, 7, 1, },
-{ 0, 7, 3, 1, },
-{ 0, 13, 5, 2, },
-{ 0, 20, 7, 3, },
-{ 2, 16, 5, 2, },
-{ 1, 13, 3, 1, },
-{ 1, 10, 7, 2, },
-{ 1, 7, 6, 1, },
-{ 0, 3, 3, 0, },
-{ 0, 4, 11, 7, },
-{ 0, 13, 32, 20, },
-{ 1, 14, 38, 21, },
-{ 0, 9, 20, 12, },
-{ 0, 8, 8, 5, },
-{ 0, 9, 6, 2, },
-{ 0, 10, 4, 1, },
-{ 0, 8, 3, 1, },
-{ 0, 8, 5, 2, },
-{ 0, 11, 5, 2, },
-{ 0, 9, 3, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 7, 3, 0, },
-{ 0, 6, 3, 1, },
-{ 0, 11, 11, 5, },
-{ 1, 15, 16, 8, },
-{ 2, 12, 11, 5, },
-{ 1, 9, 9, 2, },
-{ 1, 11, 10, 2, },
-{ 1, 9, 8, 1, },
-{ 1, 7, 5, 1, },
-{ 1, 7, 4, 1, },
-{ 1, 6, 4, 2, },
-{ 1, 6, 4, 2, },
-{ 1, 6, 2, 1, },
-{ 1, 5, 3, 1, },
-{ 1, 5, 5, 1, },
-{ 1, 5, 3, 0, },
-{ 1, 7, 11, 6, },
-{ 1, 10, 24, 16, },
-{ 1, 7, 17, 14, },
-{ 1, 2, 6, 6, },
-{ 0, 1, 3, 2, },
-{ 0, 1, 3, 1, },
-{ 0, 0, 2, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 5, 3, 1, },
-{ 0, 6, 3, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 15, 7, 3, },
-{ 0, 19, 8, 3, },
-{ 2, 12, 3, 1, },
-{ 1, 8, 2, 1, },
-{ 1, 11, 6, 5, },
-{ 1, 12, 8, 7, },
-{ 1, 8, 4, 4, },
-{ 2, 7, 4, 1, },
-{ 1, 8, 8, 2, },
-{ 0, 8, 6, 1, },
-{ 0, 7, 6, 1, },
-{ 0, 8, 9, 3, },
-{ 0, 12, 10, 4, },
-{ 2, 15, 7, 3, },
-{ 2, 14, 4, 2, },
-{ 1, 10, 2, 1, },
-{ 1, 8, 2, 1, },
-{ 0, 6, 3, 1, },
-{ 1, 9, 18, 10, },
-{ 1, 8, 26, 19, },
-{ 1, 4, 15, 16, },
-{ 0, 2, 6, 7, },
-{ 0, 1, 3, 3, },
-{ 0, 1, 2, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 1, 1, 1, },
-{ 0, 3, 3, 2, },
-{ 0, 4, 2, 1, },
-{ 0, 4, 1, 1, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 2, 0, 0, },
-{ 0, 5, 3, 2, },
-{ 0, 16, 9, 6, },
-{ 2, 19, 11, 7, },
-{ 3, 15, 6, 3, },
-{ 2, 14, 5, 1, },
-{ 1, 15, 6, 1, },
-{ 1, 12, 4, 1, },
-{ 0, 9, 2, 0, },
-{ 0, 7, 2, 1, },
-{ 0, 6, 2, 2, },
-{ 0, 5, 1, 1, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 3, 2, },
-{ 0, 9, 20, 13, },
-{ 1, 11, 26, 21, },
-{ 0, 5, 15, 16, },
-{ 0, 2, 7, 7, },
-{ 0, 1, 5, 3, },
-{ 0, 1, 3, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 3, 2, 1, },
-{ 0, 6, 3, 2, },
-{ 0, 5, 2, 1, },
-{ 0, 7, 3, 1, },
-{ 1, 12, 13, 8, },
-{ 1, 15, 14, 12, },
-{ 1, 10, 8, 8, },
-{ 1, 8, 6, 7, },
-{ 1, 7, 10, 11, },
-{ 1, 4, 9, 10, },
-{ 1, 2, 5, 4, },
-{ 0, 6, 10, 3, },
-{ 0, 8, 9, 2, },
-{ 0, 7, 4, 1, },
-{ 0, 10, 4, 2, },
-{ 0, 19, 10, 6, },
-{ 1, 23, 10, 8, },
-{ 1, 19, 6, 7, },
-{ 1, 14, 7, 5, },
-{ 1, 10, 7, 4, },
-{ 0, 5, 4, 3, },
-{ 0, 4, 5, 4, },
-{ 0, 10, 17, 14, },
-{ 1, 13, 22, 19, },
-{ 2, 9, 13, 12, },
-{ 2, 8, 6, 5, },
-{ 2, 8, 5, 2, },
-{ 2, 8, 3, 1, },
-{ 2, 7, 2, 1, },
-{ 1, 8, 5, 2, },
-{ 1, 9, 6, 2, },
-{ 2, 9, 3, 1, },
-{ 1, 9, 3, 1, },
-{ 1, 10, 5, 1, },
-{ 1, 9, 3, 1, },
-{ 1, 6, 2, 0, },
-{ 1, 9, 9, 4, },
-{ 2, 15, 15, 9, },
-{ 3, 16, 13, 8, },
-{ 3, 15, 8, 5, },
-{ 3, 15, 9, 3, },
-{ 2, 12, 8, 3, },
-{ 2, 8, 6, 2, },
-{ 2, 7, 4, 2, },
-{ 2, 6, 4, 2, },
-{ 1, 6, 4, 1, },
-{ 1, 6, 3, 1, },
-{ 1, 6, 2, 1, },
-{ 2, 6, 4, 1, },
-{ 2, 6, 5, 1, },
-{ 2, 7, 10, 5, },
-{ 2, 9, 23, 14, },
-{ 2, 7, 19, 15, },
-{ 1, 3, 8, 8, },
-{ 0, 1, 3, 3, },
-{ 0, 0, 2, 1, },
-{ 0, 0, 2, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 4, 4, 1, },
-{ 0, 6, 4, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 13, 5, 1, },
-{ 1, 11, 3, 1, },
-{ 1, 8, 2, 0, },
-{ 1, 8, 4, 4, },
-{ 1, 11, 8, 7, },
-{ 1, 8, 6, 5, },
-{ 1, 7, 4, 2, },
-{ 1, 9, 8, 2, },
-{ 0, 9, 7, 2, },
-{ 0, 7, 6, 1, },
-{ 0, 8, 10, 3, },
-{ 0, 13, 11, 4, },
-{ 1, 15, 8, 3, },
-{ 2, 13, 5, 2, },
-{ 1, 9, 3, 1, },
-{ 1, 7, 2, 1, },
-{ 0, 6, 2, 0, },
-{ 0, 7, 16, 8, },
-{ 1, 10, 27, 18, },
-{ 1, 6, 18, 17, },
-{ 0, 3, 7, 8, },
-{ 0, 1, 4, 4, },
-{ 0, 1, 3, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 1, 1, 1, },
-{ 0, 3, 3, 2, },
-{ 0, 4, 3, 2, },
-{ 0, 3, 2, 1, },
-{ 0, 3, 2, 0, },
-{ 0, 3, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 4, 3, 2, },
-{ 0, 13, 11, 6, },
-{ 1, 20, 13, 7, },
-{ 2, 16, 9, 4, },
-{ 1, 13, 8, 2, },
-{ 1, 16, 9, 2, },
-{ 1, 13, 7, 1, },
-{ 0, 9, 5, 1, },
-{ 0, 8, 5, 2, },
-{ 0, 8, 5, 3, },
-{ 0, 7, 5, 1, },
-{ 0, 6, 4, 1, },
-{ 0, 6, 2, 1, },
-{ 0, 6, 3, 1, },
-{ 0, 6, 4, 1, },
-{ 0, 10, 17, 10, },
-{ 1, 12, 26, 21, },
-{ 1, 7, 17, 18, },
-{ 0, 2, 7, 8, },
-{ 0, 1, 4, 3, },
-{ 0, 1, 3, 2, },
-{ 0, 1, 2, 1, },
-{ 0, 2, 2, 1, },
-{ 0, 5, 3, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 6, 2, 1, },
-{ 1, 11, 11, 6, },
-{ 1, 15, 15, 12, },
-{ 1, 11, 9, 9, },
-{ 1, 8, 6, 6, },
-{ 0, 7, 10, 12, },
-{ 1, 4, 9, 11, },
-{ 1, 2, 5, 6, },
-{ 0, 5, 8, 2, },
-{ 0, 8, 9, 2, },
-{ 0, 7, 4, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 19, 7, 4, },
-{ 1, 18, 6, 3, },
-{ 2, 14, 4, 2, },
-{ 1, 10, 5, 2, },
-{ 1, 9, 7, 1, },
-{ 0, 4, 4, 0, },
-{ 0, 3, 6, 3, },
-{ 0, 10, 23, 15, },
-{ 1, 14, 39, 22, },
-{ 0, 10, 29, 17, },
-{ 0, 8, 11, 7, },
-{ 0, 9, 7, 3, },
-{ 0, 10, 5, 2, },
-{ 0, 9, 3, 1, },
-{ 0, 7, 5, 2, },
-{ 0, 11, 5, 2, },
-{ 0, 9, 3, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 9, 4, 1, },
-{ 0, 6, 2, 0, },
-{ 0, 8, 7, 3, },
-{ 1, 15, 16, 7, },
-{ 1, 14, 14, 7, },
-{ 1, 10, 8, 3, },
-{ 1, 11, 9, 2, },
-{ 1, 9, 9, 2, },
-{ 1, 8, 6, 2, },
-{ 1, 7, 5, 1, },
-{ 1, 6, 4, 2, },
-{ 1, 6, 5, 2, },
-{ 1, 6, 4, 1, },
-{ 1, 5, 3, 1, },
-{ 1, 5, 5, 1, },
-{ 1, 5, 4, 1, },
-{ 1, 6, 5, 3, },
-{ 1, 10, 21, 13, },
-{ 1, 8, 21, 16, },
-{ 1, 4, 9, 9, },
-{ 0, 1, 4, 3, },
-{ 0, 1, 3, 2, },
-{ 0, 0, 2, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 3, 3, 1, },
-{ 0, 6, 4, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 9, 5, 2, },
-{ 0, 17, 9, 4, },
-{ 1, 13, 5, 2, },
-{ 2, 8, 2, 0, },
-{ 1, 7, 4, 3, },
-{ 1, 11, 8, 6, },
-{ 1, 9, 6, 5, },
-{ 1, 6, 3, 2, },
-{ 1, 9, 8, 2, },
-{ 1, 9, 8, 2, },
-{ 0, 7, 5, 1, },
-{ 0, 7, 9, 3, },
-{ 0, 12, 11, 4, },
-{ 1, 16, 9, 4, },
-{ 2, 14, 6, 2, },
-{ 1, 10, 3, 1, },
-{ 1, 8, 2, 1, },
-{ 1, 6, 1, 0, },
-{ 0, 6, 11, 6, },
-{ 1, 9, 26, 17, },
-{ 1, 7, 20, 19, },
-{ 0, 3, 9, 10, },
-{ 0, 1, 4, 4, },
-{ 0, 1, 3, 2, },
-{ 0, 0, 2, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 4, 4, 2, },
-{ 0, 6, 4, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 6, 2, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 2, 1, 0, },
-{ 0, 1, 1, 1, },
-{ 0, 11, 9, 5, },
-{ 1, 20, 12, 7, },
-{ 2, 17, 8, 5, },
-{ 1, 13, 4, 1, },
-{ 1, 16, 6, 1, },
-{ 1, 14, 5, 1, },
-{ 0, 10, 2, 0, },
-{ 0, 8, 2, 1, },
-{ 0, 8, 2, 2, },
-{ 0, 7, 1, 1, },
-{ 0, 6, 1, 0, },
-{ 0, 7, 2, 0, },
-{ 0, 6, 1, 0, },
-{ 0, 6, 0, 0, },
-{ 0, 9, 13, 8, },
-{ 1, 12, 26, 19, },
-{ 1, 8, 20, 19, },
-{ 0, 2, 9, 10, },
-{ 0, 1, 6, 4, },
-{ 0, 1, 4, 2, },
-{ 0, 0, 2, 1, },
-{ 0, 1, 1, 1, },
-{ 0, 4, 3, 2, },
-{ 0, 4, 2, 2, },
-{ 0, 4, 1, 1, },
-{ 1, 7, 7, 4, },
-{ 1, 12, 14, 11, },
-{ 1, 10, 10, 9, },
-{ 0, 9, 5, 6, },
-{ 0, 10, 8, 10, },
-{ 0, 8, 10, 11, },
-{ 0, 3, 6, 7, },
-{ 0, 5, 7, 3, },
-{ 0, 8, 9, 2, },
-{ 0, 7, 5, 1, },
-{ 0, 6, 3, 1, },
-{ 0, 15, 8, 4, },
-{ 1, 22, 11, 8, },
-{ 2, 20, 8, 8, },
-{ 1, 15, 6, 6, },
-{ 1, 11, 8, 4, },
-{ 0, 7, 5, 3, },
-{ 0, 3, 4, 3, },
-{ 0, 7, 18, 12, },
-{ 0, 13, 39, 23, },
-{ 1, 11, 34, 19, },
-{ 2, 8, 14, 9, },
-{ 2, 8, 7, 4, },
-{ 2, 9, 5, 2, },
-{ 2, 9, 4, 1, },
-{ 2, 9, 4, 1, },
-{ 2, 11, 6, 2, },
-{ 2, 10, 5, 2, },
-{ 2, 9, 3, 1, },
-{ 2, 10, 4, 1, },
-{ 2, 11, 4, 1, },
-{ 2, 10, 2, 0, },
-{ 2, 11, 5, 2, },
-{ 1, 15, 14, 7, },
-{ 1, 16, 16, 9, },
-{ 1, 10, 12, 6, },
-{ 0, 8, 9, 4, },
-{ 0, 9, 9, 3, },
-{ 1, 8, 6, 3, },
-{ 1, 7, 5, 3, },
-{ 1, 7, 4, 3, },
-{ 1, 7, 5, 3, },
-{ 1, 5, 4, 3, },
-{ 1, 5, 4, 2, },
-{ 1, 5, 8, 2, },
-{ 1, 5, 7, 1, },
-{ 1, 5, 6, 2, },
-{ 1, 8, 20, 11, },
-{ 1, 9, 24, 16, },
-{ 1, 5, 13, 11, },
-{ 0, 2, 6, 4, },
-{ 0, 1, 3, 2, },
-{ 0, 0, 3, 1, },
-{ 0, 0, 2, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 5, 4, 2, },
-{ 0, 7, 4, 2, },
-{ 0, 7, 3, 1, },
-{ 0, 11, 7, 2, },
-{ 1, 13, 7, 1, },
-{ 1, 10, 4, 1, },
-{ 1, 7, 4, 2, },
-{ 1, 13, 8, 6, },
-{ 1, 11, 8, 7, },
-{ 1, 8, 4, 3, },
-{ 0, 8, 6, 2, },
-{ 0, 8, 10, 3, },
-{ 0, 7, 7, 2, },
-{ 0, 7, 8, 2, },
-{ 0, 10, 12, 4, },
-{ 1, 12, 10, 4, },
-{ 1, 15, 6, 2, },
-{ 1, 12, 4, 1, },
-{ 1, 8, 4, 1, },
-{ 1, 7, 3, 0, },
-{ 0, 6, 9, 4, },
-{ 0, 10, 26, 15, },
-{ 1, 10, 24, 18, },
-{ 1, 7, 11, 12, },
-{ 0, 2, 5, 5, },
-{ 0, 1, 4, 2, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 2, 5, 2, },
-{ 0, 4, 8, 2, },
-{ 0, 4, 5, 1, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 4, 1, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 3, 0, },
-{ 0, 10, 9, 5, },
-{ 1, 20, 15, 8, },
-{ 2, 19, 12, 6, },
-{ 1, 14, 7, 3, },
-{ 1, 16, 8, 3, },
-{ 1, 15, 7, 2, },
-{ 0, 10, 5, 2, },
-{ 0, 9, 4, 2, },
-{ 0, 8, 5, 3, },
-{ 0, 7, 5, 4, },
-{ 0, 6, 4, 2, },
-{ 0, 7, 8, 1, },
-{ 0, 7, 12, 2, },
-{ 0, 6, 9, 1, },
-{ 0, 8, 11, 5, },
-{ 1, 14, 26, 18, },
-{ 1, 11, 23, 20, },
-{ 0, 4, 12, 12, },
-{ 0, 2, 6, 4, },
-{ 0, 2, 4, 2, },
-{ 0, 1, 3, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 4, 4, 2, },
-{ 0, 6, 4, 2, },
-{ 0, 5, 2, 1, },
-{ 0, 8, 7, 3, },
-{ 1, 14, 15, 10, },
-{ 1, 13, 12, 11, },
-{ 1, 8, 6, 6, },
-{ 1, 8, 10, 10, },
-{ 0, 9, 14, 13, },
-{ 0, 5, 8, 8, },
-{ 0, 6, 5, 3, },
-{ 0, 5, 6, 2, },
-{ 0, 5, 5, 1, },
-{ 0, 5, 3, 1, },
-{ 0, 13, 8, 3, },
-{ 1, 21, 13, 5, },
-{ 2, 16, 8, 3, },
-{ 1, 13, 5, 1, },
-{ 1, 13, 8, 2, },
-{ 1, 10, 6, 1, },
-{ 0, 7, 3, 1, },
-{ 0, 8, 15, 10, },
-{ 0, 13, 38, 22, },
-{ 0, 13, 38, 20, },
-{ 0, 9, 17, 10, },
-{ 0, 8, 8, 4, },
-{ 0, 10, 6, 2, },
-{ 0, 9, 4, 1, },
-{ 0, 7, 4, 1, },
-{ 0, 9, 6, 2, },
-{ 0, 10, 4, 2, },
-{ 0, 9, 3, 1, },
-{ 0, 9, 3, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 7, 3, 0, },
-{ 0, 6, 4, 2, },
-{ 0, 13, 13, 6, },
-{ 1, 15, 15, 7, },
-{ 2, 11, 9, 4, },
-{ 1, 10, 8, 1, },
-{ 1, 10, 10, 2, },
-{ 1, 8, 7, 1, },
-{ 1, 7, 5, 1, },
-{ 1, 7, 4, 2, },
-{ 1, 6, 5, 2, },
-{ 1, 6, 4, 1, },
-{ 1, 5, 2, 1, },
-{ 1, 6, 3, 1, },
-{ 1, 5, 5, 1, },
-{ 1, 5, 4, 1, },
-{ 1, 8, 15, 9, },
-{ 1, 10, 24, 17, },
-{ 2, 6, 14, 13, },
-{ 1, 2, 5, 5, },
-{ 0, 1, 3, 2, },
-{ 0, 0, 3, 1, },
-{ 0, 0, 2, 0, },
-{ 0, 2, 2, 1, },
-{ 0, 5, 4, 1, },
-{ 0, 6, 2, 1, },
-{ 0, 7, 3, 1, },
-{ 0, 16, 7, 3, },
-{ 1, 18, 7, 3, },
-{ 2, 11, 3, 1, },
-{ 1, 8, 2, 1, },
-{ 1, 12, 6, 5, },
-{ 1, 11, 7, 6, },
-{ 1, 7, 4, 3, },
-{ 2, 7, 5, 1, },
-{ 1, 9, 8, 2, },
-{ 0, 8, 6, 1, },
-{ 0, 7, 6, 2, },
-{ 0, 9, 10, 3, },
-{ 0, 12, 9, 4, },
-{ 2, 15, 7, 3, },
-{ 2, 14, 4, 1, },
-{ 1, 9, 2, 1, },
-{ 1, 7, 1, 0, },
-{ 0, 6, 5, 2, },
-{ 1, 9, 22, 13, },
-{ 1, 7, 25, 20, },
-{ 1, 4, 13, 14, },
-{ 0, 2, 5, 6, },
-{ 0, 1, 3, 3, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 3, 3, 1, },
-{ 0, 5, 4, 2, },
-{ 0, 4, 2, 1, },
-{ 0, 4, 1, 0, },
-{ 0, 4, 2, 0, },
-{ 0, 4, 1, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 9, 5, 3, },
-{ 1, 17, 10, 7, },
-{ 3, 18, 11, 6, },
-{ 2, 14, 5, 2, },
-{ 2, 14, 5, 1, },
-{ 1, 14, 6, 1, },
-{ 1, 11, 3, 0, },
-{ 0, 8, 2, 0, },
-{ 0, 6, 2, 1, },
-{ 0, 6, 1, 1, },
-{ 0, 5, 1, 1, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 6, 3, },
-{ 0, 10, 23, 16, },
-{ 1, 10, 25, 21, },
-{ 0, 4, 12, 14, },
-{ 0, 2, 6, 5, },
-{ 0, 1, 5, 2, },
-{ 0, 1, 3, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 3, 3, 2, },
-{ 0, 6, 3, 2, },
-{ 0, 5, 2, 1, },
-{ 0, 7, 5, 2, },
-{ 1, 13, 14, 9, },
-{ 1, 14, 13, 11, },
-{ 1, 9, 7, 7, },
-{ 1, 8, 7, 7, },
-{ 1, 6, 10, 11, },
-{ 1, 4, 8, 9, },
-{ 1, 3, 5, 4, },
-{ 0, 7, 10, 3, },
-{ 0, 8, 7, 2, },
-{ 0, 7, 3, 0, },
-{ 0, 11, 6, 3, },
-{ 0, 20, 12, 7, },
-{ 1, 22, 10, 8, },
-{ 1, 18, 6, 6, },
-{ 1, 13, 7, 5, },
-{ 1, 9, 6, 4, },
-{ 0, 5, 3, 2, },
-{ 0, 4, 11, 7, },
-{ 0, 11, 34, 20, },
-{ 1, 12, 41, 23, },
-{ 2, 9, 21, 13, },
-{ 2, 8, 8, 5, },
-{ 2, 9, 6, 2, },
-{ 2, 7, 4, 1, },
-{ 1, 6, 3, 1, },
-{ 1, 8, 6, 2, },
-{ 1, 9, 7, 2, },
-{ 2, 9, 4, 1, },
-{ 2, 9, 4, 1, },
-{ 2, 10, 5, 1, },
-{ 2, 8, 3, 1, },
-{ 1, 6, 3, 1, },
-{ 1, 11, 12, 5, },
-{ 3, 18, 17, 9, },
-{ 5, 19, 12, 8, },
-{ 4, 16, 8, 5, },
-{ 3, 15, 10, 4, },
-{ 2, 11, 8, 4, },
-{ 2, 8, 5, 3, },
-{ 2, 7, 5, 3, },
-{ 1, 6, 5, 4, },
-{ 1, 7, 5, 3, },
-{ 1, 6, 3, 1, },
-{ 1, 6, 6, 2, },
-{ 2, 7, 7, 2, },
-{ 2, 6, 5, 1, },
-{ 2, 8, 14, 7, },
-{ 2, 11, 25, 15, },
-{ 2, 8, 17, 14, },
-{ 1, 3, 8, 6, },
-{ 0, 1, 4, 2, },
-{ 0, 1, 4, 1, },
-{ 0, 0, 2, 1, },
-{ 0, 1, 2, 0, },
-{ 0, 5, 5, 2, },
-{ 0, 6, 4, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 10, 5, 1, },
-{ 0, 13, 8, 2, },
-{ 1, 10, 5, 1, },
-{ 1, 7, 4, 1, },
-{ 1, 10, 8, 5, },
-{ 1, 13, 8, 6, },
-{ 1, 9, 4, 3, },
-{ 1, 8, 6, 2, },
-{ 1, 10, 10, 3, },
-{ 0, 8, 7, 2, },
-{ 0, 7, 7, 1, },
-{ 0, 8, 10, 3, },
-{ 0, 14, 11, 4, },
-{ 2, 15, 8, 3, },
-{ 2, 12, 4, 2, },
-{ 1, 9, 4, 1, },
-{ 1, 7, 3, 1, },
-{ 0, 6, 3, 1, },
-{ 0, 9, 20, 10, },
-{ 1, 12, 29, 18, },
-{ 1, 7, 17, 15, },
-{ 0, 3, 8, 7, },
-{ 0, 2, 4, 3, },
-{ 0, 1, 3, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 2, 4, 1, },
-{ 0, 4, 8, 2, },
-{ 0, 4, 6, 2, },
-{ 0, 3, 3, 1, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 3, 0, },
-{ 0, 3, 2, 0, },
-{ 0, 6, 5, 2, },
-{ 0, 17, 13, 6, },
-{ 1, 20, 14, 7, },
-{ 2, 16, 9, 5, },
-{ 1, 14, 8, 3, },
-{ 1, 16, 8, 3, },
-{ 1, 12, 6, 2, },
-{ 0, 9, 4, 2, },
-{ 0, 8, 5, 3, },
-{ 0, 8, 5, 4, },
-{ 0, 7, 4, 2, },
-{ 0, 7, 6, 1, },
-{ 0, 7, 11, 2, },
-{ 0, 6, 10, 2, },
-{ 0, 7, 8, 2, },
-{ 0, 12, 21, 13, },
-{ 1, 13, 27, 21, },
-{ 1, 6, 15, 16, },
-{ 0, 2, 8, 7, },
-{ 0, 2, 5, 3, },
-{ 0, 1, 3, 1, },
-{ 0, 1, 2, 1, },
-{ 0, 2, 3, 2, },
-{ 0, 6, 4, 3, },
-{ 0, 5, 2, 2, },
-{ 0, 6, 3, 1, },
-{ 1, 12, 13, 8, },
-{ 1, 14, 14, 12, },
-{ 1, 10, 7, 8, },
-{ 1, 8, 6, 7, },
-{ 1, 7, 9, 11, },
-{ 1, 4, 8, 10, },
-{ 1, 2, 4, 4, },
-{ 0, 6, 8, 2, },
-{ 0, 8, 7, 1, },
-{ 0, 7, 3, 1, },
-{ 0, 11, 5, 2, },
-{ 0, 20, 9, 4, },
-{ 1, 17, 7, 3, },
-{ 2, 14, 4, 2, },
-{ 1, 10, 6, 2, },
-{ 1, 8, 6, 1, },
-{ 0, 4, 3, 0, },
-{ 0, 3, 8, 4, },
-{ 0, 11, 28, 16, },
-{ 1, 14, 41, 21, },
-{ 0, 10, 24, 14, },
-{ 0, 8, 9, 6, },
-{ 0, 9, 6, 3, },
-{ 0, 10, 5, 1, },
-{ 0, 8, 3, 1, },
-{ 0, 7, 5, 2, },
-{ 0, 11, 6, 2, },
-{ 0, 9, 5, 1, },
-{ 0, 9, 4, 1, },
-{ 0, 10, 4, 1, },
-{ 0, 8, 3, 1, },
-{ 0, 6, 2, 1, },
-{ 0, 10, 8, 4, },
-{ 1, 16, 15, 7, },
-{ 2, 13, 11, 5, },
-{ 1, 10, 8, 3, },
-{ 1, 11, 9, 3, },
-{ 1, 9, 7, 3, },
-{ 1, 8, 5, 2, },
-{ 1, 7, 4, 2, },
-{ 1, 7, 4, 3, },
-{ 1, 6, 4, 3, },
-{ 1, 5, 4, 3, },
-{ 1, 5, 4, 2, },
-{ 1, 5, 3, 1, },
-{ 1, 5, 4, 1, },
-{ 1, 6, 9, 4, },
-{ 1, 10, 23, 14, },
-{ 1, 8, 18, 15, },
-{ 1, 3, 7, 7, },
-{ 0, 1, 3, 3, },
-{ 0, 1, 2, 2, },
-{ 0, 0, 2, 1, },
-{ 0, 1, 1, 0, },
-{ 0, 4, 3, 1, },
-{ 0, 6, 3, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 13, 5, 3, },
-{ 0, 19, 8, 4, },
-{ 1, 14, 4, 1, },
-{ 2, 8, 3, 1, },
-{ 1, 10, 5, 4, },
-{ 1, 12, 7, 7, },
-{ 1, 9, 4, 4, },
-{ 1, 7, 3, 2, },
-{ 2, 8, 8, 2, },
-{ 0, 9, 7, 1, },
-{ 0, 7, 5, 1, },
-{ 0, 8, 9, 3, },
-{ 0, 11, 10, 4, },
-{ 1, 14, 8, 3, },
-{ 2, 15, 5, 2, },
-{ 1, 11, 3, 1, },
-{ 1, 8, 2, 1, },
-{ 0, 6, 1, 0, },
-{ 0, 8, 15, 8, },
-{ 1, 9, 26, 18, },
-{ 1, 5, 17, 16, },
-{ 0, 2, 7, 8, },
-{ 0, 1, 3, 3, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 1, 1, 1, },
-{ 0, 6, 3, 2, },
-{ 0, 6, 2, 1, },
-{ 0, 5, 1, 1, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 3, 1, 0, },
-{ 0, 4, 2, 1, },
-{ 0, 15, 9, 5, },
-{ 1, 19, 9, 5, },
-{ 1, 15, 5, 3, },
-{ 2, 14, 4, 1, },
-{ 1, 16, 6, 1, },
-{ 1, 12, 3, 0, },
-{ 0, 10, 2, 0, },
-{ 0, 7, 2, 1, },
-{ 0, 6, 2, 2, },
-{ 0, 5, 1, 1, },
-{ 0, 5, 1, 0, },
-{ 0, 5, 2, 0, },
-{ 0, 5, 1, 0, },
-{ 0, 4, 2, 1, },
-{ 0, 8, 16, 10, },
-{ 0, 10, 25, 19, },
-{ 0, 6, 17, 17, },
-{ 0, 2, 7, 8, },
-{ 0, 1, 3, 3, },
-{ 0, 1, 2, 1, },
-{ 0, 0, 1, 0, },
-{ 0, 2, 2, 1, },
-{ 0, 4, 3, 2, },
-{ 0, 4, 2, 1, },
-{ 0, 4, 2, 1, },
-{ 1, 9, 10, 6, },
-{ 1, 12, 14, 12, },
-{ 0, 10, 9, 9, },
-{ 0, 9, 6, 6, },
-{ 0, 10, 9, 10, },
-{ 0, 7, 9, 10, },
-{ 0, 3, 5, 5, },
-{ 0, 6, 7, 2, },
-{ 0, 8, 8, 1, },
-{ 0, 7, 4, 0, },
-{ 0, 7, 3, 1, },
-{ 0, 17, 10, 5, },
-{ 1, 22, 12, 8, },
-{ 2, 19, 7, 7, },
-{ 1, 14, 7, 6, },
-{ 1, 10, 10, 5, },
-{ 0, 6, 6, 4, },
-{ 0, 3, 4, 3, },
-{ 0, 8, 15, 12, },
-{ 0, 13, 21, 18, },
-{ 2, 10, 14, 14, },
-{ 2, 7, 6, 6, },
-{ 2, 8, 5, 3, },
-{ 2, 9, 4, 2, },
-{ 2, 9, 2, 0, },
-{ 2, 9, 4, 1, },
-{ 2, 11, 6, 2, },
-{ 2, 10, 3, 1, },
-{ 2, 9, 2, 1, },
-{ 2, 10, 3, 1, },
-{ 2, 11, 3, 1, },
-{ 2, 10, 1, 0, },
-{ 2, 12, 5, 4, },
-{ 2, 17, 9, 9, },
-{ 4, 18, 8, 10, },
-{ 3, 14, 4, 7, },
-{ 2, 12, 2, 6, },
-{ 2, 10, 2, 5, },
-{ 1, 8, 2, 4, },
-{ 0, 6, 3, 5, },
-{ 0, 7, 4, 5, },
-{ 0, 6, 3, 5, },
-{ 0, 5, 2, 4, },
-{ 0, 5, 2, 4, },
-{ 1, 5, 1, 4, },
-{ 0, 4, 1, 4, },
-{ 0, 6, 6, 7, },
-{ 1, 9, 18, 18, },
-{ 1, 7, 18, 21, },
-{ 0, 3, 9, 13, },
-{ 0, 1, 5, 6, },
-{ 0, 1, 3, 3, },
-{ 0, 0, 2, 3, },
-{ 0, 0, 1, 3, },
-{ 0, 0, 1, 3, },
-{ 0, 0, 1, 3, },
-{ 0, 0, 1, 3, },
-{ 0, 2, 1, 2, },
-{ 0, 8, 2, 3, },
-{ 1, 9, 2, 3, },
-{ 2, 7, 2, 2, },
-{ 1, 6, 4, 4, },
-{ 1, 12, 6, 7, },
-{ 1, 9, 5, 6, },
-{ 1, 6, 2, 3, },
-{ 1, 4, 1, 2, },
-{ 0, 4, 1, 2, },
-{ 0, 2, 1, 2, },
-{ 0, 2, 1, 2, },
-{ 0, 11, 5, 4, },
-{ 1, 16, 7, 4, },
-{ 2, 14, 4, 3, },
-{ 1, 10, 5, 3, },
-{ 1, 7, 5, 2, },
-{ 1, 4, 2, 1, },
-{ 0, 3, 7, 6, },
-{ 0, 6, 18, 19, },
-{ 0, 6, 18, 21, },
-{ 0, 3, 9, 12, },
-{ 0, 1, 4, 5, },
-{ 0, 1, 1, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 2, },
-{ 0, 0, 1, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 1, },
-{ 0, 0, 0, 1, },
-{ 0, 0, 0, 1, },
-{ 0, 1, 1, 1, },
-{ 0, 9, 4, 5, },
-{ 1, 13, 5, 6, },
-{ 3, 11, 3, 4, },
-{ 2, 8, 1, 2, },
-{ 1, 6, 0, 1, },
-{ 1, 3, 0, 0, },
-{ 0, 1, 0, 0, },
-{ 0, 1, 0, 1, },
-{ 0, 1, 1, 2, },
-{ 0, 1, 1, 2, },
-{ 0, 1, 0, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 4, 13, 9, },
-{ 0, 9, 27, 22, },
-{ 0, 7, 21, 22, },
-{ 0, 3, 10, 11, },
-{ 0, 1, 4, 5, },
-{ 0, 0, 2, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 1, },
-{ 0, 0, 1, 2, },
-{ 0, 0, 1, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 2, 5, 5, },
-{ 0, 5, 12, 14, },
-{ 0, 3, 10, 12, },
-{ 0, 2, 5, 7, },
-{ 0, 4, 8, 11, },
-{ 0, 3, 9, 12, },
-{ 0, 1, 4, 7, },
-{ 0, 1, 2, 2, },
-{ 0, 0, 0, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 3, 3, 1, },
-{ 0, 13, 8, 4, },
-{ 1, 17, 8, 4, },
-{ 3, 16, 4, 2, },
-{ 3, 13, 2, 1, },
-{ 3, 8, 1, 1, },
-{ 2, 5, 0, 0, },
-{ 1, 4, 2, 4, },
-{ 2, 6, 19, 18, },
-{ 2, 9, 38, 27, },
-{ 2, 6, 33, 22, },
-{ 2, 4, 13, 10, },
-{ 1, 4, 7, 4, },
-{ 1, 6, 6, 1, },
-{ 1, 5, 3, 1, },
-{ 1, 5, 2, 1, },
-{ 1, 5, 2, 2, },
-{ 1, 5, 2, 2, },
-{ 1, 5, 2, 1, },
-{ 1, 4, 1, 0, },
-{ 1, 4, 1, 1, },
-{ 1, 5, 1, 3, },
-{ 1, 6, 3, 6, },
-{ 0, 13, 8, 8, },
-{ 1, 14, 8, 8, },
-{ 1, 12, 4, 4, },
-{ 1, 9, 2, 3, },
-{ 0, 8, 1, 2, },
-{ 0, 6, 1, 1, },
-{ 1, 5, 1, 1, },
-{ 1, 6, 3, 2, },
-{ 1, 6, 3, 2, },
-{ 1, 6, 1, 1, },
-{ 1, 6, 1, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 5, 0, 1, },
-{ 1, 6, 2, 2, },
-{ 1, 11, 12, 12, },
-{ 1, 9, 16, 19, },
-{ 1, 3, 10, 13, },
-{ 0, 1, 5, 5, },
-{ 0, 1, 2, 2, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 0, 0, },
-{ 0, 0, 1, 1, },
-{ 0, 0, 1, 1, },
-{ 0, 3, 3, 2, },
-{ 0, 12, 8, 4, },
-{ 1, 12, 5, 3, },
-{ 2, 7, 1, 1, },
-{ 1, 5, 3, 2, },
-{ 1, 11, 5, 5, },
-{ 1, 10, 5, 5, },
-{ 1, 6, 2, 2, },
-{ 1, 5, 1, 1, },
-{ 1, 4, 1, 0, },
-};
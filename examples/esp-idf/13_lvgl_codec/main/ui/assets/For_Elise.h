@@ -1,1803 +0,0 @@
-const uint16_t For_Elise[][4] = {
-{ 0, 0, 4, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 0, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 15, 0, },
-{ 0, 3, 14, 0, },
-{ 0, 2, 13, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 18, 0, },
-{ 0, 11, 16, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 13, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 6, 5, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 6, 17, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 4, 16, 0, },
-{ 0, 3, 15, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 17, 0, },
-{ 0, 11, 14, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 5, 0, },
-{ 0, 7, 5, 0, },
-{ 0, 6, 5, 0, },
-{ 0, 6, 4, 0, },
-{ 0, 5, 3, 0, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 3, 0, },
-{ 0, 4, 6, 0, },
-{ 0, 5, 12, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 15, 0, },
-{ 0, 3, 14, 0, },
-{ 0, 2, 13, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 18, 0, },
-{ 0, 11, 16, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 13, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 9, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 6, 5, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 6, 17, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 4, 16, 0, },
-{ 0, 3, 15, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 17, 0, },
-{ 0, 11, 14, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 6, 0, },
-{ 0, 3, 6, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 10, 19, 0, },
-{ 0, 9, 15, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 8, 14, 0, },
-{ 0, 10, 12, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 7, 17, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 5, 17, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 5, 16, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 13, 15, 0, },
-{ 0, 14, 14, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 8, 15, 0, },
-{ 0, 9, 17, 0, },
-{ 0, 9, 13, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 15, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 6, 17, 0, },
-{ 0, 6, 15, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 8, 14, 0, },
-{ 0, 12, 17, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 4, 15, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 17, 0, },
-{ 0, 8, 15, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 9, 12, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 15, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 3, 15, 0, },
-{ 0, 3, 13, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 13, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 0, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 7, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 15, 0, },
-{ 0, 3, 14, 0, },
-{ 0, 2, 13, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 18, 0, },
-{ 0, 11, 16, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 13, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 6, 5, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 6, 17, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 4, 16, 0, },
-{ 0, 3, 15, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 17, 0, },
-{ 0, 11, 14, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 5, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 6, 0, },
-{ 0, 3, 6, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 10, 19, 0, },
-{ 0, 9, 16, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 8, 14, 0, },
-{ 0, 10, 12, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 7, 17, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 5, 17, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 5, 16, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 13, 15, 0, },
-{ 0, 14, 14, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 8, 15, 0, },
-{ 0, 9, 17, 0, },
-{ 0, 9, 13, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 6, 17, 0, },
-{ 0, 6, 15, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 8, 14, 0, },
-{ 0, 12, 17, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 4, 15, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 17, 0, },
-{ 0, 8, 15, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 9, 12, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 15, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 3, 15, 0, },
-{ 0, 3, 13, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 2, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 13, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 0, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 13, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 15, 0, },
-{ 0, 3, 14, 0, },
-{ 0, 2, 13, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 18, 0, },
-{ 0, 11, 16, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 13, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 9, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 6, 5, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 4, 12, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 2, 8, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 2, 11, 0, },
-{ 0, 2, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 5, 0, },
-{ 0, 0, 4, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 1, 10, 0, },
-{ 0, 1, 12, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 0, 9, 0, },
-{ 0, 0, 8, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 2, 12, 0, },
-{ 0, 1, 8, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 1, 6, 0, },
-{ 0, 0, 6, 0, },
-{ 0, 1, 9, 0, },
-{ 0, 1, 13, 0, },
-{ 0, 1, 11, 0, },
-{ 0, 1, 7, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 0, 5, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 10, 14, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 9, 7, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 8, 11, 0, },
-{ 0, 9, 11, 0, },
-{ 0, 9, 8, 0, },
-{ 0, 8, 7, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 6, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 9, 18, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 7, 10, 0, },
-{ 0, 10, 11, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 6, 17, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 4, 14, 0, },
-{ 0, 4, 16, 0, },
-{ 0, 3, 15, 0, },
-{ 0, 3, 12, 0, },
-{ 0, 2, 10, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 10, 17, 0, },
-{ 0, 11, 14, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 6, 8, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 10, 0, },
-{ 0, 11, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 9, 10, 0, },
-{ 0, 11, 12, 0, },
-{ 0, 10, 10, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 7, 6, 0, },
-{ 0, 10, 12, 0, },
-{ 0, 14, 22, 0, },
-{ 0, 16, 20, 0, },
-{ 0, 12, 16, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 8, 14, 0, },
-{ 0, 12, 25, 0, },
-{ 0, 13, 24, 0, },
-{ 0, 11, 20, 0, },
-{ 0, 9, 17, 0, },
-{ 0, 7, 16, 0, },
-{ 0, 7, 16, 0, },
-{ 0, 13, 27, 0, },
-{ 0, 17, 32, 0, },
-{ 0, 14, 26, 0, },
-{ 0, 12, 23, 0, },
-{ 0, 9, 22, 0, },
-{ 0, 8, 20, 0, },
-{ 0, 9, 23, 0, },
-{ 0, 10, 22, 0, },
-{ 0, 11, 23, 0, },
-{ 0, 11, 22, 0, },
-{ 0, 9, 22, 0, },
-{ 0, 9, 21, 0, },
-{ 0, 9, 17, 0, },
-{ 0, 9, 15, 0, },
-{ 0, 9, 13, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 6, 15, 0, },
-{ 0, 7, 11, 0, },
-{ 0, 6, 7, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 4, 5, 0, },
-{ 0, 4, 6, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 7, 0, },
-{ 0, 4, 5, 0, },
-{ 0, 3, 6, 0, },
-{ 0, 5, 17, 0, },
-{ 0, 8, 20, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 8, 0, },
-{ 0, 4, 6, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 5, 12, 0, },
-{ 0, 6, 16, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 5, 14, 0, },
-{ 0, 7, 20, 0, },
-{ 0, 9, 17, 0, },
-{ 0, 9, 12, 0, },
-{ 0, 9, 9, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 8, 8, 0, },
-{ 0, 9, 13, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 2, 7, 0, },
-{ 0, 4, 16, 0, },
-{ 0, 6, 19, 0, },
-{ 0, 6, 15, 0, },
-{ 0, 5, 12, 0, },
-{ 0, 4, 11, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 6, 16, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 2, 6, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 4, 16, 0, },
-{ 0, 5, 16, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 3, 11, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 3, 9, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 6, 13, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 4, 13, 0, },
-{ 0, 5, 13, 0, },
-{ 0, 5, 9, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 9, 17, 0, },
-{ 0, 10, 12, 0, },
-{ 0, 10, 9, 0, },
-{ 0, 10, 8, 0, },
-{ 0, 8, 6, 0, },
-{ 0, 8, 10, 0, },
-{ 0, 8, 16, 0, },
-{ 0, 9, 13, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 4, 6, 0, },
-{ 0, 3, 5, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 9, 24, 0, },
-{ 0, 12, 24, 0, },
-{ 0, 11, 20, 0, },
-{ 0, 11, 18, 0, },
-{ 0, 9, 15, 0, },
-{ 0, 9, 14, 0, },
-{ 0, 10, 21, 0, },
-{ 0, 10, 20, 0, },
-{ 0, 9, 15, 0, },
-{ 0, 6, 11, 0, },
-{ 0, 4, 10, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 7, 18, 0, },
-{ 0, 11, 25, 0, },
-{ 0, 11, 21, 0, },
-{ 0, 11, 19, 0, },
-{ 0, 10, 17, 0, },
-{ 0, 9, 15, 0, },
-{ 0, 9, 19, 0, },
-{ 0, 9, 25, 0, },
-{ 0, 9, 19, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 3, 8, 0, },
-{ 0, 3, 10, 0, },
-{ 0, 6, 16, 0, },
-{ 0, 7, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 8, 9, 0, },
-{ 0, 7, 7, 0, },
-{ 0, 7, 8, 0, },
-{ 0, 8, 13, 0, },
-{ 0, 8, 12, 0, },
-{ 0, 6, 10, 0, },
-{ 0, 4, 8, 0, },
-{ 0, 4, 7, 0, },
-{ 0, 3, 7, 0, },
-{ 0, 6, 14, 0, },
-{ 0, 7, 17, 0, },
-{ 0, 7, 14, 0, },
-{ 0, 6, 12, 0, },
-{ 0, 5, 10, 0, },
-{ 0, 4, 9, 0, },
-{ 0, 5, 11, 0, },
-{ 0, 7, 12, 0, },
-{ 0, 6, 9, 0, },
-{ 0, 5, 6, 0, },
-{ 0, 5, 4, 0, },
-{ 0, 4, 4, 0, },
-{ 0, 3, 4, 0, },
-};
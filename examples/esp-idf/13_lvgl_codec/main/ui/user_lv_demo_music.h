@@ -47,6 +47,7 @@ uint32_t lv_demo_music_get_track_length(uint32_t track_id);
 
 void list_files(const char *base_path);
 void speaker_callback(audio_player_cb_ctx_t *ctx);
+void speaker_track_callback(const char *file_path, void *user_data);
 
 /**********************
  *      MACROS
@@ -9,14 +9,12 @@
 #include "user_lv_demo_music_main.h"
 
 #include "user_lv_demo_music_list.h"
-// #include "spectrum_1.h"
-// #include "spectrum_2.h"
-// #include "spectrum_3.h"
-#include "For_Elise.h"
-#include "BGM_1.h"
-#include "BGM_2.h"
+
+#include <string.h>          // strcmp for the gapless track change
 
 #include "codec_dev.h"       // Header for audio codec device interface
+#include "lvgl_port.h"       // Image cache pinning
+#include "spectrum.h"        // Live spectrum of the playing track
 
 /*********************
  *      DEFINES
@@ -40,6 +38,7 @@
 #define DEG_STEP            (180/BAR_CNT)
 #define BAND_CNT            4
 #define BAR_PER_BAND_CNT    (BAR_CNT / BAND_CNT)
+#define ALBUM_COVER_SD_PATH "S:/music/cover_%"LV_PRIu32".bin"  /*Optional covers on the SD card, used instead of the built-in ones*/
 
 /**********************
  *      TYPEDEFS
@@ -56,19 +55,22 @@ static lv_obj_t * create_spectrum_obj(lv_obj_t * parent);
 static lv_obj_t * create_ctrl_box(lv_obj_t * parent);
 static lv_obj_t * create_handle(lv_obj_t * parent);
 
-static void spectrum_anim_cb(void * a, int32_t v);
+static void spectrum_timer_cb(lv_timer_t * t);
 static void start_anim_cb(void * var, int32_t v);
 static void del_counter_timer_cb(lv_event_t * e);
 static void spectrum_draw_event_cb(lv_event_t * e);
 static lv_obj_t * album_image_create(lv_obj_t * parent);
+static const void * album_cover_src(uint32_t id);
+static void album_cover_pin_one(uint32_t id);
+static void album_cover_pin(uint32_t id);
 static void album_gesture_event_cb(lv_event_t * e);
 static void play_event_click_cb(lv_event_t * e);
 static void prev_click_event_cb(lv_event_t * e);
 static void next_click_event_cb(lv_event_t * e);
 static void timer_cb(lv_timer_t * t);
 static void track_load(uint32_t id);
+static void play_track(uint32_t id);
 static void stop_start_anim(lv_timer_t * t);
-static void spectrum_end_cb(lv_anim_t * a);
 static void album_fade_anim_cb(void * var, int32_t v);
 static int32_t get_cos(int32_t deg, int32_t a);
 static int32_t get_sin(int32_t deg, int32_t a);
@@ -98,8 +100,9 @@ static bool playing = false;
 static bool start_anim;
 static int32_t start_anim_values[40];
 static lv_obj_t * play_obj;
-static const uint16_t (* spectrum)[4];
-static uint32_t spectrum_len;
+static lv_timer_t  * spectrum_timer;
+static volatile int32_t gapless_track_id = -1;  /*Track the player moved on to by itself, shown by timer_cb*/
+static uint16_t spectrum[BAND_CNT];     /*Band levels of the playing track, from the spectrum analyzer*/
 static const uint16_t rnd_array[30] = {994, 285, 553, 11, 792, 707, 966, 641, 852, 827, 44, 352, 146, 581, 490, 80, 729, 58, 695, 940, 724, 561, 124, 653, 27, 292, 557, 506, 382, 199};
 
 void ui_event_Slider1(lv_event_t * e);
@@ -121,6 +124,22 @@ void speaker_callback(audio_player_cb_ctx_t *ctx)
     if (play_state == 0) lv_demo_music_album_next(true);
 }
 
+/**
+ * @brief Audio player callback for a gapless change to the queued track.
+ *
+ * Runs in the player task, so only the track is noted here and timer_cb updates the UI.
+ */
+void speaker_track_callback(const char *file_path, void *user_data)
+{
+    LV_UNUSED(user_data);
+    for(uint32_t i = 0; i < ACTIVE_TRACK_CNT; i++) {
+        if(strcmp(Mp3Path[i], file_path) == 0) {
+            gapless_track_id = i;
+            break;
+        }
+    }
+}
+
 
 /*
  * Callback adapter function to convert parameter types to avoid compile-time
@@ -231,7 +250,7 @@ static void ui_update_timer_cb(lv_timer_t * timer) {
         else
         {
             //Stop the song when in the paused state
-            speaker_player_play_file(Mp3Path[track_id]);
+            play_track(track_id);
             audio_player_pause(); // Pause playback
         }
         
@@ -464,17 +483,9 @@ void lv_demo_music_resume(void)
     
     spectrum_i = spectrum_i_pause;
 
-    // Setup animation
-    lv_anim_t a;
-    lv_anim_init(&a);
-    lv_anim_set_values(&a, spectrum_i, spectrum_len - 1);
-    lv_anim_set_exec_cb(&a, spectrum_anim_cb);
-    lv_anim_set_var(&a, spectrum_obj);
-    lv_anim_set_duration(&a, ((spectrum_len - spectrum_i) * 1000) / 30);
-    lv_anim_set_playback_duration(&a, 0);
-    lv_anim_set_completed_cb(&a, spectrum_end_cb);
-    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_start(&a);
+    // Follow the spectrum analyzer, it updates at the same rate
+    if(spectrum_timer) lv_timer_resume(spectrum_timer);
+    else spectrum_timer = lv_timer_create(spectrum_timer_cb, 1000 / SPECTRUM_RATE_HZ, spectrum_obj);
 
     if(sec_counter_timer) lv_timer_resume(sec_counter_timer);
     lv_slider_set_range(slider_obj, 0, lv_demo_music_get_track_length(track_id));
@@ -486,15 +497,15 @@ void lv_demo_music_resume(void)
     switch (play_state)
     {
         case AUDIO_PLAYER_CALLBACK_EVENT_IDLE:
-            speaker_player_play_file(Mp3Path[track_id]); // Start playback
+            play_track(track_id); // Start playback
             break;
     
         case AUDIO_PLAYER_CALLBACK_EVENT_COMPLETED_PLAYING_NEXT:
-            speaker_player_play_file(Mp3Path[track_id]); // Start playback
+            play_track(track_id); // Start playback
             break;
 
         case AUDIO_PLAYER_CALLBACK_EVENT_PLAYING:
-            speaker_player_play_file(Mp3Path[track_id]); // Start playback
+            play_track(track_id); // Start playback
             break;
 
         case AUDIO_PLAYER_CALLBACK_EVENT_PAUSE:
@@ -512,7 +523,8 @@ void lv_demo_music_pause(void)
     playing = false;
     spectrum_i_pause = spectrum_i;
     spectrum_i = 0;
-    lv_anim_delete(spectrum_obj, spectrum_anim_cb);
+    if(spectrum_timer) lv_timer_pause(spectrum_timer);
+    lv_memzero(spectrum, sizeof(spectrum));
     lv_obj_invalidate(spectrum_obj);
     lv_image_set_scale(album_image_obj, LV_SCALE_NONE);
     if(sec_counter_timer) lv_timer_pause(sec_counter_timer);
@@ -870,6 +882,15 @@ static lv_obj_t * create_handle(lv_obj_t * parent)
     return cont;
 }
 
+/*Start a track unless the player already runs it after a gapless change, and queue the one after it*/
+static void play_track(uint32_t id)
+{
+    if(play_state != AUDIO_PLAYER_CALLBACK_EVENT_PLAYING || !speaker_player_is_playing_by_path(Mp3Path[id])) {
+        speaker_player_play_file(Mp3Path[id]);
+    }
+    speaker_player_queue_file(Mp3Path[(id + 1) % ACTIVE_TRACK_CNT]);
+}
+
 static void track_load(uint32_t id)
 {
     spectrum_i = 0;
@@ -964,7 +985,7 @@ static void spectrum_draw_event_cb(lv_event_t * e)
 
             /* Add "side bars" with cosine characteristic.*/
             for(f = 0; f < band_w; f++) {
-                uint32_t ampl_main = spectrum[spectrum_i][s];
+                uint32_t ampl_main = spectrum[s];
                 int32_t ampl_mod = get_cos(f * 360 / band_w + 180, 180) + 180;
                 int32_t t = BAR_PER_BAND_CNT * s - band_w / 2 + f;
                 if(t < 0) t = BAR_CNT + t;
@@ -1022,26 +1043,30 @@ static void spectrum_draw_event_cb(lv_event_t * e)
     }
     else if(code == LV_EVENT_DELETE) {
         lv_anim_delete(NULL, start_anim_cb);
-        lv_anim_delete(NULL, spectrum_anim_cb);
+        if(spectrum_timer) {
+            lv_timer_delete(spectrum_timer);
+            spectrum_timer = NULL;
+        }
         if(start_anim && stop_start_anim_timer) lv_timer_delete(stop_start_anim_timer);
     }
 }
 
-static void spectrum_anim_cb(void * a, int32_t v)
+static void spectrum_timer_cb(lv_timer_t * t)
 {
-    lv_obj_t * obj = a;
+    lv_obj_t * obj = lv_timer_get_user_data(t);
     if(start_anim) {
         lv_obj_invalidate(obj);
         return;
     }
 
-    spectrum_i = v;
+    if(!spectrum_get_bands(spectrum)) return;
+    spectrum_i++;
     lv_obj_invalidate(obj);
 
     static uint32_t bass_cnt = 0;
     static int32_t last_bass = -1000;
     static int32_t dir = 1;
-    if(spectrum[spectrum_i][0] > 12) {
+    if(spectrum[0] > 12) {
         if(spectrum_i - last_bass > 5) {
             bass_cnt++;
             last_bass = spectrum_i;
@@ -1051,9 +1076,9 @@ static void spectrum_anim_cb(void * a, int32_t v)
             }
         }
     }
-    if(spectrum[spectrum_i][0] < 4) bar_rot += dir;
+    if(spectrum[0] < 4) bar_rot += dir;
 
-    lv_image_set_scale(album_image_obj, LV_SCALE_NONE + spectrum[spectrum_i][0]);
+    lv_image_set_scale(album_image_obj, LV_SCALE_NONE + spectrum[0]);
 }
 
 static void start_anim_cb(void * var, int32_t v)
@@ -1063,32 +1088,54 @@ static void start_anim_cb(void * var, int32_t v)
     lv_obj_invalidate(spectrum_obj);
 }
 
-static lv_obj_t * album_image_create(lv_obj_t * parent)
+static const void * album_cover_src(uint32_t id)
 {
     LV_IMAGE_DECLARE(user_img_lv_demo_music_cover_1);
     LV_IMAGE_DECLARE(user_img_lv_demo_music_cover_2);
     LV_IMAGE_DECLARE(user_img_lv_demo_music_cover_3);
+    static const lv_image_dsc_t * builtin[ACTIVE_TRACK_CNT] = {
+        &user_img_lv_demo_music_cover_1,
+        &user_img_lv_demo_music_cover_2,
+        &user_img_lv_demo_music_cover_3,
+    };
+    static char sd_path[ACTIVE_TRACK_CNT][32];
+    static const void * src[ACTIVE_TRACK_CNT];
+
+    id %= ACTIVE_TRACK_CNT;
+
+    /*Prefer a cover from the SD card. The card is probed once per cover, the result is kept*/
+    if(src[id] == NULL) {
+        lv_image_header_t header;
+        lv_snprintf(sd_path[id], sizeof(sd_path[id]), ALBUM_COVER_SD_PATH, id + 1);
+        src[id] = (lv_image_decoder_get_info(sd_path[id], &header) == LV_RESULT_OK) ? (const void *)sd_path[id] : builtin[id];
+    }
 
+    return src[id];
+}
+
+static void album_cover_pin_one(uint32_t id)
+{
+    /*Built-in covers are drawn straight from flash, only SD covers are decoded into the cache*/
+    const void * src = album_cover_src(id);
+    if(lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) lvgl_port_img_pin(src);
+}
+
+static void album_cover_pin(uint32_t id)
+{
+    /*Keep the current cover and its neighbours decoded so swiping doesn't stall on the SD card*/
+    lvgl_port_img_unpin_all();
+    album_cover_pin_one(id);
+    album_cover_pin_one(id + 1);
+    album_cover_pin_one(id + ACTIVE_TRACK_CNT - 1);
+}
+
+static lv_obj_t * album_image_create(lv_obj_t * parent)
+{
     lv_obj_t * img;
     img = lv_image_create(parent);
+    lv_image_set_src(img, album_cover_src(track_id));
+    album_cover_pin(track_id);
 
-    switch(track_id) {
-        case 2:
-            lv_image_set_src(img, &user_img_lv_demo_music_cover_3);
-            spectrum = BGM_2;
-            spectrum_len = sizeof(BGM_2) / sizeof(BGM_2[0]);
-            break;
-        case 1:
-            lv_image_set_src(img, &user_img_lv_demo_music_cover_2);
-            spectrum = BGM_1;
-            spectrum_len = sizeof(BGM_1) / sizeof(BGM_1[0]);
-            break;
-        case 0:
-            lv_image_set_src(img, &user_img_lv_demo_music_cover_1);
-            spectrum = For_Elise;
-            spectrum_len = sizeof(For_Elise) / sizeof(For_Elise[0]);
-            break;
-    }
     lv_image_set_antialias(img, false);
     lv_obj_align(img, LV_ALIGN_CENTER, 0, 0);
     lv_obj_add_event_cb(img, album_gesture_event_cb, LV_EVENT_GESTURE, NULL);
@@ -1110,6 +1157,7 @@ static void album_gesture_event_cb(lv_event_t * e)
 static void play_event_click_cb(lv_event_t * e)
 {
     lv_obj_t * obj = lv_event_get_target(e);
+    speaker_player_click();
     if(lv_obj_has_state(obj, LV_STATE_CHECKED)) {
         lv_demo_music_resume();
     }
@@ -1121,6 +1169,7 @@ static void play_event_click_cb(lv_event_t * e)
 static void prev_click_event_cb(lv_event_t * e)
 {
     LV_UNUSED(e);
+    speaker_player_click();
     lv_demo_music_album_next(false);
 }
 
@@ -1128,6 +1177,7 @@ static void next_click_event_cb(lv_event_t * e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if(code == LV_EVENT_CLICKED) {
+        speaker_player_click();
         lv_demo_music_album_next(true);
     }
 }
@@ -1135,17 +1185,17 @@ static void next_click_event_cb(lv_event_t * e)
 static void timer_cb(lv_timer_t * t)
 {
     LV_UNUSED(t);
+    if(gapless_track_id >= 0) {
+        uint32_t id = gapless_track_id;
+        gapless_track_id = -1;
+        track_load(id);
+        return;
+    }
     time_act++;
     lv_label_set_text_fmt(time_obj, "%"LV_PRIu32":%02"LV_PRIu32, time_act / 60, time_act % 60);
     lv_slider_set_value(slider_obj, time_act, LV_ANIM_ON);
 }
 
-static void spectrum_end_cb(lv_anim_t * a)
-{
-    LV_UNUSED(a);
-
-}
-
 static void stop_start_anim(lv_timer_t * t)
 {
     LV_UNUSED(t);
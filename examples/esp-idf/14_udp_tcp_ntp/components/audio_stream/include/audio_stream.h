@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Audio stream configuration
+#define AUDIO_STREAM_SAMPLE_RATE        16000   // Mono, both directions
+#define AUDIO_STREAM_FRAME_MS           20      // Audio per RTP packet
+#define AUDIO_STREAM_PORT               12350   // Local RTP port, also the peer port unless set otherwise
+#define AUDIO_STREAM_PT_L16             96      // Dynamic payload types, 16-bit big-endian PCM and G.711 u-law at 16 kHz
+#define AUDIO_STREAM_PT_PCMU            97
+#define AUDIO_STREAM_PT_DVI4            6       // Static payload type of IMA ADPCM at 16 kHz (RFC 3551)
+
+#define AUDIO_STREAM_JB_FRAMES          16      // Jitter buffer slots, a power of two covering AUDIO_STREAM_JB_MAX_MS
+#define AUDIO_STREAM_JB_MIN_MS          40      // Shortest playout delay
+#define AUDIO_STREAM_JB_MAX_MS          300     // Longest playout delay, a slower network loses packets instead
+#define AUDIO_STREAM_JB_JITTER_MULT     4       // Playout delay above one frame, in multiples of the measured jitter
+#define AUDIO_STREAM_JB_SHRINK_MS       2000    // The buffer must hold too much for this long before a frame is dropped
+#define AUDIO_STREAM_PLC_FRAMES         3       // Lost frames replaced by the faded last frame, silence after that
+
+#define AUDIO_STREAM_TASK_PRIORITY      7       // Above the network workers, below the LVGL task
+#define AUDIO_STREAM_TASK_STACK_SIZE    (4 * 1024)
+
+/**
+ * @brief Payload compression
+ */
+typedef enum {
+    AUDIO_STREAM_CODEC_L16 = 0,     // 256 kbit/s, no loss
+    AUDIO_STREAM_CODEC_PCMU,        // G.711 u-law, 128 kbit/s
+    AUDIO_STREAM_CODEC_DVI4,        // IMA ADPCM, 64 kbit/s
+} audio_stream_codec_t;
+
+/**
+ * @brief Stream configuration
+ */
+typedef struct {
+    const char *peer_ip;            // Where the microphone is sent, NULL to answer the first stream received
+    uint16_t peer_port;             // 0 for AUDIO_STREAM_PORT
+    audio_stream_codec_t codec;     // Sent payload, received packets are decoded by their payload type
+    bool send;                      // Stream the microphone
+    bool receive;                   // Play the received stream
+} audio_stream_config_t;
+
+/**
+ * @brief Stream statistics
+ */
+typedef struct {
+    uint32_t tx_packets;            // RTP packets sent
+    uint32_t tx_errors;             // Failed sends and microphone reads
+    uint32_t rx_packets;            // RTP packets accepted, duplicates excluded
+    uint32_t rx_invalid;            // Datagrams that were not RTP or had an unknown payload type
+    uint32_t rx_lost;               // Sequence numbers never received (RFC 3550 cumulative loss)
+    uint32_t rx_late;               // Packets that arrived after their playout time
+    uint32_t rx_duplicates;
+    uint32_t loss_permille;         // rx_lost over the packets expected
+    uint32_t jitter_us;             // RFC 3550 interarrival jitter
+    uint32_t concealed_frames;      // Frames replaced by loss concealment
+    uint32_t underruns;             // Times the buffer ran dry and refilled to the playout delay
+    uint32_t dropped_frames;        // Frames skipped to bring the delay back down
+    uint32_t target_ms;             // Current playout delay
+    uint32_t delay_avg_ms;          // Packet arrival to I2S write of the played frames
+    uint32_t delay_max_ms;
+} audio_stream_stats_t;
+
+/**
+ * @brief Start streaming
+ *
+ * Switches the codec to AUDIO_STREAM_SAMPLE_RATE mono until audio_stream_stop(). Call
+ * once the network is up and speaker_codec_init() has run.
+ *
+ * @param config Stream configuration
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Already streaming
+ *      - ESP_ERR_INVALID_ARG: Bad configuration
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ *      - ESP_FAIL: The socket could not be opened
+ */
+esp_err_t audio_stream_start(const audio_stream_config_t *config);
+
+/**
+ * @brief Stop streaming and restore the default codec format
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Not streaming
+ */
+esp_err_t audio_stream_stop(void);
+
+/**
+ * @brief Check whether the stream is running
+ *
+ * @return true while streaming
+ */
+bool audio_stream_is_running(void);
+
+/**
+ * @brief Get the statistics of the current or last stream
+ *
+ * @param stats Output statistics
+ */
+void audio_stream_get_stats(audio_stream_stats_t *stats);
+
+/**
+ * @brief Log the statistics of the current or last stream
+ */
+void audio_stream_log_stats(void);
@@ -0,0 +1,708 @@
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "esp_log.h"
+#include "lwip/sockets.h"
+
+#include "codec_dev.h"
+#include "audio_stream.h"
+
+static const char *TAG = "audio_stream";
+
+#define RTP_HEADER_SIZE         12
+#define RTP_VERSION             2
+#define RTP_MARKER              0x80
+#define RTP_RX_BUFFER_SIZE      1500    // One Ethernet MTU, room for CSRCs and header extensions
+
+#define FRAME_SAMPLES           (AUDIO_STREAM_SAMPLE_RATE * AUDIO_STREAM_FRAME_MS / 1000)
+#define FRAME_BYTES             (FRAME_SAMPLES * sizeof(int16_t))
+#define DVI4_HEADER_SIZE        4       // Predicted sample and step index of the packet (RFC 3551 4.5.1)
+#define TX_PACKET_SIZE          (RTP_HEADER_SIZE + FRAME_BYTES)
+#define RX_TIMEOUT_MS           200     // How long the receive task may take to notice audio_stream_stop()
+
+#define PLC_HISTORY             (2 * FRAME_SAMPLES)             // Played audio kept for the pitch search
+#define PLC_WINDOW              (AUDIO_STREAM_SAMPLE_RATE / 100) // 10 ms compared per candidate period
+#define PLC_PITCH_MIN           (AUDIO_STREAM_SAMPLE_RATE / 400)
+#define PLC_PITCH_MAX           (AUDIO_STREAM_SAMPLE_RATE / 66)
+
+#if (AUDIO_STREAM_JB_FRAMES & (AUDIO_STREAM_JB_FRAMES - 1)) != 0
+#error "AUDIO_STREAM_JB_FRAMES must be a power of two"
+#endif
+#if AUDIO_STREAM_JB_FRAMES * AUDIO_STREAM_FRAME_MS < AUDIO_STREAM_JB_MAX_MS + AUDIO_STREAM_FRAME_MS
+#error "AUDIO_STREAM_JB_FRAMES must cover AUDIO_STREAM_JB_MAX_MS and the frame being played"
+#endif
+#if PLC_WINDOW + PLC_PITCH_MAX > PLC_HISTORY
+#error "The loss concealment history is too short for its pitch search"
+#endif
+
+typedef struct {
+    int16_t *pcm;           // One decoded frame
+    uint16_t seq;
+    bool valid;
+    int64_t arrival_us;
+} audio_stream_slot_t;
+
+typedef struct {
+    int32_t predicted;
+    int32_t index;
+} audio_stream_adpcm_t;
+
+static const int16_t s_ima_steps[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const int8_t s_ima_index[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static audio_stream_config_t s_config;
+static struct sockaddr_in s_peer;
+static volatile bool s_peer_known = false;
+static int s_sock = -1;
+static volatile bool s_running = false;
+static volatile bool s_stop = false;
+static int s_task_num = 0;
+static SemaphoreHandle_t s_done_sem = NULL;     // Given by each task on exit
+static SemaphoreHandle_t s_lock = NULL;         // Jitter buffer, receive state and statistics
+
+// Buffers, allocated on the first start and kept
+static int16_t *s_slot_pcm = NULL;
+static uint8_t *s_rx_buf = NULL;
+static int16_t *s_rx_pcm = NULL;
+static uint8_t *s_tx_pkt = NULL;
+static int16_t *s_tx_pcm = NULL;
+static int16_t *s_play_pcm = NULL;
+
+// Receive side, under s_lock
+static audio_stream_slot_t s_slots[AUDIO_STREAM_JB_FRAMES];
+static bool s_rx_started = false;               // A stream is being received
+static uint32_t s_rx_ssrc = 0;
+static uint32_t s_ext_base = 0;                 // Extended sequence numbers of the first and the newest packet
+static uint32_t s_ext_max = 0;
+static uint32_t s_received = 0;
+static int32_t s_last_transit = 0;
+static uint32_t s_jitter_q4 = 0;                // RFC 3550 A.8, timestamp units times 16
+static uint16_t s_play_seq = 0;                 // Next frame to play
+static bool s_playing = false;                  // false while filling up to the playout delay
+static uint32_t s_target_frames = AUDIO_STREAM_JB_MIN_MS / AUDIO_STREAM_FRAME_MS;
+static uint32_t s_over_frames = 0;              // Frames played in a row with the buffer above its target
+static int16_t s_plc_hist[PLC_HISTORY];         // Last played audio, newest last
+static uint32_t s_plc_run = 0;                  // Frames concealed in a row
+static uint32_t s_plc_period = 0;
+static uint32_t s_plc_pos = 0;
+static uint64_t s_delay_sum_ms = 0;
+static uint32_t s_delay_cnt = 0;
+static audio_stream_stats_t s_stats;
+
+/**************************************************************************************************
+ *
+ * Payload Codecs
+ *
+ **************************************************************************************************/
+
+// G.711 u-law
+static uint8_t audio_stream_ulaw_encode(int16_t pcm)
+{
+    const int sign = (pcm < 0) ? 0x80 : 0;
+    int s = sign ? -(int)pcm : pcm;
+    s = (s > 32635) ? 32635 : s;
+    s += 0x84;
+
+    int exponent = 7;
+    for (int mask = 0x4000; (s & mask) == 0 && exponent > 0; mask >>= 1) {
+        exponent--;
+    }
+    const int mantissa = (s >> (exponent + 3)) & 0x0f;
+    return (uint8_t)~(sign | (exponent << 4) | mantissa);
+}
+
+static int16_t audio_stream_ulaw_decode(uint8_t u)
+{
+    u = ~u;
+    const int t = (((u & 0x0f) << 3) + 0x84) << ((u & 0x70) >> 4);
+    return (int16_t)((u & 0x80) ? (0x84 - t) : (t - 0x84));
+}
+
+// IMA ADPCM, the encoder and the decoder take the same steps
+static int16_t audio_stream_adpcm_step(audio_stream_adpcm_t *st, uint8_t code)
+{
+    const int32_t step = s_ima_steps[st->index];
+    int32_t delta = step >> 3;
+    delta += (code & 4) ? step : 0;
+    delta += (code & 2) ? step >> 1 : 0;
+    delta += (code & 1) ? step >> 2 : 0;
+
+    st->predicted += (code & 8) ? -delta : delta;
+    st->predicted = (st->predicted > INT16_MAX) ? INT16_MAX : (st->predicted < INT16_MIN) ? INT16_MIN : st->predicted;
+    st->index += s_ima_index[code & 7];
+    st->index = (st->index < 0) ? 0 : (st->index > 88) ? 88 : st->index;
+    return (int16_t)st->predicted;
+}
+
+static uint8_t audio_stream_adpcm_encode(audio_stream_adpcm_t *st, int16_t sample)
+{
+    int32_t step = s_ima_steps[st->index];
+    int32_t diff = sample - st->predicted;
+    uint8_t code = 0;
+
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    for (uint8_t bit = 4; bit > 0; bit >>= 1) {
+        if (diff >= step) {
+            code |= bit;
+            diff -= step;
+        }
+        step >>= 1;
+    }
+    audio_stream_adpcm_step(st, code);
+    return code;
+}
+
+static uint8_t audio_stream_payload_type(audio_stream_codec_t codec)
+{
+    return (codec == AUDIO_STREAM_CODEC_PCMU) ? AUDIO_STREAM_PT_PCMU :
+           (codec == AUDIO_STREAM_CODEC_DVI4) ? AUDIO_STREAM_PT_DVI4 : AUDIO_STREAM_PT_L16;
+}
+
+// Encode one frame, returns the payload size
+static size_t audio_stream_encode(audio_stream_codec_t codec, audio_stream_adpcm_t *st, const int16_t *pcm, uint8_t *out)
+{
+    switch (codec) {
+    case AUDIO_STREAM_CODEC_PCMU:
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            out[i] = audio_stream_ulaw_encode(pcm[i]);
+        }
+        return FRAME_SAMPLES;
+    case AUDIO_STREAM_CODEC_DVI4:
+        // The state at the start of the packet goes first, so every packet decodes on its own
+        out[0] = (uint8_t)((uint16_t)st->predicted >> 8);
+        out[1] = (uint8_t)st->predicted;
+        out[2] = (uint8_t)st->index;
+        out[3] = 0;
+        for (int i = 0; i < FRAME_SAMPLES; i += 2) {
+            const uint8_t hi = audio_stream_adpcm_encode(st, pcm[i]);
+            out[DVI4_HEADER_SIZE + i / 2] = (uint8_t)((hi << 4) | audio_stream_adpcm_encode(st, pcm[i + 1]));
+        }
+        return DVI4_HEADER_SIZE + FRAME_SAMPLES / 2;
+    default:
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            out[2 * i] = (uint8_t)((uint16_t)pcm[i] >> 8);
+            out[2 * i + 1] = (uint8_t)pcm[i];
+        }
+        return FRAME_BYTES;
+    }
+}
+
+// Decode one frame, false for an unknown payload type or another frame length
+static bool audio_stream_decode(uint8_t pt, const uint8_t *in, size_t len, int16_t *pcm)
+{
+    if (pt == AUDIO_STREAM_PT_L16 && len == FRAME_BYTES) {
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            pcm[i] = (int16_t)((in[2 * i] << 8) | in[2 * i + 1]);
+        }
+        return true;
+    }
+    if (pt == AUDIO_STREAM_PT_PCMU && len == FRAME_SAMPLES) {
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            pcm[i] = audio_stream_ulaw_decode(in[i]);
+        }
+        return true;
+    }
+    if (pt == AUDIO_STREAM_PT_DVI4 && len == DVI4_HEADER_SIZE + FRAME_SAMPLES / 2 && in[2] <= 88) {
+        audio_stream_adpcm_t st = {
+            .predicted = (int16_t)((in[0] << 8) | in[1]),
+            .index = in[2],
+        };
+        for (int i = 0; i < FRAME_SAMPLES; i += 2) {
+            const uint8_t b = in[DVI4_HEADER_SIZE + i / 2];
+            pcm[i] = audio_stream_adpcm_step(&st, b >> 4);
+            pcm[i + 1] = audio_stream_adpcm_step(&st, b & 0x0f);
+        }
+        return true;
+    }
+    return false;
+}
+
+/**************************************************************************************************
+ *
+ * Loss Concealment
+ *
+ **************************************************************************************************/
+
+// Period of the played audio, the candidate whose shifted copy matches the last 10 ms best
+static uint32_t audio_stream_plc_period(void)
+{
+    const int16_t *x = &s_plc_hist[PLC_HISTORY - PLC_WINDOW];
+    float best = 0;
+    uint32_t period = PLC_PITCH_MAX;
+
+    for (uint32_t p = PLC_PITCH_MIN; p <= PLC_PITCH_MAX; p++) {
+        const int16_t *y = x - p;
+        int64_t c = 0, e = 0;
+        for (int i = 0; i < PLC_WINDOW; i++) {
+            c += (int32_t)x[i] * y[i];
+            e += (int32_t)y[i] * y[i];
+        }
+        if (c > 0 && e > 0) {
+            const float score = (float)c * (float)c / (float)e;
+            if (score > best) {
+                best = score;
+                period = p;
+            }
+        }
+    }
+    return period;
+}
+
+// Replace a missing frame: the last period repeated and faded out over AUDIO_STREAM_PLC_FRAMES
+static void audio_stream_conceal(int16_t *out)
+{
+    if (s_plc_run >= AUDIO_STREAM_PLC_FRAMES) {
+        memset(out, 0, FRAME_BYTES);
+        return;
+    }
+    if (s_plc_run == 0) {
+        s_plc_period = audio_stream_plc_period();
+        s_plc_pos = 0;
+    }
+
+    const int32_t total = AUDIO_STREAM_PLC_FRAMES * FRAME_SAMPLES;
+    const int16_t *period = &s_plc_hist[PLC_HISTORY - s_plc_period];
+    for (int i = 0; i < FRAME_SAMPLES; i++) {
+        const int32_t left = total - (int32_t)(s_plc_run * FRAME_SAMPLES) - i;
+        out[i] = (int16_t)((int32_t)period[s_plc_pos] * left / total);
+        s_plc_pos = (s_plc_pos + 1) % s_plc_period;
+    }
+    s_plc_run++;
+    s_stats.concealed_frames++;
+}
+
+static void audio_stream_plc_push(const int16_t *pcm)
+{
+    memmove(s_plc_hist, &s_plc_hist[FRAME_SAMPLES], (PLC_HISTORY - FRAME_SAMPLES) * sizeof(int16_t));
+    memcpy(&s_plc_hist[PLC_HISTORY - FRAME_SAMPLES], pcm, FRAME_BYTES);
+    s_plc_run = 0;
+}
+
+/**************************************************************************************************
+ *
+ * Jitter Buffer
+ *
+ **************************************************************************************************/
+
+static void audio_stream_jb_reset(uint16_t seq, uint32_t ssrc)
+{
+    for (int i = 0; i < AUDIO_STREAM_JB_FRAMES; i++) {
+        s_slots[i].valid = false;
+    }
+    s_rx_started = true;
+    s_rx_ssrc = ssrc;
+    s_ext_base = s_ext_max = seq;
+    s_received = 0;
+    s_jitter_q4 = 0;
+    s_play_seq = seq;
+    s_playing = false;
+    s_over_frames = 0;
+}
+
+// Store a decoded frame, called by the receive task with s_lock held
+static void audio_stream_jb_put(uint16_t seq, uint32_t ts, uint32_t ssrc, int64_t arrival_us, const int16_t *pcm)
+{
+    if (!s_rx_started || ssrc != s_rx_ssrc) {
+        ESP_LOGI(TAG, "Receiving stream %08" PRIx32, ssrc);
+        audio_stream_jb_reset(seq, ssrc);
+    }
+
+    const int16_t ahead = (int16_t)(seq - (uint16_t)s_ext_max);
+    s_ext_max += (ahead > 0) ? ahead : 0;
+
+    // Interarrival jitter in timestamp units, RFC 3550 A.8
+    const int32_t transit = (int32_t)(arrival_us * AUDIO_STREAM_SAMPLE_RATE / 1000000) - (int32_t)ts;
+    if (s_received > 0) {
+        const int32_t d = abs(transit - s_last_transit);
+        s_jitter_q4 += d - ((s_jitter_q4 + 8) >> 4);
+    }
+    s_last_transit = transit;
+
+    // Playout delay: a frame plus a few times the jitter
+    const uint32_t jitter_ms = (s_jitter_q4 >> 4) * 1000 / AUDIO_STREAM_SAMPLE_RATE;
+    uint32_t target_ms = AUDIO_STREAM_FRAME_MS + AUDIO_STREAM_JB_JITTER_MULT * jitter_ms;
+    target_ms = (target_ms < AUDIO_STREAM_JB_MIN_MS) ? AUDIO_STREAM_JB_MIN_MS : (target_ms > AUDIO_STREAM_JB_MAX_MS) ? AUDIO_STREAM_JB_MAX_MS : target_ms;
+    s_target_frames = (target_ms + AUDIO_STREAM_FRAME_MS - 1) / AUDIO_STREAM_FRAME_MS;
+
+    int16_t from_play = (int16_t)(seq - s_play_seq);
+    if (!s_playing && from_play < 0 && -from_play < AUDIO_STREAM_JB_FRAMES / 2) {
+        s_play_seq = seq;       // Reordered ahead of the first packet, playout has not started
+        from_play = 0;
+    }
+    if (from_play >= AUDIO_STREAM_JB_FRAMES) {
+        // Too far ahead to keep, the sender skipped or playback stalled: start over from here
+        for (int i = 0; i < AUDIO_STREAM_JB_FRAMES; i++) {
+            s_slots[i].valid = false;
+        }
+        s_play_seq = seq;
+        s_playing = false;
+        from_play = 0;
+    }
+
+    s_received++;
+    audio_stream_slot_t *slot = &s_slots[seq % AUDIO_STREAM_JB_FRAMES];
+    if (from_play < 0) {
+        s_stats.rx_late++;
+    } else if (slot->valid && slot->seq == seq) {
+        s_received--;
+        s_stats.rx_duplicates++;
+    } else {
+        memcpy(slot->pcm, pcm, FRAME_BYTES);
+        slot->seq = seq;
+        slot->valid = true;
+        slot->arrival_us = arrival_us;
+    }
+}
+
+// Produce the next frame to play, called by the playback task with s_lock held
+static void audio_stream_jb_get(int16_t *out)
+{
+    if (!s_rx_started) {
+        memset(out, 0, FRAME_BYTES);
+        return;
+    }
+
+    // Frames from the next one to play to the newest received, holes included
+    int32_t depth = (int16_t)((uint16_t)s_ext_max - s_play_seq) + 1;
+    if (!s_playing) {
+        if (depth < (int32_t)s_target_frames) {
+            audio_stream_conceal(out);
+            return;
+        }
+        s_playing = true;
+    }
+
+    audio_stream_slot_t *slot = &s_slots[s_play_seq % AUDIO_STREAM_JB_FRAMES];
+    if (slot->valid && slot->seq == s_play_seq) {
+        memcpy(out, slot->pcm, FRAME_BYTES);
+        slot->valid = false;
+        audio_stream_plc_push(out);
+        const uint32_t delay_ms = (uint32_t)((esp_timer_get_time() - slot->arrival_us) / 1000);
+        s_delay_sum_ms += delay_ms;
+        s_delay_cnt++;
+        s_stats.delay_max_ms = (delay_ms > s_stats.delay_max_ms) ? delay_ms : s_stats.delay_max_ms;
+    } else if (depth <= 0) {
+        // Nothing newer came in: conceal and refill to the playout delay
+        audio_stream_conceal(out);
+        s_playing = false;
+        s_stats.underruns++;
+        return;
+    } else {
+        audio_stream_conceal(out);  // Lost, or so late that newer frames are here already
+    }
+    s_play_seq++;
+    depth--;
+
+    // A jitter burst that has passed leaves the buffer too full, skip a frame once it has lasted
+    s_over_frames = (depth > (int32_t)s_target_frames + 1) ? s_over_frames + 1 : 0;
+    if (s_over_frames >= AUDIO_STREAM_JB_SHRINK_MS / AUDIO_STREAM_FRAME_MS) {
+        s_slots[s_play_seq % AUDIO_STREAM_JB_FRAMES].valid = false;
+        s_play_seq++;
+        s_over_frames = 0;
+        s_stats.dropped_frames++;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Stream Tasks
+ *
+ **************************************************************************************************/
+
+static void audio_stream_tx_task(void *arg)
+{
+    audio_stream_adpcm_t adpcm = { 0 };
+    uint16_t seq = (uint16_t)esp_random();
+    uint32_t ts = esp_random();
+    const uint32_t ssrc = esp_random();
+    const uint8_t pt = audio_stream_payload_type(s_config.codec);
+    bool first = true;
+
+    while (!s_stop) {
+        size_t bytes_read = 0;
+        if (mic_i2s_read(s_tx_pcm, FRAME_BYTES, &bytes_read, portMAX_DELAY) != ESP_OK || bytes_read != FRAME_BYTES) {
+            xSemaphoreTake(s_lock, portMAX_DELAY);
+            s_stats.tx_errors++;
+            xSemaphoreGive(s_lock);
+            continue;
+        }
+        if (!s_peer_known) {
+            ts += FRAME_SAMPLES;    // The timestamp keeps counting sampling time (RFC 3550 5.1)
+            continue;
+        }
+
+        uint8_t *h = s_tx_pkt;
+        h[0] = RTP_VERSION << 6;
+        h[1] = pt | (first ? RTP_MARKER : 0);
+        h[2] = (uint8_t)(seq >> 8);
+        h[3] = (uint8_t)seq;
+        for (int i = 0; i < 4; i++) {
+            h[4 + i] = (uint8_t)(ts >> (24 - 8 * i));
+            h[8 + i] = (uint8_t)(ssrc >> (24 - 8 * i));
+        }
+        const size_t len = RTP_HEADER_SIZE + audio_stream_encode(s_config.codec, &adpcm, s_tx_pcm, h + RTP_HEADER_SIZE);
+        const int sent = sendto(s_sock, s_tx_pkt, len, 0, (struct sockaddr *)&s_peer, sizeof(s_peer));
+        seq++;
+        ts += FRAME_SAMPLES;
+        first = false;
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        (sent == (int)len) ? s_stats.tx_packets++ : s_stats.tx_errors++;
+        xSemaphoreGive(s_lock);
+    }
+
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+static void audio_stream_rx_task(void *arg)
+{
+    while (!s_stop) {
+        struct sockaddr_in source_addr;
+        socklen_t socklen = sizeof(source_addr);
+        const int len = recvfrom(s_sock, s_rx_buf, RTP_RX_BUFFER_SIZE, 0, (struct sockaddr *)&source_addr, &socklen);
+        if (len < 0) {
+            continue;   // Timeout, s_stop is checked again
+        }
+        const int64_t arrival_us = esp_timer_get_time();
+
+        // RTP header (RFC 3550 5.1): CSRCs, extension and padding are skipped
+        const uint8_t *p = s_rx_buf;
+        size_t off = RTP_HEADER_SIZE + 4 * (p[0] & 0x0f);
+        size_t end = len;
+        bool ok = len >= RTP_HEADER_SIZE && (p[0] >> 6) == RTP_VERSION;
+        if (ok && (p[0] & 0x10)) {
+            ok = off + 4 <= end;
+            off += ok ? 4 + 4 * ((p[off + 2] << 8) | p[off + 3]) : 0;
+        }
+        if (ok && (p[0] & 0x20)) {
+            ok = p[len - 1] <= end;
+            end -= ok ? p[len - 1] : 0;
+        }
+        ok = ok && off <= end && audio_stream_decode(p[1] & 0x7f, p + off, end - off, s_rx_pcm);
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        if (ok) {
+            const uint16_t seq = (p[2] << 8) | p[3];
+            const uint32_t ts = ((uint32_t)p[4] << 24) | (p[5] << 16) | (p[6] << 8) | p[7];
+            const uint32_t ssrc = ((uint32_t)p[8] << 24) | (p[9] << 16) | (p[10] << 8) | p[11];
+            audio_stream_jb_put(seq, ts, ssrc, arrival_us, s_rx_pcm);
+        } else {
+            s_stats.rx_invalid++;
+        }
+        xSemaphoreGive(s_lock);
+
+        // Symmetric RTP: without a configured peer, answer the first stream
+        if (ok && !s_peer_known) {
+            s_peer = source_addr;
+            s_peer_known = true;
+            ESP_LOGI(TAG, "Peer %s:%d", inet_ntoa(source_addr.sin_addr), ntohs(source_addr.sin_port));
+        }
+    }
+
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+static void audio_stream_play_task(void *arg)
+{
+    while (!s_stop) {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        audio_stream_jb_get(s_play_pcm);
+        xSemaphoreGive(s_lock);
+
+        // Paced by I2S, the write blocks while the DMA buffers are full
+        size_t bytes_written = 0;
+        speaker_i2s_write(s_play_pcm, FRAME_BYTES, &bytes_written, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(s_done_sem);
+    vTaskDelete(NULL);
+}
+
+/**************************************************************************************************
+ *
+ * Public Functions
+ *
+ **************************************************************************************************/
+
+static bool audio_stream_alloc(void)
+{
+    if (!s_slot_pcm) {
+        s_slot_pcm = heap_caps_malloc(AUDIO_STREAM_JB_FRAMES * FRAME_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        s_rx_buf = heap_caps_malloc(RTP_RX_BUFFER_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_rx_pcm = heap_caps_malloc(FRAME_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_tx_pkt = heap_caps_malloc(TX_PACKET_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_tx_pcm = heap_caps_malloc(FRAME_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_play_pcm = heap_caps_malloc(FRAME_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        s_lock = xSemaphoreCreateMutex();
+        s_done_sem = xSemaphoreCreateCounting(3, 0);
+        for (int i = 0; i < AUDIO_STREAM_JB_FRAMES && s_slot_pcm; i++) {
+            s_slots[i].pcm = &s_slot_pcm[i * FRAME_SAMPLES];
+        }
+    }
+    return s_slot_pcm && s_rx_buf && s_rx_pcm && s_tx_pkt && s_tx_pcm && s_play_pcm && s_lock && s_done_sem;
+}
+
+static bool audio_stream_task(TaskFunction_t fn, const char *name)
+{
+    if (xTaskCreate(fn, name, AUDIO_STREAM_TASK_STACK_SIZE, NULL, AUDIO_STREAM_TASK_PRIORITY, NULL) != pdPASS) {
+        return false;
+    }
+    s_task_num++;
+    return true;
+}
+
+static void audio_stream_join(void)
+{
+    s_stop = true;
+    for (; s_task_num > 0; s_task_num--) {
+        xSemaphoreTake(s_done_sem, portMAX_DELAY);
+    }
+    close(s_sock);
+    s_sock = -1;
+    speaker_codec_dev_resume();
+}
+
+esp_err_t audio_stream_start(const audio_stream_config_t *config)
+{
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!config || (!config->send && !config->receive) || config->codec > AUDIO_STREAM_CODEC_DVI4 ||
+        (config->send && !config->peer_ip && !config->receive)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(&s_peer, 0, sizeof(s_peer));
+    s_peer.sin_family = AF_INET;
+    s_peer.sin_port = htons(config->peer_port ? config->peer_port : AUDIO_STREAM_PORT);
+    s_peer_known = false;
+    if (config->peer_ip) {
+        s_peer.sin_addr.s_addr = inet_addr(config->peer_ip);
+        if (s_peer.sin_addr.s_addr == IPADDR_NONE) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        s_peer_known = true;
+    }
+
+    if (!audio_stream_alloc()) {
+        ESP_LOGE(TAG, "Failed to allocate buffers");
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s_sock < 0) {
+        ESP_LOGE(TAG, "Unable to create socket: errno %d", errno);
+        return ESP_FAIL;
+    }
+    struct sockaddr_in local_addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(AUDIO_STREAM_PORT),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    struct timeval rcv_to = { .tv_sec = 0, .tv_usec = RX_TIMEOUT_MS * 1000 };
+    setsockopt(s_sock, SOL_SOCKET, SO_RCVTIMEO, &rcv_to, sizeof(rcv_to));
+    if (bind(s_sock, (struct sockaddr *)&local_addr, sizeof(local_addr)) < 0) {
+        ESP_LOGE(TAG, "Socket unable to bind: errno %d", errno);
+        close(s_sock);
+        s_sock = -1;
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_config = *config;
+    s_rx_started = false;
+    s_target_frames = AUDIO_STREAM_JB_MIN_MS / AUDIO_STREAM_FRAME_MS;
+    memset(s_plc_hist, 0, sizeof(s_plc_hist));
+    s_plc_run = AUDIO_STREAM_PLC_FRAMES;    // Silence until the first frame
+    s_delay_sum_ms = 0;
+    s_delay_cnt = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+    xSemaphoreGive(s_lock);
+
+    speaker_codec_set_fs(AUDIO_STREAM_SAMPLE_RATE, 16, I2S_SLOT_MODE_MONO);
+
+    s_stop = false;
+    if ((config->receive && (!audio_stream_task(audio_stream_rx_task, "rtp_rx") || !audio_stream_task(audio_stream_play_task, "rtp_play"))) ||
+        (config->send && !audio_stream_task(audio_stream_tx_task, "rtp_tx"))) {
+        audio_stream_join();
+        return ESP_ERR_NO_MEM;
+    }
+    s_running = true;
+
+    ESP_LOGI(TAG, "Started on port %d, %s%s, payload type %d", AUDIO_STREAM_PORT,
+             config->send ? "send" : "", config->receive ? (config->send ? " and receive" : "receive") : "",
+             audio_stream_payload_type(config->codec));
+    return ESP_OK;
+}
+
+esp_err_t audio_stream_stop(void)
+{
+    if (!s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    audio_stream_join();
+    s_running = false;
+    audio_stream_log_stats();
+    return ESP_OK;
+}
+
+bool audio_stream_is_running(void)
+{
+    return s_running;
+}
+
+void audio_stream_get_stats(audio_stream_stats_t *stats)
+{
+    if (!s_lock) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *stats = s_stats;
+    if (s_rx_started) {
+        const uint32_t expected = s_ext_max - s_ext_base + 1;
+        stats->rx_packets = s_received;
+        stats->rx_lost = (expected > s_received) ? expected - s_received : 0;
+        stats->loss_permille = (uint32_t)((uint64_t)stats->rx_lost * 1000 / expected);
+        stats->jitter_us = (uint32_t)((uint64_t)(s_jitter_q4 >> 4) * 1000000 / AUDIO_STREAM_SAMPLE_RATE);
+    }
+    stats->target_ms = s_target_frames * AUDIO_STREAM_FRAME_MS;
+    stats->delay_avg_ms = s_delay_cnt ? (uint32_t)(s_delay_sum_ms / s_delay_cnt) : 0;
+    xSemaphoreGive(s_lock);
+}
+
+void audio_stream_log_stats(void)
+{
+    audio_stream_stats_t stats;
+    audio_stream_get_stats(&stats);
+
+    ESP_LOGI(TAG, "tx %" PRIu32 " packets, %" PRIu32 " errors; rx %" PRIu32 " packets, lost %" PRIu32 " (%" PRIu32 ".%" PRIu32 "%%), "
+             "late %" PRIu32 ", duplicates %" PRIu32 ", invalid %" PRIu32,
+             stats.tx_packets, stats.tx_errors, stats.rx_packets, stats.rx_lost,
+             stats.loss_permille / 10, stats.loss_permille % 10, stats.rx_late, stats.rx_duplicates, stats.rx_invalid);
+    ESP_LOGI(TAG, "jitter %" PRIu32 " us, playout delay %" PRIu32 " ms, buffer delay avg %" PRIu32 " ms max %" PRIu32 " ms, "
+             "concealed %" PRIu32 ", underruns %" PRIu32 ", dropped %" PRIu32,
+             stats.jitter_us, stats.target_ms, stats.delay_avg_ms, stats.delay_max_ms,
+             stats.concealed_frames, stats.underruns, stats.dropped_frames);
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "esp_event.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
@@ -10,23 +12,109 @@
 #define EXAMPLE_SERVER_IP          "192.168.137.1"
 #define EXAMPLE_TCP_PORT           12345
 #define EXAMPLE_UDP_PORT           12346
+#define EXAMPLE_FRAME_PORT         12347   // TCP server port speaking net_frame.h frames instead of text
+
+// TCP server configuration
+#define NET_TCP_SERVER_MAX_CLIENTS          4       // More are refused, each takes one of the CONFIG_LWIP_MAX_SOCKETS
+#define NET_TCP_SERVER_TX_BUFS              4       // Per client: echoes and broadcast messages waiting for the socket, by pointer
+#define NET_TCP_SERVER_RX_BYTES             1436    // Largest single read of a text client, up to NET_FRAME_MAX_PAYLOAD
+#define NET_TCP_SERVER_READS_PER_WAKE       8       // Reads from one client before the others get a turn
+#define NET_TCP_SERVER_STALL_POLL_MS        10      // Retry interval while a client waits for a pool buffer
+#define NET_TCP_SERVER_UI_LOG_MS            200     // Shortest interval between two receives shown per client
+#define NET_UI_LOG_MAX_CHARS                100     // Characters of a receive shown on the screen
+
+// Outgoing TCP connection configuration
+#define NET_TCP_CLIENT_QUEUE_LEN            16      // Messages waiting for the connection, more are dropped
+#define NET_TCP_CLIENT_BATCH_BYTES          1436    // Largest single send, one MSS of the default lwIP config
+#define NET_TCP_CLIENT_BATCH_MSGS           NET_TCP_CLIENT_QUEUE_LEN
+#define NET_TCP_CLIENT_CONNECT_TIMEOUT_MS   5000
+#define NET_TCP_CLIENT_SEND_TIMEOUT_MS      2000    // A send blocked this long drops the connection
+#define NET_TCP_CLIENT_BACKOFF_MIN_MS       500     // First reconnect delay, doubled after each failure
+#define NET_TCP_CLIENT_BACKOFF_MAX_MS       30000
+#define NET_TCP_CLIENT_RETRY_POLL_MS        100     // Check interval while waiting to reconnect
+#define NET_TCP_CLIENT_IDLE_POLL_MS         100     // Check interval for data or a close from the server
+#define NET_TCP_CLIENT_KEEPALIVE_IDLE_S     10      // Idle time before the first keepalive probe
+#define NET_TCP_CLIENT_KEEPALIVE_INTVL_S    5
+#define NET_TCP_CLIENT_KEEPALIVE_COUNT      3       // Unanswered probes before the connection is dropped
+#define NET_TCP_CLIENT_INFLIGHT             8       // Sends tracked for the echo round trip
+#define NET_TCP_CLIENT_ECHO_TIMEOUT_MS      1000    // A send not echoed by then is no longer waited for, so a server that does not echo costs no polling
+#define NET_TCP_CLIENT_TASK_STACK_SIZE      (4 * 1024)
 
 // WiFi event group bits
 #define WIFI_CONNECTED_BIT BIT0
 #define WIFI_IP_UPDATED_BIT BIT1
 
+// net_send() paths
+#define NET_SEND_UDP    BIT0
+#define NET_SEND_TCP    BIT1
+
+/**
+ * @brief TCP server statistics
+ */
+typedef struct {
+    uint32_t clients;               // Connected now
+    uint32_t clients_peak;
+    uint32_t accepts;
+    uint32_t rejects;               // Connections refused while NET_TCP_SERVER_MAX_CLIENTS were connected
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;              // Echoes and messages
+    uint32_t tx_dropped;            // Messages a client missed because its queue was full
+    uint32_t wakeups;               // Returns from select()
+    uint32_t ui_skipped;            // Receives not shown on the screen
+} net_tcp_server_stats_t;
+
+/**
+ * @brief Outgoing TCP connection statistics
+ */
+typedef struct {
+    bool connected;
+    uint32_t messages;              // Messages sent
+    uint32_t batches;               // Sends they took
+    uint32_t queued;                // Messages waiting now
+    uint32_t dropped;               // Messages refused because the queue was full
+    uint32_t connects;
+    uint32_t connect_failures;
+    uint32_t disconnects;           // Connections closed by the server, an error or a failed send
+    uint32_t send_errors;
+    uint32_t backoff_ms;            // Delay before the next connect, 0 while connected
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;              // Data from the server, e.g. an echo
+    uint32_t latency_avg_us;        // From net_tcp_client_send() to the send that carried the message
+    uint32_t latency_max_us;
+    uint32_t rtt_cnt;               // Sends fully echoed by the server
+    uint32_t rtt_expired;           // Sends not echoed within NET_TCP_CLIENT_ECHO_TIMEOUT_MS
+    uint32_t rtt_avg_us;            // From a send to the last byte of its echo
+    uint32_t rtt_max_us;
+} net_tcp_client_stats_t;
+
 /**
  * @brief Initialize WiFi STA mode
  */
 void wifi_init_sta(void);
 
 /**
- * @brief Initialize SNTP service and sync time
+ * @brief Start the network time discipline, see time_sync.h
  */
 void initialize_sntp(void);
 
 /**
- * @brief Send TCP message
+ * @brief Send a message over UDP and/or TCP
+ *
+ * The text is copied once into a pool buffer, see net_buf.h. Every path queues a reference
+ * to that buffer, TCP goes to every client of the server or over the outgoing connection.
+ *
+ * @param msg String to send, up to NET_FRAME_MAX_PAYLOAD bytes
+ * @param paths NET_SEND_UDP, NET_SEND_TCP or both
+ * @return
+ *      - ESP_OK: Queued on every path
+ *      - ESP_ERR_INVALID_SIZE: Longer than NET_FRAME_MAX_PAYLOAD, nothing is sent
+ *      - ESP_ERR_NO_MEM: No free pool buffer
+ *      - ESP_FAIL: A queue was full, the other path still sends it
+ */
+esp_err_t net_send(const char *msg, uint32_t paths);
+
+/**
+ * @brief Send TCP message to every client of the server, over the outgoing connection when there is none
  * @param msg String to send
  */
 void app_send_tcp(const char *msg);
@@ -53,4 +141,44 @@ const char* net_get_last_ip(void);
 
 void net_start_udp_server(void);
 
+/**
+ * @brief Start the TCP server on EXAMPLE_TCP_PORT
+ *
+ * Serves up to NET_TCP_SERVER_MAX_CLIENTS at once from one task: what a client sends is
+ * echoed back to it, app_send_tcp() messages go to all of them. Clients of EXAMPLE_FRAME_PORT
+ * exchange net_frame.h frames, received into pool buffers and echoed from the same buffers.
+ */
 void net_start_tcp_server(void);
+
+/**
+ * @brief Get the TCP server statistics
+ * @param stats Output statistics
+ */
+void net_tcp_server_get_stats(net_tcp_server_stats_t *stats);
+
+/**
+ * @brief Log the TCP server statistics
+ */
+void net_tcp_server_log_stats(void);
+
+/**
+ * @brief Queue a message for the server at EXAMPLE_SERVER_IP, or the learned one, port EXAMPLE_TCP_PORT
+ *
+ * One connection is kept open and reconnected with exponential backoff when it fails.
+ * Messages are newline terminated and those queued together go out in one send.
+ *
+ * @param msg String to send, up to NET_FRAME_MAX_PAYLOAD bytes
+ * @return true if queued, false if it is too long, no pool buffer is free or the queue is full
+ */
+bool net_tcp_client_send(const char *msg);
+
+/**
+ * @brief Get the outgoing TCP connection statistics
+ * @param stats Output statistics
+ */
+void net_tcp_client_get_stats(net_tcp_client_stats_t *stats);
+
+/**
+ * @brief Log the outgoing TCP connection statistics, with the message rate since the last call
+ */
+void net_tcp_client_log_stats(void);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Buffer pool configuration
+#define NET_BUF_SIZE                (4 + 4096 + 4)  // One frame with the largest payload, see net_frame.h
+#define NET_BUF_COUNT               32              // Shared by all sockets and send queues, allocated in PSRAM when present
+
+/**
+ * @brief Fixed size network buffer
+ *
+ * Passed between tasks by pointer. Each holder of a reference may read it, the one that
+ * allocated it writes it before handing it on. It returns to the pool with the last reference.
+ */
+typedef struct {
+    uint16_t len;                   // Bytes used in data
+    atomic_uint refs;
+    int64_t alloc_us;               // When it was taken from the pool, for queue latency
+    uint8_t data[NET_BUF_SIZE];
+} net_buf_t;
+
+/**
+ * @brief Buffer pool statistics
+ */
+typedef struct {
+    uint32_t count;                 // Buffers in the pool
+    uint32_t in_use;                // Taken now
+    uint32_t in_use_peak;
+    uint32_t allocs;
+    uint32_t exhausted;             // Allocations that found the pool empty
+    uint32_t shares;                // References added by net_buf_ref(), each a copy avoided
+    uint64_t shared_bytes;          // Bytes those copies would have moved
+} net_buf_stats_t;
+
+/**
+ * @brief Allocate the pool
+ *
+ * @return
+ *      - ESP_OK: Success (also when it is allocated already)
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t net_buf_init(void);
+
+/**
+ * @brief Take a buffer from the pool
+ *
+ * @param timeout_ms How long to wait for one to be freed, 0 to return at once
+ * @return The buffer with len 0 and one reference, NULL if none was free
+ */
+net_buf_t *net_buf_alloc(uint32_t timeout_ms);
+
+/**
+ * @brief Add a reference, to hand the same buffer to one more task or queue
+ *
+ * @param buf Buffer
+ * @return buf
+ */
+net_buf_t *net_buf_ref(net_buf_t *buf);
+
+/**
+ * @brief Drop a reference, the last one returns the buffer to the pool
+ *
+ * @param buf Buffer, may be NULL
+ */
+void net_buf_free(net_buf_t *buf);
+
+/**
+ * @brief Get the pool statistics
+ *
+ * @param stats Output statistics
+ */
+void net_buf_get_stats(net_buf_stats_t *stats);
+
+/**
+ * @brief Log the pool statistics
+ */
+void net_buf_log_stats(void);
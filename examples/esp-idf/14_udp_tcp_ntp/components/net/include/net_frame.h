@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "net_buf.h"
+
+// Frame format: sync, type, payload length (big-endian), payload, CRC-32 (big-endian)
+// The CRC is the zlib one over type, length and payload
+#define NET_FRAME_SYNC              0xA5
+#define NET_FRAME_HEADER_SIZE       4
+#define NET_FRAME_CRC_SIZE          4
+#define NET_FRAME_MAX_PAYLOAD       (NET_BUF_SIZE - NET_FRAME_HEADER_SIZE - NET_FRAME_CRC_SIZE)
+
+// Frame types
+#define NET_FRAME_TYPE_TEXT         1       // Shown on the screen and echoed
+#define NET_FRAME_TYPE_ECHO         2       // Echoed unchanged
+#define NET_FRAME_TYPE_DATA         3       // Counted and dropped, for one way throughput
+
+/**
+ * @brief Framing statistics, all sockets together
+ */
+typedef struct {
+    uint32_t rx_frames;
+    uint64_t rx_bytes;              // Payload of the received frames
+    uint32_t tx_frames;             // Frames sealed for sending
+    uint32_t crc_errors;
+    uint32_t resync_bytes;          // Bytes skipped looking for the next frame
+    uint64_t copied_bytes;          // Bytes moved between buffers because a read brought more than one frame
+    uint32_t stalls;                // Times a parser waited for a free buffer
+} net_frame_stats_t;
+
+/**
+ * @brief Incremental frame parser for a stream
+ *
+ * The socket reads straight into the pool buffer a frame is returned in. When one read brings
+ * several frames, the smaller side is copied: the frame out, or the bytes after it into a new buffer.
+ */
+typedef struct {
+    net_buf_t *buf;                 // Frame being received
+    size_t start;                   // Where it starts in buf
+    size_t have;                    // Bytes of it and anything after it in buf
+} net_frame_parser_t;
+
+/**
+ * @brief Get the payload of a frame
+ *
+ * @param buf Frame buffer
+ * @return Where the payload starts, also where it is written before net_frame_seal()
+ */
+static inline uint8_t *net_frame_payload(net_buf_t *buf)
+{
+    return buf->data + NET_FRAME_HEADER_SIZE;
+}
+
+/**
+ * @brief Get the type of a received frame
+ */
+static inline uint8_t net_frame_type(const net_buf_t *buf)
+{
+    return buf->data[1];
+}
+
+/**
+ * @brief Get the payload length of a received frame
+ */
+static inline size_t net_frame_payload_len(const net_buf_t *buf)
+{
+    return (size_t)((buf->data[2] << 8) | buf->data[3]);
+}
+
+/**
+ * @brief Write the header and the CRC around a payload, buf->len becomes the frame size
+ *
+ * @param buf Buffer with the payload at net_frame_payload()
+ * @param type Frame type
+ * @param len Payload length, up to NET_FRAME_MAX_PAYLOAD
+ */
+void net_frame_seal(net_buf_t *buf, uint8_t type, size_t len);
+
+/**
+ * @brief Check that data is exactly one valid frame, e.g. a datagram
+ *
+ * @param data Received data
+ * @param len Its length
+ * @return true if it is a frame
+ */
+bool net_frame_check(const uint8_t *data, size_t len);
+
+/**
+ * @brief Start a parser
+ *
+ * @param parser Parser
+ */
+void net_frame_parser_init(net_frame_parser_t *parser);
+
+/**
+ * @brief Free the buffer held by a parser and forget the partial frame
+ *
+ * @param parser Parser
+ */
+void net_frame_parser_reset(net_frame_parser_t *parser);
+
+/**
+ * @brief Get where the next bytes of the stream go
+ *
+ * @param parser Parser
+ * @param len Output, how many bytes fit
+ * @return Where to read to, NULL while no buffer is free or a complete frame waits for
+ *         net_frame_parser_push()
+ */
+uint8_t *net_frame_parser_space(net_frame_parser_t *parser, size_t *len);
+
+/**
+ * @brief Take bytes read to net_frame_parser_space() and return the next complete frame
+ *
+ * Call again with len 0 until it returns NULL, one read may hold several frames.
+ *
+ * @param parser Parser
+ * @param len Bytes read
+ * @return A frame, owned by the caller until net_buf_free(), NULL if none is complete
+ */
+net_buf_t *net_frame_parser_push(net_frame_parser_t *parser, size_t len);
+
+/**
+ * @brief Get the framing statistics
+ *
+ * @param stats Output statistics
+ */
+void net_frame_get_stats(net_frame_stats_t *stats);
@@ -4,6 +4,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <sys/select.h>
+#include <sys/param.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
@@ -12,14 +13,19 @@
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "esp_log.h"
-#include "esp_sntp.h"
+#include "esp_timer.h"
+#include "esp_random.h"
 #include "lwip/err.h"
 #include "lwip/sys.h"
 #include "lwip/sockets.h"
 #include "lwip/netdb.h"
 
 #include "net.h"
+#include "net_buf.h"
+#include "net_frame.h"
 #include "ui_app.h" // Used for ui_log and ui_update_ip
+#include "rtc_service.h"
+#include "time_sync.h"
 
 static const char *TAG = "net";
 
@@ -28,31 +34,42 @@ static EventGroupHandle_t s_wifi_event_group;
 static struct sockaddr_in s_learned_server_addr; // Used to save the learned server address
 static bool s_ip_learned = false;               // Whether the IP has been learned
 static char s_last_ip[IP4ADDR_STRLEN_MAX] = "Failed";
-static QueueHandle_t s_net_work_q = NULL;
+static QueueHandle_t s_net_work_q = NULL;            // Messages for UDP, by net_buf_t pointer
 static TaskHandle_t s_tcp_server_task_handle = NULL;
-static QueueHandle_t s_tcp_tx_q = NULL;
-static volatile bool s_tcp_client_connected = false;
+static QueueHandle_t s_tcp_tx_q = NULL;              // Messages for the TCP server clients, by net_buf_t pointer
+static volatile int s_tcp_server_clients = 0;        // Clients connected to the TCP server
+static int s_tcp_wake_rx = -1;
+static int s_tcp_wake_tx = -1;
+static volatile bool s_tcp_wake_pending = false;
+static net_tcp_server_stats_t s_tcp_server_stats;
+static QueueHandle_t s_tcp_client_q = NULL;          // Messages for the outgoing connection, by net_buf_t pointer
+static net_tcp_client_stats_t s_tcp_client_stats;
+static uint64_t s_tcp_client_latency_sum_us = 0;
+static uint64_t s_tcp_client_rtt_sum_us = 0;
 
 void udp_server_task(void *pvParameters);
 static void tcp_server_task(void *pvParameters);
 
-typedef enum {
-    NET_WORK_TCP = 0,
-    NET_WORK_UDP = 1,
-} net_work_kind_t;
-
-typedef struct {
-    net_work_kind_t kind;
-    char payload[256];
-} net_work_item_t;
-
-typedef struct {
-    char payload[256];
-} net_tcp_tx_item_t;
-
 static void net_tcp_txq_start(void)
 {
-    s_tcp_tx_q ? (void)0 : (void)(s_tcp_tx_q = xQueueCreate(8, sizeof(net_tcp_tx_item_t)));
+    s_tcp_tx_q ? (void)0 : (void)(s_tcp_tx_q = xQueueCreate(8, sizeof(net_buf_t *)));
+}
+
+// A message is kept as a sealed text frame: a framed client is sent all of it, anything else its payload
+static esp_err_t net_msg_new(const char *msg, net_buf_t **out)
+{
+    const size_t len = msg ? strlen(msg) : 0;
+    if (len > NET_FRAME_MAX_PAYLOAD) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    net_buf_t *buf = net_buf_alloc(0);
+    if (!buf) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(net_frame_payload(buf), msg ? msg : "", len);
+    net_frame_seal(buf, NET_FRAME_TYPE_TEXT, len);
+    *out = buf;
+    return ESP_OK;
 }
 
 static int net_set_nonblocking(int sock, bool enable)
@@ -118,36 +135,312 @@ static struct sockaddr_in net_get_dest_addr(uint16_t port)
     return dest_addr;
 }
 
-static void net_do_send_tcp(const char *msg)
+/**************************************************************************************************
+ *
+ * Outgoing TCP Connection
+ *
+ **************************************************************************************************/
+
+// Connection state, owned by the client task
+typedef struct {
+    int sock;
+    uint32_t backoff_ms;
+    int64_t retry_at_us;
+    uint64_t sent_bytes;        // Stream offset of the next byte sent
+    uint64_t echoed_bytes;      // Stream offset of the next byte received
+    struct {
+        uint64_t end;           // Stream offset just past the batch
+        int64_t sent_us;
+    } inflight[NET_TCP_CLIENT_INFLIGHT];
+    uint32_t inflight_head;
+    uint32_t inflight_cnt;
+    size_t batch_len;           // Bytes of the batch, newlines included
+    uint32_t batch_msgs;
+    net_buf_t *batch[NET_TCP_CLIENT_BATCH_MSGS];
+} net_tcp_client_t;
+
+static void net_tcp_client_close(net_tcp_client_t *c, bool failed)
 {
-    if (!(xEventGroupGetBits(s_wifi_event_group) & WIFI_CONNECTED_BIT)) {
-        ui_log("[TCP] WiFi Not Connected");
-        return;
+    if (c->sock >= 0) {
+        close(c->sock);
+        c->sock = -1;
+        s_tcp_client_stats.disconnects++;
+        s_tcp_client_stats.connected = false;
+        ui_log("[TCP] Connection to server closed");
+    }
+    c->inflight_cnt = 0;
+    if (failed) {
+        // Exponential backoff with +-25% jitter, so boards that lost the server together do not retry in step
+        const uint32_t jitter = c->backoff_ms / 2;
+        const uint32_t wait_ms = c->backoff_ms - jitter / 2 + (jitter ? esp_random() % jitter : 0);
+        c->retry_at_us = esp_timer_get_time() + (int64_t)wait_ms * 1000;
+        s_tcp_client_stats.backoff_ms = wait_ms;
+        c->backoff_ms = (c->backoff_ms * 2 > NET_TCP_CLIENT_BACKOFF_MAX_MS) ? NET_TCP_CLIENT_BACKOFF_MAX_MS : c->backoff_ms * 2;
+    }
+}
+
+static bool net_tcp_client_connect(net_tcp_client_t *c)
+{
+    if (!(xEventGroupGetBits(s_wifi_event_group) & WIFI_CONNECTED_BIT) || esp_timer_get_time() < c->retry_at_us) {
+        return false;
     }
 
     struct sockaddr_in dest_addr = net_get_dest_addr(EXAMPLE_TCP_PORT);
-
     const int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
     if (sock < 0) {
-        ui_log("[TCP] Unable to create socket: errno %d", errno);
-        return;
+        ESP_LOGE(TAG, "[TCP] Unable to create socket: errno %d", errno);
+        s_tcp_client_stats.connect_failures++;
+        net_tcp_client_close(c, true);
+        return false;
     }
 
-    const int err = net_connect_with_timeout(sock, (struct sockaddr *)&dest_addr, sizeof(dest_addr), 5000);
-    if (err != 0) {
-        ui_log("[TCP] Socket unable to connect: errno %d", errno);
+    if (net_connect_with_timeout(sock, (struct sockaddr *)&dest_addr, sizeof(dest_addr), NET_TCP_CLIENT_CONNECT_TIMEOUT_MS) != 0) {
+        ESP_LOGW(TAG, "[TCP] Unable to connect to %s: errno %d", inet_ntoa(dest_addr.sin_addr), errno);
+        s_tcp_client_stats.connect_failures++;
         close(sock);
-        return;
+        net_tcp_client_close(c, true);
+        return false;
     }
 
-    const int sent = send(sock, msg, strlen(msg), 0);
-    (sent < 0) ? ui_log("[TCP] Error occurred during sending: errno %d", errno)
-               : ui_log("[TCP] Sent");
+    // Keepalive notices a server that vanished while the connection was idle,
+    // Nagle is off since the batches are as large as they get already
+    int on = 1;
+    int idle = NET_TCP_CLIENT_KEEPALIVE_IDLE_S;
+    int intvl = NET_TCP_CLIENT_KEEPALIVE_INTVL_S;
+    int cnt = NET_TCP_CLIENT_KEEPALIVE_COUNT;
+    struct timeval snd_to = {
+        .tv_sec = NET_TCP_CLIENT_SEND_TIMEOUT_MS / 1000,
+        .tv_usec = (NET_TCP_CLIENT_SEND_TIMEOUT_MS % 1000) * 1000,
+    };
+    setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPINTVL, &intvl, sizeof(intvl));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &snd_to, sizeof(snd_to));
+
+    c->sock = sock;
+    c->backoff_ms = NET_TCP_CLIENT_BACKOFF_MIN_MS;
+    c->sent_bytes = 0;
+    c->echoed_bytes = 0;
+    c->inflight_cnt = 0;
+    s_tcp_client_stats.connects++;
+    s_tcp_client_stats.connected = true;
+    s_tcp_client_stats.backoff_ms = 0;
+    ui_log("[TCP] Connected to %s", inet_ntoa(dest_addr.sin_addr));
+    return true;
+}
+
+// Read what the server sent back, an echo server closes the round trip of the batches
+static void net_tcp_client_drain(net_tcp_client_t *c)
+{
+    char rx[256];
+    while (c->sock >= 0) {
+        const int len = recv(c->sock, rx, sizeof(rx), MSG_DONTWAIT);
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (len <= 0) {
+            net_tcp_client_close(c, len < 0);
+            return;
+        }
 
-    close(sock);
+        const int64_t now = esp_timer_get_time();
+        s_tcp_client_stats.rx_bytes += len;
+        c->echoed_bytes += len;
+        while (c->inflight_cnt > 0 && c->echoed_bytes >= c->inflight[c->inflight_head].end) {
+            const uint32_t rtt_us = (uint32_t)(now - c->inflight[c->inflight_head].sent_us);
+            s_tcp_client_rtt_sum_us += rtt_us;
+            s_tcp_client_stats.rtt_cnt++;
+            s_tcp_client_stats.rtt_max_us = (rtt_us > s_tcp_client_stats.rtt_max_us) ? rtt_us : s_tcp_client_stats.rtt_max_us;
+            c->inflight_head = (c->inflight_head + 1) % NET_TCP_CLIENT_INFLIGHT;
+            c->inflight_cnt--;
+        }
+    }
+}
+
+// Stop waiting for echoes that are overdue, the server may not echo at all
+static void net_tcp_client_expire(net_tcp_client_t *c)
+{
+    const int64_t now = esp_timer_get_time();
+    while (c->inflight_cnt > 0 && now - c->inflight[c->inflight_head].sent_us > NET_TCP_CLIENT_ECHO_TIMEOUT_MS * 1000LL) {
+        s_tcp_client_stats.rtt_expired++;
+        c->inflight_head = (c->inflight_head + 1) % NET_TCP_CLIENT_INFLIGHT;
+        c->inflight_cnt--;
+    }
+}
+
+// Send the batch straight from the message buffers, it stays pending when the connection fails
+static void net_tcp_client_flush(net_tcp_client_t *c)
+{
+    static char newline[] = "\n";
+    struct iovec iov[2 * NET_TCP_CLIENT_BATCH_MSGS];
+    for (size_t off = 0; off < c->batch_len; ) {
+        // Each message and its newline, less what went out already
+        int cnt = 0;
+        size_t skip = off;
+        for (uint32_t i = 0; i < c->batch_msgs; i++) {
+            const struct iovec parts[2] = {
+                { .iov_base = net_frame_payload(c->batch[i]), .iov_len = net_frame_payload_len(c->batch[i]) },
+                { .iov_base = newline, .iov_len = 1 },
+            };
+            for (int k = 0; k < 2; k++) {
+                if (skip >= parts[k].iov_len) {
+                    skip -= parts[k].iov_len;
+                    continue;
+                }
+                iov[cnt].iov_base = (uint8_t *)parts[k].iov_base + skip;
+                iov[cnt].iov_len = parts[k].iov_len - skip;
+                skip = 0;
+                cnt++;
+            }
+        }
+
+        const struct msghdr msg = { .msg_iov = iov, .msg_iovlen = cnt };
+        const int sent = sendmsg(c->sock, &msg, 0);
+        if (sent < 0) {
+            // What went out may be lost with the connection, the batch is sent again in full
+            ESP_LOGW(TAG, "[TCP] Send failed: errno %d", errno);
+            s_tcp_client_stats.send_errors++;
+            net_tcp_client_close(c, true);
+            return;
+        }
+        off += sent;
+    }
+
+    const int64_t now = esp_timer_get_time();
+    c->sent_bytes += c->batch_len;
+    if (c->inflight_cnt < NET_TCP_CLIENT_INFLIGHT) {
+        const uint32_t i = (c->inflight_head + c->inflight_cnt) % NET_TCP_CLIENT_INFLIGHT;
+        c->inflight[i].end = c->sent_bytes;
+        c->inflight[i].sent_us = now;
+        c->inflight_cnt++;
+    }
+    for (uint32_t i = 0; i < c->batch_msgs; i++) {
+        const uint32_t latency_us = (uint32_t)(now - c->batch[i]->alloc_us);
+        s_tcp_client_latency_sum_us += latency_us;
+        s_tcp_client_stats.latency_max_us = (latency_us > s_tcp_client_stats.latency_max_us) ? latency_us : s_tcp_client_stats.latency_max_us;
+        net_buf_free(c->batch[i]);
+    }
+    s_tcp_client_stats.messages += c->batch_msgs;
+    s_tcp_client_stats.batches++;
+    s_tcp_client_stats.tx_bytes += c->batch_len;
+    c->batch_len = 0;
+    c->batch_msgs = 0;
+}
+
+// Add a message and its newline, false when the batch is full. A message larger than a batch goes alone
+static bool net_tcp_client_append(net_tcp_client_t *c, net_buf_t *msg)
+{
+    const size_t len = net_frame_payload_len(msg) + 1;
+    if (c->batch_msgs == NET_TCP_CLIENT_BATCH_MSGS || (c->batch_msgs > 0 && c->batch_len + len > NET_TCP_CLIENT_BATCH_BYTES)) {
+        return false;
+    }
+    c->batch[c->batch_msgs++] = msg;
+    c->batch_len += len;
+    return true;
+}
+
+static void net_tcp_client_task(void *pvParameters)
+{
+    static net_tcp_client_t c = { .sock = -1, .backoff_ms = NET_TCP_CLIENT_BACKOFF_MIN_MS };
+    net_buf_t *item = NULL;
+    bool item_pending = false;
+
+    while (1) {
+        if (!item_pending) {
+            // Connect lazily; while an echo is awaited poll every tick, so the round trip is measured to the ms
+            net_tcp_client_expire(&c);
+            const TickType_t wait = (c.batch_len > 0) ? 0 :
+                                    (c.sock < 0) ? portMAX_DELAY :
+                                    (c.inflight_cnt > 0) ? 1 : pdMS_TO_TICKS(NET_TCP_CLIENT_IDLE_POLL_MS);
+            item_pending = (xQueueReceive(s_tcp_client_q, &item, wait) == pdTRUE);
+        }
+        net_tcp_client_drain(&c);
+
+        if (!item_pending && c.batch_len == 0) {
+            continue;
+        }
+        if (c.sock < 0 && !net_tcp_client_connect(&c)) {
+            // Messages wait in the queue meanwhile, new ones are dropped once it is full
+            vTaskDelay(pdMS_TO_TICKS(NET_TCP_CLIENT_RETRY_POLL_MS));
+            continue;
+        }
+
+        // Whatever is queued by now goes out in one send
+        while (item_pending && net_tcp_client_append(&c, item)) {
+            item_pending = (xQueueReceive(s_tcp_client_q, &item, 0) == pdTRUE);
+        }
+        net_tcp_client_flush(&c);
+    }
+}
+
+static void net_tcp_client_start(void)
+{
+    if (!s_tcp_client_q) {
+        s_tcp_client_q = xQueueCreate(NET_TCP_CLIENT_QUEUE_LEN, sizeof(net_buf_t *));
+        s_tcp_client_q ? (void)xTaskCreate(net_tcp_client_task, "tcp_client", NET_TCP_CLIENT_TASK_STACK_SIZE, NULL, 6, NULL) : (void)0;
+    }
+}
+
+// Queue a message buffer for the outgoing connection, which takes a reference of its own
+static bool net_tcp_client_put(net_buf_t *msg)
+{
+    net_tcp_client_start();
+    net_buf_ref(msg);
+    if (!s_tcp_client_q || xQueueSend(s_tcp_client_q, &msg, 0) != pdTRUE) {
+        net_buf_free(msg);
+        s_tcp_client_stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool net_tcp_client_send(const char *msg)
+{
+    net_buf_t *buf = NULL;
+    if (net_msg_new(msg, &buf) != ESP_OK) {
+        s_tcp_client_stats.dropped++;
+        return false;
+    }
+    const bool queued = net_tcp_client_put(buf);
+    net_buf_free(buf);
+    return queued;
+}
+
+void net_tcp_client_get_stats(net_tcp_client_stats_t *stats)
+{
+    *stats = s_tcp_client_stats;
+    stats->queued = s_tcp_client_q ? uxQueueMessagesWaiting(s_tcp_client_q) : 0;
+    stats->latency_avg_us = stats->messages ? (uint32_t)(s_tcp_client_latency_sum_us / stats->messages) : 0;
+    stats->rtt_avg_us = stats->rtt_cnt ? (uint32_t)(s_tcp_client_rtt_sum_us / stats->rtt_cnt) : 0;
+}
+
+void net_tcp_client_log_stats(void)
+{
+    static int64_t last_us = 0;
+    static uint32_t last_messages = 0;
+    net_tcp_client_stats_t st;
+    net_tcp_client_get_stats(&st);
+
+    // Rate since the last call
+    const int64_t now = esp_timer_get_time();
+    const uint32_t rate = (last_us && now > last_us) ? (uint32_t)((uint64_t)(st.messages - last_messages) * 1000000 / (uint64_t)(now - last_us)) : 0;
+    last_us = now;
+    last_messages = st.messages;
+
+    ESP_LOGI(TAG, "[TCP] %s, %lu msgs (%lu/s) in %lu sends, %lu queued, %lu dropped",
+             st.connected ? "Connected" : "Closed", (unsigned long)st.messages, (unsigned long)rate,
+             (unsigned long)st.batches, (unsigned long)st.queued, (unsigned long)st.dropped);
+    ESP_LOGI(TAG, "[TCP] %lu connects, %lu failed, %lu closed, %lu send errors, backoff %lu ms",
+             (unsigned long)st.connects, (unsigned long)st.connect_failures, (unsigned long)st.disconnects,
+             (unsigned long)st.send_errors, (unsigned long)st.backoff_ms);
+    ESP_LOGI(TAG, "[TCP] Queue to wire avg %lu us max %lu us, echo round trip avg %lu us max %lu us, %lu not echoed",
+             (unsigned long)st.latency_avg_us, (unsigned long)st.latency_max_us,
+             (unsigned long)st.rtt_avg_us, (unsigned long)st.rtt_max_us, (unsigned long)st.rtt_expired);
 }
 
-static void net_do_send_udp(const char *msg)
+static void net_do_send_udp(net_buf_t *msg)
 {
     if (!(xEventGroupGetBits(s_wifi_event_group) & WIFI_CONNECTED_BIT)) {
         ui_log("[UDP] WiFi Not Connected");
@@ -162,7 +455,7 @@ static void net_do_send_udp(const char *msg)
         return;
     }
 
-    const int err = sendto(sock, msg, strlen(msg), 0, (struct sockaddr *)&dest_addr, sizeof(dest_addr));
+    const int err = sendto(sock, net_frame_payload(msg), net_frame_payload_len(msg), 0, (struct sockaddr *)&dest_addr, sizeof(dest_addr));
     (err < 0) ? ui_log("[UDP] Error occurred during sending: errno %d", errno)
               : ui_log("[UDP] Sent");
 
@@ -171,12 +464,13 @@ static void net_do_send_udp(const char *msg)
 
 static void net_worker_task(void *pvParameters)
 {
-    net_work_item_t item;
+    net_buf_t *msg = NULL;
     while (1) {
-        if (xQueueReceive(s_net_work_q, &item, portMAX_DELAY) != pdTRUE) {
+        if (xQueueReceive(s_net_work_q, &msg, portMAX_DELAY) != pdTRUE) {
             continue;
         }
-        (item.kind == NET_WORK_TCP) ? net_do_send_tcp(item.payload) : net_do_send_udp(item.payload);
+        net_do_send_udp(msg);
+        net_buf_free(msg);
     }
 }
 
@@ -184,7 +478,7 @@ static void net_worker_start(void)
 {
     static bool started = false;
     if (!s_net_work_q) {
-        s_net_work_q = xQueueCreate(8, sizeof(net_work_item_t));
+        s_net_work_q = xQueueCreate(8, sizeof(net_buf_t *));
     }
     if (!started && s_net_work_q) {
         xTaskCreate(net_worker_task, "net_worker", 4096, NULL, 6, NULL);
@@ -192,6 +486,18 @@ static void net_worker_start(void)
     }
 }
 
+// Queue a message buffer for UDP, the worker takes a reference of its own
+static bool net_worker_put(net_buf_t *msg)
+{
+    net_worker_start();
+    net_buf_ref(msg);
+    if (!s_net_work_q || xQueueSend(s_net_work_q, &msg, 0) != pdTRUE) {
+        net_buf_free(msg);
+        return false;
+    }
+    return true;
+}
+
 const char* net_get_last_ip(void)
 {
     return s_last_ip;
@@ -232,13 +538,20 @@ static void event_handler(void* arg, esp_event_base_t event_base,
         esp_ip4addr_ntoa(&event->ip_info.ip, s_last_ip, IP4ADDR_STRLEN_MAX);
         ESP_LOGI(TAG, "got ip: %s", s_last_ip);
         xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT | WIFI_IP_UPDATED_BIT);
+        time_sync_request(); // Resync after a reconnect instead of waiting out the poll interval
     }
 }
 
 void udp_server_task(void *pvParameters) {
-    char rx_buffer[128];
     struct sockaddr_in local_addr;
 
+    // Datagrams up to a full frame are received into a pool buffer the task keeps
+    net_buf_t *rx = NULL;
+    while (!(rx = net_buf_alloc(1000))) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    char *rx_buffer = (char *)rx->data;
+
     while (1) {
         int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
         if (sock < 0) {
@@ -263,16 +576,12 @@ void udp_server_task(void *pvParameters) {
         while (1) {
             struct sockaddr_in source_addr;
             socklen_t socklen = sizeof(source_addr);
-            int len = recvfrom(sock, rx_buffer, sizeof(rx_buffer) - 1, 0, (struct sockaddr *)&source_addr, &socklen);
+            int len = recvfrom(sock, rx->data, sizeof(rx->data) - 1, 0, (struct sockaddr *)&source_addr, &socklen);
 
             if (len < 0) {
                 ESP_LOGE(TAG, "recvfrom failed: errno %d", errno);
                 break;
             } else {
-                rx_buffer[len] = 0; // Ensure the string is null-terminated
-                ui_log("[UDP] Recv: %s", rx_buffer);
-                ESP_LOGI(TAG, "Received %d bytes from %s:", len, inet_ntoa(source_addr.sin_addr));
-
                 // Smart learning: remember the sender's IP
                 if (!s_ip_learned || s_learned_server_addr.sin_addr.s_addr != source_addr.sin_addr.s_addr) {
                     s_learned_server_addr = source_addr;
@@ -280,10 +589,31 @@ void udp_server_task(void *pvParameters) {
                     ui_log("[NET] Learned Server IP: %s", inet_ntoa(source_addr.sin_addr));
                 }
 
-                // Add echo functionality: send back an ACK for whatever is received
-                char ack_msg[160];
-                snprintf(ack_msg, sizeof(ack_msg), "ESP32 ACK: %s", rx_buffer);
-                sendto(sock, ack_msg, strlen(ack_msg), 0, (struct sockaddr *)&source_addr, sizeof(source_addr));
+                // A frame is echoed as it came, from the buffer it was received in
+                if (net_frame_check(rx->data, len)) {
+                    sendto(sock, rx->data, len, 0, (struct sockaddr *)&source_addr, sizeof(source_addr));
+                    continue;
+                }
+
+                ESP_LOGI(TAG, "Received %d bytes from %s:", len, inet_ntoa(source_addr.sin_addr));
+
+                // Add echo functionality: send back an ACK for whatever is received, gathered from the receive buffer
+                static char ack[] = "ESP32 ACK: ";
+                struct iovec iov[2] = {
+                    { .iov_base = ack, .iov_len = sizeof(ack) - 1 },
+                    { .iov_base = rx->data, .iov_len = len },
+                };
+                const struct msghdr ack_msg = {
+                    .msg_name = &source_addr,
+                    .msg_namelen = sizeof(source_addr),
+                    .msg_iov = iov,
+                    .msg_iovlen = 2,
+                };
+                sendmsg(sock, &ack_msg, 0);
+
+                // The buffer is this task's own until the next receive, so the text is cut in place and shown from there
+                rx_buffer[MIN(len, NET_UI_LOG_MAX_CHARS)] = 0;
+                ui_log_text("[UDP] Recv: ", rx_buffer);
             }
         }
 
@@ -293,109 +623,448 @@ void udp_server_task(void *pvParameters) {
     }
 }
 
-static void tcp_server_task(void *pvParameters)
+/**************************************************************************************************
+ *
+ * TCP Server
+ *
+ **************************************************************************************************/
+
+// One accepted client. What it is sent waits in a queue of pool buffers until the socket takes
+// it. Every buffer holds a sealed frame: a framed client gets all of it, a text client its payload
+typedef struct {
+    int sock;
+    bool framed;                // Connected to EXAMPLE_FRAME_PORT
+    struct sockaddr_in addr;
+    int64_t ui_log_us;          // Last receive shown on the screen
+    net_buf_t *rx;              // Text client: where the next read goes
+    net_frame_parser_t parser;  // Framed client: the frame being received
+    net_buf_t *tx_bufs[NET_TCP_SERVER_TX_BUFS];
+    uint8_t tx_head;
+    uint8_t tx_cnt;
+    uint16_t tx_off;            // Bytes of the first buffer already sent
+} net_tcp_conn_t;
+
+static net_tcp_conn_t s_tcp_conns[NET_TCP_SERVER_MAX_CLIENTS];
+
+// Loopback UDP pair, a datagram on it wakes the server out of select() when the TX queue has data
+static int net_tcp_wake_open(void)
 {
-    char rx_buffer[256];
-    struct sockaddr_in local_addr = { 0 };
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    socklen_t addr_len = sizeof(addr);
+
+    s_tcp_wake_rx = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    s_tcp_wake_tx = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    if (s_tcp_wake_rx < 0 || s_tcp_wake_tx < 0 ||
+        bind(s_tcp_wake_rx, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        getsockname(s_tcp_wake_rx, (struct sockaddr *)&addr, &addr_len) < 0 ||
+        connect(s_tcp_wake_tx, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        ESP_LOGE(TAG, "[TCP_SRV] Unable to open the wakeup socket: errno %d", errno);
+        (s_tcp_wake_rx >= 0) ? (void)close(s_tcp_wake_rx) : (void)0;
+        (s_tcp_wake_tx >= 0) ? (void)close(s_tcp_wake_tx) : (void)0;
+        s_tcp_wake_rx = s_tcp_wake_tx = -1;
+        return -1;
+    }
+    net_set_nonblocking(s_tcp_wake_rx, true);
+    net_set_nonblocking(s_tcp_wake_tx, true);
+    return 0;
+}
 
-    while (1) {
-        const int listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
-        if (listen_sock < 0) {
-            ESP_LOGE(TAG, "[TCP_SRV] Unable to create socket: errno %d", errno);
-            vTaskDelay(pdMS_TO_TICKS(1000));
-            continue;
+static void net_tcp_wake(void)
+{
+    // One datagram per batch of messages, the server clears the flag before it reads the queue
+    if (s_tcp_wake_tx >= 0 && !s_tcp_wake_pending) {
+        s_tcp_wake_pending = true;
+        send(s_tcp_wake_tx, "", 1, 0);
+    }
+}
+
+static bool net_tcp_conn_tx_full(const net_tcp_conn_t *conn)
+{
+    return conn->tx_cnt == NET_TCP_SERVER_TX_BUFS;
+}
+
+// Queue a buffer for sending, the reference passes to the connection
+static void net_tcp_conn_put(net_tcp_conn_t *conn, net_buf_t *buf)
+{
+    conn->tx_bufs[(conn->tx_head + conn->tx_cnt) % NET_TCP_SERVER_TX_BUFS] = buf;
+    conn->tx_cnt++;
+}
+
+static void net_tcp_conn_close(net_tcp_conn_t *conn)
+{
+    ui_log("[TCP] Client %s left", inet_ntoa(conn->addr.sin_addr));
+    close(conn->sock);
+    conn->sock = -1;
+    net_buf_free(conn->rx);
+    conn->rx = NULL;
+    net_frame_parser_reset(&conn->parser);
+    for (; conn->tx_cnt > 0; conn->tx_cnt--) {
+        net_buf_free(conn->tx_bufs[conn->tx_head]);
+        conn->tx_head = (conn->tx_head + 1) % NET_TCP_SERVER_TX_BUFS;
+    }
+    conn->tx_off = 0;
+    s_tcp_server_clients--;
+    s_tcp_server_stats.clients = s_tcp_server_clients;
+}
+
+// Send the queued buffers without blocking, false when the client is gone
+static bool net_tcp_conn_flush(net_tcp_conn_t *conn)
+{
+    while (conn->tx_cnt > 0) {
+        net_buf_t *buf = conn->tx_bufs[conn->tx_head];
+        const uint8_t *data = conn->framed ? buf->data : net_frame_payload(buf);
+        const size_t chunk = (conn->framed ? buf->len : net_frame_payload_len(buf)) - conn->tx_off;
+        const int sent = send(conn->sock, data + conn->tx_off, chunk, MSG_DONTWAIT);
+        if (sent < 0) {
+            return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+        }
+        s_tcp_server_stats.tx_bytes += sent;
+        if ((size_t)sent < chunk) {
+            conn->tx_off += sent;
+            break;
         }
+        net_buf_free(buf);
+        conn->tx_off = 0;
+        conn->tx_head = (conn->tx_head + 1) % NET_TCP_SERVER_TX_BUFS;
+        conn->tx_cnt--;
+    }
+    return true;
+}
 
-        int reuse = 1;
-        setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+// Hand the queued messages to every client by reference, a client with a full queue misses the message
+static void net_tcp_server_broadcast(void)
+{
+    net_buf_t *msg = NULL;
+    s_tcp_wake_pending = false;
+    while (xQueueReceive(s_tcp_tx_q, &msg, 0) == pdTRUE) {
+        for (int i = 0; i < NET_TCP_SERVER_MAX_CLIENTS; i++) {
+            net_tcp_conn_t *conn = &s_tcp_conns[i];
+            if (conn->sock < 0) {
+                continue;
+            }
+            net_tcp_conn_tx_full(conn) ? (void)s_tcp_server_stats.tx_dropped++ : net_tcp_conn_put(conn, net_buf_ref(msg));
+        }
+        net_buf_free(msg);
+    }
+}
 
-        local_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-        local_addr.sin_family = AF_INET;
-        local_addr.sin_port = htons(EXAMPLE_TCP_PORT);
+static void net_tcp_server_accept(int listen_sock, bool framed)
+{
+    struct sockaddr_in source_addr = { 0 };
+    socklen_t addr_len = sizeof(source_addr);
+    const int sock = accept(listen_sock, (struct sockaddr *)&source_addr, &addr_len);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "[TCP_SRV] accept failed: errno %d", errno);
+        return;
+    }
 
-        if (bind(listen_sock, (struct sockaddr *)&local_addr, sizeof(local_addr)) < 0) {
-            ESP_LOGE(TAG, "[TCP_SRV] bind failed: errno %d", errno);
-            close(listen_sock);
-            vTaskDelay(pdMS_TO_TICKS(1000));
-            continue;
+    net_tcp_conn_t *conn = NULL;
+    for (int i = 0; i < NET_TCP_SERVER_MAX_CLIENTS && !conn; i++) {
+        conn = (s_tcp_conns[i].sock < 0) ? &s_tcp_conns[i] : NULL;
+    }
+    if (!conn) {
+        // Full, refuse at once rather than leave the client waiting in the backlog
+        s_tcp_server_stats.rejects++;
+        close(sock);
+        return;
+    }
+
+    int on = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    net_set_nonblocking(sock, true);
+    conn->sock = sock;
+    conn->framed = framed;
+    conn->addr = source_addr;
+    conn->ui_log_us = 0;
+    conn->rx = NULL;
+    net_frame_parser_init(&conn->parser);
+    conn->tx_head = 0;
+    conn->tx_cnt = 0;
+    conn->tx_off = 0;
+
+    s_learned_server_addr = source_addr;
+    s_ip_learned = true;
+    s_tcp_server_clients++;
+    s_tcp_server_stats.accepts++;
+    s_tcp_server_stats.clients = s_tcp_server_clients;
+    s_tcp_server_stats.clients_peak = MAX(s_tcp_server_stats.clients_peak, s_tcp_server_stats.clients);
+    ui_log(framed ? "[TCP] Framed client: %s" : "[TCP] Client: %s", inet_ntoa(source_addr.sin_addr));
+}
+
+// Drawing every receive would pace the server by the LCD. Unlike UDP the text is formatted into a
+// copy: its pool buffer is shared with the echo sends of other clients, so it can't be cut in place,
+// and LVGL takes NUL-terminated text only. The copy is at most NET_UI_LOG_MAX_CHARS per
+// NET_TCP_SERVER_UI_LOG_MS, and LVGL copies the text into the text area anyway.
+static void net_tcp_conn_ui_log(net_tcp_conn_t *conn, const char *text, size_t len)
+{
+    const int64_t now = esp_timer_get_time();
+    if (now - conn->ui_log_us >= NET_TCP_SERVER_UI_LOG_MS * 1000) {
+        conn->ui_log_us = now;
+        ui_log("[TCP] Recv: %.*s", (int)MIN(len, NET_UI_LOG_MAX_CHARS), text);
+    } else {
+        s_tcp_server_stats.ui_skipped++;
+    }
+}
+
+// Whether select() should report the client readable: not while its echo has no room or no buffer is free
+static bool net_tcp_conn_wants_read(net_tcp_conn_t *conn)
+{
+    if (net_tcp_conn_tx_full(conn)) {
+        return false;
+    }
+    size_t room = 0;
+    if (conn->framed) {
+        return net_frame_parser_space(&conn->parser, &room) != NULL;
+    }
+    conn->rx = conn->rx ? conn->rx : net_buf_alloc(0);
+    return conn->rx != NULL;
+}
+
+// Echo what the client sent from the buffer it was read into, false when it is gone
+static bool net_tcp_conn_recv(net_tcp_conn_t *conn)
+{
+    // A few reads per wakeup, each echo sent on at once, so a busy client does not starve the others
+    for (int n = 0; n < NET_TCP_SERVER_READS_PER_WAKE && net_tcp_conn_wants_read(conn); n++) {
+        const int len = recv(conn->sock, net_frame_payload(conn->rx), NET_TCP_SERVER_RX_BYTES, MSG_DONTWAIT);
+        if (len < 0) {
+            return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+        }
+        if (len == 0) {
+            return false;
         }
 
-        if (listen(listen_sock, 2) < 0) {
-            ESP_LOGE(TAG, "[TCP_SRV] listen failed: errno %d", errno);
-            close(listen_sock);
+        s_tcp_server_stats.rx_bytes += len;
+        net_frame_seal(conn->rx, NET_FRAME_TYPE_TEXT, len);
+        net_tcp_conn_ui_log(conn, (const char *)net_frame_payload(conn->rx), len);
+        net_tcp_conn_put(conn, conn->rx);
+        conn->rx = NULL;
+
+        if (!net_tcp_conn_flush(conn)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Handle the frames the parser has complete, as long as their echo can be queued
+static void net_tcp_conn_parse(net_tcp_conn_t *conn, size_t len)
+{
+    net_buf_t *frame = (len == 0 && net_tcp_conn_tx_full(conn)) ? NULL : net_frame_parser_push(&conn->parser, len);
+    while (frame) {
+        switch (net_frame_type(frame)) {
+        case NET_FRAME_TYPE_TEXT:
+            net_tcp_conn_ui_log(conn, (const char *)net_frame_payload(frame), net_frame_payload_len(frame));
+            net_tcp_conn_put(conn, frame);
+            break;
+        case NET_FRAME_TYPE_ECHO:
+            // The frame goes back in the buffer it arrived in, header and CRC included
+            net_tcp_conn_put(conn, frame);
+            break;
+        default:
+            net_buf_free(frame);
+            break;
+        }
+        frame = net_tcp_conn_tx_full(conn) ? NULL : net_frame_parser_push(&conn->parser, 0);
+    }
+}
+
+// Parse and send in turns while the socket takes the echoes, false when the client is gone
+static bool net_tcp_conn_pump(net_tcp_conn_t *conn)
+{
+    while (1) {
+        net_tcp_conn_parse(conn, 0);
+        const uint8_t queued = conn->tx_cnt;
+        if (!net_tcp_conn_flush(conn)) {
+            return false;
+        }
+        // Done when the parser ran out of frames or the socket is full
+        if (queued < NET_TCP_SERVER_TX_BUFS || conn->tx_cnt == queued) {
+            return true;
+        }
+    }
+}
+
+// Read frames straight into pool buffers and echo them, false when the client is gone
+static bool net_tcp_conn_recv_frames(net_tcp_conn_t *conn)
+{
+    for (int n = 0; n < NET_TCP_SERVER_READS_PER_WAKE && !net_tcp_conn_tx_full(conn); n++) {
+        size_t room = 0;
+        uint8_t *dst = net_frame_parser_space(&conn->parser, &room);
+        if (!dst) {
+            return true;
+        }
+        const int len = recv(conn->sock, dst, room, MSG_DONTWAIT);
+        if (len < 0) {
+            return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+        }
+        if (len == 0) {
+            return false;
+        }
+
+        s_tcp_server_stats.rx_bytes += len;
+        net_tcp_conn_parse(conn, len);
+        if (!net_tcp_conn_pump(conn)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int net_tcp_server_listen(uint16_t port)
+{
+    struct sockaddr_in local_addr = { 0 };
+    const int listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    if (listen_sock < 0) {
+        ESP_LOGE(TAG, "[TCP_SRV] Unable to create socket: errno %d", errno);
+        return -1;
+    }
+
+    int reuse = 1;
+    setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    local_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    local_addr.sin_family = AF_INET;
+    local_addr.sin_port = htons(port);
+
+    if (bind(listen_sock, (struct sockaddr *)&local_addr, sizeof(local_addr)) < 0) {
+        ESP_LOGE(TAG, "[TCP_SRV] bind failed: errno %d", errno);
+        close(listen_sock);
+        return -1;
+    }
+
+    if (listen(listen_sock, NET_TCP_SERVER_MAX_CLIENTS) < 0) {
+        ESP_LOGE(TAG, "[TCP_SRV] listen failed: errno %d", errno);
+        close(listen_sock);
+        return -1;
+    }
+
+    net_set_nonblocking(listen_sock, true);
+    return listen_sock;
+}
+
+static void tcp_server_task(void *pvParameters)
+{
+    for (int i = 0; i < NET_TCP_SERVER_MAX_CLIENTS; i++) {
+        s_tcp_conns[i].sock = -1;
+    }
+    while (net_tcp_wake_open() != 0) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+
+    while (1) {
+        const int listen_sock = net_tcp_server_listen(EXAMPLE_TCP_PORT);
+        const int frame_sock = (listen_sock >= 0) ? net_tcp_server_listen(EXAMPLE_FRAME_PORT) : -1;
+        if (frame_sock < 0) {
+            (listen_sock >= 0) ? (void)close(listen_sock) : (void)0;
             vTaskDelay(pdMS_TO_TICKS(1000));
             continue;
         }
 
-        ui_log("[TCP] Server listening on port %d", EXAMPLE_TCP_PORT);
+        ui_log("[TCP] Server listening on port %d, framed on %d", EXAMPLE_TCP_PORT, EXAMPLE_FRAME_PORT);
 
         while (1) {
-            struct sockaddr_in source_addr = { 0 };
-            socklen_t addr_len = sizeof(source_addr);
-            const int sock = accept(listen_sock, (struct sockaddr *)&source_addr, &addr_len);
-            if (sock < 0) {
-                ESP_LOGE(TAG, "[TCP_SRV] accept failed: errno %d", errno);
-                break;
-            }
-
-            struct timeval rcv_to = { .tv_sec = 0, .tv_usec = 200 * 1000 };
-            struct timeval snd_to = { .tv_sec = 2, .tv_usec = 0 };
-            setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &rcv_to, sizeof(rcv_to));
-            setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &snd_to, sizeof(snd_to));
-
-            s_learned_server_addr = source_addr;
-            s_ip_learned = true;
-            s_tcp_client_connected = true;
-            ui_log("[TCP] Client: %s", inet_ntoa(source_addr.sin_addr));
-
-            while (1) {
-                net_tcp_tx_item_t tx;
-                for (int i = 0; i < 4; i++) {
-                    if (xQueueReceive(s_tcp_tx_q, &tx, 0) != pdTRUE) {
-                        break;
-                    }
-                    if (send(sock, tx.payload, strlen(tx.payload), 0) < 0) {
-                        i = 4;
-                        vTaskDelay(pdMS_TO_TICKS(10));
-                        goto tcp_close;
-                    }
+            // Sleep until a client, a new connection or the TX queue needs the task
+            fd_set rfds;
+            fd_set wfds;
+            FD_ZERO(&rfds);
+            FD_ZERO(&wfds);
+            FD_SET(listen_sock, &rfds);
+            FD_SET(frame_sock, &rfds);
+            FD_SET(s_tcp_wake_rx, &rfds);
+            int max_fd = MAX(MAX(listen_sock, frame_sock), s_tcp_wake_rx);
+            bool stalled = false;
+            for (int i = 0; i < NET_TCP_SERVER_MAX_CLIENTS; i++) {
+                net_tcp_conn_t *conn = &s_tcp_conns[i];
+                if (conn->sock < 0) {
+                    continue;
                 }
+                // A client is read only while its echo has room, a slow reader is not flooded
+                if (net_tcp_conn_wants_read(conn)) {
+                    FD_SET(conn->sock, &rfds);
+                } else {
+                    // Waiting for a free pool buffer is the one thing no socket reports
+                    stalled = stalled || !net_tcp_conn_tx_full(conn);
+                }
+                (conn->tx_cnt > 0) ? (void)FD_SET(conn->sock, &wfds) : (void)0;
+                max_fd = MAX(max_fd, conn->sock);
+            }
 
-                const int len = recv(sock, rx_buffer, sizeof(rx_buffer) - 1, 0);
-                if (len > 0) {
-                    rx_buffer[len] = 0;
-                    ui_log("[TCP] Recv: %s", rx_buffer);
-                    if (send(sock, rx_buffer, len, 0) < 0) {
-                        break;
-                    }
+            struct timeval retry = { .tv_sec = 0, .tv_usec = NET_TCP_SERVER_STALL_POLL_MS * 1000 };
+            const int sel = select(max_fd + 1, &rfds, &wfds, NULL, stalled ? &retry : NULL);
+            s_tcp_server_stats.wakeups++;
+            if (sel < 0) {
+                if (errno == EINTR) {
                     continue;
                 }
+                ESP_LOGE(TAG, "[TCP_SRV] select failed: errno %d", errno);
+                break;
+            }
 
-                if (len == 0) {
-                    break;
+            if (FD_ISSET(s_tcp_wake_rx, &rfds)) {
+                char wake[8];
+                while (recv(s_tcp_wake_rx, wake, sizeof(wake), MSG_DONTWAIT) > 0) {
                 }
+                net_tcp_server_broadcast();
+            }
+            if (FD_ISSET(listen_sock, &rfds)) {
+                net_tcp_server_accept(listen_sock, false);
+            }
+            if (FD_ISSET(frame_sock, &rfds)) {
+                net_tcp_server_accept(frame_sock, true);
+            }
 
-                const int e = errno;
-                if ((e == EAGAIN) || (e == EWOULDBLOCK)) {
-                    vTaskDelay(pdMS_TO_TICKS(10));
+            for (int i = 0; i < NET_TCP_SERVER_MAX_CLIENTS; i++) {
+                net_tcp_conn_t *conn = &s_tcp_conns[i];
+                if (conn->sock < 0) {
                     continue;
                 }
-
-                break;
+                // Frames parsed earlier whose echo had no room go first
+                bool alive = !conn->framed || net_tcp_conn_pump(conn);
+                alive = alive && (!FD_ISSET(conn->sock, &rfds) ||
+                                  (conn->framed ? net_tcp_conn_recv_frames(conn) : net_tcp_conn_recv(conn)));
+                // Send right away rather than wait for the next select() to report the socket writable
+                alive = alive && net_tcp_conn_flush(conn);
+                alive ? (void)0 : net_tcp_conn_close(conn);
             }
-
-tcp_close:
-            s_tcp_client_connected = false;
-            close(sock);
         }
 
+        for (int i = 0; i < NET_TCP_SERVER_MAX_CLIENTS; i++) {
+            (s_tcp_conns[i].sock >= 0) ? net_tcp_conn_close(&s_tcp_conns[i]) : (void)0;
+        }
         close(listen_sock);
+        close(frame_sock);
     }
 }
 
+void net_tcp_server_get_stats(net_tcp_server_stats_t *stats)
+{
+    *stats = s_tcp_server_stats;
+}
+
+void net_tcp_server_log_stats(void)
+{
+    const net_tcp_server_stats_t st = s_tcp_server_stats;
+    ESP_LOGI(TAG, "[TCP_SRV] %lu clients (peak %lu), %lu accepted, %lu refused, rx %llu bytes, tx %llu bytes",
+             (unsigned long)st.clients, (unsigned long)st.clients_peak, (unsigned long)st.accepts,
+             (unsigned long)st.rejects, (unsigned long long)st.rx_bytes, (unsigned long long)st.tx_bytes);
+    ESP_LOGI(TAG, "[TCP_SRV] %lu wakeups, %lu messages dropped on full queues, %lu receives not shown",
+             (unsigned long)st.wakeups, (unsigned long)st.tx_dropped, (unsigned long)st.ui_skipped);
+
+    net_frame_stats_t fs;
+    net_frame_get_stats(&fs);
+    ESP_LOGI(TAG, "[FRAME] rx %lu frames %llu bytes, tx %lu frames, %lu CRC errors, %lu bytes skipped, %llu bytes copied, %lu stalls",
+             (unsigned long)fs.rx_frames, (unsigned long long)fs.rx_bytes, (unsigned long)fs.tx_frames,
+             (unsigned long)fs.crc_errors, (unsigned long)fs.resync_bytes, (unsigned long long)fs.copied_bytes,
+             (unsigned long)fs.stalls);
+}
+
 void wifi_init_sta(void)
 {
     s_wifi_event_group = xEventGroupCreate();
+    ESP_ERROR_CHECK(net_buf_init());
     net_worker_start();
     net_tcp_txq_start();
 
@@ -435,45 +1104,69 @@ void wifi_init_sta(void)
     ui_log("Connecting to WiFi...");
 }
 
+static void net_time_sync_cb(bool ok, const time_sync_stats_t *stats)
+{
+    if (!ok) {
+        ui_log("[NTP] No server answered");
+        return;
+    }
+    ui_log("[NTP] Offset %ld us, drift %ld ppb, next sync in %lu s",
+           (long)stats->offset_us, (long)stats->freq_ppb, (unsigned long)stats->poll_s);
+}
+
 void initialize_sntp(void)
 {
-    ui_log("[NTP] Starting time sync...");
-    esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
-    esp_sntp_setservername(0, "ntp.ntsc.ac.cn");
-    esp_sntp_init();
-    
-    // Set timezone to China Standard Time
-    setenv("TZ", "CST-8", 1);
-    tzset();
+    ui_log(rtc_service_time_valid() ? "[NTP] Starting time sync, RTC time in use..." : "[NTP] Starting time sync...");
+    // Multi-server discipline: slews the clock, tracks the ESP32 and RTC drift and adapts the poll interval
+    ESP_ERROR_CHECK(time_sync_start(net_time_sync_cb));
+    // The time zone is set by rtc_service_init()
 }
 
-void app_send_tcp(const char *msg) {
+// To every client of the server, or over the outgoing connection when there is none
+static bool net_tcp_put(net_buf_t *msg)
+{
+    if (s_tcp_server_clients == 0) {
+        return net_tcp_client_put(msg);
+    }
     net_tcp_txq_start();
-    if (!s_tcp_tx_q) {
-        ui_log("[TCP] Queue not ready");
-        return;
+    net_buf_ref(msg);
+    if (!s_tcp_tx_q || xQueueSend(s_tcp_tx_q, &msg, 0) != pdTRUE) {
+        net_buf_free(msg);
+        return false;
     }
+    net_tcp_wake();
+    return true;
+}
 
-    if (!s_tcp_client_connected) {
-        ui_log("[TCP] No client");
-        return;
+esp_err_t net_send(const char *msg, uint32_t paths)
+{
+    net_buf_t *buf = NULL;
+    const esp_err_t err = net_msg_new(msg, &buf);
+    if (err != ESP_OK) {
+        return err;
     }
 
-    net_tcp_tx_item_t item;
-    snprintf(item.payload, sizeof(item.payload), "%s", msg ? msg : "");
-    (xQueueSend(s_tcp_tx_q, &item, 0) == pdTRUE) ? (void)0 : ui_log("[TCP] Queue full");
+    // Each path takes its own reference to the one buffer
+    bool queued = true;
+    queued = (paths & NET_SEND_UDP) ? net_worker_put(buf) && queued : queued;
+    queued = (paths & NET_SEND_TCP) ? net_tcp_put(buf) && queued : queued;
+    net_buf_free(buf);
+    return queued ? ESP_OK : ESP_FAIL;
 }
 
-void app_send_udp(const char *msg) {
-    net_worker_start();
-    if (!s_net_work_q) {
-        ui_log("[UDP] Queue not ready");
-        return;
-    }
+static void net_send_log_err(const char *tag, esp_err_t err)
+{
+    (err == ESP_ERR_INVALID_SIZE) ? ui_log("%s Message too long", tag) :
+    (err == ESP_ERR_NO_MEM) ? ui_log("%s No free buffer", tag) :
+    (err != ESP_OK) ? ui_log("%s Queue full", tag) : (void)0;
+}
 
-    net_work_item_t item = { .kind = NET_WORK_UDP };
-    snprintf(item.payload, sizeof(item.payload), "%s", msg ? msg : "");
-    (xQueueSend(s_net_work_q, &item, 0) == pdTRUE) ? (void)0 : ui_log("[UDP] Queue full");
+void app_send_tcp(const char *msg) {
+    net_send_log_err("[TCP]", net_send(msg, NET_SEND_TCP));
+}
+
+void app_send_udp(const char *msg) {
+    net_send_log_err("[UDP]", net_send(msg, NET_SEND_UDP));
 }
 
 const char* app_get_server_ip(void) {
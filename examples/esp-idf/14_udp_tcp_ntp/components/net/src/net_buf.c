@@ -0,0 +1,95 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "net_buf.h"
+
+static const char *TAG = "net_buf";
+
+static net_buf_t *s_bufs = NULL;
+static QueueHandle_t s_free_q = NULL;   // Free buffers by pointer, allocation and free from any task
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;    // Guards s_stats, updated from every task using buffers
+static net_buf_stats_t s_stats = { .count = NET_BUF_COUNT };
+
+esp_err_t net_buf_init(void)
+{
+    if (s_free_q) {
+        return ESP_OK;
+    }
+
+    s_bufs = heap_caps_calloc(NET_BUF_COUNT, sizeof(net_buf_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    s_bufs = s_bufs ? s_bufs : heap_caps_calloc(NET_BUF_COUNT, sizeof(net_buf_t), MALLOC_CAP_8BIT);
+    QueueHandle_t free_q = xQueueCreate(NET_BUF_COUNT, sizeof(net_buf_t *));
+    if (!s_bufs || !free_q) {
+        ESP_LOGE(TAG, "No memory for %d buffers", NET_BUF_COUNT);
+        heap_caps_free(s_bufs);
+        s_bufs = NULL;
+        free_q ? vQueueDelete(free_q) : (void)0;
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (int i = 0; i < NET_BUF_COUNT; i++) {
+        net_buf_t *buf = &s_bufs[i];
+        xQueueSend(free_q, &buf, 0);
+    }
+    s_free_q = free_q;
+    return ESP_OK;
+}
+
+net_buf_t *net_buf_alloc(uint32_t timeout_ms)
+{
+    net_buf_t *buf = NULL;
+    if (!s_free_q || xQueueReceive(s_free_q, &buf, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        portENTER_CRITICAL(&s_lock);
+        s_stats.exhausted++;
+        portEXIT_CRITICAL(&s_lock);
+        return NULL;
+    }
+    buf->len = 0;
+    atomic_store(&buf->refs, 1);
+    buf->alloc_us = esp_timer_get_time();
+
+    const uint32_t in_use = NET_BUF_COUNT - uxQueueMessagesWaiting(s_free_q);
+    portENTER_CRITICAL(&s_lock);
+    s_stats.in_use_peak = (in_use > s_stats.in_use_peak) ? in_use : s_stats.in_use_peak;
+    s_stats.allocs++;
+    portEXIT_CRITICAL(&s_lock);
+    return buf;
+}
+
+net_buf_t *net_buf_ref(net_buf_t *buf)
+{
+    atomic_fetch_add(&buf->refs, 1);
+    portENTER_CRITICAL(&s_lock);
+    s_stats.shares++;
+    s_stats.shared_bytes += buf->len;
+    portEXIT_CRITICAL(&s_lock);
+    return buf;
+}
+
+void net_buf_free(net_buf_t *buf)
+{
+    if (buf && atomic_fetch_sub(&buf->refs, 1) == 1) {
+        xQueueSend(s_free_q, &buf, 0);
+    }
+}
+
+void net_buf_get_stats(net_buf_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+    stats->in_use = s_free_q ? NET_BUF_COUNT - uxQueueMessagesWaiting(s_free_q) : 0;
+}
+
+void net_buf_log_stats(void)
+{
+    net_buf_stats_t st;
+    net_buf_get_stats(&st);
+    ESP_LOGI(TAG, "%lu/%lu buffers in use (peak %lu), %lu allocated, pool empty %lu times, %lu copies avoided (%llu bytes)",
+             (unsigned long)st.in_use, (unsigned long)st.count, (unsigned long)st.in_use_peak,
+             (unsigned long)st.allocs, (unsigned long)st.exhausted, (unsigned long)st.shares,
+             (unsigned long long)st.shared_bytes);
+}
@@ -0,0 +1,187 @@
+#include <string.h>
+#include "esp_rom_crc.h"
+
+#include "net_frame.h"
+
+static net_frame_stats_t s_stats;
+
+static uint32_t net_frame_crc(const uint8_t *frame, size_t payload_len)
+{
+    return esp_rom_crc32_le(0, frame + 1, NET_FRAME_HEADER_SIZE - 1 + payload_len);
+}
+
+static uint32_t net_frame_get_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void net_frame_seal(net_buf_t *buf, uint8_t type, size_t len)
+{
+    uint8_t *d = buf->data;
+    d[0] = NET_FRAME_SYNC;
+    d[1] = type;
+    d[2] = (uint8_t)(len >> 8);
+    d[3] = (uint8_t)len;
+
+    const uint32_t crc = net_frame_crc(d, len);
+    uint8_t *t = d + NET_FRAME_HEADER_SIZE + len;
+    t[0] = (uint8_t)(crc >> 24);
+    t[1] = (uint8_t)(crc >> 16);
+    t[2] = (uint8_t)(crc >> 8);
+    t[3] = (uint8_t)crc;
+
+    buf->len = NET_FRAME_HEADER_SIZE + len + NET_FRAME_CRC_SIZE;
+    s_stats.tx_frames++;
+}
+
+bool net_frame_check(const uint8_t *data, size_t len)
+{
+    if (len < NET_FRAME_HEADER_SIZE + NET_FRAME_CRC_SIZE || data[0] != NET_FRAME_SYNC) {
+        return false;
+    }
+    const size_t payload_len = (size_t)((data[2] << 8) | data[3]);
+    if (len != NET_FRAME_HEADER_SIZE + payload_len + NET_FRAME_CRC_SIZE) {
+        return false;
+    }
+    if (net_frame_get_be32(data + NET_FRAME_HEADER_SIZE + payload_len) != net_frame_crc(data, payload_len)) {
+        s_stats.crc_errors++;
+        return false;
+    }
+    s_stats.rx_frames++;
+    s_stats.rx_bytes += payload_len;
+    return true;
+}
+
+void net_frame_parser_init(net_frame_parser_t *parser)
+{
+    parser->buf = NULL;
+    parser->start = 0;
+    parser->have = 0;
+}
+
+void net_frame_parser_reset(net_frame_parser_t *parser)
+{
+    net_buf_free(parser->buf);
+    net_frame_parser_init(parser);
+}
+
+// Drop the first byte and everything up to the next sync byte
+static void net_frame_parser_resync(net_frame_parser_t *parser)
+{
+    const uint8_t *d = parser->buf->data + parser->start;
+    const uint8_t *next = memchr(d + 1, NET_FRAME_SYNC, parser->have - 1);
+    const size_t skip = next ? (size_t)(next - d) : parser->have;
+    parser->start += skip;
+    parser->have -= skip;
+    s_stats.resync_bytes += skip;
+}
+
+// Size of the frame at start, the header must be there and valid
+static size_t net_frame_parser_size(const net_frame_parser_t *parser)
+{
+    const uint8_t *d = parser->buf->data + parser->start;
+    return NET_FRAME_HEADER_SIZE + (size_t)((d[2] << 8) | d[3]) + NET_FRAME_CRC_SIZE;
+}
+
+// Move the frame being received to the start of its buffer
+static void net_frame_parser_compact(net_frame_parser_t *parser)
+{
+    memmove(parser->buf->data, parser->buf->data + parser->start, parser->have);
+    s_stats.copied_bytes += parser->have;
+    parser->start = 0;
+}
+
+uint8_t *net_frame_parser_space(net_frame_parser_t *parser, size_t *len)
+{
+    if (!parser->buf) {
+        parser->buf = net_buf_alloc(0);
+        parser->start = 0;
+        parser->have = 0;
+        if (!parser->buf) {
+            s_stats.stalls++;
+            return NULL;
+        }
+    }
+
+    // Until the header is in, read as much as fits; then only the rest of the frame, so a
+    // large payload lands in its own buffer and the next frame starts in a new one
+    const bool header = (parser->have >= NET_FRAME_HEADER_SIZE);
+    const size_t need = header ? net_frame_parser_size(parser) : NET_FRAME_HEADER_SIZE;
+    if (parser->start + need > NET_BUF_SIZE) {
+        net_frame_parser_compact(parser);
+    }
+    const size_t end = header ? parser->start + need : NET_BUF_SIZE;
+    if (parser->start + parser->have >= end) {
+        return NULL;
+    }
+    *len = end - parser->start - parser->have;
+    return parser->buf->data + parser->start + parser->have;
+}
+
+net_buf_t *net_frame_parser_push(net_frame_parser_t *parser, size_t len)
+{
+    parser->have += len;
+    while (parser->buf && parser->have >= NET_FRAME_HEADER_SIZE) {
+        uint8_t *d = parser->buf->data + parser->start;
+        const size_t payload_len = (size_t)((d[2] << 8) | d[3]);
+        if (d[0] != NET_FRAME_SYNC || payload_len > NET_FRAME_MAX_PAYLOAD) {
+            net_frame_parser_resync(parser);
+            continue;
+        }
+
+        const size_t size = net_frame_parser_size(parser);
+        if (parser->have < size) {
+            return NULL;
+        }
+        if (net_frame_get_be32(d + NET_FRAME_HEADER_SIZE + payload_len) != net_frame_crc(d, payload_len)) {
+            s_stats.crc_errors++;
+            net_frame_parser_resync(parser);
+            continue;
+        }
+
+        net_buf_t *frame = parser->buf;
+        const size_t extra = parser->have - size;
+        if (extra >= size) {
+            // A small frame ahead of more data: it moves out, the rest stays
+            frame = net_buf_alloc(0);
+            if (!frame) {
+                s_stats.stalls++;
+                return NULL;    // Kept until a later call finds a free buffer
+            }
+            memcpy(frame->data, d, size);
+            s_stats.copied_bytes += size;
+            parser->start += size;
+            parser->have = extra;
+        } else {
+            // The frame keeps the buffer, what came after it moves to a new one
+            net_buf_t *next = NULL;
+            if (extra > 0) {
+                next = net_buf_alloc(0);
+                if (!next) {
+                    s_stats.stalls++;
+                    return NULL;
+                }
+                memcpy(next->data, d + size, extra);
+                s_stats.copied_bytes += extra;
+            }
+            if (parser->start > 0) {
+                memmove(frame->data, d, size);
+                s_stats.copied_bytes += size;
+            }
+            parser->buf = next;
+            parser->start = 0;
+            parser->have = extra;
+        }
+
+        frame->len = size;
+        s_stats.rx_frames++;
+        s_stats.rx_bytes += payload_len;
+        return frame;
+    }
+    return NULL;
+}
+
+void net_frame_get_stats(net_frame_stats_t *stats)
+{
+    *stats = s_stats;
+}
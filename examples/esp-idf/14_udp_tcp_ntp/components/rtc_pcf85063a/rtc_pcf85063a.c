@@ -84,6 +84,16 @@ void PCF85063A_Set_All(datetime_t time)
  * Read current RTC time and date 
  **/
 void PCF85063A_Read_now(datetime_t *time)
+{
+	PCF85063A_Read_now_Valid(time);
+}
+
+/**
+ * Read current RTC time and date in one burst and check the oscillator stop flag.
+ * The chip freezes the time registers during the transfer, so the fields always match.
+ * Returns 1 if the clock has run without interruption since it was last set, 0 otherwise
+ **/
+uint8_t PCF85063A_Read_now_Valid(datetime_t *time)
 {
 	uint8_t bufss[7] = {0};
 	DEV_I2C_Read_Nbyte(RTC_DEV, RTC_SECOND_ADDR, bufss, 7);
@@ -94,6 +104,46 @@ void PCF85063A_Read_now(datetime_t *time)
 	time->dotw = bcdToDec(bufss[4] & 0x07);
 	time->month = bcdToDec(bufss[5] & 0x1F);
 	time->year = bcdToDec(bufss[6]) + YEAR_OFFSET;
+	return (bufss[0] & RTC_SECOND_OS) ? 0 : 1;
+}
+
+/**
+ * Stop or restart the time counting. Stopping clears the upper prescaler stages,
+ * the first second after the restart ends 0.507813 s to 0.507935 s later
+ **/
+void PCF85063A_Set_Stop(uint8_t stop)
+{
+	uint8_t Value = RTC_CTRL_1_DEFAULT | RTC_CTRL_1_CAP_SEL;
+	if (stop)
+	{
+		Value |= RTC_CTRL_1_STOP;
+	}
+	DEV_I2C_Write_Byte(RTC_DEV, RTC_CTRL_1_ADDR, Value);
+}
+
+/**
+ * Set the offset register. Each step is 4.34 ppm (normal mode) or 4.069 ppm (course mode),
+ * positive values make the clock run faster
+ **/
+void PCF85063A_Set_Offset(int8_t offset, uint8_t course)
+{
+	uint8_t Value = (uint8_t)offset & 0x7F;
+	if (course)
+	{
+		Value |= RTC_OFFSET_MODE;
+	}
+	DEV_I2C_Write_Byte(RTC_DEV, RTC_OFFSET_ADDR, Value);
+}
+
+/**
+ * Read the offset register, as a signed number of steps 
+ **/
+int8_t PCF85063A_Read_Offset(void)
+{
+	uint8_t Value = 0;
+	DEV_I2C_Read_Nbyte(RTC_DEV, RTC_OFFSET_ADDR, &Value, 1);
+	Value &= 0x7F;
+	return (Value & 0x40) ? (int8_t)(Value | 0x80) : (int8_t)Value; // Sign extend the 7-bit value
 }
 
 /**
@@ -70,7 +70,9 @@
 #define RTC_CTRL_2_HMI      (0X10) // Half Minute Interrupt 
 #define RTC_CTRL_2_TF       (0X08) // Timer Flag 
 
-#define RTC_OFFSET_MODE     (0X80) // Offset Mode 
+#define RTC_OFFSET_MODE     (0X80) // Offset Mode 0-Normal mode (once every two hours), 1-Course mode (every 4 minutes) 
+
+#define RTC_SECOND_OS       (0X80) // Oscillator Stop flag 0-Clock integrity guaranteed, 1-Clock integrity not guaranteed 
 
 #define RTC_TIMER_MODE_TE   (0X04) // Timer Enable 0-Disable, 1-Enable 
 #define RTC_TIMER_MODE_TIE  (0X02) // Timer Interrupt Enable 0-Disable, 1-Enable 
@@ -106,6 +108,10 @@ void PCF85063A_Set_Date(datetime_t date); // Set date on PCF85063A
 void PCF85063A_Set_All(datetime_t time); // Set both time and date on PCF85063A 
 
 void PCF85063A_Read_now(datetime_t *time); // Read current time from PCF85063A 
+uint8_t PCF85063A_Read_now_Valid(datetime_t *time); // Read current time, returns 0 if the oscillator stopped since it was set 
+void PCF85063A_Set_Stop(uint8_t stop); // Stop (1) or restart (0) the time counting 
+void PCF85063A_Set_Offset(int8_t offset, uint8_t course); // Set the frequency offset, in steps of 4.34 ppm (4.069 ppm in course mode) 
+int8_t PCF85063A_Read_Offset(void); // Read the frequency offset steps 
 
 void PCF85063A_Enable_Alarm(void); // Enable alarm on PCF85063A 
 uint8_t PCF85063A_Get_Alarm_Flag(); // Get alarm flag from PCF85063A 
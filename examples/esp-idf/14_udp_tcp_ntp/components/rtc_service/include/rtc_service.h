@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/time.h>
+#include "esp_err.h"
+
+// RTC service configuration
+#define RTC_SERVICE_TZ              "CST-8" // Local time zone, the PCF85063A itself keeps UTC
+#define RTC_SERVICE_MIN_YEAR        2024    // RTC readings before this year are taken as never set
+#define RTC_SERVICE_STOP_RELEASE_US 492000  // Release STOP this far into a second, so the chip's first tick (0.5078 s later) lands on the next one
+#define RTC_SERVICE_COARSE_POLL_MS  40      // Seconds register poll period while looking for a tick
+#define RTC_SERVICE_FINE_WINDOW_MS  10      // Tight polling starts this long before the predicted tick
+#define RTC_SERVICE_FINE_POLL_MS    1       // Seconds register poll period around the predicted tick
+#define RTC_SERVICE_FINE_MAX_GAP_MS 5       // A tick bracketed by reads further apart than this is measured another time
+#define RTC_SERVICE_OFFSET_PPB      4340    // Frequency change of one offset register step, in normal mode
+#define RTC_SERVICE_WRITE_TASK_STACK_SIZE   (3 * 1024)  // Stack size of the write back task, in bytes
+#define RTC_SERVICE_WRITE_TASK_PRIORITY     (10)        // Priority of the write back task, high so the writes land close to the planned point of the second
+
+/**
+ * @brief Where the system time comes from
+ */
+typedef enum {
+    RTC_SERVICE_SOURCE_NONE = 0,    // Not set yet
+    RTC_SERVICE_SOURCE_RTC,         // Seeded from the PCF85063A at boot
+    RTC_SERVICE_SOURCE_NETWORK,     // Set by a network time sync
+} rtc_service_source_t;
+
+/**
+ * @brief RTC service statistics
+ */
+typedef struct {
+    rtc_service_source_t source;    // Current time source
+    int64_t valid_after_us;         // Boot to valid time, -1 while the time is not valid
+    int64_t network_after_us;       // Boot to first network sync, -1 before it
+    uint32_t i2c_reads;             // PCF85063A reads since boot
+    uint32_t i2c_writes;            // PCF85063A write backs since boot
+    uint32_t reads_per_hour;        // i2c_reads scaled to one hour of uptime
+    int32_t rtc_error_ms;           // RTC minus network time at the first sync, valid when seeded from the RTC
+    int8_t offset_steps;            // Offset register value written by rtc_service_trim()
+} rtc_service_stats_t;
+
+/**
+ * @brief Seed the system time from the PCF85063A
+ *
+ * Does one burst read of the time registers. If the chip kept time since it was last
+ * set, the system time is valid as soon as this returns, long before the network is up.
+ * Also sets the local time zone. Call after DEV_I2C_Init().
+ *
+ * @return
+ *      - ESP_OK: The time is valid
+ *      - ESP_ERR_INVALID_STATE: The RTC lost its time
+ *      - ESP_ERR_NO_MEM: The write back task could not be created
+ */
+esp_err_t rtc_service_init(void);
+
+/**
+ * @brief Report a network time sync
+ *
+ * Call once the system time was set from the network.
+ *
+ * @param tv Time that was set
+ * @param write_back true to write the PCF85063A back, see rtc_service_write_back()
+ */
+void rtc_service_network_synced(const struct timeval *tv, bool write_back);
+
+/**
+ * @brief Write the system time to the PCF85063A
+ *
+ * Done by a task, woken by a timer at the right point of the next second, not from the
+ * caller's context, so the chip's seconds tick together with the system clock.
+ */
+void rtc_service_write_back(void);
+
+/**
+ * @brief Measure the PCF85063A against the system clock
+ *
+ * Blocks for up to two seconds: the seconds register is polled every
+ * RTC_SERVICE_COARSE_POLL_MS until it ticks, then every RTC_SERVICE_FINE_POLL_MS from
+ * RTC_SERVICE_FINE_WINDOW_MS before the following tick, which is timestamped to about a
+ * millisecond. That is some 25 to 45 I2C reads, so call it rarely.
+ *
+ * @param error_us Output RTC minus system time, in microseconds
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: A write back is pending
+ *      - ESP_ERR_INVALID_RESPONSE: The oscillator stop flag is set, the RTC lost its time
+ *      - ESP_ERR_NOT_FINISHED: The calling task ran too late to timestamp the tick, nothing is known about the RTC
+ *      - ESP_ERR_TIMEOUT: The RTC does not tick, or its second is far from the system one
+ */
+esp_err_t rtc_service_measure_error(int32_t *error_us);
+
+/**
+ * @brief Correct the PCF85063A frequency
+ *
+ * @param steps Offset register steps to add, positive makes the clock faster, see RTC_SERVICE_OFFSET_PPB
+ * @return New offset register value
+ */
+int8_t rtc_service_trim(int steps);
+
+/**
+ * @brief Check whether the system time is valid
+ *
+ * @return true once seeded from the RTC or the network
+ */
+bool rtc_service_time_valid(void);
+
+/**
+ * @brief Get the current time without touching the I2C bus
+ *
+ * @param tv Output time
+ * @return true if the time is valid
+ */
+bool rtc_service_get_time(struct timeval *tv);
+
+/**
+ * @brief Get the current local time without touching the I2C bus
+ *
+ * @param tm Output local time
+ * @return true if the time is valid
+ */
+bool rtc_service_get_localtime(struct tm *tm);
+
+/**
+ * @brief Get the statistics
+ *
+ * @param stats Output statistics
+ */
+void rtc_service_get_stats(rtc_service_stats_t *stats);
+
+/**
+ * @brief Log the statistics
+ */
+void rtc_service_log_stats(void);
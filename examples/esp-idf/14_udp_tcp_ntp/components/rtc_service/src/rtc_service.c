@@ -0,0 +1,339 @@
+#include <stdlib.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "rtc_pcf85063a.h"
+#include "rtc_service.h"
+
+static const char *TAG = "rtc_service";
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile rtc_service_source_t s_source = RTC_SERVICE_SOURCE_NONE;
+static esp_timer_handle_t s_write_timer = NULL;
+static TaskHandle_t s_write_task = NULL;        // Does the write back, woken by s_write_timer
+static volatile bool s_write_pending = false;   // A write back is scheduled and not done yet
+static struct timeval s_seed_tv;                // Time seeded from the RTC
+static int64_t s_seed_us;                       // esp_timer time of the seeding
+static bool s_offset_read = false;              // s_stats.offset_steps holds the register value
+static rtc_service_stats_t s_stats = {
+    .valid_after_us = -1,
+    .network_after_us = -1,
+};
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+static int64_t rtc_service_days_from_civil(int year, int month, int day)
+{
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yoe = year - era * 400;
+    const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (int64_t)era * 146097 + doe - 719468;
+}
+
+static time_t rtc_service_datetime_to_time(const datetime_t *dt)
+{
+    const int64_t days = rtc_service_days_from_civil(dt->year, dt->month, dt->day);
+    return (time_t)(days * 86400 + dt->hour * 3600 + dt->min * 60 + dt->sec);
+}
+
+static datetime_t rtc_service_time_to_datetime(time_t t)
+{
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    const datetime_t dt = {
+        .year = tm.tm_year + 1900,
+        .month = tm.tm_mon + 1,
+        .day = tm.tm_mday,
+        .dotw = tm.tm_wday,
+        .hour = tm.tm_hour,
+        .min = tm.tm_min,
+        .sec = tm.tm_sec,
+    };
+    return dt;
+}
+
+// Fires RTC_SERVICE_STOP_RELEASE_US into a second, the I2C writes block so they run in the write task
+static void rtc_service_write_cb(void *arg)
+{
+    xTaskNotifyGive(s_write_task);
+}
+
+// Load the current second with the counting stopped, so the chip's next tick comes at the next second of the system time
+static void rtc_service_write_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        struct timeval now;
+        gettimeofday(&now, NULL);
+
+        PCF85063A_Set_Stop(1);
+        PCF85063A_Set_All(rtc_service_time_to_datetime(now.tv_sec));
+        PCF85063A_Set_Stop(0);
+        s_write_pending = false;
+
+        portENTER_CRITICAL(&s_lock);
+        s_stats.i2c_writes++;
+        portEXIT_CRITICAL(&s_lock);
+        ESP_LOGI(TAG, "RTC written back (%ld ms into the second)", (long)(now.tv_usec / 1000));
+        rtc_service_log_stats();
+    }
+}
+
+esp_err_t rtc_service_init(void)
+{
+    setenv("TZ", RTC_SERVICE_TZ, 1);
+    tzset();
+
+    if (!s_write_timer) {
+        const esp_timer_create_args_t args = {
+            .callback = rtc_service_write_cb,
+            .name = "rtc_write",
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&args, &s_write_timer));
+    }
+    if (!s_write_task) {
+        const BaseType_t ret = xTaskCreate(rtc_service_write_task, "rtc_write", RTC_SERVICE_WRITE_TASK_STACK_SIZE, NULL,
+                                           RTC_SERVICE_WRITE_TASK_PRIORITY, &s_write_task);
+        ESP_RETURN_ON_FALSE(ret == pdPASS, ESP_ERR_NO_MEM, TAG, "Failed to create the write task");
+    }
+
+    PCF85063A_Init();
+
+    // One burst read, the only RTC read needed: afterwards the system clock runs on its own
+    datetime_t dt;
+    const bool intact = PCF85063A_Read_now_Valid(&dt);
+    portENTER_CRITICAL(&s_lock);
+    s_stats.i2c_reads++;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (!intact || dt.year < RTC_SERVICE_MIN_YEAR || dt.month < 1 || dt.month > 12 || dt.day < 1) {
+        ESP_LOGW(TAG, "RTC time not valid (%d-%02d-%02d, oscillator %s), waiting for the network",
+                 dt.year, dt.month, dt.day, intact ? "ok" : "stopped");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // The fraction of the current second is unknown, take the middle to halve the worst error
+    struct timeval tv = {
+        .tv_sec = rtc_service_datetime_to_time(&dt),
+        .tv_usec = 500000,
+    };
+    settimeofday(&tv, NULL);
+
+    const int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_lock);
+    if (s_source == RTC_SERVICE_SOURCE_NONE) {
+        s_seed_tv = tv;
+        s_seed_us = now_us;
+        s_stats.valid_after_us = now_us;
+        s_source = RTC_SERVICE_SOURCE_RTC;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    ESP_LOGI(TAG, "Time seeded from RTC: %d-%02d-%02d %02d:%02d:%02d UTC, valid %" PRId64 " ms after boot",
+             dt.year, dt.month, dt.day, dt.hour, dt.min, dt.sec, now_us / 1000);
+    return ESP_OK;
+}
+
+void rtc_service_network_synced(const struct timeval *tv, bool write_back)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    const int64_t now_us = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_lock);
+    if (s_stats.network_after_us < 0) {
+        s_stats.network_after_us = now_us;
+        if (s_source == RTC_SERVICE_SOURCE_RTC) {
+            // Where the RTC seeded clock would be now, against the network time
+            const int64_t seeded_us = (int64_t)s_seed_tv.tv_sec * 1000000 + s_seed_tv.tv_usec + (now_us - s_seed_us);
+            const int64_t network_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+            s_stats.rtc_error_ms = (int32_t)((seeded_us - network_us) / 1000);
+        }
+    }
+    if (s_stats.valid_after_us < 0) {
+        s_stats.valid_after_us = now_us;
+    }
+    s_source = RTC_SERVICE_SOURCE_NETWORK;
+    portEXIT_CRITICAL(&s_lock);
+
+    ESP_LOGI(TAG, "Network time %lld.%06ld", (long long)tv->tv_sec, (long)tv->tv_usec);
+    if (write_back) {
+        rtc_service_write_back();
+    }
+}
+
+void rtc_service_write_back(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+
+    // Write back at the next point where the chip's seconds can be aligned to ours
+    int64_t delay_us = RTC_SERVICE_STOP_RELEASE_US - now.tv_usec;
+    if (delay_us < 0) {
+        delay_us += 1000000;
+    }
+    if (s_write_timer) {
+        s_write_pending = true;
+        esp_timer_stop(s_write_timer);
+        esp_timer_start_once(s_write_timer, delay_us);
+        ESP_LOGI(TAG, "RTC write back in %" PRId64 " ms", delay_us / 1000);
+    }
+}
+
+// Read the RTC and timestamp the read with the system clock, in microseconds since the epoch.
+// Returns false if the oscillator stopped since the RTC was last set, its time is then meaningless
+static bool rtc_service_read_stamped(time_t *sec, int64_t *sys_us)
+{
+    struct timeval now;
+    datetime_t dt;
+
+    gettimeofday(&now, NULL);
+    const bool intact = PCF85063A_Read_now_Valid(&dt);
+    *sys_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.i2c_reads++;
+    portEXIT_CRITICAL(&s_lock);
+    *sec = rtc_service_datetime_to_time(&dt);
+    return intact;
+}
+
+esp_err_t rtc_service_measure_error(int32_t *error_us)
+{
+    if (s_write_pending) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Coarse: find a tick to within RTC_SERVICE_COARSE_POLL_MS, the bounds are system time since the first read */
+    int64_t first_us, prev_us = 0, sys_us;
+    time_t start, sec;
+    if (!rtc_service_read_stamped(&start, &sys_us)) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    first_us = sys_us;
+    sec = start;
+    while (sec == start) {
+        if (sys_us - first_us > (1000 + 2 * RTC_SERVICE_COARSE_POLL_MS) * 1000LL) {
+            return ESP_ERR_TIMEOUT; // No tick in more than a second
+        }
+        vTaskDelay(pdMS_TO_TICKS(RTC_SERVICE_COARSE_POLL_MS));
+        prev_us = sys_us;
+        if (!rtc_service_read_stamped(&sec, &sys_us)) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+    if (sys_us - prev_us > 2 * RTC_SERVICE_COARSE_POLL_MS * 1000LL) {
+        return ESP_ERR_NOT_FINISHED; // A late poll leaves the tick too vague to predict the next one
+    }
+
+    /* Fine: the next tick is one RTC second after a point between the last two reads */
+    const int64_t wake_us = prev_us + 1000000 - RTC_SERVICE_FINE_WINDOW_MS * 1000;
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    const int64_t wait_us = wake_us - ((int64_t)now.tv_sec * 1000000 + now.tv_usec);
+    if (wait_us > 0) {
+        vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+    }
+
+    const time_t from = sec;
+    int64_t last_us = 0;
+    if (!rtc_service_read_stamped(&sec, &last_us)) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    if (sec != from) {
+        return ESP_ERR_NOT_FINISHED; // Woke up too late, don't report a wrong edge
+    }
+    const int64_t fine_us = last_us;
+    const TickType_t poll_ticks = pdMS_TO_TICKS(RTC_SERVICE_FINE_POLL_MS) ? pdMS_TO_TICKS(RTC_SERVICE_FINE_POLL_MS) : 1;
+    while (sec == from) {
+        if (last_us - fine_us > (RTC_SERVICE_COARSE_POLL_MS + 2 * RTC_SERVICE_FINE_WINDOW_MS) * 1000LL) {
+            return ESP_ERR_TIMEOUT; // The RTC second is far from the system one
+        }
+        vTaskDelay(poll_ticks);
+        prev_us = last_us;
+        if (!rtc_service_read_stamped(&sec, &last_us)) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+
+    // A read held up by other tasks leaves a wide bracket around the tick, measure another time
+    if (last_us - prev_us > RTC_SERVICE_FINE_MAX_GAP_MS * 1000LL) {
+        return ESP_ERR_NOT_FINISHED;
+    }
+
+    // The tick happened between the two reads, take the middle
+    const int64_t tick_us = (prev_us + last_us) / 2;
+    *error_us = (int32_t)((int64_t)sec * 1000000 - tick_us);
+    return ESP_OK;
+}
+
+int8_t rtc_service_trim(int steps)
+{
+    if (!s_offset_read) {
+        s_stats.offset_steps = PCF85063A_Read_Offset();
+        s_offset_read = true;
+    }
+
+    int value = s_stats.offset_steps + steps;
+    value = value > 63 ? 63 : (value < -64 ? -64 : value);
+    PCF85063A_Set_Offset((int8_t)value, 0);
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.offset_steps = (int8_t)value;
+    s_stats.i2c_writes++;
+    portEXIT_CRITICAL(&s_lock);
+
+    ESP_LOGI(TAG, "RTC offset register %d (%+d steps)", value, steps);
+    return (int8_t)value;
+}
+
+bool rtc_service_time_valid(void)
+{
+    return s_source != RTC_SERVICE_SOURCE_NONE;
+}
+
+bool rtc_service_get_time(struct timeval *tv)
+{
+    gettimeofday(tv, NULL);
+    return rtc_service_time_valid();
+}
+
+bool rtc_service_get_localtime(struct tm *tm)
+{
+    struct timeval tv;
+    const bool valid = rtc_service_get_time(&tv);
+    const time_t now = tv.tv_sec;
+    localtime_r(&now, tm);
+    return valid;
+}
+
+void rtc_service_get_stats(rtc_service_stats_t *stats)
+{
+    const int64_t uptime_us = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    stats->source = s_source;
+    portEXIT_CRITICAL(&s_lock);
+
+    stats->reads_per_hour = uptime_us > 0 ? (uint32_t)((int64_t)stats->i2c_reads * 3600 * 1000000 / uptime_us) : 0;
+}
+
+void rtc_service_log_stats(void)
+{
+    static const char *source_str[] = { "none", "rtc", "network" };
+    rtc_service_stats_t stats;
+    rtc_service_get_stats(&stats);
+
+    ESP_LOGI(TAG, "source %s, valid after %" PRId64 " ms, network after %" PRId64 " ms, rtc error %" PRId32 " ms, "
+             "%" PRIu32 " reads (%" PRIu32 "/h), %" PRIu32 " writes, offset %d",
+             source_str[stats.source],
+             stats.valid_after_us < 0 ? -1 : stats.valid_after_us / 1000,
+             stats.network_after_us < 0 ? -1 : stats.network_after_us / 1000,
+             stats.rtc_error_ms, stats.i2c_reads, stats.reads_per_hour, stats.i2c_writes, stats.offset_steps);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Time discipline configuration
+#define TIME_SYNC_SERVERS           { "ntp.ntsc.ac.cn", "cn.pool.ntp.org", "time.windows.com" }
+#define TIME_SYNC_USE_LOCAL_SERVER  0       // Set to 1 to query only TIME_SYNC_LOCAL_SERVER, e.g. an NTP server on the host PC for testing
+#define TIME_SYNC_LOCAL_SERVER      "192.168.137.1" // Same host as EXAMPLE_SERVER_IP
+#define TIME_SYNC_PORT              123
+
+#define TIME_SYNC_SAMPLES           4       // Queries per server and poll, the one with the shortest round trip is kept
+#define TIME_SYNC_SAMPLE_GAP_MS     50      // Pause between two queries to the same server
+#define TIME_SYNC_REPLY_TIMEOUT_MS  1000    // Wait for one reply
+#define TIME_SYNC_MAX_DELAY_MS      250     // Samples with a longer round trip are dropped
+
+#define TIME_SYNC_POLL_MIN_S        64      // Shortest interval between two polls
+#define TIME_SYNC_POLL_MAX_S        4096    // Longest interval between two polls
+#define TIME_SYNC_RETRY_S           16      // Interval after a poll where no server answered
+#define TIME_SYNC_STABLE_US         5000    // Offsets below this count as stable
+#define TIME_SYNC_STABLE_POLLS      3       // Stable polls in a row before the interval doubles
+#define TIME_SYNC_UNSTABLE_US       20000   // An offset above this halves the interval
+#define TIME_SYNC_STEP_US           1000000 // Larger offsets are stepped, smaller ones slewed
+#define TIME_SYNC_FLL_TAU_S         1024    // Frequency estimate averaging time, longer intervals trust the sample more
+#define TIME_SYNC_TRIM_PERIOD_S     16      // Period of the frequency correction slews
+#define TIME_SYNC_MAX_PPB           500000  // Frequency correction limit
+
+#define TIME_SYNC_RTC_DISCIPLINE    1       // Set to 1 to measure the PCF85063A after polls, rewrite and trim it
+#define TIME_SYNC_RTC_RESYNC_US     20000   // RTC errors above this are fixed by writing the RTC again
+#define TIME_SYNC_RTC_MIN_SPAN_S    7200    // Shortest time between RTC measurements, and span before the offset register is changed
+
+#define TIME_SYNC_TASK_STACK_SIZE   (4 * 1024)
+#define TIME_SYNC_TASK_PRIORITY     (3)
+
+/**
+ * @brief Time discipline statistics
+ */
+typedef struct {
+    uint32_t poll_cnt;              // Polls done, each one a network wakeup
+    uint32_t packet_cnt;            // Queries sent
+    uint32_t sample_cnt;            // Replies accepted
+    uint32_t reject_cnt;            // Replies dropped: round trip too long, bad header or not ours
+    uint32_t fail_cnt;              // Polls where no server answered
+    uint32_t step_cnt;              // Offsets applied as a step
+    uint32_t poll_s;                // Current poll interval
+    int32_t offset_us;              // Last measured offset, server minus local
+    uint32_t offset_rms_us;         // RMS offset of the slewed polls since convergence
+    uint32_t offset_max_us;         // Largest absolute offset of the slewed polls since convergence
+    uint32_t delay_us;              // Round trip of the sample used last
+    int32_t freq_ppb;               // ESP32 clock correction, positive when it runs slow
+    int64_t converged_after_ms;     // Boot to the first stable poll, -1 before it
+    int32_t rtc_error_us;           // Last PCF85063A error, RTC minus system time
+    int32_t rtc_drift_ppb;          // Last PCF85063A drift estimate, positive when it runs fast
+    uint32_t rtc_write_cnt;         // PCF85063A rewrites
+} time_sync_stats_t;
+
+/**
+ * @brief Called by the time discipline task after each poll
+ *
+ * @param ok true if a server answered
+ * @param stats Statistics after the poll
+ */
+typedef void (*time_sync_cb_t)(bool ok, const time_sync_stats_t *stats);
+
+/**
+ * @brief Start the time discipline task
+ *
+ * Call once the network is up.
+ *
+ * @param cb Called after each poll, may be NULL
+ * @return
+ *      - ESP_OK: Success (also when it is running already)
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t time_sync_start(time_sync_cb_t cb);
+
+/**
+ * @brief Poll the servers now, e.g. after the network came back
+ */
+void time_sync_request(void);
+
+/**
+ * @brief Get the statistics
+ *
+ * @param stats Output statistics
+ */
+void time_sync_get_stats(time_sync_stats_t *stats);
+
+/**
+ * @brief Log the statistics
+ */
+void time_sync_log_stats(void);
@@ -0,0 +1,542 @@
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "lwip/sockets.h"
+#include "lwip/netdb.h"
+
+#include "rtc_service.h"
+#include "time_sync.h"
+
+static const char *TAG = "time_sync";
+
+#define NTP_PACKET_SIZE     48
+#define NTP_UNIX_OFFSET     2208988800LL    // Seconds from 1900 to 1970
+#define NTP_MODE_CLIENT     3
+#define NTP_MODE_SERVER     4
+#define NTP_VERSION         4
+
+typedef struct {
+    int64_t offset_us;  // Server minus local
+    int64_t delay_us;   // Round trip without the server's processing time
+} time_sync_sample_t;
+
+typedef struct {
+    const char *host;
+    struct sockaddr_in addr;
+    bool resolved;
+} time_sync_server_t;
+
+#if TIME_SYNC_USE_LOCAL_SERVER
+static time_sync_server_t s_servers[] = { { .host = TIME_SYNC_LOCAL_SERVER } };
+#else
+static const char *s_server_hosts[] = TIME_SYNC_SERVERS;
+static time_sync_server_t s_servers[sizeof(s_server_hosts) / sizeof(s_server_hosts[0])];
+#endif
+#define TIME_SYNC_SERVER_NUM    ((int)(sizeof(s_servers) / sizeof(s_servers[0])))
+
+static TaskHandle_t s_task = NULL;
+static time_sync_cb_t s_cb = NULL;
+static esp_timer_handle_t s_trim_timer = NULL;
+static SemaphoreHandle_t s_adj_lock = NULL;     // Keeps the slews of the task and of the trim timer apart
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile int32_t s_freq_ppb = 0;
+static time_sync_stats_t s_stats = {
+    .poll_s = TIME_SYNC_POLL_MIN_S,
+    .converged_after_ms = -1,
+};
+static uint64_t s_offset_sq_sum = 0;            // For offset_rms_us
+static uint32_t s_offset_sq_cnt = 0;
+
+static int64_t time_sync_now_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void time_sync_put_ntp(uint8_t *p, int64_t us)
+{
+    const uint32_t sec = (uint32_t)(us / 1000000 + NTP_UNIX_OFFSET);
+    const uint32_t frac = (uint32_t)(((uint64_t)(us % 1000000) << 32) / 1000000);
+    for (int i = 0; i < 4; i++) {
+        p[i] = sec >> (24 - 8 * i);
+        p[4 + i] = frac >> (24 - 8 * i);
+    }
+}
+
+static int64_t time_sync_get_ntp(const uint8_t *p)
+{
+    uint32_t sec = 0, frac = 0;
+    for (int i = 0; i < 4; i++) {
+        sec = (sec << 8) | p[i];
+        frac = (frac << 8) | p[4 + i];
+    }
+    // Era 1 starts in 2036, small values belong to it
+    const int64_t ntp_sec = sec < 0x80000000u ? (int64_t)sec + (1LL << 32) : sec;
+    return (ntp_sec - NTP_UNIX_OFFSET) * 1000000 + (int64_t)(((uint64_t)frac * 1000000) >> 32);
+}
+
+// Change the outstanding slew, replacing it or adding to it
+static void time_sync_slew(int64_t delta_us, bool add)
+{
+    struct timeval old = { 0 };
+    xSemaphoreTake(s_adj_lock, portMAX_DELAY);
+    if (add) {
+        adjtime(NULL, &old);
+        delta_us += (int64_t)old.tv_sec * 1000000 + old.tv_usec;
+    }
+    const struct timeval delta = {
+        .tv_sec = delta_us / 1000000,
+        .tv_usec = delta_us % 1000000,
+    };
+    adjtime(&delta, NULL);
+    xSemaphoreGive(s_adj_lock);
+}
+
+static int64_t time_sync_slew_pending(void)
+{
+    struct timeval old = { 0 };
+    xSemaphoreTake(s_adj_lock, portMAX_DELAY);
+    adjtime(NULL, &old);
+    xSemaphoreGive(s_adj_lock);
+    return (int64_t)old.tv_sec * 1000000 + old.tv_usec;
+}
+
+// Frequency correction: slew the estimated drift of each period
+static void time_sync_trim_cb(void *arg)
+{
+    const int64_t delta_us = (int64_t)s_freq_ppb * TIME_SYNC_TRIM_PERIOD_S / 1000;
+    if (delta_us) {
+        time_sync_slew(delta_us, true);
+    }
+}
+
+static bool time_sync_resolve(time_sync_server_t *server)
+{
+    if (server->resolved) {
+        return true;
+    }
+
+    const struct addrinfo hints = {
+        .ai_family = AF_INET,
+        .ai_socktype = SOCK_DGRAM,
+    };
+    struct addrinfo *res = NULL;
+    if (getaddrinfo(server->host, NULL, &hints, &res) != 0 || !res) {
+        ESP_LOGW(TAG, "%s: DNS lookup failed", server->host);
+        return false;
+    }
+    memcpy(&server->addr, res->ai_addr, sizeof(server->addr));
+    server->addr.sin_port = htons(TIME_SYNC_PORT);
+    freeaddrinfo(res);
+    server->resolved = true;
+    return true;
+}
+
+// One request and reply, false if there was no usable reply
+static bool time_sync_query(int sock, const time_sync_server_t *server, time_sync_sample_t *sample)
+{
+    uint8_t req[NTP_PACKET_SIZE] = { 0 };
+    uint8_t rsp[NTP_PACKET_SIZE];
+
+    req[0] = (NTP_VERSION << 3) | NTP_MODE_CLIENT;
+    const int64_t t1 = time_sync_now_us();
+    time_sync_put_ntp(&req[40], t1); // Transmit timestamp, echoed back as the origin timestamp
+
+    if (sendto(sock, req, sizeof(req), 0, (const struct sockaddr *)&server->addr, sizeof(server->addr)) < 0) {
+        return false;
+    }
+    portENTER_CRITICAL(&s_lock);
+    s_stats.packet_cnt++;
+    portEXIT_CRITICAL(&s_lock);
+
+    while (1) {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        const int len = recvfrom(sock, rsp, sizeof(rsp), 0, (struct sockaddr *)&from, &from_len);
+        const int64_t t4 = time_sync_now_us();
+        if (len < 0) {
+            return false; // Timeout
+        }
+
+        // Late replies to an earlier query fail the origin check and are skipped
+        const uint8_t li = rsp[0] >> 6, mode = rsp[0] & 0x07, stratum = rsp[1];
+        if (len < NTP_PACKET_SIZE || from.sin_addr.s_addr != server->addr.sin_addr.s_addr ||
+            mode != NTP_MODE_SERVER || li == 3 || stratum == 0 || stratum > 15 ||
+            memcmp(&rsp[24], &req[40], 8) != 0) {
+            portENTER_CRITICAL(&s_lock);
+            s_stats.reject_cnt++;
+            portEXIT_CRITICAL(&s_lock);
+            continue;
+        }
+
+        const int64_t t2 = time_sync_get_ntp(&rsp[32]);
+        const int64_t t3 = time_sync_get_ntp(&rsp[40]);
+        sample->offset_us = ((t2 - t1) + (t3 - t4)) / 2;
+        sample->delay_us = (t4 - t1) - (t3 - t2);
+        if (sample->delay_us < 0) {
+            sample->delay_us = 0;
+        }
+        return true;
+    }
+}
+
+static int time_sync_sample_cmp(const void *a, const void *b)
+{
+    const int64_t oa = ((const time_sync_sample_t *)a)->offset_us;
+    const int64_t ob = ((const time_sync_sample_t *)b)->offset_us;
+    return (oa > ob) - (oa < ob);
+}
+
+// Query every server, keep the shortest round trip of each and combine them by median
+static bool time_sync_poll(time_sync_sample_t *result)
+{
+    time_sync_sample_t best[TIME_SYNC_SERVER_NUM];
+    int n = 0;
+
+    const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "Unable to create socket: errno %d", errno);
+        return false;
+    }
+    const struct timeval timeout = {
+        .tv_sec = TIME_SYNC_REPLY_TIMEOUT_MS / 1000,
+        .tv_usec = (TIME_SYNC_REPLY_TIMEOUT_MS % 1000) * 1000,
+    };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    for (int i = 0; i < TIME_SYNC_SERVER_NUM; i++) {
+        time_sync_server_t *server = &s_servers[i];
+        if (!time_sync_resolve(server)) {
+            continue;
+        }
+
+        bool answered = false;
+        best[n].delay_us = INT64_MAX;
+        for (int k = 0; k < TIME_SYNC_SAMPLES; k++) {
+            time_sync_sample_t sample;
+            if (k) {
+                vTaskDelay(pdMS_TO_TICKS(TIME_SYNC_SAMPLE_GAP_MS));
+            }
+            if (!time_sync_query(sock, server, &sample)) {
+                continue;
+            }
+            answered = true;
+            if (sample.delay_us > TIME_SYNC_MAX_DELAY_MS * 1000LL) {
+                portENTER_CRITICAL(&s_lock);
+                s_stats.reject_cnt++;
+                portEXIT_CRITICAL(&s_lock);
+                continue;
+            }
+            portENTER_CRITICAL(&s_lock);
+            s_stats.sample_cnt++;
+            portEXIT_CRITICAL(&s_lock);
+            // The shortest round trip has the least asymmetry, so the most accurate offset
+            if (sample.delay_us < best[n].delay_us) {
+                best[n] = sample;
+            }
+        }
+        if (!answered) {
+            server->resolved = false; // Look the name up again next time, the address may have moved
+        }
+        if (best[n].delay_us != INT64_MAX) {
+            ESP_LOGD(TAG, "%s: offset %" PRId64 " us, delay %" PRId64 " us", server->host, best[n].offset_us, best[n].delay_us);
+            n++;
+        }
+    }
+    close(sock);
+
+    if (n == 0) {
+        return false;
+    }
+
+    // The median outvotes a single wrong server; with an even count take the middle sample with the shorter round trip
+    qsort(best, n, sizeof(best[0]), time_sync_sample_cmp);
+    *result = best[n / 2];
+    if (n % 2 == 0 && best[n / 2 - 1].delay_us < result->delay_us) {
+        *result = best[n / 2 - 1];
+    }
+    return true;
+}
+
+// Correct the clock, returns true if it was stepped
+static bool time_sync_apply(const time_sync_sample_t *sample)
+{
+    static int64_t last_us = -1; // esp_timer time of the last slewed correction
+    const int64_t now_us = esp_timer_get_time();
+
+    if (!rtc_service_time_valid() || llabs(sample->offset_us) > TIME_SYNC_STEP_US) {
+        time_sync_slew(0, false); // Drop what is still outstanding, it was based on the wrong time
+        const int64_t t = time_sync_now_us() + sample->offset_us;
+        const struct timeval tv = { .tv_sec = t / 1000000, .tv_usec = t % 1000000 };
+        settimeofday(&tv, NULL);
+        last_us = now_us;
+        portENTER_CRITICAL(&s_lock);
+        s_stats.step_cnt++;
+        portEXIT_CRITICAL(&s_lock);
+        ESP_LOGI(TAG, "Clock stepped by %" PRId64 " ms", sample->offset_us / 1000);
+        return true;
+    }
+
+    // Frequency: the offset left after one interval is the error of the drift estimate
+    if (last_us >= 0 && now_us > last_us) {
+        const int64_t interval_us = now_us - last_us;
+        const int64_t interval_s = interval_us / 1000000;
+        int64_t freq = s_freq_ppb + sample->offset_us * 1000000000LL / interval_us *
+                       (interval_s < TIME_SYNC_FLL_TAU_S ? interval_s : TIME_SYNC_FLL_TAU_S) / TIME_SYNC_FLL_TAU_S;
+        freq = freq > TIME_SYNC_MAX_PPB ? TIME_SYNC_MAX_PPB : (freq < -TIME_SYNC_MAX_PPB ? -TIME_SYNC_MAX_PPB : freq);
+        s_freq_ppb = (int32_t)freq;
+    }
+    last_us = now_us;
+
+    // Phase: slew the offset away, replacing what is outstanding since the offset already includes it
+    time_sync_slew(sample->offset_us, false);
+    return false;
+}
+
+#if TIME_SYNC_RTC_DISCIPLINE
+// Measure the PCF85063A against the freshly corrected clock, rewrite it or trim its frequency
+static void time_sync_rtc(void)
+{
+    static int64_t base_us = -1;    // esp_timer time of base_error_us
+    static int32_t base_error_us;
+    static int64_t measure_us = -1; // esp_timer time of the last measurement
+
+    // The RTC drifts by milliseconds a day, one measurement per span is enough
+    if (measure_us >= 0 && esp_timer_get_time() - measure_us < TIME_SYNC_RTC_MIN_SPAN_S * 1000000LL) {
+        return;
+    }
+
+    // Measure against the corrected clock, not one that is still being slewed
+    for (int i = 0; i < 120 && llabs(time_sync_slew_pending()) > 1000; i++) {
+        vTaskDelay(pdMS_TO_TICKS(500));
+    }
+
+    int32_t error_us;
+    const esp_err_t ret = rtc_service_measure_error(&error_us);
+    if (ret == ESP_ERR_INVALID_STATE) {
+        return; // A write back is already on its way
+    }
+    if (ret == ESP_ERR_NOT_FINISHED) {
+        ESP_LOGD(TAG, "RTC measurement disturbed, trying again at the next poll");
+        return; // Nothing is known about the RTC, don't rewrite it
+    }
+    const int64_t now_us = esp_timer_get_time();
+
+    if (ret != ESP_OK || abs(error_us) > TIME_SYNC_RTC_RESYNC_US) {
+        ESP_LOGI(TAG, "RTC %s, rewriting it", ret == ESP_OK ? "error too large" :
+                 ret == ESP_ERR_INVALID_RESPONSE ? "lost its time" : "not ticking with the system clock");
+        rtc_service_write_back();
+        base_us = -1; // The next measurement starts a new span
+        measure_us = -1; // Check the rewritten RTC at the next poll
+        portENTER_CRITICAL(&s_lock);
+        s_stats.rtc_error_us = ret == ESP_OK ? error_us : 0;
+        s_stats.rtc_write_cnt++;
+        portEXIT_CRITICAL(&s_lock);
+        return;
+    }
+
+    measure_us = now_us;
+    portENTER_CRITICAL(&s_lock);
+    s_stats.rtc_error_us = error_us;
+    portEXIT_CRITICAL(&s_lock);
+    if (base_us < 0) {
+        base_us = now_us;
+        base_error_us = error_us;
+        return;
+    }
+
+    // The error grows by the drift, in us per s, i.e. ppm; long spans average out the 1 ms timestamp resolution
+    const int64_t span_s = (now_us - base_us) / 1000000;
+    if (span_s < TIME_SYNC_RTC_MIN_SPAN_S) {
+        return;
+    }
+    const int32_t drift_ppb = (int32_t)((int64_t)(error_us - base_error_us) * 1000 / span_s);
+    portENTER_CRITICAL(&s_lock);
+    s_stats.rtc_drift_ppb = drift_ppb;
+    portEXIT_CRITICAL(&s_lock);
+
+    // A fast RTC needs a negative offset, round to the nearest step
+    const int steps = -(drift_ppb + (drift_ppb >= 0 ? RTC_SERVICE_OFFSET_PPB / 2 : -RTC_SERVICE_OFFSET_PPB / 2)) / RTC_SERVICE_OFFSET_PPB;
+    if (steps != 0) {
+        rtc_service_trim(steps);
+        base_us = now_us; // The rate changed, measure it again
+        base_error_us = error_us;
+    }
+}
+#endif
+
+// Longer intervals while the clock holds, shorter ones when it wanders
+static void time_sync_adapt(int64_t offset_us, bool stepped)
+{
+    static int stable = 0;
+    const int64_t abs_us = llabs(offset_us);
+
+    portENTER_CRITICAL(&s_lock);
+    if (stepped) {
+        s_stats.poll_s = TIME_SYNC_POLL_MIN_S;
+        stable = 0;
+    } else if (abs_us < TIME_SYNC_STABLE_US) {
+        if (++stable >= TIME_SYNC_STABLE_POLLS) {
+            s_stats.poll_s = s_stats.poll_s * 2 > TIME_SYNC_POLL_MAX_S ? TIME_SYNC_POLL_MAX_S : s_stats.poll_s * 2;
+            stable = 0;
+        }
+    } else if (abs_us > TIME_SYNC_UNSTABLE_US) {
+        s_stats.poll_s = s_stats.poll_s / 2 < TIME_SYNC_POLL_MIN_S ? TIME_SYNC_POLL_MIN_S : s_stats.poll_s / 2;
+        stable = 0;
+    } else {
+        stable = 0;
+    }
+
+    if (!stepped) {
+        if (s_stats.converged_after_ms < 0 && abs_us < TIME_SYNC_STABLE_US) {
+            s_stats.converged_after_ms = esp_timer_get_time() / 1000;
+        }
+        if (s_stats.converged_after_ms >= 0) {
+            s_offset_sq_sum += (uint64_t)(abs_us * abs_us);
+            s_offset_sq_cnt++;
+            s_stats.offset_max_us = abs_us > s_stats.offset_max_us ? abs_us : s_stats.offset_max_us;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+static void time_sync_task(void *arg)
+{
+    uint32_t retry_s = TIME_SYNC_RETRY_S;
+
+    while (1) {
+        time_sync_sample_t sample;
+        uint32_t wait_s;
+        const bool ok = time_sync_poll(&sample);
+
+        portENTER_CRITICAL(&s_lock);
+        s_stats.poll_cnt++;
+        if (!ok) {
+            s_stats.fail_cnt++;
+        }
+        portEXIT_CRITICAL(&s_lock);
+
+        if (ok) {
+            const bool stepped = time_sync_apply(&sample);
+            portENTER_CRITICAL(&s_lock);
+            s_stats.offset_us = (int32_t)sample.offset_us;
+            s_stats.delay_us = (uint32_t)sample.delay_us;
+            portEXIT_CRITICAL(&s_lock);
+            time_sync_adapt(sample.offset_us, stepped);
+
+            struct timeval tv;
+            gettimeofday(&tv, NULL);
+#if TIME_SYNC_RTC_DISCIPLINE
+            rtc_service_network_synced(&tv, false);
+            time_sync_rtc();
+#else
+            rtc_service_network_synced(&tv, true);
+#endif
+            retry_s = TIME_SYNC_RETRY_S;
+            wait_s = s_stats.poll_s;
+        } else {
+            // Back off while the network is down, but never wait longer than a normal poll
+            wait_s = retry_s;
+            retry_s = retry_s * 2 > s_stats.poll_s ? s_stats.poll_s : retry_s * 2;
+        }
+
+        time_sync_log_stats();
+        if (s_cb) {
+            time_sync_stats_t stats;
+            time_sync_get_stats(&stats);
+            s_cb(ok, &stats);
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_s * 1000));
+    }
+}
+
+esp_err_t time_sync_start(time_sync_cb_t cb)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+    s_cb = cb;
+
+#if !TIME_SYNC_USE_LOCAL_SERVER
+    for (int i = 0; i < TIME_SYNC_SERVER_NUM; i++) {
+        s_servers[i].host = s_server_hosts[i];
+    }
+#endif
+
+    s_adj_lock = xSemaphoreCreateMutex();
+    if (!s_adj_lock) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t args = {
+        .callback = time_sync_trim_cb,
+        .name = "time_trim",
+    };
+    esp_err_t ret = esp_timer_create(&args, &s_trim_timer);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    esp_timer_start_periodic(s_trim_timer, TIME_SYNC_TRIM_PERIOD_S * 1000000ULL);
+
+    if (xTaskCreate(time_sync_task, "time_sync", TIME_SYNC_TASK_STACK_SIZE, NULL, TIME_SYNC_TASK_PRIORITY, &s_task) != pdPASS) {
+        s_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+void time_sync_request(void)
+{
+    if (s_task) {
+        xTaskNotifyGive(s_task);
+    }
+}
+
+void time_sync_get_stats(time_sync_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    stats->freq_ppb = s_freq_ppb;
+    stats->offset_rms_us = 0;
+    if (s_offset_sq_cnt) {
+        // Integer square root of the mean square
+        uint64_t ms = s_offset_sq_sum / s_offset_sq_cnt, r = 0, bit = 1ULL << 62;
+        while (bit > ms) {
+            bit >>= 2;
+        }
+        while (bit) {
+            if (ms >= r + bit) {
+                ms -= r + bit;
+                r = (r >> 1) + bit;
+            } else {
+                r >>= 1;
+            }
+            bit >>= 2;
+        }
+        stats->offset_rms_us = (uint32_t)r;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void time_sync_log_stats(void)
+{
+    time_sync_stats_t stats;
+    time_sync_get_stats(&stats);
+
+    ESP_LOGI(TAG, "offset %" PRId32 " us, delay %" PRIu32 " us, rms %" PRIu32 " us, max %" PRIu32 " us, freq %" PRId32 " ppb, "
+             "poll %" PRIu32 " s, converged after %" PRId64 " ms",
+             stats.offset_us, stats.delay_us, stats.offset_rms_us, stats.offset_max_us, stats.freq_ppb,
+             stats.poll_s, stats.converged_after_ms);
+    ESP_LOGI(TAG, "%" PRIu32 " polls (%" PRIu32 " failed), %" PRIu32 " packets, %" PRIu32 " samples, %" PRIu32 " rejected, %" PRIu32 " steps, "
+             "rtc error %" PRId32 " us, rtc drift %" PRId32 " ppb, %" PRIu32 " rtc writes",
+             stats.poll_cnt, stats.fail_cnt, stats.packet_cnt, stats.sample_cnt, stats.reject_cnt, stats.step_cnt,
+             stats.rtc_error_us, stats.rtc_drift_ppb, stats.rtc_write_cnt);
+}
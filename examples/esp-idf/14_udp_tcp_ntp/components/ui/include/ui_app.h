@@ -4,6 +4,7 @@
 
 void ui_init(void);
 void ui_log(const char *fmt, ...);
+void ui_log_text(const char *prefix, const char *text);
 bool ui_update_ip(const char *ip);
 void ui_update_time(const char *time_str);
 
@@ -32,6 +32,21 @@ void ui_log(const char *fmt, ...) {
     }
 }
 
+// Append a line straight from the caller's string, without formatting it into buf first
+void ui_log_text(const char *prefix, const char *text) {
+
+    if (!log_box) {
+        return;
+    }
+
+    if (lvgl_port_lock(50)) {
+        lv_textarea_add_text(log_box, prefix);
+        lv_textarea_add_text(log_box, text);
+        lv_textarea_add_text(log_box, "\n");
+        lvgl_port_unlock();
+    }
+}
+
 static void event_tcp_send(lv_event_t * e) {
     const char *msg = lv_textarea_get_text(input_box);
     ui_log("[TCP] Clicked: %s", msg);
@@ -15,6 +15,13 @@
 #include "lvgl_port.h"
 #include "ui_app.h"
 #include "net.h"
+#include "net_buf.h"
+#include "rtc_service.h"
+#include "codec_dev.h"
+#include "audio_stream.h"
+
+// Stream the microphone to EXAMPLE_SERVER_IP and play what it sends back, over RTP
+#define AUDIO_STREAM_ENABLE 0
 
 static const char *TAG = "main";
 
@@ -31,6 +38,8 @@ void peripheral_init(void)
     // Initialize Hardware
     DEV_I2C_Init();
     IO_EXTENSION_Init();
+    // Seed the system time from the RTC, so the clock is valid before WiFi is up
+    rtc_service_init();
     // Initialize LCD and Touch
     esp_lcd_panel_handle_t panel_handle = waveshare_esp32_s3_rgb_lcd_init();
     wavesahre_rgb_lcd_bl_on();
@@ -46,6 +55,20 @@ void peripheral_init(void)
     xEventGroupWaitBits(get_wifi_event_group(), WIFI_CONNECTED_BIT, pdFALSE, pdFALSE, portMAX_DELAY);
     net_start_udp_server();
     net_start_tcp_server();
+#if AUDIO_STREAM_ENABLE
+    speaker_codec_init();
+    const audio_stream_config_t stream_config = {
+        .peer_ip = EXAMPLE_SERVER_IP,
+        .codec = AUDIO_STREAM_CODEC_PCMU,
+        .send = true,
+        .receive = true,
+    };
+    if (audio_stream_start(&stream_config) == ESP_OK) {
+        ui_log("Audio stream on port %d", AUDIO_STREAM_PORT);
+    } else {
+        ESP_LOGE(TAG, "Audio stream failed to start");
+    }
+#endif
     // Initialize NTP
     initialize_sntp();
 }
@@ -53,7 +76,9 @@ void peripheral_init(void)
 void app_main(void)
 {
     peripheral_init();
+    uint32_t loops = 0;
     while (1) {
+        loops++;
         EventGroupHandle_t wifi_event_group = get_wifi_event_group();
         if (wifi_event_group) {
             const EventBits_t bits = xEventGroupGetBits(wifi_event_group);
@@ -63,17 +88,40 @@ void app_main(void)
             }
         }
 
-        time_t now;
         struct tm timeinfo;
-        time(&now);
-        localtime_r(&now, &timeinfo);
         char strftime_buf[64];
-        if (timeinfo.tm_year > (2016 - 1900)) {
+        if (rtc_service_get_localtime(&timeinfo)) { // System clock only, no I2C access
             strftime(strftime_buf, sizeof(strftime_buf), "%Y-%m-%d %H:%M:%S", &timeinfo);
             ui_update_time(strftime_buf);
         } else {
             ui_update_time("Syncing...");
         }
+        net_tcp_client_stats_t tcp_stats;
+        net_tcp_client_get_stats(&tcp_stats);
+        if (loops % 10 == 0 && tcp_stats.messages > 0) {
+            net_tcp_client_log_stats();
+        }
+        net_tcp_server_stats_t server_stats;
+        net_tcp_server_get_stats(&server_stats);
+        if (loops % 10 == 0 && server_stats.accepts > 0) {
+            net_tcp_server_log_stats();
+        }
+        net_buf_stats_t buf_stats;
+        net_buf_get_stats(&buf_stats);
+        if (loops % 10 == 0 && buf_stats.allocs > 0) {
+            net_buf_log_stats();
+        }
+#if AUDIO_STREAM_ENABLE
+        if (audio_stream_is_running() && loops % 10 == 0) {
+            audio_stream_stats_t stats;
+            audio_stream_get_stats(&stats);
+            ui_log("Audio rx %lu lost %lu.%lu%% jitter %lu ms delay %lu ms",
+                   (unsigned long)stats.rx_packets, (unsigned long)(stats.loss_permille / 10),
+                   (unsigned long)(stats.loss_permille % 10), (unsigned long)(stats.jitter_us / 1000),
+                   (unsigned long)stats.delay_avg_ms);
+            audio_stream_log_stats();
+        }
+#endif
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
 }